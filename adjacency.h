@@ -0,0 +1,331 @@
+/**
+ * Declarations and definitions of the <code>Adjacency</code> class.
+ *
+ * @file adjacency.h
+ *
+ * @author Kris Torres
+ *
+ * @date 2026-10-14
+ *
+ * @version 1.0
+ */
+
+#ifndef PIC_10C_ADJACENCY_H_
+#define PIC_10C_ADJACENCY_H_
+
+#include <string>
+#include <vector>
+#include <stdexcept>
+#include <algorithm>
+#include <utility>
+#include "index_error.h"
+
+namespace Kris_Torres_UCLA_PIC_10C_Winter_2014
+{
+   template<typename T, typename S, typename A>
+   class DirectedGraph;
+   class GraphWriter;
+   
+   /**
+    * An <b>adjacency</b> is a read-only snapshot of the directed edges of a
+    * directed graph, in <i>compressed sparse row</i> form. The tail nodes of
+    * each node are kept in one contiguous array, grouped by starting node, and
+    * the head nodes of each node are kept in another, so that graph
+    * algorithms can scan the neighbors of a node in either direction without
+    * touching the nodes themselves.<p>
+    *
+    * The tail nodes of each node are kept in the order in which they were
+    * connected, so an algorithm visits them in the same order as
+    * <code>DirectedGraph::Iterator::next</code>.
+    *
+    * @author Kris Torres
+    */
+   class Adjacency final
+   {
+   public:
+      
+      // Class
+      class Range;
+      
+      // Constructors
+      Adjacency();
+      explicit Adjacency(const size_t& n);
+      Adjacency(const size_t& n,
+         const std::vector<std::pair<size_t, size_t>>& edges);
+      
+      // Accessors
+      size_t edges() const;
+      size_t indegree(const size_t& k) const;
+      Range next(const size_t& k) const;
+      size_t outdegree(const size_t& k) const;
+      Range prev(const size_t& k) const;
+      size_t size() const;
+      
+      // Friends
+      template<typename T, typename S, typename A>
+      friend class DirectedGraph;
+      friend class GraphWriter;
+      
+   private:
+      
+      // Accessor
+      void test_index(const size_t& k) const;
+      
+      /**
+       * The position in <code>targets_</code> at which the tail nodes of each
+       * node begin, followed by the number of directed edges.
+       */
+      std::vector<size_t> offsets_;
+      
+      /** The tail node positions of all the directed edges. */
+      std::vector<size_t> targets_;
+      
+      /**
+       * The position in <code>sources_</code> at which the head nodes of each
+       * node begin, followed by the number of directed edges.
+       */
+      std::vector<size_t> reverse_offsets_;
+      
+      /** The head node positions of all the directed edges. */
+      std::vector<size_t> sources_;
+   };
+   
+   /**
+    * A <b>range</b> is a view of the adjacent nodes of one node in an
+    * adjacency, which can be traversed with a range-based <code>for</code>
+    * loop. A range is invalidated when its adjacency is destroyed.
+    *
+    * @author Kris Torres
+    */
+   class Adjacency::Range final
+   {
+   public:
+      
+      // Constructor
+      Range(const size_t* first, const size_t* last);
+      
+      // Accessors
+      const size_t* begin() const;
+      bool empty() const;
+      const size_t* end() const;
+      size_t size() const;
+      
+   private:
+      
+      /** The position of the first adjacent node. */
+      const size_t* first_;
+      
+      /** The position one past the last adjacent node. */
+      const size_t* last_;
+   };
+   
+   /** Constructs an empty adjacency, with no nodes. */
+   inline Adjacency::Adjacency() : offsets_(1, 0), reverse_offsets_(1, 0) {}
+   
+   /**
+    * Constructs an adjacency with <i>n</i> nodes and no directed edges.
+    *
+    * @param n   the number of nodes
+    */
+   inline Adjacency::Adjacency(const size_t& n)
+      : offsets_(n + 1, 0), reverse_offsets_(n + 1, 0) {}
+   
+   /**
+    * Constructs an adjacency with <i>n</i> nodes and the specified directed
+    * edges, given as pairs of starting and ending node positions. The
+    * directed edges are grouped by a stable counting sort, so the whole
+    * adjacency is built in linear time.
+    *
+    * @param n       the number of nodes
+    * @param edges   the directed edges
+    *
+    * @throws std::out_of_range if some directed edge has a node position that
+    * is at least <i>n</i>
+    */
+   inline Adjacency::Adjacency(const size_t& n,
+      const std::vector<std::pair<size_t, size_t>>& edges)
+      : offsets_(n + 1, 0), targets_(edges.size()), reverse_offsets_(n + 1, 0),
+        sources_(edges.size())
+   {
+      // Counts the outdegree and the indegree of each node.
+      for (const auto& edge : edges)
+      {
+         if (edge.first >= n || edge.second >= n)
+            throw_index_error("Invalid node index in adjacency: ",
+               std::max(edge.first, edge.second));
+         
+         offsets_[edge.first + 1]++;
+         reverse_offsets_[edge.second + 1]++;
+      }
+      
+      for (size_t i = 0; i < n; i++)
+      {
+         offsets_[i + 1] += offsets_[i];
+         reverse_offsets_[i + 1] += reverse_offsets_[i];
+      }
+      
+      // Places each directed edge at the next free slot of its group.
+      std::vector<size_t> next(offsets_.begin(), offsets_.end() - 1);
+      std::vector<size_t> prev(reverse_offsets_.begin(),
+         reverse_offsets_.end() - 1);
+      
+      for (const auto& edge : edges)
+      {
+         targets_[next[edge.first]++] = edge.second;
+         sources_[prev[edge.second]++] = edge.first;
+      }
+   }
+   
+   /**
+    * Returns the number of directed edges in this adjacency.
+    *
+    * @return the number of directed edges
+    */
+   inline size_t Adjacency::edges() const
+   {
+      return targets_.size();
+   }
+   
+   /**
+    * Returns the <b>indegree</b> of the node at position <i>k</i> in this
+    * adjacency.
+    *
+    * @param k   the position of the node
+    *
+    * @return the indegree of the node
+    *
+    * @throws std::out_of_range if <i>k</i> is at least the number of nodes
+    */
+   inline size_t Adjacency::indegree(const size_t& k) const
+   {
+      test_index(k);
+      return reverse_offsets_[k + 1] - reverse_offsets_[k];
+   }
+   
+   /**
+    * Returns the tail nodes adjacent to the node at position <i>k</i> in this
+    * adjacency.
+    *
+    * @param k   the position of the node
+    *
+    * @return the range of the tail node positions
+    *
+    * @throws std::out_of_range if <i>k</i> is at least the number of nodes
+    */
+   inline Adjacency::Range Adjacency::next(const size_t& k) const
+   {
+      test_index(k);
+      return Range(targets_.data() + offsets_[k],
+         targets_.data() + offsets_[k + 1]);
+   }
+   
+   /**
+    * Returns the <b>outdegree</b> of the node at position <i>k</i> in this
+    * adjacency.
+    *
+    * @param k   the position of the node
+    *
+    * @return the outdegree of the node
+    *
+    * @throws std::out_of_range if <i>k</i> is at least the number of nodes
+    */
+   inline size_t Adjacency::outdegree(const size_t& k) const
+   {
+      test_index(k);
+      return offsets_[k + 1] - offsets_[k];
+   }
+   
+   /**
+    * Returns the head nodes adjacent to the node at position <i>k</i> in this
+    * adjacency.
+    *
+    * @param k   the position of the node
+    *
+    * @return the range of the head node positions
+    *
+    * @throws std::out_of_range if <i>k</i> is at least the number of nodes
+    */
+   inline Adjacency::Range Adjacency::prev(const size_t& k) const
+   {
+      test_index(k);
+      return Range(sources_.data() + reverse_offsets_[k],
+         sources_.data() + reverse_offsets_[k + 1]);
+   }
+   
+   /**
+    * Returns the number of nodes in this adjacency.
+    *
+    * @return the number of nodes
+    */
+   inline size_t Adjacency::size() const
+   {
+      return offsets_.size() - 1;
+   }
+   
+   /**
+    * Tests if the specified position is a valid node position in this
+    * adjacency.
+    *
+    * @param k   the position of the node
+    *
+    * @throws std::out_of_range if <i>k</i> is at least the number of nodes
+    */
+   inline void Adjacency::test_index(const size_t& k) const
+   {
+      if (k >= size())
+         throw_index_error("Invalid node index in adjacency: ", k);
+   }
+   
+   /**
+    * Constructs a range of the adjacent nodes from <i>first</i> up to, but not
+    * including, <i>last</i>.
+    *
+    * @param first   the position of the first adjacent node
+    * @param last    the position one past the last adjacent node
+    */
+   inline Adjacency::Range::Range(const size_t* first, const size_t* last)
+      : first_(first), last_(last) {}
+   
+   /**
+    * Returns the position of the first adjacent node in this range.
+    *
+    * @return the position of the first adjacent node
+    */
+   inline const size_t* Adjacency::Range::begin() const
+   {
+      return first_;
+   }
+   
+   /**
+    * Tests if this range is empty.
+    *
+    * @return <code>true</code> if this range has no adjacent nodes, or
+    * <code>false</code> otherwise
+    */
+   inline bool Adjacency::Range::empty() const
+   {
+      return first_ == last_;
+   }
+   
+   /**
+    * Returns the position one past the last adjacent node in this range.
+    *
+    * @return the position one past the last adjacent node
+    */
+   inline const size_t* Adjacency::Range::end() const
+   {
+      return last_;
+   }
+   
+   /**
+    * Returns the number of adjacent nodes in this range.
+    *
+    * @return the number of adjacent nodes
+    */
+   inline size_t Adjacency::Range::size() const
+   {
+      return last_ - first_;
+   }
+}
+
+#endif   // PIC_10C_ADJACENCY_H_
@@ -0,0 +1,88 @@
+/**
+ * Declarations and definitions of the <code>Barrier</code> class.
+ *
+ * @file barrier.h
+ *
+ * @author Kris Torres
+ *
+ * @date 2026-10-14
+ *
+ * @version 1.0
+ */
+
+#ifndef PIC_10C_BARRIER_H_
+#define PIC_10C_BARRIER_H_
+
+#include <cstddef>
+#include <mutex>
+#include <condition_variable>
+
+namespace Kris_Torres_UCLA_PIC_10C_Winter_2014
+{
+   /**
+    * A <b>barrier</b> blocks each of a fixed number of threads until all of
+    * them have reached it, and can then be reused for the next step. The
+    * parallel graph algorithms meet at a barrier after every level or
+    * iteration, so that the writes of one step are seen by the next.
+    *
+    * @author Kris Torres
+    */
+   class Barrier final
+   {
+   public:
+      
+      // Constructor
+      explicit Barrier(const size_t& count);
+      
+      // Mutator
+      void wait();
+      
+   private:
+      
+      /** The mutex that guards the barrier. */
+      std::mutex mutex_;
+      
+      /** The condition on which the waiting threads block. */
+      std::condition_variable condition_;
+      
+      /** The number of threads that meet at the barrier. */
+      size_t count_;
+      
+      /** The number of threads waiting at the barrier. */
+      size_t waiting_;
+      
+      /** The number of times that all of the threads have met. */
+      size_t generation_;
+   };
+   
+   /**
+    * Constructs a barrier at which the specified number of threads meet.
+    *
+    * @param count   the number of threads
+    */
+   inline Barrier::Barrier(const size_t& count)
+      : count_(count), waiting_(0), generation_(0) {}
+   
+   /**
+    * Blocks the calling thread until all of the threads have reached this
+    * barrier.
+    */
+   inline void Barrier::wait()
+   {
+      std::unique_lock<std::mutex> lock(mutex_);
+      const size_t generation = generation_;
+      
+      if (++waiting_ == count_)
+      {
+         waiting_ = 0;
+         generation_++;
+         condition_.notify_all();
+      }
+      else
+      {
+         condition_.wait(lock, [&] { return generation != generation_; });
+      }
+   }
+}
+
+#endif   // PIC_10C_BARRIER_H_
@@ -0,0 +1,1845 @@
+/**
+ * Declarations and definitions of the <code>DirectedGraph</code> class for the
+ * <code>BitsetStorage</code> storage policy, and <code>operator<<</code> for
+ * that class.
+ *
+ * @file bitset_directed_graph.h
+ *
+ * @author Kris Torres
+ *
+ * @date 2026-10-14
+ *
+ * @version 1.0
+ */
+
+#ifndef PIC_10C_BITSET_DIRECTED_GRAPH_H_
+#define PIC_10C_BITSET_DIRECTED_GRAPH_H_
+
+#include <string>
+#include <vector>
+#include <map>
+#include <stdexcept>
+#include <algorithm>
+#include <initializer_list>
+#include <utility>
+#include <iterator>
+#include <cstdint>
+#include "adjacency.h"
+#include "directed_graph.h"
+#include "index_error.h"
+
+namespace Kris_Torres_UCLA_PIC_10C_Winter_2014
+{
+   /**
+    * A directed graph stored as a packed <i>adjacency matrix</i>, with one bit
+    * for each ordered pair of nodes. Row <i>i</i> of the matrix has a bit set
+    * in column <i>j</i> if there is a directed edge from node <i>i</i> to node
+    * <i>j</i>; the transposed matrix is kept as well, so that the head nodes
+    * of a node are one row too. A directed edge costs no memory of its own,
+    * testing for one takes constant time, and the degree of a node is the
+    * number of bits set in its row, counted a 64-bit word at a time.<p>
+    *
+    * The matrix can only tell whether a directed edge exists. The multiple
+    * directed edges, which are rare, are counted in a side table that stays
+    * empty as long as the directed graph has none.<p>
+    *
+    * The public interface is the same as that of the default storage policy,
+    * along with <code>transitive_closure</code>, except that the tail nodes
+    * and the head nodes of each node are kept in increasing order of position
+    * rather than in the order in which they were connected. The matrix takes
+    * <i>V</i><sup>2</sup> / 4 bytes, so this storage policy favors small,
+    * dense directed graphs.
+    *
+    * @param T   the type of the elements
+    * @param A   the allocator type
+    *
+    * @author Kris Torres
+    */
+   template<typename T, typename A>
+   class DirectedGraph<T, BitsetStorage, A>
+   {
+   public:
+      
+      // Class
+      class Iterator;
+      
+      // Type
+      typedef A allocator_type;
+      
+      // Constructors
+      DirectedGraph();
+      explicit DirectedGraph(const A& alloc);
+      explicit DirectedGraph(const size_t& n, const A& alloc = A());
+      DirectedGraph(const size_t& n, const T& val, const A& alloc = A());
+      DirectedGraph(const std::vector<T>& v, const A& alloc = A());
+      DirectedGraph(std::vector<T>&& v, const A& alloc = A());
+      DirectedGraph(const std::initializer_list<T> il, const A& alloc = A());
+      DirectedGraph(const DirectedGraph& rhs);
+      DirectedGraph(const DirectedGraph& rhs, const A& alloc);
+      DirectedGraph(DirectedGraph&& rhs) noexcept;
+      
+      // Assignment operators
+      DirectedGraph& operator=(const DirectedGraph& rhs);
+      DirectedGraph& operator=(DirectedGraph&& rhs)
+         noexcept(std::allocator_traits<A>
+            ::propagate_on_container_move_assignment::value);
+      
+      // Destructor
+      virtual ~DirectedGraph();
+      
+      // Mutators
+      T& at(const size_t& k);
+      Iterator begin();
+      void clear();
+      void connect(const size_t& from, const size_t& to);
+      template<typename InputIterator>
+      void connect_bulk(InputIterator first, InputIterator last);
+      void connect_bulk(
+         const std::initializer_list<std::pair<size_t, size_t>> il);
+      void dedupe_edges();
+      void disconnect(const size_t& k);
+      void disconnect(const size_t& from, const size_t& to);
+      template<typename... Args>
+      void emplace_back(Args&&... args);
+      void erase(const size_t& k);
+      T& front();
+      T& operator[](const size_t& k);
+      void push_back(const T& val);
+      void push_back(T&& val);
+      void remove_self_loops();
+      void reserve(const size_t& nodes, const size_t& edges = 0);
+      void swap(DirectedGraph& rhs) noexcept;
+      
+      // Accessors
+      Adjacency adjacency() const;
+      T at(const size_t& k) const;
+      size_t edge_count(const size_t& from, const size_t& to) const;
+      size_t edges() const;
+      bool empty() const;
+      T front() const;
+      A get_allocator() const;
+      bool has_edge(const size_t& from, const size_t& to) const;
+      size_t indegree(const size_t& k) const;
+      T operator[](const size_t& k) const;
+      size_t outdegree(const size_t& k) const;
+      bool simple() const;
+      size_t size() const;
+      DirectedGraph transitive_closure() const;
+      
+      // Relational operators
+      bool operator==(const DirectedGraph& rhs) const;
+      bool operator!=(const DirectedGraph& rhs) const;
+      
+      // Friend
+      template<typename U, typename V>
+      friend std::ostream& operator<<(std::ostream& out,
+         const DirectedGraph<U, BitsetStorage, V>& rhs);
+      
+   private:
+      
+      // Types
+      template<typename U>
+      using Allocator =
+         typename std::allocator_traits<A>::template rebind_alloc<U>;
+      typedef std::uint64_t Word;
+      typedef std::vector<Word, Allocator<Word>> Words;
+      typedef std::vector<size_t, Allocator<size_t>> Indices;
+      typedef std::pair<size_t, size_t> EdgeKey;
+      typedef std::map<EdgeKey, size_t, std::less<EdgeKey>,
+         Allocator<std::pair<const EdgeKey, size_t>>> Parallels;
+      
+      // Constant
+      static const size_t bits = 64;
+      
+      // Mutators
+      void add_parallel(const size_t& from, const size_t& to);
+      void attach_nodes();
+      void restride(const size_t& stride);
+      
+      // Accessors
+      size_t multiplicity(const size_t& from, const size_t& to) const;
+      size_t row_count(const Words& matrix, const size_t& k) const;
+      size_t select(const size_t& k, const size_t& n, const bool& forward)
+         const;
+      void test_index(const size_t& k, const char* error) const;
+      size_t words() const;
+      
+      // Helpers
+      static size_t count_bits(const Word& word);
+      static size_t lowest_bit(const Word& word);
+      static void remove_column(Word* row, const size_t& words,
+         const size_t& k);
+      template<typename F>
+      static void scan_row(const Word* row, const size_t& words, F f);
+      
+      /** The values of the nodes in this directed graph. */
+      std::vector<T, A> values_;
+      
+      /**
+       * The adjacency matrix of this directed graph, one row of
+       * <code>stride_</code> words for each node. The bits past the last
+       * node are always clear.
+       */
+      Words out_;
+      
+      /** The transpose of the adjacency matrix. */
+      Words in_;
+      
+      /**
+       * The number of words in each row of the matrices, which is doubled
+       * as the nodes outgrow it.
+       */
+      size_t stride_;
+      
+      /**
+       * The number of directed edges beyond the first from each starting node
+       * to each ending node, for the pairs of nodes with more than one.
+       */
+      Parallels parallels_;
+      
+      /** The number of multiple directed edges that leave each node. */
+      Indices parallel_out_;
+      
+      /** The number of multiple directed edges that enter each node. */
+      Indices parallel_in_;
+      
+      /** The number of directed edges in this directed graph. */
+      size_t edges_;
+   };
+   
+   /**
+    * <i>Iterators</i> are objects that point to some nodes in a directed graph
+    * and have the ability to traverse through the nodes in that directed
+    * graph.<p>
+    *
+    * An iterator for the <code>BitsetStorage</code> storage policy holds the
+    * position of its node, so it is invalidated by <code>erase</code>.
+    *
+    * @author Kris Torres
+    */
+   template<typename T, typename A>
+   class DirectedGraph<T, BitsetStorage, A>::Iterator
+   {
+   public:
+      
+      // Constructor
+      Iterator();
+      
+      // Destructor
+      virtual ~Iterator();
+      
+      // Mutators
+      void next(const size_t& k);
+      T& operator*();
+      void prev(const size_t& k);
+      
+      // Accessors
+      size_t indegree() const;
+      T operator*() const;
+      T* operator->() const;
+      size_t outdegree() const;
+      
+      // Relational operators
+      bool operator==(const Iterator& rhs) const;
+      bool operator!=(const Iterator& rhs) const;
+      
+      // Friend
+      friend class DirectedGraph<T, BitsetStorage, A>;
+      
+   private:
+      
+      /** The position of this iterator in the directed graph. */
+      size_t position_;
+      
+      /** The directed graph that this iterator traverses. */
+      DirectedGraph<T, BitsetStorage, A>* container_;
+   };
+   
+   // Directed graph output operator
+   template<typename T, typename A>
+   std::ostream& operator<<(std::ostream& out,
+      const DirectedGraph<T, BitsetStorage, A>& rhs);
+   
+   template<typename T, typename A>
+   const size_t DirectedGraph<T, BitsetStorage, A>::bits;
+   
+   /** Constructs an empty directed graph, with no nodes. */
+   template<typename T, typename A>
+   inline DirectedGraph<T, BitsetStorage, A>::DirectedGraph()
+      : stride_(0), edges_(0) {}
+   
+   /**
+    * Constructs an empty directed graph, with no nodes, that allocates its
+    * memory with the specified allocator.
+    *
+    * @param alloc   the allocator
+    */
+   template<typename T, typename A>
+   inline DirectedGraph<T, BitsetStorage, A>::DirectedGraph(const A& alloc)
+      : values_(alloc), out_(alloc), in_(alloc), stride_(0),
+        parallels_(alloc), parallel_out_(alloc), parallel_in_(alloc),
+        edges_(0) {}
+   
+   /**
+    * Constructs a directed graph with <i>n</i> nodes. Each node has the
+    * default value of the specified type for the directed graph.
+    *
+    * @param n       the initial number of nodes
+    * @param alloc   the allocator
+    */
+   template<typename T, typename A>
+   DirectedGraph<T, BitsetStorage, A>::DirectedGraph(const size_t& n,
+      const A& alloc)
+      : values_(n, T(), alloc), out_(alloc), in_(alloc), stride_(0),
+        parallels_(alloc), parallel_out_(alloc), parallel_in_(alloc),
+        edges_(0)
+   {
+      attach_nodes();
+   }
+   
+   /**
+    * Constructs a directed graph with <i>n</i> nodes. Each node has the
+    * specified value.
+    *
+    * @param n       the initial number of nodes
+    * @param val     the value of each node
+    * @param alloc   the allocator
+    */
+   template<typename T, typename A>
+   DirectedGraph<T, BitsetStorage, A>::DirectedGraph(const size_t& n,
+      const T& val, const A& alloc)
+      : values_(n, val, alloc), out_(alloc), in_(alloc), stride_(0),
+        parallels_(alloc), parallel_out_(alloc), parallel_in_(alloc),
+        edges_(0)
+   {
+      attach_nodes();
+   }
+   
+   /**
+    * Constructs a directed graph that contains nodes with each of the elements
+    * in the specified vector.
+    *
+    * @param v       the vector of elements
+    * @param alloc   the allocator
+    */
+   template<typename T, typename A>
+   DirectedGraph<T, BitsetStorage, A>::DirectedGraph(const std::vector<T>& v,
+      const A& alloc)
+      : values_(v.begin(), v.end(), alloc), out_(alloc), in_(alloc),
+        stride_(0), parallels_(alloc), parallel_out_(alloc),
+        parallel_in_(alloc), edges_(0)
+   {
+      attach_nodes();
+   }
+   
+   /**
+    * Constructs a directed graph that contains nodes with each of the elements
+    * in the specified vector. Each element is moved into its node, and the
+    * vector is left in a valid but unspecified state.
+    *
+    * @param v       the vector of elements
+    * @param alloc   the allocator
+    */
+   template<typename T, typename A>
+   DirectedGraph<T, BitsetStorage, A>::DirectedGraph(std::vector<T>&& v,
+      const A& alloc)
+      : values_(std::make_move_iterator(v.begin()),
+           std::make_move_iterator(v.end()), alloc),
+        out_(alloc), in_(alloc), stride_(0), parallels_(alloc),
+        parallel_out_(alloc), parallel_in_(alloc), edges_(0)
+   {
+      attach_nodes();
+   }
+   
+   /**
+    * Constructs a directed graph that contains nodes with each of the elements
+    * in the specified initializer list.
+    *
+    * @param il      the initializer list of elements
+    * @param alloc   the allocator
+    */
+   template<typename T, typename A>
+   DirectedGraph<T, BitsetStorage, A>
+      ::DirectedGraph(const std::initializer_list<T> il, const A& alloc)
+      : values_(il, alloc), out_(alloc), in_(alloc), stride_(0),
+        parallels_(alloc), parallel_out_(alloc), parallel_in_(alloc),
+        edges_(0)
+   {
+      attach_nodes();
+   }
+   
+   /**
+    * Constructs a directed graph with a copy of each of the nodes in the
+    * specified directed graph.
+    *
+    * @param rhs   the directed graph to be copied
+    */
+   template<typename T, typename A>
+   DirectedGraph<T, BitsetStorage, A>::DirectedGraph(const DirectedGraph& rhs)
+      : DirectedGraph(rhs, std::allocator_traits<A>
+         ::select_on_container_copy_construction(rhs.get_allocator())) {}
+   
+   /**
+    * Constructs a directed graph with a copy of each of the nodes in the
+    * specified directed graph, allocating its memory with the specified
+    * allocator.
+    *
+    * @param rhs     the directed graph to be copied
+    * @param alloc   the allocator
+    */
+   template<typename T, typename A>
+   DirectedGraph<T, BitsetStorage, A>::DirectedGraph(const DirectedGraph& rhs,
+      const A& alloc)
+      : values_(rhs.values_, alloc), out_(rhs.out_, alloc),
+        in_(rhs.in_, alloc), stride_(rhs.stride_),
+        parallels_(rhs.parallels_, alloc),
+        parallel_out_(rhs.parallel_out_, alloc),
+        parallel_in_(rhs.parallel_in_, alloc), edges_(rhs.edges_) {}
+   
+   /**
+    * Constructs a directed graph that acquires the nodes in the specified
+    * directed graph. Note that the specified directed graph is left in an
+    * unspecified but valid state.
+    *
+    * @param rhs   the directed graph to be moved
+    */
+   template<typename T, typename A>
+   DirectedGraph<T, BitsetStorage, A>::DirectedGraph(DirectedGraph&& rhs)
+      noexcept
+      : values_(std::move(rhs.values_)), out_(std::move(rhs.out_)),
+        in_(std::move(rhs.in_)), stride_(rhs.stride_),
+        parallels_(std::move(rhs.parallels_)),
+        parallel_out_(std::move(rhs.parallel_out_)),
+        parallel_in_(std::move(rhs.parallel_in_)), edges_(rhs.edges_)
+   {
+      rhs.clear();
+   }
+   
+   /**
+    * Copies all the nodes in the specified directed graph into this directed
+    * graph, with the former preserving its contents.
+    *
+    * @param rhs   the directed graph to be copied
+    *
+    * @return this directed graph after the assignment
+    */
+   template<typename T, typename A>
+   DirectedGraph<T, BitsetStorage, A>& DirectedGraph<T, BitsetStorage, A>
+      ::operator=(const DirectedGraph& rhs)
+   {
+      // Tests for self-assignment.
+      if (this != &rhs)
+      {
+         values_ = rhs.values_;
+         out_ = rhs.out_;
+         in_ = rhs.in_;
+         stride_ = rhs.stride_;
+         parallels_ = rhs.parallels_;
+         parallel_out_ = rhs.parallel_out_;
+         parallel_in_ = rhs.parallel_in_;
+         edges_ = rhs.edges_;
+      }
+      
+      return *this;
+   }
+   
+   /**
+    * Moves all the nodes in the specified directed graph into this directed
+    * graph, with the former left in an unspecified but valid state.
+    *
+    * @param rhs   the directed graph to be moved
+    *
+    * @return this directed graph after the assignment
+    */
+   template<typename T, typename A>
+   DirectedGraph<T, BitsetStorage, A>& DirectedGraph<T, BitsetStorage, A>
+      ::operator=(DirectedGraph&& rhs)
+      noexcept(std::allocator_traits<A>
+         ::propagate_on_container_move_assignment::value)
+   {
+      // Tests for self-assignment.
+      if (this != &rhs)
+      {
+         values_ = std::move(rhs.values_);
+         out_ = std::move(rhs.out_);
+         in_ = std::move(rhs.in_);
+         stride_ = rhs.stride_;
+         parallels_ = std::move(rhs.parallels_);
+         parallel_out_ = std::move(rhs.parallel_out_);
+         parallel_in_ = std::move(rhs.parallel_in_);
+         edges_ = rhs.edges_;
+         rhs.clear();
+      }
+      
+      return *this;
+   }
+   
+   /** Destroys this directed graph. */
+   template<typename T, typename A>
+   inline DirectedGraph<T, BitsetStorage, A>::~DirectedGraph() {}
+   
+   /**
+    * Returns a reference to the value of the node at position <i>k</i> in this
+    * directed graph.<p>
+    *
+    * The function automatically checks whether <i>k</i> is within the bounds of
+    * valid positions in the directed graph, throwing an
+    * <code>std::out_of_range</code> exception if it is not (i.e., if <i>k</i>
+    * is greater than or equal to the number of nodes in the directed graph).
+    * This is in contrast with member <code>operator[]</code>, which does not
+    * check against bounds.
+    *
+    * @param k   the position of the node
+    *
+    * @return a reference to the value of the node at position <i>k</i>
+    *
+    * @throws std::out_of_range if <i>k</i> is out of bounds
+    */
+   template<typename T, typename A>
+   T& DirectedGraph<T, BitsetStorage, A>::at(const size_t& k)
+   {
+      // Tests if k is valid.
+      test_index(k, "Invalid node index in directed graph: ");
+      
+      return values_[k];
+   }
+   
+   /**
+    * Returns an iterator pointing to the first node in this directed graph.
+    *
+    * @return an iterator pointing to the first node
+    *
+    * @throws std::out_of_range if this directed graph is empty
+    */
+   template<typename T, typename A>
+   typename DirectedGraph<T, BitsetStorage, A>::Iterator
+      DirectedGraph<T, BitsetStorage, A>::begin()
+   {
+      // Tests if the directed graph is empty.
+      if (empty()) throw std::out_of_range("Empty directed graph");
+      
+      Iterator start;
+      start.position_ = 0;
+      start.container_ = this;
+      return start;
+   }
+   
+   /**
+    * Removes all nodes from this directed graph, leaving the directed graph
+    * with no nodes.
+    */
+   template<typename T, typename A>
+   void DirectedGraph<T, BitsetStorage, A>::clear()
+   {
+      values_.clear();
+      out_.clear();
+      in_.clear();
+      stride_ = 0;
+      parallels_.clear();
+      parallel_out_.clear();
+      parallel_in_.clear();
+      edges_ = 0;
+   }
+   
+   /**
+    * Connects a directed edge from the specified starting node to the specified
+    * ending node in this directed graph, in constant time unless the directed
+    * edge is a multiple one.<p>
+    *
+    * The function automatically checks whether <code>from</code> and
+    * <code>to</code> are greater than or equal to the number of nodes in the
+    * directed graph, throwing an <code>std::out_of_range</code> exception if it
+    * is not.
+    *
+    * @param from   the position of the starting node
+    * @param to     the position of the ending node
+    *
+    * @throws std::out_of_range if either <code>from</code> or <code>to</code>
+    * is out of bounds
+    */
+   template<typename T, typename A>
+   void DirectedGraph<T, BitsetStorage, A>::connect(const size_t& from,
+      const size_t& to)
+   {
+      // Tests if the starting and ending node indices are valid.
+      test_index(from, "Invalid starting node index in directed graph: ");
+      test_index(to, "Invalid ending node index in directed graph: ");
+      
+      Word& word = out_[from * stride_ + to / bits];
+      const Word mask = Word(1) << (to % bits);
+      
+      if (word & mask) add_parallel(from, to);
+      else
+      {
+         word |= mask;
+         in_[to * stride_ + from / bits] |= Word(1) << (from % bits);
+      }
+      
+      edges_++;
+   }
+   
+   /**
+    * Connects a directed edge for each (starting node, ending node) pair of
+    * positions in the range [<code>first</code>, <code>last</code>) in this
+    * directed graph.<p>
+    *
+    * The function automatically checks whether any position in the range is
+    * greater than or equal to the number of nodes in the directed graph,
+    * throwing an <code>std::out_of_range</code> exception if it is. In that
+    * case, no directed edge is connected.
+    *
+    * @param first   the iterator to the first pair of positions
+    * @param last    the iterator past the last pair of positions
+    *
+    * @throws std::out_of_range if any position in the range is out of bounds
+    */
+   template<typename T, typename A>
+   template<typename InputIterator>
+   void DirectedGraph<T, BitsetStorage, A>::connect_bulk(InputIterator first,
+      InputIterator last)
+   {
+      std::vector<EdgeKey, Allocator<EdgeKey>> edges(get_allocator());
+      
+      // Tests if the starting and ending node indices are valid.
+      for (; first != last; ++first)
+      {
+         const size_t from = (*first).first;
+         const size_t to = (*first).second;
+         test_index(from, "Invalid starting node index in directed graph: ");
+         test_index(to, "Invalid ending node index in directed graph: ");
+         edges.push_back(EdgeKey(from, to));
+      }
+      
+      for (const auto& element : edges) connect(element.first, element.second);
+   }
+   
+   /**
+    * Connects a directed edge for each (starting node, ending node) pair of
+    * positions in the specified initializer list in this directed graph.<p>
+    *
+    * The function automatically checks whether any position in the list is
+    * greater than or equal to the number of nodes in the directed graph,
+    * throwing an <code>std::out_of_range</code> exception if it is. In that
+    * case, no directed edge is connected.
+    *
+    * @param il   the initializer list of pairs of positions
+    *
+    * @throws std::out_of_range if any position in the list is out of bounds
+    */
+   template<typename T, typename A>
+   inline void DirectedGraph<T, BitsetStorage, A>::connect_bulk(
+      const std::initializer_list<std::pair<size_t, size_t>> il)
+   {
+      connect_bulk(il.begin(), il.end());
+   }
+   
+   /**
+    * Removes the multiple directed edges in this directed graph, so that at
+    * most one directed edge is left from each starting node to each ending
+    * node. Only the side table of multiple directed edges is cleared, so the
+    * function takes linear time in the number of nodes.
+    */
+   template<typename T, typename A>
+   void DirectedGraph<T, BitsetStorage, A>::dedupe_edges()
+   {
+      for (const auto& element : parallels_) edges_ -= element.second;
+      
+      parallels_.clear();
+      std::fill(parallel_out_.begin(), parallel_out_.end(), 0);
+      std::fill(parallel_in_.begin(), parallel_in_.end(), 0);
+   }
+   
+   /**
+    * Disconnects all head nodes and all tail nodes adjacent to the node at
+    * position <i>k</i> in this directed graph.<p>
+    *
+    * The function automatically checks whether <i>k</i> is greater than or
+    * equal to the number of nodes in the directed graph, throwing an
+    * <code>std::out_of_range</code> exception if it is not.
+    *
+    * @param k   the position of the node
+    *
+    * @throws std::out_of_range if <i>k</i> is out of bounds
+    */
+   template<typename T, typename A>
+   void DirectedGraph<T, BitsetStorage, A>::disconnect(const size_t& k)
+   {
+      // Tests if k is valid.
+      test_index(k, "Invalid node index in directed graph: ");
+      
+      // Removes the multiple directed edges of the given node.
+      for (auto position = parallels_.begin(); position != parallels_.end();)
+      {
+         const EdgeKey& key = position -> first;
+         
+         if (key.first != k && key.second != k)
+         {
+            ++position;
+            continue;
+         }
+         
+         parallel_out_[key.first] -= position -> second;
+         parallel_in_[key.second] -= position -> second;
+         edges_ -= position -> second;
+         position = parallels_.erase(position);
+      }
+      
+      Word* row = out_.data() + k * stride_;
+      Word* column = in_.data() + k * stride_;
+      const Word mask = Word(1) << (k % bits);
+      
+      // Clears the given node from the rows of its neighbors.
+      scan_row(row, words(), [&](const size_t& tail)
+      {
+         in_[tail * stride_ + k / bits] &= ~mask;
+         edges_--;
+      });
+      
+      scan_row(column, words(), [&](const size_t& head)
+      {
+         out_[head * stride_ + k / bits] &= ~mask;
+         
+         // A loop was already counted with the tail nodes.
+         if (head != k) edges_--;
+      });
+      
+      std::fill(row, row + stride_, Word(0));
+      std::fill(column, column + stride_, Word(0));
+   }
+   
+   /**
+    * Disconnects a directed edge from the specified starting node to the
+    * specified ending node in this directed graph, in constant time unless
+    * the directed edge is a multiple one.<p>
+    *
+    * The function automatically checks whether <code>from</code> and
+    * <code>to</code> are greater than or equal to the number of nodes in the
+    * directed graph, throwing an <code>std::out_of_range</code> exception if it
+    * is not.
+    *
+    * @param from   the position of the starting node
+    * @param to     the position of the ending node
+    *
+    * @throws std::out_of_range if either <code>from</code> or <code>to</code>
+    * is out of bounds
+    */
+   template<typename T, typename A>
+   void DirectedGraph<T, BitsetStorage, A>::disconnect(const size_t& from,
+      const size_t& to)
+   {
+      // Tests if the starting and ending node indices are valid.
+      test_index(from, "Invalid starting node index in directed graph: ");
+      test_index(to, "Invalid ending node index in directed graph: ");
+      
+      Word& word = out_[from * stride_ + to / bits];
+      const Word mask = Word(1) << (to % bits);
+      
+      // Tests if the given directed edge is missing.
+      if (!(word & mask)) return;
+      
+      edges_--;
+      
+      if (!parallels_.empty())
+      {
+         auto position = parallels_.find(EdgeKey(from, to));
+         
+         // Removes one of the multiple directed edges instead of the bit.
+         if (position != parallels_.end())
+         {
+            parallel_out_[from]--;
+            parallel_in_[to]--;
+            if (--position -> second == 0) parallels_.erase(position);
+            return;
+         }
+      }
+      
+      word &= ~mask;
+      in_[to * stride_ + from / bits] &= ~(Word(1) << (from % bits));
+   }
+   
+   /**
+    * Adds a node to this directed graph, after its current last node. The
+    * value of the new node is constructed in place from the specified
+    * arguments. The row and the column of the node are cleared in amortized
+    * constant time, but the matrices are laid out again whenever the number
+    * of nodes outgrows a power of two.
+    *
+    * @param args   the arguments with which to construct the value
+    */
+   template<typename T, typename A>
+   template<typename... Args>
+   void DirectedGraph<T, BitsetStorage, A>::emplace_back(Args&&... args)
+   {
+      values_.emplace_back(std::forward<Args>(args)...);
+      
+      if (size() > stride_ * bits)
+         restride(std::max(stride_ * 2, static_cast<size_t>(1)));
+      
+      out_.resize(size() * stride_, Word(0));
+      in_.resize(size() * stride_, Word(0));
+      parallel_out_.push_back(0);
+      parallel_in_.push_back(0);
+   }
+   
+   /**
+    * Removes the node at position <i>k</i> from this directed graph. The nodes
+    * after position <i>k</i> are moved down by one position, and the directed
+    * edges between them are kept. Every row is shifted by one bit past column
+    * <i>k</i>, so the function takes O(<i>V</i><sup>2</sup> / 64) time.<p>
+    *
+    * The function automatically checks whether <i>k</i> is greater than or
+    * equal to the number of nodes in the directed graph, throwing an
+    * <code>std::out_of_range</code> exception if it is not.
+    *
+    * @param k   the position of the node
+    *
+    * @throws std::out_of_range if <i>k</i> is out of bounds
+    */
+   template<typename T, typename A>
+   void DirectedGraph<T, BitsetStorage, A>::erase(const size_t& k)
+   {
+      // Tests if k is valid.
+      test_index(k, "Invalid node index in directed graph: ");
+      
+      disconnect(k);
+      values_.erase(values_.begin() + k);
+      out_.erase(out_.begin() + k * stride_, out_.begin() + (k + 1) * stride_);
+      in_.erase(in_.begin() + k * stride_, in_.begin() + (k + 1) * stride_);
+      parallel_out_.erase(parallel_out_.begin() + k);
+      parallel_in_.erase(parallel_in_.begin() + k);
+      
+      // Renumbers the nodes after the removed node.
+      for (size_t i = 0; i < size(); i++)
+      {
+         remove_column(out_.data() + i * stride_, stride_, k);
+         remove_column(in_.data() + i * stride_, stride_, k);
+      }
+      
+      if (!parallels_.empty())
+      {
+         Parallels renumbered(parallels_.get_allocator());
+         
+         for (const auto& element : parallels_)
+         {
+            const size_t from = element.first.first;
+            const size_t to = element.first.second;
+            renumbered.insert(renumbered.end(), std::make_pair(
+               EdgeKey(from > k ? from - 1 : from, to > k ? to - 1 : to),
+               element.second));
+         }
+         
+         parallels_.swap(renumbered);
+      }
+   }
+   
+   /**
+    * Returns a reference to the value of the first node in this directed graph.
+    *
+    * @return a reference to the value of the first node
+    *
+    * @throws std::out_of_range if this directed graph is empty
+    */
+   template<typename T, typename A>
+   T& DirectedGraph<T, BitsetStorage, A>::front()
+   {
+      // Tests if the directed graph is empty.
+      if (empty()) throw std::out_of_range("Empty directed graph");
+      
+      return values_.front();
+   }
+   
+   /**
+    * Returns a reference to the value of the node at position <i>k</i> in this
+    * directed graph.
+    *
+    * @param k   the position of the node
+    *
+    * @return a reference to the value of the node at position <i>k</i>
+    */
+   template<typename T, typename A>
+   inline T& DirectedGraph<T, BitsetStorage, A>::operator[](const size_t& k)
+   {
+      return values_[k];
+   }
+   
+   /**
+    * Adds a node with the specified value to this directed graph, after its
+    * current last node.
+    *
+    * @param val   the value of the new node
+    */
+   template<typename T, typename A>
+   inline void DirectedGraph<T, BitsetStorage, A>::push_back(const T& val)
+   {
+      emplace_back(val);
+   }
+   
+   /**
+    * Adds a node with the specified value to this directed graph, after its
+    * current last node. The value is moved into the new node.
+    *
+    * @param val   the value of the new node
+    */
+   template<typename T, typename A>
+   inline void DirectedGraph<T, BitsetStorage, A>::push_back(T&& val)
+   {
+      emplace_back(std::move(val));
+   }
+   
+   /**
+    * Removes every loop (directed edge from a node to itself) in this directed
+    * graph, in linear time in the number of nodes.
+    */
+   template<typename T, typename A>
+   void DirectedGraph<T, BitsetStorage, A>::remove_self_loops()
+   {
+      for (size_t i = 0; i < size(); i++)
+      {
+         const size_t count = multiplicity(i, i);
+         if (count == 0) continue;
+         
+         out_[i * stride_ + i / bits] &= ~(Word(1) << (i % bits));
+         in_[i * stride_ + i / bits] &= ~(Word(1) << (i % bits));
+         edges_ -= count;
+         
+         if (count > 1)
+         {
+            parallels_.erase(EdgeKey(i, i));
+            parallel_out_[i] -= count - 1;
+            parallel_in_[i] -= count - 1;
+         }
+      }
+   }
+   
+   /**
+    * Reserves memory for at least the specified number of nodes, so that
+    * adding up to that many nodes does not lay out the matrices again. The
+    * number of directed edges is ignored, since the matrices already have
+    * room for every directed edge.
+    *
+    * @param nodes   the number of nodes
+    * @param edges   the number of directed edges
+    */
+   template<typename T, typename A>
+   void DirectedGraph<T, BitsetStorage, A>::reserve(const size_t& nodes,
+      const size_t& /* edges */)
+   {
+      values_.reserve(nodes);
+      parallel_out_.reserve(nodes);
+      parallel_in_.reserve(nodes);
+      
+      const size_t stride = (nodes + bits - 1) / bits;
+      if (stride > stride_) restride(stride);
+      
+      out_.reserve(nodes * stride_);
+      in_.reserve(nodes * stride_);
+   }
+   
+   /**
+    * Exchanges the content of this directed graph with the content of the
+    * specified directed graph. No node or directed edge is copied or
+    * allocated.
+    *
+    * @param rhs   the directed graph to be swapped
+    */
+   template<typename T, typename A>
+   void DirectedGraph<T, BitsetStorage, A>::swap(DirectedGraph& rhs) noexcept
+   {
+      values_.swap(rhs.values_);
+      out_.swap(rhs.out_);
+      in_.swap(rhs.in_);
+      std::swap(stride_, rhs.stride_);
+      parallels_.swap(rhs.parallels_);
+      parallel_out_.swap(rhs.parallel_out_);
+      parallel_in_.swap(rhs.parallel_in_);
+      std::swap(edges_, rhs.edges_);
+   }
+   
+   /**
+    * Returns a snapshot of the directed edges in this directed graph, with the
+    * tail nodes and the head nodes of each node in increasing order of
+    * position. The snapshot is not updated when this directed graph is
+    * modified.
+    *
+    * @return the adjacency of this directed graph
+    */
+   template<typename T, typename A>
+   Adjacency DirectedGraph<T, BitsetStorage, A>::adjacency() const
+   {
+      Adjacency result;
+      if (empty()) return result;
+      
+      // Each matrix is already grouped by node, so its rows are read in order.
+      auto read = [&](const Words& matrix, const bool& forward,
+         std::vector<size_t>& offsets, std::vector<size_t>& targets)
+      {
+         offsets.assign(size() + 1, 0);
+         targets.reserve(edges_);
+         
+         for (size_t i = 0; i < size(); i++)
+         {
+            scan_row(matrix.data() + i * stride_, words(),
+               [&](const size_t& j)
+            {
+               size_t count = 1;
+               
+               if (!parallels_.empty())
+                  count = forward ? multiplicity(i, j) : multiplicity(j, i);
+               
+               targets.insert(targets.end(), count, j);
+            });
+            
+            offsets[i + 1] = targets.size();
+         }
+      };
+      
+      read(out_, true, result.offsets_, result.targets_);
+      read(in_, false, result.reverse_offsets_, result.sources_);
+      return result;
+   }
+   
+   /**
+    * Returns the value of the node at position <i>k</i> in this directed
+    * graph.<p>
+    *
+    * The function automatically checks whether <i>k</i> is within the bounds of
+    * valid positions in the directed graph, throwing an
+    * <code>std::out_of_range</code> exception if it is not (i.e., if <i>k</i>
+    * is greater than or equal to the number of nodes in the directed graph).
+    * This is in contrast with member <code>operator[]</code>, which does not
+    * check against bounds.
+    *
+    * @param k   the position of the node
+    *
+    * @return the value of the node at position <i>k</i>
+    *
+    * @throws std::out_of_range if <i>k</i> is out of bounds
+    */
+   template<typename T, typename A>
+   T DirectedGraph<T, BitsetStorage, A>::at(const size_t& k) const
+   {
+      // Tests if k is valid.
+      test_index(k, "Invalid node index in directed graph: ");
+      
+      return values_[k];
+   }
+   
+   /**
+    * Returns the number of directed edges from the specified starting node to
+    * the specified ending node in this directed graph, in constant time
+    * unless the directed edge is a multiple one.<p>
+    *
+    * The function automatically checks whether <code>from</code> and
+    * <code>to</code> are greater than or equal to the number of nodes in the
+    * directed graph, throwing an <code>std::out_of_range</code> exception if it
+    * is not.
+    *
+    * @param from   the position of the starting node
+    * @param to     the position of the ending node
+    *
+    * @return the number of directed edges
+    *
+    * @throws std::out_of_range if either <code>from</code> or <code>to</code>
+    * is out of bounds
+    */
+   template<typename T, typename A>
+   size_t DirectedGraph<T, BitsetStorage, A>::edge_count(const size_t& from,
+      const size_t& to) const
+   {
+      // Tests if the starting and ending node indices are valid.
+      test_index(from, "Invalid starting node index in directed graph: ");
+      test_index(to, "Invalid ending node index in directed graph: ");
+      
+      return multiplicity(from, to);
+   }
+   
+   /**
+    * Returns the number of directed edges in this directed graph, in constant
+    * time.
+    *
+    * @return the number of directed edges
+    */
+   template<typename T, typename A>
+   inline size_t DirectedGraph<T, BitsetStorage, A>::edges() const
+   {
+      return edges_;
+   }
+   
+   /**
+    * Tests if this directed graph is empty (i.e., if the directed graph
+    * contains no nodes).
+    *
+    * @return <code>true</code> if this directed graph is empty, or
+    * <code>false</code> otherwise
+    */
+   template<typename T, typename A>
+   inline bool DirectedGraph<T, BitsetStorage, A>::empty() const
+   {
+      return values_.empty();
+   }
+   
+   /**
+    * Returns the value of the first node in this directed graph.
+    *
+    * @return the value of the first node
+    *
+    * @throws std::out_of_range if this directed graph is empty
+    */
+   template<typename T, typename A>
+   T DirectedGraph<T, BitsetStorage, A>::front() const
+   {
+      // Tests if the directed graph is empty.
+      if (empty()) throw std::out_of_range("Empty directed graph");
+      
+      return values_.front();
+   }
+   
+   /**
+    * Returns a copy of the allocator with which this directed graph allocates
+    * its memory.
+    *
+    * @return the allocator
+    */
+   template<typename T, typename A>
+   inline A DirectedGraph<T, BitsetStorage, A>::get_allocator() const
+   {
+      return values_.get_allocator();
+   }
+   
+   /**
+    * Tests if this directed graph has a directed edge from the specified
+    * starting node to the specified ending node, by testing one bit.<p>
+    *
+    * The function automatically checks whether <code>from</code> and
+    * <code>to</code> are greater than or equal to the number of nodes in the
+    * directed graph, throwing an <code>std::out_of_range</code> exception if it
+    * is not.
+    *
+    * @param from   the position of the starting node
+    * @param to     the position of the ending node
+    *
+    * @return <code>true</code> if the directed edge exists, or
+    * <code>false</code> otherwise
+    *
+    * @throws std::out_of_range if either <code>from</code> or <code>to</code>
+    * is out of bounds
+    */
+   template<typename T, typename A>
+   bool DirectedGraph<T, BitsetStorage, A>::has_edge(const size_t& from,
+      const size_t& to) const
+   {
+      // Tests if the starting and ending node indices are valid.
+      test_index(from, "Invalid starting node index in directed graph: ");
+      test_index(to, "Invalid ending node index in directed graph: ");
+      
+      return (out_[from * stride_ + to / bits] >> (to % bits)) & 1;
+   }
+   
+   /**
+    * Returns the <b>indegree</b> of the node at position <i>k</i> in this
+    * directed graph (i.e., the number of head nodes adjacent to the node at
+    * position <i>k</i>), by counting the bits in its row of the transposed
+    * matrix.<p>
+    *
+    * The function automatically checks whether <i>k</i> is greater than or
+    * equal to the number of nodes in the directed graph, throwing an
+    * <code>std::out_of_range</code> exception if it is not.
+    *
+    * @param k   the position of the node
+    *
+    * @return the indegree
+    *
+    * @throws std::out_of_range if <i>k</i> is out of bounds
+    */
+   template<typename T, typename A>
+   size_t DirectedGraph<T, BitsetStorage, A>::indegree(const size_t& k) const
+   {
+      // Tests if k is valid.
+      test_index(k, "Invalid node index in directed graph: ");
+      
+      return row_count(in_, k) + parallel_in_[k];
+   }
+   
+   /**
+    * Returns the value of the node at position <i>k</i> in this directed graph.
+    *
+    * @param k   the position of the node
+    *
+    * @return the value of the node at position <i>k</i>
+    */
+   template<typename T, typename A>
+   inline T DirectedGraph<T, BitsetStorage, A>::operator[](const size_t& k)
+      const
+   {
+      return values_[k];
+   }
+   
+   /**
+    * Returns the <b>outdegree</b> of the node at position <i>k</i> in this
+    * directed graph (i.e., the number of tail nodes adjacent to the node at
+    * position <i>k</i>), by counting the bits in its row of the matrix.<p>
+    *
+    * The function automatically checks whether <i>k</i> is greater than or
+    * equal to the number of nodes in the directed graph, throwing an
+    * <code>std::out_of_range</code> exception if it is not.
+    *
+    * @param k   the position of the node
+    *
+    * @return the outdegree
+    *
+    * @throws std::out_of_range if <i>k</i> is out of bounds
+    */
+   template<typename T, typename A>
+   size_t DirectedGraph<T, BitsetStorage, A>::outdegree(const size_t& k) const
+   {
+      // Tests if k is valid.
+      test_index(k, "Invalid node index in directed graph: ");
+      
+      return row_count(out_, k) + parallel_out_[k];
+   }
+   
+   /**
+    * Tests if this directed graph is simple, that is, if the directed graph has
+    * no loops and no multiple directed edges (edges with the same starting and
+    * ending nodes). Only the diagonal of the matrix and the side table of
+    * multiple directed edges are read, so the test takes linear time in the
+    * number of nodes.
+    *
+    * @return <code>true</code> if this directed graph is simple, or
+    * <code>false</code> otherwise
+    */
+   template<typename T, typename A>
+   bool DirectedGraph<T, BitsetStorage, A>::simple() const
+   {
+      if (!parallels_.empty()) return false;
+      
+      for (size_t i = 0; i < size(); i++)
+         if ((out_[i * stride_ + i / bits] >> (i % bits)) & 1) return false;
+      
+      return true;
+   }
+   
+   /**
+    * Returns the number of nodes in this directed graph.
+    *
+    * @return the number of nodes
+    */
+   template<typename T, typename A>
+   inline size_t DirectedGraph<T, BitsetStorage, A>::size() const
+   {
+      return values_.size();
+   }
+   
+   /**
+    * Returns the <b>transitive closure</b> of this directed graph, which has
+    * the same nodes and a single directed edge from each node to each node
+    * that it can reach by a path of one or more directed edges. A node on a
+    * cycle has a loop.<p>
+    *
+    * The closure is found by the algorithm of Warshall, with each row updated
+    * by a bitwise OR of whole words. The pivot nodes are taken 64 at a time:
+    * their own rows are closed first, and then every other row is updated
+    * with all 64 of them while they are still in the cache. The function
+    * takes O(<i>V</i><sup>3</sup> / 64) time.
+    *
+    * @return the transitive closure of this directed graph
+    */
+   template<typename T, typename A>
+   DirectedGraph<T, BitsetStorage, A>
+      DirectedGraph<T, BitsetStorage, A>::transitive_closure() const
+   {
+      DirectedGraph result(get_allocator());
+      result.values_ = values_;
+      result.attach_nodes();
+      
+      const size_t n = size();
+      const size_t width = words();
+      Words& matrix = result.out_;
+      
+      for (size_t i = 0; i < n; i++)
+      {
+         std::copy(out_.begin() + i * stride_,
+            out_.begin() + i * stride_ + width,
+            matrix.begin() + i * result.stride_);
+      }
+      
+      // Adds the row of the pivot node to the specified row if it reaches it.
+      auto update = [&](const size_t& row, const size_t& pivot)
+      {
+         Word* target = matrix.data() + row * result.stride_;
+         if (!((target[pivot / bits] >> (pivot % bits)) & 1)) return;
+         
+         const Word* source = matrix.data() + pivot * result.stride_;
+         for (size_t w = 0; w < width; w++) target[w] |= source[w];
+      };
+      
+      for (size_t first = 0; first < n; first += bits)
+      {
+         const size_t last = std::min(first + bits, n);
+         
+         // Closes the rows of the pivot nodes among themselves.
+         for (size_t k = first; k < last; k++)
+            for (size_t i = first; i < last; i++) update(i, k);
+         
+         for (size_t i = 0; i < n; i++)
+         {
+            if (i >= first && i < last) continue;
+            for (size_t k = first; k < last; k++) update(i, k);
+         }
+      }
+      
+      // Rebuilds the transposed matrix and the number of directed edges.
+      for (size_t i = 0; i < n; i++)
+      {
+         scan_row(matrix.data() + i * result.stride_, width,
+            [&](const size_t& j)
+         {
+            result.in_[j * result.stride_ + i / bits] |= Word(1) << (i % bits);
+            result.edges_++;
+         });
+      }
+      
+      return result;
+   }
+   
+   /**
+    * Tests if this directed graph and the specified directed graph are equal.
+    *
+    * @param rhs   the directed graph to compare with this directed graph
+    *
+    * @return <code>true</code> if this directed graph and the specified
+    * directed graph are equal, or <code>false</code> otherwise
+    */
+   template<typename T, typename A>
+   bool DirectedGraph<T, BitsetStorage, A>
+      ::operator==(const DirectedGraph& rhs) const
+   {
+      // Tests if the two directed graphs have the same number of nodes.
+      if (size() != rhs.size() || edges_ != rhs.edges_) return false;
+      
+      // Tests if the two directed graphs have the same directed edges.
+      for (size_t i = 0; i < size(); i++)
+      {
+         const auto row = out_.begin() + i * stride_;
+         const auto other = rhs.out_.begin() + i * rhs.stride_;
+         if (!std::equal(row, row + words(), other)) return false;
+      }
+      
+      if (parallels_ != rhs.parallels_) return false;
+      
+      // Tests if the two directed graphs have the same nodes.
+      for (size_t i = 0; i < size(); i++)
+         if (values_[i] != rhs.values_[i]) return false;
+      
+      return true;
+   }
+   
+   /**
+    * Tests if this directed graph and the specified directed graph are unequal.
+    *
+    * @param rhs   the directed graph to compare with this directed graph
+    *
+    * @return <code>true</code> if this directed graph and the specified
+    * directed graph are unequal, or <code>false</code> otherwise
+    */
+   template<typename T, typename A>
+   inline bool DirectedGraph<T, BitsetStorage, A>
+      ::operator!=(const DirectedGraph& rhs) const
+   {
+      return !(*this == rhs);
+   }
+   
+   /**
+    * Counts one more multiple directed edge from the node at position
+    * <i>from</i> to the node at position <i>to</i> in the side table.
+    *
+    * @param from   the position of the starting node
+    * @param to     the position of the ending node
+    */
+   template<typename T, typename A>
+   inline void DirectedGraph<T, BitsetStorage, A>::add_parallel(
+      const size_t& from, const size_t& to)
+   {
+      parallels_[EdgeKey(from, to)]++;
+      parallel_out_[from]++;
+      parallel_in_[to]++;
+   }
+   
+   /**
+    * Lays out empty matrices and counters for the nodes whose values have
+    * just been placed in this directed graph.
+    */
+   template<typename T, typename A>
+   void DirectedGraph<T, BitsetStorage, A>::attach_nodes()
+   {
+      stride_ = (size() + bits - 1) / bits;
+      out_.assign(size() * stride_, Word(0));
+      in_.assign(size() * stride_, Word(0));
+      parallel_out_.assign(size(), 0);
+      parallel_in_.assign(size(), 0);
+   }
+   
+   /**
+    * Copies each row of the matrices into a row of the specified number of
+    * words, which must be enough for every node.
+    *
+    * @param stride   the new number of words in each row
+    */
+   template<typename T, typename A>
+   void DirectedGraph<T, BitsetStorage, A>::restride(const size_t& stride)
+   {
+      const size_t rows = stride_ == 0 ? 0 : out_.size() / stride_;
+      const size_t width = std::min(stride, stride_);
+      
+      auto copy = [&](Words& matrix)
+      {
+         Words result(rows * stride, Word(0), matrix.get_allocator());
+         
+         for (size_t i = 0; i < rows; i++)
+         {
+            std::copy(matrix.begin() + i * stride_,
+               matrix.begin() + i * stride_ + width,
+               result.begin() + i * stride);
+         }
+         
+         matrix.swap(result);
+      };
+      
+      copy(out_);
+      copy(in_);
+      stride_ = stride;
+   }
+   
+   /**
+    * Returns the number of directed edges from the node at position
+    * <i>from</i> to the node at position <i>to</i>, which must both be valid.
+    *
+    * @param from   the position of the starting node
+    * @param to     the position of the ending node
+    *
+    * @return the number of directed edges
+    */
+   template<typename T, typename A>
+   size_t DirectedGraph<T, BitsetStorage, A>::multiplicity(const size_t& from,
+      const size_t& to) const
+   {
+      if (!((out_[from * stride_ + to / bits] >> (to % bits)) & 1)) return 0;
+      if (parallels_.empty()) return 1;
+      
+      auto position = parallels_.find(EdgeKey(from, to));
+      return position == parallels_.end() ? 1 : 1 + position -> second;
+   }
+   
+   /**
+    * Returns the number of bits set in row <i>k</i> of the specified matrix.
+    * The loop has no branches, so the compiler vectorizes it when population
+    * count instructions are enabled.
+    *
+    * @param matrix   the matrix
+    * @param k        the row
+    *
+    * @return the number of bits set
+    */
+   template<typename T, typename A>
+   size_t DirectedGraph<T, BitsetStorage, A>::row_count(const Words& matrix,
+      const size_t& k) const
+   {
+      const Word* row = matrix.data() + k * stride_;
+      size_t count = 0;
+      
+      for (size_t w = 0; w < words(); w++) count += count_bits(row[w]);
+      
+      return count;
+   }
+   
+   /**
+    * Returns the position of the <i>n</i><sup>th</sup> tail node (or head
+    * node) of the node at position <i>k</i>, counting each multiple directed
+    * edge as many times as it occurs. A row without multiple directed edges
+    * is searched a word at a time.
+    *
+    * @param k         the position of the node
+    * @param n         the index of the adjacent node, less than the degree
+    * @param forward   whether to search the tail nodes rather than the head
+    *                  nodes
+    *
+    * @return the position of the adjacent node
+    */
+   template<typename T, typename A>
+   size_t DirectedGraph<T, BitsetStorage, A>::select(const size_t& k,
+      const size_t& n, const bool& forward) const
+   {
+      const Word* row = (forward ? out_ : in_).data() + k * stride_;
+      const size_t parallel = forward ? parallel_out_[k] : parallel_in_[k];
+      size_t remaining = n;
+      
+      for (size_t w = 0; w < words(); w++)
+      {
+         Word word = row[w];
+         
+         if (parallel == 0)
+         {
+            const size_t count = count_bits(word);
+            
+            if (remaining >= count)
+            {
+               remaining -= count;
+               continue;
+            }
+            
+            for (; remaining > 0; remaining--) word &= word - 1;
+            return w * bits + lowest_bit(word);
+         }
+         
+         for (; word != 0; word &= word - 1)
+         {
+            const size_t j = w * bits + lowest_bit(word);
+            const size_t count = forward ? multiplicity(k, j)
+               : multiplicity(j, k);
+            
+            if (remaining < count) return j;
+            remaining -= count;
+         }
+      }
+      
+      return size();
+   }
+   
+   /**
+    * Tests if <i>k</i> is within the bounds of valid positions in the directed
+    * graph, throwing an <code>std::out_of_range</code> exception if it is not
+    * (i.e., if <i>k</i> is greater than or equal to the number of nodes in the
+    * directed graph).
+    *
+    * @param k       the position of the node
+    * @param error   the error message
+    *
+    * @throws std::out_of_range if <i>k</i> is out of bounds
+    */
+   template<typename T, typename A>
+   void DirectedGraph<T, BitsetStorage, A>::test_index(const size_t& k,
+      const char* error) const
+   {
+      if (k >= size()) throw_index_error(error, k);
+   }
+   
+   /**
+    * Returns the number of words in each row of the matrices that can have
+    * bits set, which is at most <code>stride_</code>.
+    *
+    * @return the number of words in use
+    */
+   template<typename T, typename A>
+   inline size_t DirectedGraph<T, BitsetStorage, A>::words() const
+   {
+      return (size() + bits - 1) / bits;
+   }
+   
+   /**
+    * Returns the number of bits set in the specified word.
+    *
+    * @param word   the word
+    *
+    * @return the number of bits set
+    */
+   template<typename T, typename A>
+   inline size_t DirectedGraph<T, BitsetStorage, A>::count_bits(
+      const Word& word)
+   {
+#if defined(__GNUC__) || defined(__clang__)
+      return __builtin_popcountll(word);
+#else
+      Word x = word - ((word >> 1) & 0x5555555555555555ULL);
+      x = (x & 0x3333333333333333ULL) + ((x >> 2) & 0x3333333333333333ULL);
+      x = (x + (x >> 4)) & 0x0f0f0f0f0f0f0f0fULL;
+      return static_cast<size_t>((x * 0x0101010101010101ULL) >> 56);
+#endif
+   }
+   
+   /**
+    * Returns the position of the lowest bit set in the specified word, which
+    * must not be zero.
+    *
+    * @param word   the word
+    *
+    * @return the position of the lowest bit set
+    */
+   template<typename T, typename A>
+   inline size_t DirectedGraph<T, BitsetStorage, A>::lowest_bit(
+      const Word& word)
+   {
+#if defined(__GNUC__) || defined(__clang__)
+      return __builtin_ctzll(word);
+#else
+      return count_bits((word & (~word + 1)) - 1);
+#endif
+   }
+   
+   /**
+    * Removes column <i>k</i> from the specified row, which must have it clear,
+    * by shifting every later column down by one.
+    *
+    * @param row     the row
+    * @param words   the number of words in the row
+    * @param k       the column to remove
+    */
+   template<typename T, typename A>
+   void DirectedGraph<T, BitsetStorage, A>::remove_column(Word* row,
+      const size_t& words, const size_t& k)
+   {
+      const size_t first = k / bits;
+      const Word low = (Word(1) << (k % bits)) - 1;
+      
+      for (size_t w = first; w < words; w++)
+      {
+         const Word carry = w + 1 < words ? row[w + 1] << (bits - 1) : 0;
+         const Word kept = w == first ? row[w] & low : 0;
+         row[w] = kept | ((row[w] >> 1) & ~(w == first ? low : 0)) | carry;
+      }
+   }
+   
+   /**
+    * Calls the specified function with the column of each bit set in the
+    * specified row, in increasing order.
+    *
+    * @param F   the type of the function
+    *
+    * @param row     the row
+    * @param words   the number of words in the row
+    * @param f       the function
+    */
+   template<typename T, typename A>
+   template<typename F>
+   void DirectedGraph<T, BitsetStorage, A>::scan_row(const Word* row,
+      const size_t& words, F f)
+   {
+      for (size_t w = 0; w < words; w++)
+      {
+         for (Word word = row[w]; word != 0; word &= word - 1)
+            f(w * bits + lowest_bit(word));
+      }
+   }
+   
+   /** Constructs an iterator that does not point into any directed graph. */
+   template<typename T, typename A>
+   inline DirectedGraph<T, BitsetStorage, A>::Iterator::Iterator()
+      : position_(0), container_(nullptr) {}
+   
+   /** Destroys this iterator. */
+   template<typename T, typename A>
+   inline DirectedGraph<T, BitsetStorage, A>::Iterator::~Iterator() {}
+   
+   /**
+    * Moves this iterator to the <i>k</i><sup>th</sup> tail node. The tail
+    * nodes of a node are in increasing order of position.<p>
+    *
+    * The function automatically checks whether <i>k</i> is greater than or
+    * equal to the outdegree of the node to which this iterator points, throwing
+    * an <code>std::out_of_range</code> exception if it is not.
+    *
+    * @param k    the tail node index
+    *
+    * @throws std::logic_error if this iterator does not point into any directed
+    * graph
+    * @throws std::out_of_range if <i>k</i> is out of bounds
+    */
+   template<typename T, typename A>
+   void DirectedGraph<T, BitsetStorage, A>::Iterator::next(const size_t& k)
+   {
+      // Tests if this iterator points into a directed graph.
+      if (container_ == nullptr)
+         throw std::logic_error("Iterator does not point to a directed graph");
+      
+      // Tests if k is valid.
+      if (k >= outdegree())
+         throw_index_error("Invalid tail node index for iterator: ", k);
+      
+      position_ = container_ -> select(position_, k, true);
+   }
+   
+   /**
+    * Returns a reference to the value at the current position of this iterator.
+    *
+    * @return a reference to the value of the node to which this iterator points
+    *
+    * @throws std::logic_error if this iterator does not point into any directed
+    * graph
+    */
+   template<typename T, typename A>
+   T& DirectedGraph<T, BitsetStorage, A>::Iterator::operator*()
+   {
+      // Tests if this iterator points into a directed graph.
+      if (container_ == nullptr)
+         throw std::logic_error("Iterator does not point to a directed graph");
+      
+      return container_ -> values_[position_];
+   }
+   
+   /**
+    * Moves this iterator to the <i>k</i><sup>th</sup> head node. The head
+    * nodes of a node are in increasing order of position.<p>
+    *
+    * The function automatically checks whether <i>k</i> is greater than or
+    * equal to the indegree of the node to which this iterator points, throwing
+    * an <code>std::out_of_range</code> exception if it is not.
+    *
+    * @param k    the head node index
+    *
+    * @throws std::logic_error if this iterator does not point into any directed
+    * graph
+    * @throws std::out_of_range if <i>k</i> is out of bounds
+    */
+   template<typename T, typename A>
+   void DirectedGraph<T, BitsetStorage, A>::Iterator::prev(const size_t& k)
+   {
+      // Tests if this iterator points into a directed graph.
+      if (container_ == nullptr)
+         throw std::logic_error("Iterator does not point to a directed graph");
+      
+      // Tests if k is valid.
+      if (k >= indegree())
+         throw_index_error("Invalid head node index for iterator: ", k);
+      
+      position_ = container_ -> select(position_, k, false);
+   }
+   
+   /**
+    * Returns the indegree at the current position of this iterator.
+    *
+    * @return the indegree of the node to which this iterator points
+    *
+    * @throws std::logic_error if this iterator does not point into any directed
+    * graph
+    */
+   template<typename T, typename A>
+   size_t DirectedGraph<T, BitsetStorage, A>::Iterator::indegree() const
+   {
+      // Tests if this iterator points into a directed graph.
+      if (container_ == nullptr)
+         throw std::logic_error("Iterator does not point to a directed graph");
+      
+      return container_ -> indegree(position_);
+   }
+   
+   /**
+    * Returns the value at the current position of this iterator.
+    *
+    * @return the value of the node to which this iterator points
+    *
+    * @throws std::logic_error if this iterator does not point into any directed
+    * graph
+    */
+   template<typename T, typename A>
+   T DirectedGraph<T, BitsetStorage, A>::Iterator::operator*() const
+   {
+      // Tests if this iterator points into a directed graph.
+      if (container_ == nullptr)
+         throw std::logic_error("Iterator does not point to a directed graph");
+      
+      return container_ -> values_[position_];
+   }
+   
+   /**
+    * Returns a pointer to the value at the current position of this iterator.
+    *
+    * @return a pointer to the value of the node to which this iterator points
+    *
+    * @throws std::logic_error if this iterator does not point into any directed
+    * graph
+    */
+   template<typename T, typename A>
+   T* DirectedGraph<T, BitsetStorage, A>::Iterator::operator->() const
+   {
+      // Tests if this iterator points into a directed graph.
+      if (container_ == nullptr)
+         throw std::logic_error("Iterator does not point to a directed graph");
+      
+      return &container_ -> values_[position_];
+   }
+   
+   /**
+    * Returns the outdegree at the current position of this iterator.
+    *
+    * @return the outdegree of the node to which this iterator points
+    *
+    * @throws std::logic_error if this iterator does not point into any directed
+    * graph
+    */
+   template<typename T, typename A>
+   size_t DirectedGraph<T, BitsetStorage, A>::Iterator::outdegree() const
+   {
+      // Tests if this iterator points into a directed graph.
+      if (container_ == nullptr)
+         throw std::logic_error("Iterator does not point to a directed graph");
+      
+      return container_ -> outdegree(position_);
+   }
+   
+   /**
+    * Tests if this iterator and the specified iterator are equal.
+    *
+    * @param rhs   the iterator to compare with this iterator
+    *
+    * @return <code>true</code> if this iterator and the specified iterator are
+    * equal, or <code>false</code> otherwise
+    */
+   template<typename T, typename A>
+   inline bool DirectedGraph<T, BitsetStorage, A>::Iterator
+      ::operator==(const Iterator& rhs) const
+   {
+      return container_ == rhs.container_ && position_ == rhs.position_;
+   }
+   
+   /**
+    * Tests if this iterator and the specified iterator are unequal.
+    *
+    * @param rhs   the iterator to compare with this iterator
+    *
+    * @return <code>true</code> if this iterator and the specified iterator are
+    * unequal, or <code>false</code> otherwise
+    */
+   template<typename T, typename A>
+   inline bool DirectedGraph<T, BitsetStorage, A>::Iterator
+      ::operator!=(const Iterator& rhs) const
+   {
+      return !(*this == rhs);
+   }
+   
+   /**
+    * Outputs the specified directed graph with the specified output stream.
+    * The output stream is not flushed; <code>GraphWriter</code> writes large
+    * directed graphs faster.
+    *
+    * @param out   the output stream
+    * @param rhs   the directed graph to be outputted
+    *
+    * @return the stream after the output
+    */
+   template<typename T, typename A>
+   std::ostream& operator<<(std::ostream& out,
+      const DirectedGraph<T, BitsetStorage, A>& rhs)
+   {
+      for (size_t i = 0; i < rhs.size(); i++)
+      {
+         // Outputs the current node by itself if it is disconnected.
+         if (rhs.outdegree(i) == 0 && rhs.indegree(i) == 0)
+            out << rhs.values_[i] << '\n';
+         
+         // Outputs the starting and ending nodes for each directed edge.
+         else
+         {
+            const auto* row = rhs.out_.data() + i * rhs.stride_;
+            
+            rhs.scan_row(row, rhs.words(), [&](const size_t& j)
+            {
+               for (size_t count = rhs.multiplicity(i, j); count > 0; count--)
+                  out << rhs.values_[i] << " -> " << rhs.values_[j] << '\n';
+            });
+         }
+      }
+      
+      return out;
+   }
+}
+
+#endif   // PIC_10C_BITSET_DIRECTED_GRAPH_H_
@@ -0,0 +1,1280 @@
+/**
+ * Declarations and definitions of the <code>DirectedGraph</code> class for the
+ * <code>CompressedStorage</code> storage policy, <code>operator<<</code> for
+ * that class, and the <code>bfs</code> function for that class.
+ *
+ * @file compressed_directed_graph.h
+ *
+ * @author Kris Torres
+ *
+ * @date 2026-10-14
+ *
+ * @version 1.0
+ */
+
+#ifndef PIC_10C_COMPRESSED_DIRECTED_GRAPH_H_
+#define PIC_10C_COMPRESSED_DIRECTED_GRAPH_H_
+
+#include <cstddef>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <stdexcept>
+#include <algorithm>
+#include <memory>
+#include <utility>
+#include <iterator>
+#include <ostream>
+#include "adjacency.h"
+#include "index_error.h"
+#include "directed_graph.h"
+
+namespace Kris_Torres_UCLA_PIC_10C_Winter_2014
+{
+   /**
+    * A read-optimized directed graph whose directed edges are kept in one
+    * compressed byte array, for directed graphs too large to fit in memory
+    * with a pointer or a position for every directed edge. The tail nodes of
+    * each node are sorted, and stored as the gaps between consecutive
+    * positions, which are small when the nodes are ordered well (see
+    * <code>DirectedGraph::reorder</code>).<p>
+    *
+    * The row of each node starts with its outdegree, as a variable-length
+    * integer, followed by its gaps in groups of four, in the layout of
+    * <i>Stream VByte</i> (Lemire et al., 2017): each group starts with a
+    * control byte that gives the length of each gap in two bits, 1, 2, 4, or
+    * 8 bytes, followed by the bytes of the gaps. A gap is read with one
+    * unaligned load and one mask, without a branch on its length, and the
+    * control bytes let a vectorized decoder shuffle a whole group at once.
+    * Most gaps take one byte, so a directed edge takes a little over one
+    * byte, against the 16 bytes or more of the other storage policies.<p>
+    *
+    * The compressed row of each node is the only store of its directed
+    * edges: only the indegrees are kept for the other direction, and the
+    * head nodes are rebuilt by <code>adjacency</code>. The values of the nodes
+    * can be modified, but the directed edges are fixed when the directed
+    * graph is constructed, since inserting a directed edge would shift the
+    * rest of the array.
+    *
+    * @param T   the type of the elements
+    * @param A   the allocator type
+    *
+    * @author Kris Torres
+    */
+   template<typename T, typename A>
+   class DirectedGraph<T, CompressedStorage, A>
+   {
+   public:
+      
+      // Classes
+      class NeighborIterator;
+      class Neighbors;
+      
+      // Type
+      typedef A allocator_type;
+      
+      // Constructors
+      DirectedGraph();
+      explicit DirectedGraph(const A& alloc);
+      DirectedGraph(const Adjacency& graph, const std::vector<T>& v,
+         const A& alloc = A());
+      template<typename S, typename B>
+      explicit DirectedGraph(const DirectedGraph<T, S, B>& graph,
+         const A& alloc = A());
+      DirectedGraph(const DirectedGraph& rhs);
+      DirectedGraph(const DirectedGraph& rhs, const A& alloc);
+      DirectedGraph(DirectedGraph&& rhs) noexcept;
+      
+      // Assignment operators
+      DirectedGraph& operator=(const DirectedGraph& rhs);
+      DirectedGraph& operator=(DirectedGraph&& rhs)
+         noexcept(std::allocator_traits<A>
+            ::propagate_on_container_move_assignment::value);
+      
+      // Destructor
+      virtual ~DirectedGraph();
+      
+      // Mutators
+      T& at(const size_t& k);
+      void clear();
+      T& front();
+      T& operator[](const size_t& k);
+      void swap(DirectedGraph& rhs) noexcept;
+      
+      // Accessors
+      Adjacency adjacency() const;
+      T at(const size_t& k) const;
+      size_t bytes() const;
+      size_t edge_count(const size_t& from, const size_t& to) const;
+      size_t edges() const;
+      bool empty() const;
+      T front() const;
+      A get_allocator() const;
+      bool has_edge(const size_t& from, const size_t& to) const;
+      size_t indegree(const size_t& k) const;
+      Neighbors neighbors(const size_t& k) const;
+      T operator[](const size_t& k) const;
+      size_t outdegree(const size_t& k) const;
+      bool simple() const;
+      size_t size() const;
+      
+      // Relational operators
+      bool operator==(const DirectedGraph& rhs) const;
+      bool operator!=(const DirectedGraph& rhs) const;
+      
+      // Friend
+      template<typename U, typename V>
+      friend std::ostream& operator<<(std::ostream& out,
+         const DirectedGraph<U, CompressedStorage, V>& rhs);
+      
+   private:
+      
+      // Types
+      template<typename U>
+      using Allocator =
+         typename std::allocator_traits<A>::template rebind_alloc<U>;
+      typedef std::vector<unsigned char, Allocator<unsigned char>> Bytes;
+      typedef std::vector<size_t, Allocator<size_t>> Indices;
+      
+      // Constant
+      
+      /**
+       * The padding after the last row, so that each gap of the last group,
+       * even past the end of the group, is read in one load.
+       */
+      static const size_t padding = 16;
+      
+      // Mutators
+      void build(const Adjacency& graph);
+      void put(const size_t& value, const size_t& length);
+      
+      // Accessors
+      static size_t count(const unsigned char*& position);
+      static size_t gap(const unsigned char* position, const unsigned& code);
+      void test_index(const size_t& k, const char* error) const;
+      
+      /** The values of the nodes. */
+      std::vector<T, A> values_;
+      
+      /**
+       * The position in <code>data_</code> at which the row of each node
+       * begins, followed by the end of the last row.
+       */
+      Indices offsets_;
+      
+      /** The indegree of each node. */
+      Indices indegrees_;
+      
+      /** The rows of all the nodes, followed by the padding. */
+      Bytes data_;
+      
+      /** The number of directed edges. */
+      size_t edges_;
+   };
+   
+   /**
+    * A <b>neighbor iterator</b> is a forward iterator over the positions of
+    * the tail nodes of one node in a compressed directed graph, in ascending
+    * order. The positions are decoded a group of four at a time, when the
+    * iterator reaches the group, and kept in the iterator, so the iterator
+    * can be used with the STL algorithms.
+    *
+    * @author Kris Torres
+    */
+   template<typename T, typename A>
+   class DirectedGraph<T, CompressedStorage, A>::NeighborIterator final
+   {
+   public:
+      
+      // Types
+      typedef std::forward_iterator_tag iterator_category;
+      typedef size_t value_type;
+      typedef std::ptrdiff_t difference_type;
+      typedef const size_t* pointer;
+      typedef const size_t& reference;
+      
+      // Constructor
+      NeighborIterator();
+      
+      // Mutators
+      NeighborIterator& operator++();
+      NeighborIterator operator++(int);
+      
+      // Accessors
+      reference operator*() const;
+      pointer operator->() const;
+      
+      // Relational operators
+      bool operator==(const NeighborIterator& rhs) const;
+      bool operator!=(const NeighborIterator& rhs) const;
+      
+      // Friend
+      friend class DirectedGraph<T, CompressedStorage, A>::Neighbors;
+      
+   private:
+      
+      // Constructor
+      NeighborIterator(const unsigned char* position, const size_t& remaining);
+      
+      // Mutator
+      void decode();
+      
+      /** The control byte of the next group. */
+      const unsigned char* position_;
+      
+      /** The number of positions left, including the current one. */
+      size_t remaining_;
+      
+      /** The slot of the current position in its group. */
+      size_t slot_;
+      
+      /** The positions of the current group. */
+      size_t values_[4];
+   };
+   
+   /**
+    * A <b>neighbors</b> view is a range of the positions of the tail nodes of
+    * one node in a compressed directed graph, in ascending order, which can be
+    * traversed with a range-based <code>for</code> loop. A view is
+    * invalidated when its directed graph is destroyed or assigned to.
+    *
+    * @author Kris Torres
+    */
+   template<typename T, typename A>
+   class DirectedGraph<T, CompressedStorage, A>::Neighbors final
+   {
+   public:
+      
+      // Types
+      typedef NeighborIterator iterator;
+      typedef NeighborIterator const_iterator;
+      
+      // Accessors
+      NeighborIterator begin() const;
+      bool empty() const;
+      NeighborIterator end() const;
+      size_t size() const;
+      
+      // Friend
+      friend class DirectedGraph<T, CompressedStorage, A>;
+      
+   private:
+      
+      // Constructor
+      explicit Neighbors(const unsigned char* row);
+      
+      /** The first group of the row. */
+      const unsigned char* first_;
+      
+      /** The number of tail nodes. */
+      size_t size_;
+   };
+   
+   // Directed graph output operator
+   template<typename T, typename A>
+   std::ostream& operator<<(std::ostream& out,
+      const DirectedGraph<T, CompressedStorage, A>& rhs);
+   
+   template<typename T, typename A>
+   const size_t DirectedGraph<T, CompressedStorage, A>::padding;
+   
+   /** Constructs an empty directed graph, with no nodes. */
+   template<typename T, typename A>
+   inline DirectedGraph<T, CompressedStorage, A>::DirectedGraph()
+      : DirectedGraph(A()) {}
+   
+   /**
+    * Constructs an empty directed graph, with no nodes, that allocates its
+    * memory with the specified allocator.
+    *
+    * @param alloc   the allocator
+    */
+   template<typename T, typename A>
+   inline DirectedGraph<T, CompressedStorage, A>::DirectedGraph(const A& alloc)
+      : values_(alloc), offsets_(1, 0, alloc), indegrees_(alloc),
+        data_(alloc), edges_(0) {}
+   
+   /**
+    * Constructs a directed graph with the directed edges of the specified
+    * adjacency, and the specified values of its nodes. The tail nodes of each
+    * node are sorted and compressed in linear time, apart from the sorting.
+    *
+    * @param graph   the adjacency of the directed edges
+    * @param v       the value of each node
+    * @param alloc   the allocator
+    *
+    * @throws std::invalid_argument if the number of values is not the number
+    * of nodes in the adjacency
+    */
+   template<typename T, typename A>
+   DirectedGraph<T, CompressedStorage, A>::DirectedGraph(
+      const Adjacency& graph, const std::vector<T>& v, const A& alloc)
+      : values_(v.begin(), v.end(), alloc), offsets_(alloc),
+        indegrees_(alloc), data_(alloc), edges_(0)
+   {
+      // Tests if there is a value for each node.
+      if (v.size() != graph.size())
+      {
+         throw std::invalid_argument(
+            "Invalid number of values in directed graph");
+      }
+      
+      build(graph);
+   }
+   
+   /**
+    * Constructs a compressed copy of the specified directed graph, with any
+    * storage policy.
+    *
+    * @param S       the storage policy of the directed graph
+    * @param B       the allocator type of the directed graph
+    *
+    * @param graph   the directed graph to be copied
+    * @param alloc   the allocator
+    */
+   template<typename T, typename A>
+   template<typename S, typename B>
+   DirectedGraph<T, CompressedStorage, A>::DirectedGraph(
+      const DirectedGraph<T, S, B>& graph, const A& alloc)
+      : values_(alloc), offsets_(alloc), indegrees_(alloc), data_(alloc),
+        edges_(0)
+   {
+      values_.reserve(graph.size());
+      for (size_t i = 0; i < graph.size(); i++) values_.push_back(graph[i]);
+      
+      build(graph.adjacency());
+   }
+   
+   /**
+    * Constructs a directed graph with a copy of each of the nodes and of the
+    * compressed directed edges in the specified directed graph.
+    *
+    * @param rhs   the directed graph to be copied
+    */
+   template<typename T, typename A>
+   inline DirectedGraph<T, CompressedStorage, A>::DirectedGraph(
+      const DirectedGraph& rhs)
+      : DirectedGraph(rhs, std::allocator_traits<A>
+         ::select_on_container_copy_construction(rhs.get_allocator())) {}
+   
+   /**
+    * Constructs a directed graph with a copy of each of the nodes and of the
+    * compressed directed edges in the specified directed graph, allocating
+    * its memory with the specified allocator.
+    *
+    * @param rhs     the directed graph to be copied
+    * @param alloc   the allocator
+    */
+   template<typename T, typename A>
+   DirectedGraph<T, CompressedStorage, A>::DirectedGraph(
+      const DirectedGraph& rhs, const A& alloc)
+      : values_(rhs.values_, alloc),
+        offsets_(rhs.offsets_.begin(), rhs.offsets_.end(), alloc),
+        indegrees_(rhs.indegrees_.begin(), rhs.indegrees_.end(), alloc),
+        data_(rhs.data_.begin(), rhs.data_.end(), alloc), edges_(rhs.edges_)
+   {}
+   
+   /**
+    * Constructs a directed graph by moving the nodes and the directed edges
+    * of the specified directed graph, which is left empty.
+    *
+    * @param rhs   the directed graph to be moved
+    */
+   template<typename T, typename A>
+   DirectedGraph<T, CompressedStorage, A>::DirectedGraph(DirectedGraph&& rhs)
+      noexcept
+      : values_(std::move(rhs.values_)), offsets_(std::move(rhs.offsets_)),
+        indegrees_(std::move(rhs.indegrees_)), data_(std::move(rhs.data_)),
+        edges_(rhs.edges_)
+   {
+      rhs.clear();
+   }
+   
+   /**
+    * Copies all the nodes and the directed edges in the specified directed
+    * graph into this directed graph, with the former preserving its contents.
+    *
+    * @param rhs   the directed graph to be copied
+    *
+    * @return this directed graph
+    */
+   template<typename T, typename A>
+   DirectedGraph<T, CompressedStorage, A>& DirectedGraph<T, CompressedStorage,
+      A>::operator=(const DirectedGraph& rhs)
+   {
+      // Tests for self-assignment.
+      if (this != &rhs)
+      {
+         values_ = rhs.values_;
+         offsets_ = rhs.offsets_;
+         indegrees_ = rhs.indegrees_;
+         data_ = rhs.data_;
+         edges_ = rhs.edges_;
+      }
+      
+      return *this;
+   }
+   
+   /**
+    * Moves all the nodes and the directed edges in the specified directed
+    * graph into this directed graph. The specified directed graph is left
+    * empty.
+    *
+    * @param rhs   the directed graph to be moved
+    *
+    * @return this directed graph
+    */
+   template<typename T, typename A>
+   DirectedGraph<T, CompressedStorage, A>& DirectedGraph<T, CompressedStorage,
+      A>::operator=(DirectedGraph&& rhs)
+      noexcept(std::allocator_traits<A>
+         ::propagate_on_container_move_assignment::value)
+   {
+      // Tests for self-assignment.
+      if (this != &rhs)
+      {
+         values_ = std::move(rhs.values_);
+         offsets_ = std::move(rhs.offsets_);
+         indegrees_ = std::move(rhs.indegrees_);
+         data_ = std::move(rhs.data_);
+         edges_ = rhs.edges_;
+         rhs.clear();
+      }
+      
+      return *this;
+   }
+   
+   /** Destroys this directed graph. */
+   template<typename T, typename A>
+   inline DirectedGraph<T, CompressedStorage, A>::~DirectedGraph() {}
+   
+   /**
+    * Returns a reference to the value of the node at position <i>k</i> in this
+    * directed graph.
+    *
+    * @param k   the position of the node
+    *
+    * @return a reference to the value of the node
+    *
+    * @throws std::out_of_range if <i>k</i> is at least the number of nodes
+    */
+   template<typename T, typename A>
+   T& DirectedGraph<T, CompressedStorage, A>::at(const size_t& k)
+   {
+      // Tests if k is valid.
+      test_index(k, "Invalid node index in directed graph: ");
+      
+      return values_[k];
+   }
+   
+   /** Removes all the nodes and the directed edges from this directed graph. */
+   template<typename T, typename A>
+   void DirectedGraph<T, CompressedStorage, A>::clear()
+   {
+      values_.clear();
+      offsets_.assign(1, 0);
+      indegrees_.clear();
+      data_.clear();
+      edges_ = 0;
+   }
+   
+   /**
+    * Returns a reference to the value of the first node in this directed
+    * graph.
+    *
+    * @return a reference to the value of the first node
+    *
+    * @throws std::out_of_range if this directed graph is empty
+    */
+   template<typename T, typename A>
+   T& DirectedGraph<T, CompressedStorage, A>::front()
+   {
+      // Tests if the directed graph is empty.
+      if (empty()) throw std::out_of_range("Empty directed graph");
+      
+      return values_[0];
+   }
+   
+   /**
+    * Returns a reference to the value of the node at position <i>k</i> in this
+    * directed graph. The position is not checked.
+    *
+    * @param k   the position of the node
+    *
+    * @return a reference to the value of the node
+    */
+   template<typename T, typename A>
+   inline T& DirectedGraph<T, CompressedStorage, A>
+      ::operator[](const size_t& k)
+   {
+      return values_[k];
+   }
+   
+   /**
+    * Exchanges the nodes and the directed edges of this directed graph and
+    * the specified directed graph.
+    *
+    * @param rhs   the directed graph to be swapped with this directed graph
+    */
+   template<typename T, typename A>
+   void DirectedGraph<T, CompressedStorage, A>::swap(DirectedGraph& rhs)
+      noexcept
+   {
+      values_.swap(rhs.values_);
+      offsets_.swap(rhs.offsets_);
+      indegrees_.swap(rhs.indegrees_);
+      data_.swap(rhs.data_);
+      std::swap(edges_, rhs.edges_);
+   }
+   
+   /**
+    * Returns a snapshot of the directed edges in this directed graph, with
+    * the tail nodes of each node in ascending order. The head nodes are
+    * rebuilt from the tail nodes, so they are also in ascending order.
+    *
+    * @return the adjacency of this directed graph
+    */
+   template<typename T, typename A>
+   Adjacency DirectedGraph<T, CompressedStorage, A>::adjacency() const
+   {
+      const size_t n = size();
+      Adjacency result(n);
+      result.targets_.reserve(edges_);
+      
+      for (size_t i = 0; i < n; i++)
+      {
+         for (const auto& element : neighbors(i))
+            result.targets_.push_back(element);
+         
+         result.offsets_[i + 1] = result.targets_.size();
+         result.reverse_offsets_[i + 1] =
+            result.reverse_offsets_[i] + indegrees_[i];
+      }
+      
+      // Groups the head nodes by ending node, in order of starting node.
+      std::vector<size_t> next(result.reverse_offsets_.begin(),
+         result.reverse_offsets_.end() - 1);
+      result.sources_.resize(edges_);
+      
+      for (size_t i = 0; i < n; i++)
+      {
+         for (size_t j = result.offsets_[i]; j < result.offsets_[i + 1]; j++)
+            result.sources_[next[result.targets_[j]]++] = i;
+      }
+      
+      return result;
+   }
+   
+   /**
+    * Returns the value of the node at position <i>k</i> in this directed
+    * graph.
+    *
+    * @param k   the position of the node
+    *
+    * @return the value of the node
+    *
+    * @throws std::out_of_range if <i>k</i> is at least the number of nodes
+    */
+   template<typename T, typename A>
+   T DirectedGraph<T, CompressedStorage, A>::at(const size_t& k) const
+   {
+      // Tests if k is valid.
+      test_index(k, "Invalid node index in directed graph: ");
+      
+      return values_[k];
+   }
+   
+   /**
+    * Returns the number of bytes in which the directed edges of this directed
+    * graph are kept: the compressed rows, their offsets, and the indegrees.
+    *
+    * @return the number of bytes
+    */
+   template<typename T, typename A>
+   inline size_t DirectedGraph<T, CompressedStorage, A>::bytes() const
+   {
+      return data_.size()
+         + (offsets_.size() + indegrees_.size()) * sizeof(size_t);
+   }
+   
+   /**
+    * Returns the number of directed edges from the specified starting node to
+    * the specified ending node in this directed graph. The tail nodes of the
+    * starting node are sorted, so they are only decoded up to the ending
+    * node.
+    *
+    * @param from   the position of the starting node
+    * @param to     the position of the ending node
+    *
+    * @return the number of directed edges
+    *
+    * @throws std::out_of_range if either <code>from</code> or <code>to</code>
+    * is out of bounds
+    */
+   template<typename T, typename A>
+   size_t DirectedGraph<T, CompressedStorage, A>::edge_count(const size_t& from,
+      const size_t& to) const
+   {
+      // Tests if the starting and ending node indices are valid.
+      test_index(from, "Invalid starting node index in directed graph: ");
+      test_index(to, "Invalid ending node index in directed graph: ");
+      
+      size_t result = 0;
+      
+      for (const auto& element : neighbors(from))
+      {
+         if (element > to) break;
+         if (element == to) result++;
+      }
+      
+      return result;
+   }
+   
+   /**
+    * Returns the number of directed edges in this directed graph.
+    *
+    * @return the number of directed edges
+    */
+   template<typename T, typename A>
+   inline size_t DirectedGraph<T, CompressedStorage, A>::edges() const
+   {
+      return edges_;
+   }
+   
+   /**
+    * Tests if this directed graph is empty (i.e., if the directed graph
+    * contains no nodes).
+    *
+    * @return <code>true</code> if this directed graph is empty, or
+    * <code>false</code> otherwise
+    */
+   template<typename T, typename A>
+   inline bool DirectedGraph<T, CompressedStorage, A>::empty() const
+   {
+      return values_.empty();
+   }
+   
+   /**
+    * Returns the value of the first node in this directed graph.
+    *
+    * @return the value of the first node
+    *
+    * @throws std::out_of_range if this directed graph is empty
+    */
+   template<typename T, typename A>
+   T DirectedGraph<T, CompressedStorage, A>::front() const
+   {
+      // Tests if the directed graph is empty.
+      if (empty()) throw std::out_of_range("Empty directed graph");
+      
+      return values_[0];
+   }
+   
+   /**
+    * Returns a copy of the allocator of this directed graph.
+    *
+    * @return the allocator
+    */
+   template<typename T, typename A>
+   inline A DirectedGraph<T, CompressedStorage, A>::get_allocator() const
+   {
+      return values_.get_allocator();
+   }
+   
+   /**
+    * Tests if this directed graph has a directed edge from the specified
+    * starting node to the specified ending node. The tail nodes of the
+    * starting node are only decoded up to the ending node.
+    *
+    * @param from   the position of the starting node
+    * @param to     the position of the ending node
+    *
+    * @return <code>true</code> if the directed edge exists, or
+    * <code>false</code> otherwise
+    *
+    * @throws std::out_of_range if either <code>from</code> or <code>to</code>
+    * is out of bounds
+    */
+   template<typename T, typename A>
+   bool DirectedGraph<T, CompressedStorage, A>::has_edge(const size_t& from,
+      const size_t& to) const
+   {
+      // Tests if the starting and ending node indices are valid.
+      test_index(from, "Invalid starting node index in directed graph: ");
+      test_index(to, "Invalid ending node index in directed graph: ");
+      
+      for (const auto& element : neighbors(from))
+         if (element >= to) return element == to;
+      
+      return false;
+   }
+   
+   /**
+    * Returns the <b>indegree</b> of the node at position <i>k</i> in this
+    * directed graph.
+    *
+    * @param k   the position of the node
+    *
+    * @return the indegree of the node
+    *
+    * @throws std::out_of_range if <i>k</i> is at least the number of nodes
+    */
+   template<typename T, typename A>
+   size_t DirectedGraph<T, CompressedStorage, A>::indegree(const size_t& k)
+      const
+   {
+      // Tests if k is valid.
+      test_index(k, "Invalid node index in directed graph: ");
+      
+      return indegrees_[k];
+   }
+   
+   /**
+    * Returns a view of the positions of the tail nodes of the node at
+    * position <i>k</i> in this directed graph, in ascending order, decoded as
+    * they are traversed.
+    *
+    * @param k   the position of the node
+    *
+    * @return the view of the tail nodes
+    *
+    * @throws std::out_of_range if <i>k</i> is at least the number of nodes
+    */
+   template<typename T, typename A>
+   inline typename DirectedGraph<T, CompressedStorage, A>::Neighbors
+      DirectedGraph<T, CompressedStorage, A>::neighbors(const size_t& k) const
+   {
+      // Tests if k is valid.
+      test_index(k, "Invalid node index in directed graph: ");
+      
+      return Neighbors(data_.data() + offsets_[k]);
+   }
+   
+   /**
+    * Returns the value of the node at position <i>k</i> in this directed
+    * graph. The position is not checked.
+    *
+    * @param k   the position of the node
+    *
+    * @return the value of the node
+    */
+   template<typename T, typename A>
+   inline T DirectedGraph<T, CompressedStorage, A>
+      ::operator[](const size_t& k) const
+   {
+      return values_[k];
+   }
+   
+   /**
+    * Returns the <b>outdegree</b> of the node at position <i>k</i> in this
+    * directed graph, which is read from the start of its row.
+    *
+    * @param k   the position of the node
+    *
+    * @return the outdegree of the node
+    *
+    * @throws std::out_of_range if <i>k</i> is at least the number of nodes
+    */
+   template<typename T, typename A>
+   size_t DirectedGraph<T, CompressedStorage, A>::outdegree(const size_t& k)
+      const
+   {
+      // Tests if k is valid.
+      test_index(k, "Invalid node index in directed graph: ");
+      
+      const unsigned char* position = data_.data() + offsets_[k];
+      return count(position);
+   }
+   
+   /**
+    * Tests if this directed graph is simple, that is, if the directed graph has
+    * no loops and no multiple directed edges (edges with the same starting and
+    * ending nodes). Since the tail nodes of each node are sorted, a multiple
+    * directed edge is a gap of 0 after the first tail node, so the test takes
+    * linear time.
+    *
+    * @return <code>true</code> if this directed graph is simple, or
+    * <code>false</code> otherwise
+    */
+   template<typename T, typename A>
+   bool DirectedGraph<T, CompressedStorage, A>::simple() const
+   {
+      for (size_t i = 0; i < size(); i++)
+      {
+         const Neighbors row(data_.data() + offsets_[i]);
+         bool first = true;
+         size_t last = 0;
+         
+         for (const auto& element : row)
+         {
+            // Tests if the current node has a loop or a multiple directed edge.
+            if (element == i || (!first && element == last)) return false;
+            
+            first = false;
+            last = element;
+         }
+      }
+      
+      return true;
+   }
+   
+   /**
+    * Returns the number of nodes in this directed graph.
+    *
+    * @return the number of nodes
+    */
+   template<typename T, typename A>
+   inline size_t DirectedGraph<T, CompressedStorage, A>::size() const
+   {
+      return values_.size();
+   }
+   
+   /**
+    * Tests if this directed graph and the specified directed graph are equal.
+    * Each row is compressed the same way for the same tail nodes, so the rows
+    * are compared byte by byte.
+    *
+    * @param rhs   the directed graph to compare with this directed graph
+    *
+    * @return <code>true</code> if this directed graph and the specified
+    * directed graph are equal, or <code>false</code> otherwise
+    */
+   template<typename T, typename A>
+   bool DirectedGraph<T, CompressedStorage, A>
+      ::operator==(const DirectedGraph& rhs) const
+   {
+      return edges_ == rhs.edges_ && data_ == rhs.data_
+         && values_ == rhs.values_;
+   }
+   
+   /**
+    * Tests if this directed graph and the specified directed graph are unequal.
+    *
+    * @param rhs   the directed graph to compare with this directed graph
+    *
+    * @return <code>true</code> if this directed graph and the specified
+    * directed graph are unequal, or <code>false</code> otherwise
+    */
+   template<typename T, typename A>
+   inline bool DirectedGraph<T, CompressedStorage, A>
+      ::operator!=(const DirectedGraph& rhs) const
+   {
+      return !(*this == rhs);
+   }
+   
+   /**
+    * Compresses the directed edges of the specified adjacency into the rows
+    * of this directed graph, whose values must already be set.
+    *
+    * @param graph   the adjacency of the directed edges
+    */
+   template<typename T, typename A>
+   void DirectedGraph<T, CompressedStorage, A>::build(const Adjacency& graph)
+   {
+      const size_t n = graph.size();
+      std::vector<size_t> row;
+      
+      offsets_.assign(1, 0);
+      offsets_.reserve(n + 1);
+      indegrees_.resize(n);
+      data_.clear();
+      edges_ = graph.edges();
+      
+      for (size_t i = 0; i < n; i++)
+      {
+         row.assign(graph.next(i).begin(), graph.next(i).end());
+         std::sort(row.begin(), row.end());
+         indegrees_[i] = graph.indegree(i);
+         
+         // Writes the outdegree as a variable-length integer.
+         size_t rest = row.size();
+         
+         for (; rest >= 0x80; rest >>= 7)
+            data_.push_back(static_cast<unsigned char>(rest | 0x80));
+         
+         data_.push_back(static_cast<unsigned char>(rest));
+         
+         // Writes the gaps in groups of four, each after its control byte.
+         size_t last = 0;
+         
+         for (size_t j = 0; j < row.size(); j += 4)
+         {
+            const size_t control = data_.size();
+            data_.push_back(0);
+            
+            for (size_t slot = 0; slot < 4 && j + slot < row.size(); slot++)
+            {
+               const size_t value = row[j + slot] - last;
+               const unsigned code = value < 0x100 ? 0
+                  : value < 0x10000 ? 1 : value <= 0xffffffffu ? 2 : 3;
+               
+               data_[control] |= static_cast<unsigned char>(code << 2 * slot);
+               put(value, size_t(1) << code);
+               last = row[j + slot];
+            }
+         }
+         
+         offsets_.push_back(data_.size());
+      }
+      
+      data_.resize(data_.size() + padding, 0);
+      data_.shrink_to_fit();
+   }
+   
+   /**
+    * Appends the lowest bytes of the specified value to the rows, from the
+    * lowest byte up.
+    *
+    * @param value    the value
+    * @param length   the number of bytes
+    */
+   template<typename T, typename A>
+   inline void DirectedGraph<T, CompressedStorage, A>::put(const size_t& value,
+      const size_t& length)
+   {
+      for (size_t i = 0; i < length; i++)
+         data_.push_back(static_cast<unsigned char>(value >> 8 * i));
+   }
+   
+   /**
+    * Reads the variable-length outdegree at the start of a row, and moves the
+    * specified position past it.
+    *
+    * @param position   the start of the row
+    *
+    * @return the outdegree
+    */
+   template<typename T, typename A>
+   inline size_t DirectedGraph<T, CompressedStorage, A>::count(
+      const unsigned char*& position)
+   {
+      size_t result = 0;
+      
+      for (size_t shift = 0; ; shift += 7)
+      {
+         const unsigned char byte = *position++;
+         result |= static_cast<size_t>(byte & 0x7f) << shift;
+         if (byte < 0x80) return result;
+      }
+   }
+   
+   /**
+    * Reads the gap of the specified length code at the specified position.
+    * On a little-endian machine the gap is read with one unaligned load of
+    * eight bytes, which the padding keeps within the rows, and one mask.
+    *
+    * @param position   the first byte of the gap
+    * @param code       the length code of the gap
+    *
+    * @return the gap
+    */
+   template<typename T, typename A>
+   inline size_t DirectedGraph<T, CompressedStorage, A>::gap(
+      const unsigned char* position, const unsigned& code)
+   {
+      static const unsigned long long masks[4] =
+      {
+         0xffULL, 0xffffULL, 0xffffffffULL, ~0ULL
+      };
+      
+      const unsigned short one = 1;
+      unsigned long long result = 0;
+      
+      if (*reinterpret_cast<const unsigned char*>(&one) == 1)
+      {
+         std::memcpy(&result, position, sizeof(result));
+         return static_cast<size_t>(result & masks[code]);
+      }
+      
+      for (size_t i = 0; i < (size_t(1) << code); i++)
+         result |= static_cast<unsigned long long>(position[i]) << 8 * i;
+      
+      return static_cast<size_t>(result);
+   }
+   
+   /**
+    * Tests if the specified position is a valid node position in this
+    * directed graph.
+    *
+    * @param k       the position of the node
+    * @param error   the error message
+    *
+    * @throws std::out_of_range if <i>k</i> is at least the number of nodes
+    */
+   template<typename T, typename A>
+   inline void DirectedGraph<T, CompressedStorage, A>::test_index(
+      const size_t& k, const char* error) const
+   {
+      if (k >= size()) throw_index_error(error, k);
+   }
+   
+   /** Constructs a neighbor iterator that points to no node. */
+   template<typename T, typename A>
+   inline DirectedGraph<T, CompressedStorage, A>::NeighborIterator
+      ::NeighborIterator()
+      : position_(nullptr), remaining_(0), slot_(0) {}
+   
+   /**
+    * Moves this neighbor iterator to the next tail node, and decodes the
+    * next group if the current one is done.
+    *
+    * @return this neighbor iterator
+    */
+   template<typename T, typename A>
+   inline typename DirectedGraph<T, CompressedStorage, A>::NeighborIterator&
+      DirectedGraph<T, CompressedStorage, A>::NeighborIterator::operator++()
+   {
+      if (--remaining_ > 0 && ++slot_ == 4) decode();
+      return *this;
+   }
+   
+   /**
+    * Moves this neighbor iterator to the next tail node.
+    *
+    * @return a copy of this neighbor iterator before it was moved
+    */
+   template<typename T, typename A>
+   inline typename DirectedGraph<T, CompressedStorage, A>::NeighborIterator
+      DirectedGraph<T, CompressedStorage, A>::NeighborIterator::operator++(int)
+   {
+      NeighborIterator result = *this;
+      ++*this;
+      return result;
+   }
+   
+   /**
+    * Returns the position of the current tail node.
+    *
+    * @return the position of the tail node
+    */
+   template<typename T, typename A>
+   inline typename DirectedGraph<T, CompressedStorage, A>::NeighborIterator
+      ::reference DirectedGraph<T, CompressedStorage, A>::NeighborIterator
+      ::operator*() const
+   {
+      return values_[slot_];
+   }
+   
+   /**
+    * Returns a pointer to the position of the current tail node.
+    *
+    * @return a pointer to the position of the tail node
+    */
+   template<typename T, typename A>
+   inline typename DirectedGraph<T, CompressedStorage, A>::NeighborIterator
+      ::pointer DirectedGraph<T, CompressedStorage, A>::NeighborIterator
+      ::operator->() const
+   {
+      return values_ + slot_;
+   }
+   
+   /**
+    * Tests if this neighbor iterator and the specified neighbor iterator,
+    * over the same row, point to the same tail node.
+    *
+    * @param rhs   the neighbor iterator to compare with this one
+    *
+    * @return <code>true</code> if the two neighbor iterators are equal, or
+    * <code>false</code> otherwise
+    */
+   template<typename T, typename A>
+   inline bool DirectedGraph<T, CompressedStorage, A>::NeighborIterator
+      ::operator==(const NeighborIterator& rhs) const
+   {
+      return remaining_ == rhs.remaining_;
+   }
+   
+   /**
+    * Tests if this neighbor iterator and the specified neighbor iterator,
+    * over the same row, point to different tail nodes.
+    *
+    * @param rhs   the neighbor iterator to compare with this one
+    *
+    * @return <code>true</code> if the two neighbor iterators are unequal, or
+    * <code>false</code> otherwise
+    */
+   template<typename T, typename A>
+   inline bool DirectedGraph<T, CompressedStorage, A>::NeighborIterator
+      ::operator!=(const NeighborIterator& rhs) const
+   {
+      return remaining_ != rhs.remaining_;
+   }
+   
+   /**
+    * Constructs a neighbor iterator that decodes the specified number of tail
+    * nodes from the specified group.
+    *
+    * @param position    the first group
+    * @param remaining   the number of tail nodes
+    */
+   template<typename T, typename A>
+   inline DirectedGraph<T, CompressedStorage, A>::NeighborIterator
+      ::NeighborIterator(const unsigned char* position, const size_t& remaining)
+      : position_(position), remaining_(remaining), slot_(0)
+   {
+      values_[3] = 0;
+      if (remaining_ > 0) decode();
+   }
+   
+   /**
+    * Decodes the next group, whose positions follow the last position of the
+    * current group. All four gaps are decoded without a branch, even in the
+    * last group of a row, whose missing gaps read the following bytes as
+    * gaps of one byte and are never returned.
+    */
+   template<typename T, typename A>
+   inline void DirectedGraph<T, CompressedStorage, A>::NeighborIterator
+      ::decode()
+   {
+      const unsigned control = *position_++;
+      size_t value = values_[3];
+      
+      for (unsigned i = 0; i < 4; i++)
+      {
+         const unsigned code = (control >> 2 * i) & 3;
+         value += gap(position_, code);
+         values_[i] = value;
+         position_ += size_t(1) << code;
+      }
+      
+      slot_ = 0;
+   }
+   
+   /**
+    * Returns a neighbor iterator to the first tail node of this view.
+    *
+    * @return the neighbor iterator
+    */
+   template<typename T, typename A>
+   inline typename DirectedGraph<T, CompressedStorage, A>::NeighborIterator
+      DirectedGraph<T, CompressedStorage, A>::Neighbors::begin() const
+   {
+      return NeighborIterator(first_, size_);
+   }
+   
+   /**
+    * Tests if this view has no tail nodes.
+    *
+    * @return <code>true</code> if this view is empty, or <code>false</code>
+    * otherwise
+    */
+   template<typename T, typename A>
+   inline bool DirectedGraph<T, CompressedStorage, A>::Neighbors::empty()
+      const
+   {
+      return size_ == 0;
+   }
+   
+   /**
+    * Returns a neighbor iterator one past the last tail node of this view.
+    *
+    * @return the neighbor iterator
+    */
+   template<typename T, typename A>
+   inline typename DirectedGraph<T, CompressedStorage, A>::NeighborIterator
+      DirectedGraph<T, CompressedStorage, A>::Neighbors::end() const
+   {
+      return NeighborIterator();
+   }
+   
+   /**
+    * Returns the number of tail nodes in this view.
+    *
+    * @return the number of tail nodes
+    */
+   template<typename T, typename A>
+   inline size_t DirectedGraph<T, CompressedStorage, A>::Neighbors::size()
+      const
+   {
+      return size_;
+   }
+   
+   /**
+    * Constructs a view of the row that starts at the specified byte.
+    *
+    * @param row   the start of the row
+    */
+   template<typename T, typename A>
+   inline DirectedGraph<T, CompressedStorage, A>::Neighbors::Neighbors(
+      const unsigned char* row)
+      : first_(row), size_(count(first_)) {}
+   
+   /**
+    * Outputs the specified directed graph with the specified output stream.
+    *
+    * @param out   the output stream
+    * @param rhs   the directed graph to be outputted
+    *
+    * @return the stream after the output
+    */
+   template<typename T, typename A>
+   std::ostream& operator<<(std::ostream& out,
+      const DirectedGraph<T, CompressedStorage, A>& rhs)
+   {
+      for (size_t i = 0; i < rhs.size(); i++)
+      {
+         const auto tails = rhs.neighbors(i);
+         
+         // Outputs the current node by itself if it is disconnected.
+         if (tails.empty() && rhs.indegrees_[i] == 0)
+            out << rhs.values_[i] << '\n';
+         
+         // Outputs the starting and ending nodes for each directed edge.
+         else
+         {
+            for (const auto& element : tails)
+               out << rhs.values_[i] << " -> " << rhs.values_[element] << '\n';
+         }
+      }
+      
+      return out;
+   }
+   
+   /**
+    * Visits each node reachable from the node at position <i>source</i> in the
+    * specified compressed directed graph in breadth-first order, starting
+    * with the source node itself. The tail nodes of each node are decoded
+    * straight out of its row, without an adjacency, and visited in ascending
+    * order.
+    *
+    * @param Visitor   the type of the function called on each node
+    *
+    * @param graph    the compressed directed graph
+    * @param source   the position of the source node
+    * @param visit    the function called with the position of each node
+    *
+    * @throws std::out_of_range if <i>source</i> is at least the number of nodes
+    */
+   template<typename T, typename A, typename Visitor>
+   void bfs(const DirectedGraph<T, CompressedStorage, A>& graph,
+      const size_t& source, Visitor visit)
+   {
+      // Tests if source is valid.
+      if (source >= graph.size())
+         throw_index_error("Invalid source node index in directed graph: ",
+            source);
+      
+      std::vector<bool> visited(graph.size(), false);
+      std::vector<size_t> queue;
+      queue.reserve(graph.size());
+      queue.push_back(source);
+      visited[source] = true;
+      
+      for (size_t i = 0; i < queue.size(); i++)
+      {
+         const size_t node = queue[i];
+         visit(node);
+         
+         for (const auto& tail : graph.neighbors(node))
+         {
+            if (!visited[tail])
+            {
+               visited[tail] = true;
+               queue.push_back(tail);
+            }
+         }
+      }
+   }
+}
+
+#endif   // PIC_10C_COMPRESSED_DIRECTED_GRAPH_H_
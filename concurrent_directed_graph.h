@@ -0,0 +1,346 @@
+/**
+ * Declarations and definitions of the <code>ConcurrentDirectedGraph</code>
+ * class.
+ *
+ * @file concurrent_directed_graph.h
+ *
+ * @author Kris Torres
+ *
+ * @date 2026-10-14
+ *
+ * @version 1.0
+ */
+
+#ifndef PIC_10C_CONCURRENT_DIRECTED_GRAPH_H_
+#define PIC_10C_CONCURRENT_DIRECTED_GRAPH_H_
+
+#include <memory>
+#include <mutex>
+#include <atomic>
+#include <utility>
+#include <vector>
+#include "shared_directed_graph.h"
+
+namespace Kris_Torres_UCLA_PIC_10C_Winter_2014
+{
+   /**
+    * A <b>concurrent directed graph</b> serves reads from any number of
+    * threads while one writer at a time modifies it. The directed graph is
+    * published as an immutable <code>DirectedGraph&lt;T, SharedStorage&gt;
+    * </code> version: a reader atomically takes the current version, and
+    * reads it for as long as it likes without ever waiting for the writer. A
+    * writer copies the current version in constant time, applies its changes
+    * to the copy, which copies only the nodes that it touches, and then
+    * atomically publishes the copy in place of the current version.<p>
+    *
+    * A reader therefore sees either all of an update or none of it, never a
+    * half-applied <code>connect</code> or <code>disconnect</code>. The writers
+    * are serialized by a mutex that the readers never take, and a version
+    * stays alive until the last reader holding it lets it go.<p>
+    *
+    * Each version is published in a <i>slot</i>, through an atomic pointer. A
+    * reader counts itself into the current slot, copies its version, and
+    * counts itself out, with nothing but atomic integer and pointer
+    * operations, so a reader never waits for a lock, even while a writer
+    * publishes; it only retries if a version is published in between. A
+    * writer reuses a slot once the slot is no longer published and no reader
+    * is in it, and otherwise adds a slot, so a writer never waits for the
+    * readers either.
+    *
+    * @param T   the type of the elements
+    * @param A   the allocator type
+    *
+    * @author Kris Torres
+    */
+   template<typename T, typename A = std::allocator<T>>
+   class ConcurrentDirectedGraph final
+   {
+   public:
+      
+      // Types
+      typedef DirectedGraph<T, SharedStorage, A> Graph;
+      typedef std::shared_ptr<const Graph> Snapshot;
+      
+      // Constructors
+      ConcurrentDirectedGraph();
+      explicit ConcurrentDirectedGraph(const Graph& graph);
+      
+      // Deleted copy operations
+      ConcurrentDirectedGraph(const ConcurrentDirectedGraph& rhs) = delete;
+      ConcurrentDirectedGraph& operator=(const ConcurrentDirectedGraph& rhs)
+         = delete;
+      
+      // Destructor
+      ~ConcurrentDirectedGraph();
+      
+      // Mutators
+      void connect(const size_t& from, const size_t& to);
+      void disconnect(const size_t& k);
+      void disconnect(const size_t& from, const size_t& to);
+      void erase(const size_t& k);
+      void push_back(const T& val);
+      template<typename F>
+      void update(F f);
+      
+      // Accessors
+      size_t size() const;
+      Snapshot snapshot() const;
+      size_t version() const;
+      
+   private:
+      
+      /** A slot in which a version of the directed graph is published. */
+      struct Slot
+      {
+         /** The version, or a null pointer if the slot is free. */
+         Snapshot graph;
+         
+         /** The number of readers copying the version. */
+         std::atomic<size_t> readers;
+      };
+      
+      // Mutator
+      Slot* make_slot(const Snapshot& graph);
+      
+      /** The slot of the version of the directed graph that readers see. */
+      std::atomic<Slot*> published_;
+      
+      /** Every slot, which lives as long as this directed graph. */
+      std::vector<Slot*> slots_;
+      
+      /** The number of updates that have been published. */
+      std::atomic<size_t> version_;
+      
+      /** The mutex that serializes the writers. */
+      std::mutex writer_;
+   };
+   
+   /** Constructs an empty concurrent directed graph, with no nodes. */
+   template<typename T, typename A>
+   inline ConcurrentDirectedGraph<T, A>::ConcurrentDirectedGraph()
+      : published_(nullptr), version_(0)
+   {
+      published_.store(make_slot(std::make_shared<const Graph>()));
+   }
+   
+   /**
+    * Constructs a concurrent directed graph whose first version is the
+    * specified directed graph. The nodes are shared with the directed graph,
+    * not copied.
+    *
+    * @param graph   the first version of the directed graph
+    */
+   template<typename T, typename A>
+   inline ConcurrentDirectedGraph<T, A>::ConcurrentDirectedGraph(
+      const Graph& graph)
+      : published_(nullptr), version_(0)
+   {
+      published_.store(make_slot(std::make_shared<const Graph>(graph)));
+   }
+   
+   /**
+    * Destroys this concurrent directed graph. The snapshots that readers
+    * still hold stay valid.
+    */
+   template<typename T, typename A>
+   ConcurrentDirectedGraph<T, A>::~ConcurrentDirectedGraph()
+   {
+      for (const auto& element : slots_) delete element;
+   }
+   
+   /**
+    * Connects a directed edge from the specified starting node to the specified
+    * ending node in this concurrent directed graph, and publishes the result.
+    *
+    * @param from   the position of the starting node
+    * @param to     the position of the ending node
+    *
+    * @throws std::out_of_range if either <code>from</code> or <code>to</code>
+    * is out of bounds
+    */
+   template<typename T, typename A>
+   void ConcurrentDirectedGraph<T, A>::connect(const size_t& from,
+      const size_t& to)
+   {
+      update([&](Graph& graph) { graph.connect(from, to); });
+   }
+   
+   /**
+    * Disconnects all head nodes and all tail nodes adjacent to the node at
+    * position <i>k</i> in this concurrent directed graph, and publishes the
+    * result.
+    *
+    * @param k   the position of the node
+    *
+    * @throws std::out_of_range if <i>k</i> is out of bounds
+    */
+   template<typename T, typename A>
+   void ConcurrentDirectedGraph<T, A>::disconnect(const size_t& k)
+   {
+      update([&](Graph& graph) { graph.disconnect(k); });
+   }
+   
+   /**
+    * Disconnects a directed edge from the specified starting node to the
+    * specified ending node in this concurrent directed graph, and publishes
+    * the result.
+    *
+    * @param from   the position of the starting node
+    * @param to     the position of the ending node
+    *
+    * @throws std::out_of_range if either <code>from</code> or <code>to</code>
+    * is out of bounds
+    */
+   template<typename T, typename A>
+   void ConcurrentDirectedGraph<T, A>::disconnect(const size_t& from,
+      const size_t& to)
+   {
+      update([&](Graph& graph) { graph.disconnect(from, to); });
+   }
+   
+   /**
+    * Removes the node at position <i>k</i> from this concurrent directed
+    * graph, and publishes the result.
+    *
+    * @param k   the position of the node
+    *
+    * @throws std::out_of_range if <i>k</i> is out of bounds
+    */
+   template<typename T, typename A>
+   void ConcurrentDirectedGraph<T, A>::erase(const size_t& k)
+   {
+      update([&](Graph& graph) { graph.erase(k); });
+   }
+   
+   /**
+    * Adds a node with the specified value to this concurrent directed graph,
+    * after its current last node, and publishes the result.
+    *
+    * @param val   the value of the new node
+    */
+   template<typename T, typename A>
+   void ConcurrentDirectedGraph<T, A>::push_back(const T& val)
+   {
+      update([&](Graph& graph) { graph.push_back(val); });
+   }
+   
+   /**
+    * Applies the specified function to a copy of the current version of this
+    * concurrent directed graph, and publishes the copy as the next version.
+    * Several changes applied by one function are published together. If the
+    * function throws an exception, nothing is published and the exception is
+    * propagated.<p>
+    *
+    * The function must not call the members of this concurrent directed
+    * graph that modify it.
+    *
+    * @param f   the function, which takes a <code>Graph&</code>
+    */
+   template<typename T, typename A>
+   template<typename F>
+   void ConcurrentDirectedGraph<T, A>::update(F f)
+   {
+      std::lock_guard<std::mutex> lock(writer_);
+      
+      // Only the writers change the slots, so the current one can be read.
+      Slot* const current = published_.load();
+      Graph next(*current -> graph);
+      f(next);
+      
+      Snapshot graph = std::make_shared<const Graph>(std::move(next));
+      Slot* slot = nullptr;
+      
+      // Frees the old versions that no reader is copying. A reader that
+      // counts itself in afterwards sees that the slot is not published, and
+      // counts itself out without touching the version.
+      for (const auto& element : slots_)
+      {
+         if (element == current || element -> readers.load() != 0) continue;
+         
+         element -> graph.reset();
+         if (slot == nullptr) slot = element;
+      }
+      
+      if (slot == nullptr) slot = make_slot(nullptr);
+      slot -> graph = std::move(graph);
+      published_.store(slot);
+      version_.fetch_add(1, std::memory_order_release);
+   }
+   
+   /**
+    * Returns the number of nodes in the current version of this concurrent
+    * directed graph.
+    *
+    * @return the number of nodes
+    */
+   template<typename T, typename A>
+   inline size_t ConcurrentDirectedGraph<T, A>::size() const
+   {
+      return snapshot() -> size();
+   }
+   
+   /**
+    * Returns the current version of this concurrent directed graph. The
+    * version never changes, so it can be read without any locking while
+    * later versions are published; every read that must be consistent with
+    * another should be made on the same snapshot. The function takes no
+    * lock, and retries only if a version is published while it runs.
+    *
+    * @return the current version of this concurrent directed graph
+    */
+   template<typename T, typename A>
+   typename ConcurrentDirectedGraph<T, A>::Snapshot
+      ConcurrentDirectedGraph<T, A>::snapshot() const
+   {
+      while (true)
+      {
+         Slot* const slot = published_.load();
+         slot -> readers.fetch_add(1);
+         
+         // Tests if the slot is still published, so that no writer frees or
+         // replaces its version until this reader counts itself out.
+         if (published_.load() == slot)
+         {
+            Snapshot result = slot -> graph;
+            slot -> readers.fetch_sub(1);
+            return result;
+         }
+         
+         slot -> readers.fetch_sub(1);
+      }
+   }
+   
+   /**
+    * Returns the number of updates that have been published to this
+    * concurrent directed graph.
+    *
+    * @return the number of published updates
+    */
+   template<typename T, typename A>
+   inline size_t ConcurrentDirectedGraph<T, A>::version() const
+   {
+      return version_.load(std::memory_order_acquire);
+   }
+   
+   /**
+    * Adds a slot with the specified version, which no reader is in.
+    *
+    * @param graph   the version
+    *
+    * @return the slot
+    */
+   template<typename T, typename A>
+   typename ConcurrentDirectedGraph<T, A>::Slot*
+      ConcurrentDirectedGraph<T, A>::make_slot(const Snapshot& graph)
+   {
+      slots_.reserve(slots_.size() + 1);
+      
+      Slot* const result = new Slot();
+      result -> graph = graph;
+      result -> readers.store(0);
+      slots_.push_back(result);
+      return result;
+   }
+}
+
+#endif   // PIC_10C_CONCURRENT_DIRECTED_GRAPH_H_
@@ -0,0 +1,1563 @@
+/**
+ * Declarations and definitions of the <code>DirectedGraph</code> class for the
+ * <code>CSRStorage</code> storage policy, and <code>operator<<</code> for that
+ * class.
+ *
+ * @file csr_directed_graph.h
+ *
+ * @author Kris Torres
+ *
+ * @date 2026-10-14
+ *
+ * @version 1.0
+ */
+
+#ifndef PIC_10C_CSR_DIRECTED_GRAPH_H_
+#define PIC_10C_CSR_DIRECTED_GRAPH_H_
+
+#include <string>
+#include <vector>
+#include <stdexcept>
+#include <algorithm>
+#include <initializer_list>
+#include <utility>
+#include <iterator>
+#include "adjacency.h"
+#include "directed_graph.h"
+#include "index_error.h"
+
+namespace Kris_Torres_UCLA_PIC_10C_Winter_2014
+{
+   /**
+    * A directed graph stored in <i>compressed sparse row</i> (CSR) form. The
+    * values of the nodes are kept in one vector, and the directed edges are
+    * kept in two more: the tail node positions of all the directed edges,
+    * grouped by starting node, and the offset at which the group of each node
+    * begins. Scanning the tail nodes of a node is therefore a sequential
+    * memory read, and no directed edge needs an allocation of its own.<p>
+    *
+    * The head nodes of each node are kept in the same form, so that both the
+    * outdegree and the indegree of a node are found in constant time.<p>
+    *
+    * The public interface is the same as that of the default storage policy.
+    * Connecting and disconnecting directed edges shifts the later directed
+    * edges, so this storage policy favors directed graphs that are built once
+    * and then traversed many times.
+    *
+    * @param T   the type of the elements
+    * @param A   the allocator type
+    *
+    * @author Kris Torres
+    */
+   template<typename T, typename A>
+   class DirectedGraph<T, CSRStorage, A>
+   {
+   public:
+      
+      // Class
+      class Iterator;
+      
+      // Type
+      typedef A allocator_type;
+      
+      // Constructors
+      DirectedGraph();
+      explicit DirectedGraph(const A& alloc);
+      explicit DirectedGraph(const size_t& n, const A& alloc = A());
+      DirectedGraph(const size_t& n, const T& val, const A& alloc = A());
+      DirectedGraph(const std::vector<T>& v, const A& alloc = A());
+      DirectedGraph(std::vector<T>&& v, const A& alloc = A());
+      DirectedGraph(const std::initializer_list<T> il, const A& alloc = A());
+      DirectedGraph(const DirectedGraph& rhs);
+      DirectedGraph(const DirectedGraph& rhs, const A& alloc);
+      DirectedGraph(DirectedGraph&& rhs) noexcept;
+      
+      // Assignment operators
+      DirectedGraph& operator=(const DirectedGraph& rhs);
+      DirectedGraph& operator=(DirectedGraph&& rhs)
+         noexcept(std::allocator_traits<A>
+            ::propagate_on_container_move_assignment::value);
+      
+      // Destructor
+      virtual ~DirectedGraph();
+      
+      // Mutators
+      T& at(const size_t& k);
+      Iterator begin();
+      void clear();
+      void connect(const size_t& from, const size_t& to);
+      template<typename InputIterator>
+      void connect_bulk(InputIterator first, InputIterator last);
+      void connect_bulk(
+         const std::initializer_list<std::pair<size_t, size_t>> il);
+      void dedupe_edges();
+      void disconnect(const size_t& k);
+      void disconnect(const size_t& from, const size_t& to);
+      template<typename... Args>
+      void emplace_back(Args&&... args);
+      void erase(const size_t& k);
+      T& front();
+      T& operator[](const size_t& k);
+      void push_back(const T& val);
+      void push_back(T&& val);
+      void remove_self_loops();
+      void reserve(const size_t& nodes, const size_t& edges = 0);
+      void swap(DirectedGraph& rhs) noexcept;
+      
+      // Accessors
+      Adjacency adjacency() const;
+      T at(const size_t& k) const;
+      size_t edge_count(const size_t& from, const size_t& to) const;
+      bool empty() const;
+      T front() const;
+      A get_allocator() const;
+      bool has_edge(const size_t& from, const size_t& to) const;
+      size_t indegree(const size_t& k) const;
+      T operator[](const size_t& k) const;
+      size_t outdegree(const size_t& k) const;
+      bool simple() const;
+      size_t size() const;
+      
+      // Relational operators
+      bool operator==(const DirectedGraph& rhs) const;
+      bool operator!=(const DirectedGraph& rhs) const;
+      
+      // Friend
+      template<typename U, typename V>
+      friend std::ostream& operator<<(std::ostream& out,
+         const DirectedGraph<U, CSRStorage, V>& rhs);
+      
+   private:
+      
+      // Types
+      template<typename U>
+      using Allocator =
+         typename std::allocator_traits<A>::template rebind_alloc<U>;
+      typedef std::vector<size_t, Allocator<size_t>> Indices;
+      
+      // Accessor
+      void test_index(const size_t& k, const char* error) const;
+      
+      // Helpers
+      static void insert_edge(Indices& offsets, Indices& columns,
+         const size_t& row, const size_t& column);
+      static void insert_edges(Indices& offsets, Indices& columns,
+         const Indices& rows, const Indices& cols);
+      static void remove_duplicates(Indices& offsets, Indices& columns);
+      static bool remove_edge(Indices& offsets, Indices& columns,
+         const size_t& row, const size_t& column);
+      static void remove_loops(Indices& offsets, Indices& columns);
+      static void remove_node(Indices& offsets, Indices& columns,
+         const size_t& k);
+      static std::vector<T, A> take_values(std::vector<T, A>&& v,
+         const A& alloc);
+      template<typename V>
+      static std::vector<T, A> take_values(V&& v, const A& alloc);
+      
+      /** The values of the nodes in this directed graph. */
+      std::vector<T, A> values_;
+      
+      /**
+       * The offsets into <code>targets_</code> at which the tail nodes of each
+       * node begin, followed by the total number of directed edges. The vector
+       * is empty if this directed graph has no nodes.
+       */
+      Indices offsets_;
+      
+      /**
+       * The positions of the ending nodes for the directed edges in this
+       * directed graph, grouped by starting node and kept in the order in
+       * which the directed edges were connected.
+       */
+      Indices targets_;
+      
+      /**
+       * The offsets into <code>sources_</code> at which the head nodes of each
+       * node begin, followed by the total number of directed edges. The vector
+       * is empty if this directed graph has no nodes.
+       */
+      Indices reverse_offsets_;
+      
+      /**
+       * The positions of the starting nodes for the directed edges in this
+       * directed graph, grouped by ending node.
+       */
+      Indices sources_;
+   };
+   
+   /**
+    * <i>Iterators</i> are objects that point to some nodes in a directed graph
+    * and have the ability to traverse through the nodes in that directed
+    * graph.<p>
+    *
+    * An iterator for the <code>CSRStorage</code> storage policy holds the
+    * position of its node, so it is invalidated by <code>erase</code>.
+    *
+    * @author Kris Torres
+    */
+   template<typename T, typename A>
+   class DirectedGraph<T, CSRStorage, A>::Iterator
+   {
+   public:
+      
+      // Constructor
+      Iterator();
+      
+      // Destructor
+      virtual ~Iterator();
+      
+      // Mutators
+      void next(const size_t& k);
+      T& operator*();
+      void prev(const size_t& k);
+      
+      // Accessors
+      size_t indegree() const;
+      T operator*() const;
+      T* operator->() const;
+      size_t outdegree() const;
+      
+      // Relational operators
+      bool operator==(const Iterator& rhs) const;
+      bool operator!=(const Iterator& rhs) const;
+      
+      // Friend
+      friend class DirectedGraph<T, CSRStorage, A>;
+      
+   private:
+      
+      /** The position of this iterator in the directed graph. */
+      size_t position_;
+      
+      /** The directed graph that this iterator traverses. */
+      DirectedGraph<T, CSRStorage, A>* container_;
+   };
+   
+   // Directed graph output operator
+   template<typename T, typename A>
+   std::ostream& operator<<(std::ostream& out,
+      const DirectedGraph<T, CSRStorage, A>& rhs);
+   
+   /** Constructs an empty directed graph, with no nodes. */
+   template<typename T, typename A>
+   inline DirectedGraph<T, CSRStorage, A>::DirectedGraph() {}
+   
+   /**
+    * Constructs an empty directed graph, with no nodes, that allocates its
+    * memory with the specified allocator.
+    *
+    * @param alloc   the allocator
+    */
+   template<typename T, typename A>
+   inline DirectedGraph<T, CSRStorage, A>::DirectedGraph(const A& alloc)
+      : values_(alloc), offsets_(alloc), targets_(alloc),
+        reverse_offsets_(alloc), sources_(alloc) {}
+   
+   /**
+    * Constructs a directed graph with <i>n</i> nodes. Each node has the
+    * default value of the specified type for the directed graph.
+    *
+    * @param n       the initial number of nodes
+    * @param alloc   the allocator
+    */
+   template<typename T, typename A>
+   DirectedGraph<T, CSRStorage, A>::DirectedGraph(const size_t& n,
+      const A& alloc)
+      : values_(n, T(), alloc), offsets_(n == 0 ? 0 : n + 1, 0, alloc),
+        targets_(alloc), reverse_offsets_(offsets_, alloc), sources_(alloc) {}
+   
+   /**
+    * Constructs a directed graph with <i>n</i> nodes. Each node has the
+    * specified value.
+    *
+    * @param n       the initial number of nodes
+    * @param val     the value of each node
+    * @param alloc   the allocator
+    */
+   template<typename T, typename A>
+   DirectedGraph<T, CSRStorage, A>::DirectedGraph(const size_t& n, const T& val,
+      const A& alloc)
+      : values_(n, val, alloc), offsets_(n == 0 ? 0 : n + 1, 0, alloc),
+        targets_(alloc), reverse_offsets_(offsets_, alloc), sources_(alloc) {}
+   
+   /**
+    * Constructs a directed graph that contains nodes with each of the elements
+    * in the specified vector.
+    *
+    * @param v       the vector of elements
+    * @param alloc   the allocator
+    */
+   template<typename T, typename A>
+   DirectedGraph<T, CSRStorage, A>::DirectedGraph(const std::vector<T>& v,
+      const A& alloc)
+      : values_(v.begin(), v.end(), alloc),
+        offsets_(v.empty() ? 0 : v.size() + 1, 0, alloc), targets_(alloc),
+        reverse_offsets_(offsets_, alloc), sources_(alloc) {}
+   
+   /**
+    * Constructs a directed graph that contains nodes with each of the elements
+    * in the specified vector, which is left in a valid but unspecified state.
+    * If the directed graph uses the default allocator, the buffer of the
+    * vector is taken over, so no element is copied or moved.
+    *
+    * @param v       the vector of elements
+    * @param alloc   the allocator
+    */
+   template<typename T, typename A>
+   DirectedGraph<T, CSRStorage, A>::DirectedGraph(std::vector<T>&& v,
+      const A& alloc)
+      : values_(take_values(std::move(v), alloc)),
+        offsets_(values_.empty() ? 0 : values_.size() + 1, 0, alloc),
+        targets_(alloc), reverse_offsets_(offsets_, alloc), sources_(alloc) {}
+   
+   /**
+    * Constructs a directed graph that contains nodes with each of the elements
+    * in the specified initializer list.
+    *
+    * @param il      the initializer list of elements
+    * @param alloc   the allocator
+    */
+   template<typename T, typename A>
+   DirectedGraph<T, CSRStorage, A>
+      ::DirectedGraph(const std::initializer_list<T> il, const A& alloc)
+      : values_(il, alloc),
+        offsets_(il.size() == 0 ? 0 : il.size() + 1, 0, alloc),
+        targets_(alloc), reverse_offsets_(offsets_, alloc), sources_(alloc) {}
+   
+   /**
+    * Constructs a directed graph with a copy of each of the nodes in the
+    * specified directed graph.
+    *
+    * @param rhs   the directed graph to be copied
+    */
+   template<typename T, typename A>
+   DirectedGraph<T, CSRStorage, A>::DirectedGraph(const DirectedGraph& rhs)
+      : values_(rhs.values_), offsets_(rhs.offsets_), targets_(rhs.targets_),
+        reverse_offsets_(rhs.reverse_offsets_), sources_(rhs.sources_) {}
+   
+   /**
+    * Constructs a directed graph with a copy of each of the nodes in the
+    * specified directed graph, allocating its memory with the specified
+    * allocator.
+    *
+    * @param rhs     the directed graph to be copied
+    * @param alloc   the allocator
+    */
+   template<typename T, typename A>
+   DirectedGraph<T, CSRStorage, A>::DirectedGraph(const DirectedGraph& rhs,
+      const A& alloc)
+      : values_(rhs.values_, alloc), offsets_(rhs.offsets_, alloc),
+        targets_(rhs.targets_, alloc),
+        reverse_offsets_(rhs.reverse_offsets_, alloc),
+        sources_(rhs.sources_, alloc) {}
+   
+   /**
+    * Constructs a directed graph that acquires the nodes in the specified
+    * directed graph. Note that the specified directed graph is left in an
+    * unspecified but valid state.
+    *
+    * @param rhs   the directed graph to be moved
+    */
+   template<typename T, typename A>
+   DirectedGraph<T, CSRStorage, A>::DirectedGraph(DirectedGraph&& rhs) noexcept
+      : values_(std::move(rhs.values_)), offsets_(std::move(rhs.offsets_)),
+        targets_(std::move(rhs.targets_)),
+        reverse_offsets_(std::move(rhs.reverse_offsets_)),
+        sources_(std::move(rhs.sources_)) {}
+   
+   /**
+    * Copies all the nodes in the specified directed graph into this directed
+    * graph, with the former preserving its contents.
+    *
+    * @param rhs   the directed graph to be copied
+    *
+    * @return this directed graph after the assignment
+    */
+   template<typename T, typename A>
+   DirectedGraph<T, CSRStorage, A>& DirectedGraph<T, CSRStorage, A>
+      ::operator=(const DirectedGraph& rhs)
+   {
+      // Tests for self-assignment.
+      if (this != &rhs)
+      {
+         values_ = rhs.values_;
+         offsets_ = rhs.offsets_;
+         targets_ = rhs.targets_;
+         reverse_offsets_ = rhs.reverse_offsets_;
+         sources_ = rhs.sources_;
+      }
+      
+      return *this;
+   }
+   
+   /**
+    * Moves all the nodes in the specified directed graph into this directed
+    * graph, with the former left in an unspecified but valid state.
+    *
+    * @param rhs   the directed graph to be moved
+    *
+    * @return this directed graph after the assignment
+    */
+   template<typename T, typename A>
+   DirectedGraph<T, CSRStorage, A>& DirectedGraph<T, CSRStorage, A>
+      ::operator=(DirectedGraph&& rhs)
+      noexcept(std::allocator_traits<A>
+         ::propagate_on_container_move_assignment::value)
+   {
+      // Tests for self-assignment.
+      if (this != &rhs)
+      {
+         values_ = std::move(rhs.values_);
+         offsets_ = std::move(rhs.offsets_);
+         targets_ = std::move(rhs.targets_);
+         reverse_offsets_ = std::move(rhs.reverse_offsets_);
+         sources_ = std::move(rhs.sources_);
+         rhs.clear();
+      }
+      
+      return *this;
+   }
+   
+   /** Destroys this directed graph. */
+   template<typename T, typename A>
+   inline DirectedGraph<T, CSRStorage, A>::~DirectedGraph() {}
+   
+   /**
+    * Returns a reference to the value of the node at position <i>k</i> in this
+    * directed graph.<p>
+    *
+    * The function automatically checks whether <i>k</i> is within the bounds of
+    * valid positions in the directed graph, throwing an
+    * <code>std::out_of_range</code> exception if it is not (i.e., if <i>k</i>
+    * is greater than or equal to the number of nodes in the directed graph).
+    * This is in contrast with member <code>operator[]</code>, which does not
+    * check against bounds.
+    *
+    * @param k   the position of the node
+    *
+    * @return a reference to the value of the node at position <i>k</i>
+    *
+    * @throws std::out_of_range if <i>k</i> is out of bounds
+    */
+   template<typename T, typename A>
+   T& DirectedGraph<T, CSRStorage, A>::at(const size_t& k)
+   {
+      // Tests if k is valid.
+      test_index(k, "Invalid node index in directed graph: ");
+      
+      return values_[k];
+   }
+   
+   /**
+    * Returns an iterator pointing to the first node in this directed graph.
+    *
+    * @return an iterator pointing to the first node
+    *
+    * @throws std::out_of_range if this directed graph is empty
+    */
+   template<typename T, typename A>
+   typename DirectedGraph<T, CSRStorage, A>::Iterator
+      DirectedGraph<T, CSRStorage, A>::begin()
+   {
+      // Tests if the directed graph is empty.
+      if (empty()) throw std::out_of_range("Empty directed graph");
+      
+      Iterator start;
+      start.position_ = 0;
+      start.container_ = this;
+      return start;
+   }
+   
+   /**
+    * Removes all nodes from this directed graph, leaving the directed graph
+    * with no nodes.
+    */
+   template<typename T, typename A>
+   void DirectedGraph<T, CSRStorage, A>::clear()
+   {
+      values_.clear();
+      offsets_.clear();
+      targets_.clear();
+      reverse_offsets_.clear();
+      sources_.clear();
+   }
+   
+   /**
+    * Connects a directed edge from the specified starting node to the specified
+    * ending node in this directed graph.<p>
+    *
+    * The function automatically checks whether <code>from</code> and
+    * <code>to</code> are greater than or equal to the number of nodes in the
+    * directed graph, throwing an <code>std::out_of_range</code> exception if it
+    * is not.
+    *
+    * @param from   the position of the starting node
+    * @param to     the position of the ending node
+    *
+    * @throws std::out_of_range if either <code>from</code> or <code>to</code>
+    * is out of bounds
+    */
+   template<typename T, typename A>
+   void DirectedGraph<T, CSRStorage, A>::connect(const size_t& from,
+      const size_t& to)
+   {
+      // Tests if the starting and ending node indices are valid.
+      test_index(from, "Invalid starting node index in directed graph: ");
+      test_index(to, "Invalid ending node index in directed graph: ");
+      
+      insert_edge(offsets_, targets_, from, to);
+      insert_edge(reverse_offsets_, sources_, to, from);
+   }
+   
+   /**
+    * Connects a directed edge for each (starting node, ending node) pair of
+    * positions in the range [<code>first</code>, <code>last</code>) in this
+    * directed graph. The compressed sparse rows are rebuilt once with a
+    * counting sort, so connecting <i>B</i> directed edges at once runs in
+    * O(<i>V</i> + <i>E</i> + <i>B</i>) time.<p>
+    *
+    * The function automatically checks whether any position in the range is
+    * greater than or equal to the number of nodes in the directed graph,
+    * throwing an <code>std::out_of_range</code> exception if it is. In that
+    * case, no directed edge is connected.
+    *
+    * @param first   the iterator to the first pair of positions
+    * @param last    the iterator past the last pair of positions
+    *
+    * @throws std::out_of_range if any position in the range is out of bounds
+    */
+   template<typename T, typename A>
+   template<typename InputIterator>
+   void DirectedGraph<T, CSRStorage, A>::connect_bulk(InputIterator first,
+      InputIterator last)
+   {
+      Indices heads(offsets_.get_allocator());
+      Indices tails(offsets_.get_allocator());
+      
+      // Tests if the starting and ending node indices are valid.
+      for (; first != last; ++first)
+      {
+         const size_t from = (*first).first;
+         const size_t to = (*first).second;
+         test_index(from, "Invalid starting node index in directed graph: ");
+         test_index(to, "Invalid ending node index in directed graph: ");
+         heads.push_back(from);
+         tails.push_back(to);
+      }
+      
+      insert_edges(offsets_, targets_, heads, tails);
+      insert_edges(reverse_offsets_, sources_, tails, heads);
+   }
+   
+   /**
+    * Connects a directed edge for each (starting node, ending node) pair of
+    * positions in the specified initializer list in this directed graph.<p>
+    *
+    * The function automatically checks whether any position in the list is
+    * greater than or equal to the number of nodes in the directed graph,
+    * throwing an <code>std::out_of_range</code> exception if it is. In that
+    * case, no directed edge is connected.
+    *
+    * @param il   the initializer list of pairs of positions
+    *
+    * @throws std::out_of_range if any position in the list is out of bounds
+    */
+   template<typename T, typename A>
+   inline void DirectedGraph<T, CSRStorage, A>::connect_bulk(
+      const std::initializer_list<std::pair<size_t, size_t>> il)
+   {
+      connect_bulk(il.begin(), il.end());
+   }
+   
+   /**
+    * Removes the multiple directed edges in this directed graph, so that at
+    * most one directed edge is left from each starting node to each ending
+    * node. The directed edge that was connected first is kept, and the order
+    * of the others is unchanged. The function takes linear time in the number
+    * of nodes and directed edges.
+    */
+   template<typename T, typename A>
+   void DirectedGraph<T, CSRStorage, A>::dedupe_edges()
+   {
+      remove_duplicates(offsets_, targets_);
+      remove_duplicates(reverse_offsets_, sources_);
+   }
+   
+   /**
+    * Disconnects all head nodes and all tail nodes adjacent to the node at
+    * position <i>k</i> in this directed graph.<p>
+    *
+    * The function automatically checks whether <i>k</i> is greater than or
+    * equal to the number of nodes in the directed graph, throwing an
+    * <code>std::out_of_range</code> exception if it is not.
+    *
+    * @param k   the position of the node
+    *
+    * @throws std::out_of_range if <i>k</i> is out of bounds
+    */
+   template<typename T, typename A>
+   void DirectedGraph<T, CSRStorage, A>::disconnect(const size_t& k)
+   {
+      // Tests if k is valid.
+      test_index(k, "Invalid node index in directed graph: ");
+      
+      remove_node(offsets_, targets_, k);
+      remove_node(reverse_offsets_, sources_, k);
+   }
+   
+   /**
+    * Disconnects a directed edge from the specified starting node to the
+    * specified ending node in this directed graph.<p>
+    *
+    * The function automatically checks whether <code>from</code> and
+    * <code>to</code> are greater than or equal to the number of nodes in the
+    * directed graph, throwing an <code>std::out_of_range</code> exception if it
+    * is not.
+    *
+    * @param from   the position of the starting node
+    * @param to     the position of the ending node
+    *
+    * @throws std::out_of_range if either <code>from</code> or <code>to</code>
+    * is out of bounds
+    */
+   template<typename T, typename A>
+   void DirectedGraph<T, CSRStorage, A>::disconnect(const size_t& from,
+      const size_t& to)
+   {
+      // Tests if the starting and ending node indices are valid.
+      test_index(from, "Invalid starting node index in directed graph: ");
+      test_index(to, "Invalid ending node index in directed graph: ");
+      
+      if (remove_edge(offsets_, targets_, from, to))
+         remove_edge(reverse_offsets_, sources_, to, from);
+   }
+   
+   /**
+    * Adds a node to this directed graph, after its current last node. The
+    * value of the new node is constructed in place from the specified
+    * arguments.
+    *
+    * @param args   the arguments with which to construct the value
+    */
+   template<typename T, typename A>
+   template<typename... Args>
+   void DirectedGraph<T, CSRStorage, A>::emplace_back(Args&&... args)
+   {
+      values_.emplace_back(std::forward<Args>(args)...);
+      
+      if (offsets_.empty())
+      {
+         offsets_.push_back(0);
+         reverse_offsets_.push_back(0);
+      }
+      
+      offsets_.push_back(offsets_.back());
+      reverse_offsets_.push_back(reverse_offsets_.back());
+   }
+   
+   /**
+    * Removes the node at position <i>k</i> from this directed graph. The nodes
+    * after position <i>k</i> are moved down by one position, and the directed
+    * edges between them are kept.<p>
+    *
+    * The function automatically checks whether <i>k</i> is greater than or
+    * equal to the number of nodes in the directed graph, throwing an
+    * <code>std::out_of_range</code> exception if it is not.
+    *
+    * @param k   the position of the node
+    *
+    * @throws std::out_of_range if <i>k</i> is out of bounds
+    */
+   template<typename T, typename A>
+   void DirectedGraph<T, CSRStorage, A>::erase(const size_t& k)
+   {
+      // Tests if k is valid.
+      test_index(k, "Invalid node index in directed graph: ");
+      
+      disconnect(k);
+      values_.erase(values_.begin() + k);
+      offsets_.erase(offsets_.begin() + k);
+      reverse_offsets_.erase(reverse_offsets_.begin() + k);
+      
+      // Renumbers the nodes after the removed node.
+      for (auto& element : targets_) if (element > k) element--;
+      for (auto& element : sources_) if (element > k) element--;
+      
+      if (values_.empty())
+      {
+         offsets_.clear();
+         reverse_offsets_.clear();
+      }
+   }
+   
+   /**
+    * Returns a reference to the value of the first node in this directed graph.
+    *
+    * @return a reference to the value of the first node
+    *
+    * @throws std::out_of_range if this directed graph is empty
+    */
+   template<typename T, typename A>
+   T& DirectedGraph<T, CSRStorage, A>::front()
+   {
+      // Tests if the directed graph is empty.
+      if (empty()) throw std::out_of_range("Empty directed graph");
+      
+      return values_.front();
+   }
+   
+   /**
+    * Returns a reference to the value of the node at position <i>k</i> in this
+    * directed graph.
+    *
+    * @param k   the position of the node
+    *
+    * @return a reference to the value of the node at position <i>k</i>
+    */
+   template<typename T, typename A>
+   inline T& DirectedGraph<T, CSRStorage, A>::operator[](const size_t& k)
+   {
+      return values_[k];
+   }
+   
+   /**
+    * Adds a node with the specified value to this directed graph, after its
+    * current last node.
+    *
+    * @param val   the value of the new node
+    */
+   template<typename T, typename A>
+   inline void DirectedGraph<T, CSRStorage, A>::push_back(const T& val)
+   {
+      emplace_back(val);
+   }
+   
+   /**
+    * Adds a node with the specified value to this directed graph, after its
+    * current last node. The value is moved into the new node.
+    *
+    * @param val   the value of the new node
+    */
+   template<typename T, typename A>
+   inline void DirectedGraph<T, CSRStorage, A>::push_back(T&& val)
+   {
+      emplace_back(std::move(val));
+   }
+   
+   /**
+    * Removes every loop (directed edge from a node to itself) in this directed
+    * graph, in linear time in the number of nodes and directed edges.
+    */
+   template<typename T, typename A>
+   void DirectedGraph<T, CSRStorage, A>::remove_self_loops()
+   {
+      remove_loops(offsets_, targets_);
+      remove_loops(reverse_offsets_, sources_);
+   }
+   
+   /**
+    * Reserves memory for at least the specified numbers of nodes and directed
+    * edges, so that adding up to that many of each does not reallocate any
+    * of the vectors of this directed graph.
+    *
+    * @param nodes   the number of nodes
+    * @param edges   the number of directed edges
+    */
+   template<typename T, typename A>
+   void DirectedGraph<T, CSRStorage, A>::reserve(const size_t& nodes,
+      const size_t& edges)
+   {
+      values_.reserve(nodes);
+      offsets_.reserve(nodes + 1);
+      reverse_offsets_.reserve(nodes + 1);
+      targets_.reserve(edges);
+      sources_.reserve(edges);
+   }
+   
+   /**
+    * Exchanges the content of this directed graph with the content of the
+    * specified directed graph. No node or directed edge is copied or
+    * allocated.
+    *
+    * @param rhs   the directed graph to be swapped
+    */
+   template<typename T, typename A>
+   void DirectedGraph<T, CSRStorage, A>::swap(DirectedGraph& rhs) noexcept
+   {
+      values_.swap(rhs.values_);
+      offsets_.swap(rhs.offsets_);
+      targets_.swap(rhs.targets_);
+      reverse_offsets_.swap(rhs.reverse_offsets_);
+      sources_.swap(rhs.sources_);
+   }
+   
+   /**
+    * Returns a snapshot of the directed edges in this directed graph, with the
+    * tail nodes of each node in the order in which they were connected. The
+    * snapshot is not updated when this directed graph is modified.
+    *
+    * @return the adjacency of this directed graph
+    */
+   template<typename T, typename A>
+   Adjacency DirectedGraph<T, CSRStorage, A>::adjacency() const
+   {
+      Adjacency result;
+      
+      // The arrays are already grouped by node, so they are copied as is.
+      if (!empty())
+      {
+         result.offsets_.assign(offsets_.begin(), offsets_.end());
+         result.targets_.assign(targets_.begin(), targets_.end());
+         result.reverse_offsets_.assign(reverse_offsets_.begin(),
+            reverse_offsets_.end());
+         result.sources_.assign(sources_.begin(), sources_.end());
+      }
+      
+      return result;
+   }
+   
+   /**
+    * Returns the value of the node at position <i>k</i> in this directed
+    * graph.<p>
+    *
+    * The function automatically checks whether <i>k</i> is within the bounds of
+    * valid positions in the directed graph, throwing an
+    * <code>std::out_of_range</code> exception if it is not (i.e., if <i>k</i>
+    * is greater than or equal to the number of nodes in the directed graph).
+    * This is in contrast with member <code>operator[]</code>, which does not
+    * check against bounds.
+    *
+    * @param k   the position of the node
+    *
+    * @return the value of the node at position <i>k</i>
+    *
+    * @throws std::out_of_range if <i>k</i> is out of bounds
+    */
+   template<typename T, typename A>
+   T DirectedGraph<T, CSRStorage, A>::at(const size_t& k) const
+   {
+      // Tests if k is valid.
+      test_index(k, "Invalid node index in directed graph: ");
+      
+      return values_[k];
+   }
+   
+   /**
+    * Returns the number of directed edges from the specified starting node to
+    * the specified ending node in this directed graph. The function scans the
+    * shorter of the row of tail nodes of the starting node and the row of head
+    * nodes of the ending node.<p>
+    *
+    * The function automatically checks whether <code>from</code> and
+    * <code>to</code> are greater than or equal to the number of nodes in the
+    * directed graph, throwing an <code>std::out_of_range</code> exception if it
+    * is not.
+    *
+    * @param from   the position of the starting node
+    * @param to     the position of the ending node
+    *
+    * @return the number of directed edges
+    *
+    * @throws std::out_of_range if either <code>from</code> or <code>to</code>
+    * is out of bounds
+    */
+   template<typename T, typename A>
+   size_t DirectedGraph<T, CSRStorage, A>::edge_count(const size_t& from,
+      const size_t& to) const
+   {
+      // Tests if the starting and ending node indices are valid.
+      test_index(from, "Invalid starting node index in directed graph: ");
+      test_index(to, "Invalid ending node index in directed graph: ");
+      
+      if (offsets_[from + 1] - offsets_[from]
+          <= reverse_offsets_[to + 1] - reverse_offsets_[to])
+      {
+         return std::count(targets_.begin() + offsets_[from],
+            targets_.begin() + offsets_[from + 1], to);
+      }
+      
+      return std::count(sources_.begin() + reverse_offsets_[to],
+         sources_.begin() + reverse_offsets_[to + 1], from);
+   }
+   
+   /**
+    * Tests if this directed graph is empty (i.e., if the directed graph
+    * contains no nodes).
+    *
+    * @return <code>true</code> if this directed graph is empty, or
+    * <code>false</code> otherwise
+    */
+   template<typename T, typename A>
+   inline bool DirectedGraph<T, CSRStorage, A>::empty() const
+   {
+      return values_.empty();
+   }
+   
+   /**
+    * Returns the value of the first node in this directed graph.
+    *
+    * @return the value of the first node
+    *
+    * @throws std::out_of_range if this directed graph is empty
+    */
+   template<typename T, typename A>
+   T DirectedGraph<T, CSRStorage, A>::front() const
+   {
+      // Tests if the directed graph is empty.
+      if (empty()) throw std::out_of_range("Empty directed graph");
+      
+      return values_.front();
+   }
+   
+   /**
+    * Returns a copy of the allocator with which this directed graph allocates
+    * its memory.
+    *
+    * @return the allocator
+    */
+   template<typename T, typename A>
+   inline A DirectedGraph<T, CSRStorage, A>::get_allocator() const
+   {
+      return values_.get_allocator();
+   }
+   
+   /**
+    * Tests if this directed graph has a directed edge from the specified
+    * starting node to the specified ending node. The function scans the
+    * shorter of the row of tail nodes of the starting node and the row of head
+    * nodes of the ending node.<p>
+    *
+    * The function automatically checks whether <code>from</code> and
+    * <code>to</code> are greater than or equal to the number of nodes in the
+    * directed graph, throwing an <code>std::out_of_range</code> exception if it
+    * is not.
+    *
+    * @param from   the position of the starting node
+    * @param to     the position of the ending node
+    *
+    * @return <code>true</code> if the directed edge exists, or
+    * <code>false</code> otherwise
+    *
+    * @throws std::out_of_range if either <code>from</code> or <code>to</code>
+    * is out of bounds
+    */
+   template<typename T, typename A>
+   bool DirectedGraph<T, CSRStorage, A>::has_edge(const size_t& from,
+      const size_t& to) const
+   {
+      // Tests if the starting and ending node indices are valid.
+      test_index(from, "Invalid starting node index in directed graph: ");
+      test_index(to, "Invalid ending node index in directed graph: ");
+      
+      if (offsets_[from + 1] - offsets_[from]
+          <= reverse_offsets_[to + 1] - reverse_offsets_[to])
+      {
+         const auto last = targets_.begin() + offsets_[from + 1];
+         return std::find(targets_.begin() + offsets_[from], last, to) != last;
+      }
+      
+      const auto last = sources_.begin() + reverse_offsets_[to + 1];
+      const auto first = sources_.begin() + reverse_offsets_[to];
+      return std::find(first, last, from) != last;
+   }
+   
+   /**
+    * Returns the <b>indegree</b> of the node at position <i>k</i> in this
+    * directed graph (i.e., the number of head nodes adjacent to the node at
+    * position <i>k</i>).<p>
+    *
+    * The function automatically checks whether <i>k</i> is greater than or
+    * equal to the number of nodes in the directed graph, throwing an
+    * <code>std::out_of_range</code> exception if it is not.
+    *
+    * @param k   the position of the node
+    *
+    * @return the indegree
+    *
+    * @throws std::out_of_range if <i>k</i> is out of bounds
+    */
+   template<typename T, typename A>
+   size_t DirectedGraph<T, CSRStorage, A>::indegree(const size_t& k) const
+   {
+      // Tests if k is valid.
+      test_index(k, "Invalid node index in directed graph: ");
+      
+      return reverse_offsets_[k + 1] - reverse_offsets_[k];
+   }
+   
+   /**
+    * Returns the value of the node at position <i>k</i> in this directed graph.
+    *
+    * @param k   the position of the node
+    *
+    * @return the value of the node at position <i>k</i>
+    */
+   template<typename T, typename A>
+   inline T DirectedGraph<T, CSRStorage, A>::operator[](const size_t& k) const
+   {
+      return values_[k];
+   }
+   
+   /**
+    * Returns the <b>outdegree</b> of the node at position <i>k</i> in this
+    * directed graph (i.e., the number of tail nodes adjacent to the node at
+    * position <i>k</i>).<p>
+    *
+    * The function automatically checks whether <i>k</i> is greater than or
+    * equal to the number of nodes in the directed graph, throwing an
+    * <code>std::out_of_range</code> exception if it is not.
+    *
+    * @param k   the position of the node
+    *
+    * @return the outdegree
+    *
+    * @throws std::out_of_range if <i>k</i> is out of bounds
+    */
+   template<typename T, typename A>
+   size_t DirectedGraph<T, CSRStorage, A>::outdegree(const size_t& k) const
+   {
+      // Tests if k is valid.
+      test_index(k, "Invalid node index in directed graph: ");
+      
+      return offsets_[k + 1] - offsets_[k];
+   }
+   
+   /**
+    * Tests if this directed graph is simple, that is, if the directed graph has
+    * no loops and no multiple directed edges (edges with the same starting and
+    * ending nodes). Each ending node is marked with the last starting node
+    * that reached it, so the test takes linear time.
+    *
+    * @return <code>true</code> if this directed graph is simple, or
+    * <code>false</code> otherwise
+    */
+   template<typename T, typename A>
+   bool DirectedGraph<T, CSRStorage, A>::simple() const
+   {
+      Indices marks(size(), static_cast<size_t>(-1), offsets_.get_allocator());
+      
+      for (size_t i = 0; i < size(); i++)
+      {
+         for (size_t j = offsets_[i]; j < offsets_[i + 1]; j++)
+         {
+            // Tests if the current node has a loop or a multiple directed edge.
+            if (targets_[j] == i || marks[targets_[j]] == i) return false;
+            marks[targets_[j]] = i;
+         }
+      }
+      
+      return true;
+   }
+   
+   /**
+    * Returns the number of nodes in this directed graph.
+    *
+    * @return the number of nodes
+    */
+   template<typename T, typename A>
+   inline size_t DirectedGraph<T, CSRStorage, A>::size() const
+   {
+      return values_.size();
+   }
+   
+   /**
+    * Tests if this directed graph and the specified directed graph are equal.
+    *
+    * @param rhs   the directed graph to compare with this directed graph
+    *
+    * @return <code>true</code> if this directed graph and the specified
+    * directed graph are equal, or <code>false</code> otherwise
+    */
+   template<typename T, typename A>
+   bool DirectedGraph<T, CSRStorage, A>
+      ::operator==(const DirectedGraph& rhs) const
+   {
+      // Tests if the two directed graphs have the same directed edges.
+      if (offsets_ != rhs.offsets_ || targets_ != rhs.targets_) return false;
+      
+      // Tests if the two directed graphs have the same nodes.
+      for (size_t i = 0; i < size(); i++)
+         if (values_[i] != rhs.values_[i]) return false;
+      
+      return true;
+   }
+   
+   /**
+    * Tests if this directed graph and the specified directed graph are unequal.
+    *
+    * @param rhs   the directed graph to compare with this directed graph
+    *
+    * @return <code>true</code> if this directed graph and the specified
+    * directed graph are unequal, or <code>false</code> otherwise
+    */
+   template<typename T, typename A>
+   inline bool DirectedGraph<T, CSRStorage, A>
+      ::operator!=(const DirectedGraph& rhs) const
+   {
+      return !(*this == rhs);
+   }
+   
+   /**
+    * Tests if <i>k</i> is within the bounds of valid positions in the directed
+    * graph, throwing an <code>std::out_of_range</code> exception if it is not
+    * (i.e., if <i>k</i> is greater than or equal to the number of nodes in the
+    * directed graph).
+    *
+    * @param k       the position of the node
+    * @param error   the error message
+    *
+    * @throws std::out_of_range if <i>k</i> is out of bounds
+    */
+   template<typename T, typename A>
+   void DirectedGraph<T, CSRStorage, A>::test_index(const size_t& k,
+      const char* error) const
+   {
+      if (k >= size()) throw_index_error(error, k);
+   }
+   
+   /**
+    * Appends the specified column to the end of the specified row of a
+    * compressed sparse row array.
+    *
+    * @param offsets   the offsets at which each row begins
+    * @param columns   the columns of all the rows
+    * @param row       the row
+    * @param column    the column to append
+    */
+   template<typename T, typename A>
+   void DirectedGraph<T, CSRStorage, A>::insert_edge(Indices& offsets,
+      Indices& columns, const size_t& row, const size_t& column)
+   {
+      columns.insert(columns.begin() + offsets[row + 1], column);
+      
+      for (size_t i = row + 1; i < offsets.size(); i++) offsets[i]++;
+   }
+   
+   /**
+    * Appends each of the specified columns to the end of its row of a
+    * compressed sparse row array, in order. The array is rebuilt once by a
+    * counting sort on the rows.
+    *
+    * @param offsets   the offsets at which each row begins
+    * @param columns   the columns of all the rows
+    * @param rows      the row of each column to append
+    * @param cols      the columns to append
+    */
+   template<typename T, typename A>
+   void DirectedGraph<T, CSRStorage, A>::insert_edges(Indices& offsets,
+      Indices& columns, const Indices& rows, const Indices& cols)
+   {
+      if (rows.empty()) return;
+      
+      // Counts the new columns in each row.
+      Indices result(offsets.size(), 0, offsets.get_allocator());
+      
+      for (const auto& element : rows) result[element + 1]++;
+      
+      for (size_t i = 1; i < result.size(); i++)
+         result[i] += result[i - 1] + offsets[i] - offsets[i - 1];
+      
+      // Moves the old columns of each row, then appends the new ones.
+      Indices sorted(columns.size() + cols.size(), 0, columns.get_allocator());
+      Indices position(offsets.size() - 1, 0, offsets.get_allocator());
+      
+      for (size_t i = 0; i < position.size(); i++)
+      {
+         position[i] = std::copy(columns.begin() + offsets[i],
+            columns.begin() + offsets[i + 1], sorted.begin() + result[i])
+            - sorted.begin();
+      }
+      
+      for (size_t i = 0; i < rows.size(); i++)
+         sorted[position[rows[i]]++] = cols[i];
+      
+      offsets.swap(result);
+      columns.swap(sorted);
+   }
+   
+   /**
+    * Removes every column after the first occurrence of each column within
+    * each row of a compressed sparse row array, compacting the array in place.
+    * Each column is marked with the last row in which it was seen, so the
+    * function takes linear time.
+    *
+    * @param offsets   the offsets at which each row begins
+    * @param columns   the columns of all the rows
+    */
+   template<typename T, typename A>
+   void DirectedGraph<T, CSRStorage, A>::remove_duplicates(Indices& offsets,
+      Indices& columns)
+   {
+      if (offsets.empty()) return;
+      
+      Indices marks(offsets.size() - 1, static_cast<size_t>(-1),
+         offsets.get_allocator());
+      size_t count = 0;
+      
+      for (size_t i = 0; i + 1 < offsets.size(); i++)
+      {
+         const size_t first = offsets[i];
+         const size_t last = offsets[i + 1];
+         offsets[i] = count;
+         
+         for (size_t j = first; j < last; j++)
+         {
+            if (marks[columns[j]] == i) continue;
+            
+            marks[columns[j]] = i;
+            columns[count++] = columns[j];
+         }
+      }
+      
+      offsets.back() = count;
+      columns.resize(count);
+   }
+   
+   /**
+    * Removes the rightmost occurrence of the specified column from the
+    * specified row of a compressed sparse row array.
+    *
+    * @param offsets   the offsets at which each row begins
+    * @param columns   the columns of all the rows
+    * @param row       the row
+    * @param column    the column to remove
+    *
+    * @return <code>true</code> if the column was found, or <code>false</code>
+    * otherwise
+    */
+   template<typename T, typename A>
+   bool DirectedGraph<T, CSRStorage, A>::remove_edge(Indices& offsets,
+      Indices& columns, const size_t& row, const size_t& column)
+   {
+      for (size_t i = offsets[row + 1]; i > offsets[row]; i--)
+      {
+         if (columns[i - 1] == column)
+         {
+            columns.erase(columns.begin() + i - 1);
+            
+            for (size_t j = row + 1; j < offsets.size(); j++) offsets[j]--;
+            
+            return true;
+         }
+      }
+      
+      return false;
+   }
+   
+   /**
+    * Removes column <i>k</i> from each row <i>k</i> of a compressed sparse row
+    * array, compacting the array in place.
+    *
+    * @param offsets   the offsets at which each row begins
+    * @param columns   the columns of all the rows
+    */
+   template<typename T, typename A>
+   void DirectedGraph<T, CSRStorage, A>::remove_loops(Indices& offsets,
+      Indices& columns)
+   {
+      if (offsets.empty()) return;
+      
+      size_t count = 0;
+      
+      for (size_t i = 0; i + 1 < offsets.size(); i++)
+      {
+         const size_t first = offsets[i];
+         const size_t last = offsets[i + 1];
+         offsets[i] = count;
+         
+         for (size_t j = first; j < last; j++)
+            if (columns[j] != i) columns[count++] = columns[j];
+      }
+      
+      offsets.back() = count;
+      columns.resize(count);
+   }
+   
+   /**
+    * Empties row <i>k</i> of a compressed sparse row array and removes column
+    * <i>k</i> from every other row, compacting the array in place.
+    *
+    * @param offsets   the offsets at which each row begins
+    * @param columns   the columns of all the rows
+    * @param k         the row and column to remove
+    */
+   template<typename T, typename A>
+   void DirectedGraph<T, CSRStorage, A>::remove_node(Indices& offsets,
+      Indices& columns, const size_t& k)
+   {
+      size_t count = 0;
+      
+      for (size_t i = 0; i + 1 < offsets.size(); i++)
+      {
+         const size_t first = offsets[i];
+         const size_t last = offsets[i + 1];
+         offsets[i] = count;
+         
+         if (i == k) continue;
+         
+         for (size_t j = first; j < last; j++)
+            if (columns[j] != k) columns[count++] = columns[j];
+      }
+      
+      offsets.back() = count;
+      columns.resize(count);
+   }
+   
+   /**
+    * Returns a vector of values with the specified allocator that takes over
+    * the buffer of the specified vector, if the allocators are equal.
+    *
+    * @param v       the vector of values
+    * @param alloc   the allocator
+    *
+    * @return the vector of values
+    */
+   template<typename T, typename A>
+   inline std::vector<T, A> DirectedGraph<T, CSRStorage, A>
+      ::take_values(std::vector<T, A>&& v, const A& alloc)
+   {
+      return std::vector<T, A>(std::move(v), alloc);
+   }
+   
+   /**
+    * Returns a vector of values with the specified allocator into which each
+    * of the values in the specified vector is moved.
+    *
+    * @param v       the vector of values
+    * @param alloc   the allocator
+    *
+    * @return the vector of values
+    */
+   template<typename T, typename A>
+   template<typename V>
+   inline std::vector<T, A> DirectedGraph<T, CSRStorage, A>
+      ::take_values(V&& v, const A& alloc)
+   {
+      return std::vector<T, A>(std::make_move_iterator(v.begin()),
+         std::make_move_iterator(v.end()), alloc);
+   }
+   
+   /** Constructs an iterator that does not point into any directed graph. */
+   template<typename T, typename A>
+   inline DirectedGraph<T, CSRStorage, A>::Iterator::Iterator()
+      : position_(0), container_(nullptr) {}
+   
+   /** Destroys this iterator. */
+   template<typename T, typename A>
+   inline DirectedGraph<T, CSRStorage, A>::Iterator::~Iterator() {}
+   
+   /**
+    * Moves this iterator to the <i>k</i><sup>th</sup> tail node.<p>
+    *
+    * The function automatically checks whether <i>k</i> is greater than or
+    * equal to the outdegree of the node to which this iterator points, throwing
+    * an <code>std::out_of_range</code> exception if it is not.
+    *
+    * @param k    the tail node index
+    *
+    * @throws std::logic_error if this iterator does not point into any directed
+    * graph
+    * @throws std::out_of_range if <i>k</i> is out of bounds
+    */
+   template<typename T, typename A>
+   void DirectedGraph<T, CSRStorage, A>::Iterator::next(const size_t& k)
+   {
+      // Tests if this iterator points into a directed graph.
+      if (container_ == nullptr)
+         throw std::logic_error("Iterator does not point to a directed graph");
+      
+      // Tests if k is valid.
+      if (k >= outdegree())
+         throw_index_error("Invalid tail node index for iterator: ", k);
+      
+      position_ = container_ -> targets_[container_ -> offsets_[position_] + k];
+   }
+   
+   /**
+    * Returns a reference to the value at the current position of this iterator.
+    *
+    * @return a reference to the value of the node to which this iterator points
+    *
+    * @throws std::logic_error if this iterator does not point into any directed
+    * graph
+    */
+   template<typename T, typename A>
+   T& DirectedGraph<T, CSRStorage, A>::Iterator::operator*()
+   {
+      // Tests if this iterator points into a directed graph.
+      if (container_ == nullptr)
+         throw std::logic_error("Iterator does not point to a directed graph");
+      
+      return container_ -> values_[position_];
+   }
+   
+   /**
+    * Moves this iterator to the <i>k</i><sup>th</sup> head node. The order of
+    * the head nodes of a node is unspecified.<p>
+    *
+    * The function automatically checks whether <i>k</i> is greater than or
+    * equal to the indegree of the node to which this iterator points, throwing
+    * an <code>std::out_of_range</code> exception if it is not.
+    *
+    * @param k    the head node index
+    *
+    * @throws std::logic_error if this iterator does not point into any directed
+    * graph
+    * @throws std::out_of_range if <i>k</i> is out of bounds
+    */
+   template<typename T, typename A>
+   void DirectedGraph<T, CSRStorage, A>::Iterator::prev(const size_t& k)
+   {
+      // Tests if this iterator points into a directed graph.
+      if (container_ == nullptr)
+         throw std::logic_error("Iterator does not point to a directed graph");
+      
+      // Tests if k is valid.
+      if (k >= indegree())
+         throw_index_error("Invalid head node index for iterator: ", k);
+      
+      const size_t first = container_ -> reverse_offsets_[position_];
+      position_ = container_ -> sources_[first + k];
+   }
+   
+   /**
+    * Returns the indegree at the current position of this iterator.
+    *
+    * @return the indegree of the node to which this iterator points
+    *
+    * @throws std::logic_error if this iterator does not point into any directed
+    * graph
+    */
+   template<typename T, typename A>
+   size_t DirectedGraph<T, CSRStorage, A>::Iterator::indegree() const
+   {
+      // Tests if this iterator points into a directed graph.
+      if (container_ == nullptr)
+         throw std::logic_error("Iterator does not point to a directed graph");
+      
+      const Indices& offsets = container_ -> reverse_offsets_;
+      return offsets[position_ + 1] - offsets[position_];
+   }
+   
+   /**
+    * Returns the value at the current position of this iterator.
+    *
+    * @return the value of the node to which this iterator points
+    *
+    * @throws std::logic_error if this iterator does not point into any directed
+    * graph
+    */
+   template<typename T, typename A>
+   T DirectedGraph<T, CSRStorage, A>::Iterator::operator*() const
+   {
+      // Tests if this iterator points into a directed graph.
+      if (container_ == nullptr)
+         throw std::logic_error("Iterator does not point to a directed graph");
+      
+      return container_ -> values_[position_];
+   }
+   
+   /**
+    * Returns a pointer to the value at the current position of this iterator.
+    *
+    * @return a pointer to the value of the node to which this iterator points
+    *
+    * @throws std::logic_error if this iterator does not point into any directed
+    * graph
+    */
+   template<typename T, typename A>
+   T* DirectedGraph<T, CSRStorage, A>::Iterator::operator->() const
+   {
+      // Tests if this iterator points into a directed graph.
+      if (container_ == nullptr)
+         throw std::logic_error("Iterator does not point to a directed graph");
+      
+      return &container_ -> values_[position_];
+   }
+   
+   /**
+    * Returns the outdegree at the current position of this iterator.
+    *
+    * @return the outdegree of the node to which this iterator points
+    *
+    * @throws std::logic_error if this iterator does not point into any directed
+    * graph
+    */
+   template<typename T, typename A>
+   size_t DirectedGraph<T, CSRStorage, A>::Iterator::outdegree() const
+   {
+      // Tests if this iterator points into a directed graph.
+      if (container_ == nullptr)
+         throw std::logic_error("Iterator does not point to a directed graph");
+      
+      const Indices& offsets = container_ -> offsets_;
+      return offsets[position_ + 1] - offsets[position_];
+   }
+   
+   /**
+    * Tests if this iterator and the specified iterator are equal.
+    *
+    * @param rhs   the iterator to compare with this iterator
+    *
+    * @return <code>true</code> if this iterator and the specified iterator are
+    * equal, or <code>false</code> otherwise
+    */
+   template<typename T, typename A>
+   inline bool DirectedGraph<T, CSRStorage, A>::Iterator
+      ::operator==(const Iterator& rhs) const
+   {
+      return container_ == rhs.container_ && position_ == rhs.position_;
+   }
+   
+   /**
+    * Tests if this iterator and the specified iterator are unequal.
+    *
+    * @param rhs   the iterator to compare with this iterator
+    *
+    * @return <code>true</code> if this iterator and the specified iterator are
+    * unequal, or <code>false</code> otherwise
+    */
+   template<typename T, typename A>
+   inline bool DirectedGraph<T, CSRStorage, A>::Iterator
+      ::operator!=(const Iterator& rhs) const
+   {
+      return !(*this == rhs);
+   }
+   
+   /**
+    * Outputs the specified directed graph with the specified output stream.
+    * The output stream is not flushed; <code>GraphWriter</code> writes large
+    * directed graphs faster.
+    *
+    * @param out   the output stream
+    * @param rhs   the directed graph to be outputted
+    *
+    * @return the stream after the output
+    */
+   template<typename T, typename A>
+   std::ostream& operator<<(std::ostream& out,
+      const DirectedGraph<T, CSRStorage, A>& rhs)
+   {
+      for (size_t i = 0; i < rhs.size(); i++)
+      {
+         // Outputs the current node by itself if it is disconnected.
+         if (rhs.offsets_[i] == rhs.offsets_[i + 1]
+             && rhs.reverse_offsets_[i] == rhs.reverse_offsets_[i + 1])
+            out << rhs.values_[i] << '\n';
+         
+         // Outputs the starting and ending nodes for each directed edge.
+         else
+         {
+            for (size_t j = rhs.offsets_[i]; j < rhs.offsets_[i + 1]; j++)
+            {
+               out << rhs.values_[i] << " -> " << rhs.values_[rhs.targets_[j]]
+                  << '\n';
+            }
+         }
+      }
+      
+      return out;
+   }
+}
+
+#endif   // PIC_10C_CSR_DIRECTED_GRAPH_H_
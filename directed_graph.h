@@ -22,7 +22,20 @@
 #include <algorithm>
 #include <memory>
 #include <initializer_list>
-#include "boost/lexical_cast.hpp"
+#include <utility>
+#include <iterator>
+#include <functional>
+#include <thread>
+#include <system_error>
+#include <unordered_map>
+#include "adjacency.h"
+#include "index_error.h"
+#include "graph_stats.h"
+#include "graph_reordering.h"
+
+#if __cplusplus >= 201703L
+#include <memory_resource>
+#endif
 
 /**
  * The <code>Kris_Torres_UCLA_PIC_10C_Winter_2014</code> namespace contains the
@@ -31,91 +44,277 @@
  */
 namespace Kris_Torres_UCLA_PIC_10C_Winter_2014
 {
+   /**
+    * The <code>LinkedStorage</code> storage policy keeps each node of a
+    * directed graph in its own heap allocation, with every node holding
+    * pointers to its tail nodes. This is the default storage policy of the
+    * <code>DirectedGraph</code> class.
+    */
+   struct LinkedStorage final {};
+   
+   /**
+    * The <code>CSRStorage</code> storage policy keeps a directed graph in
+    * <i>compressed sparse row</i> form: the values of the nodes, the row
+    * offsets, and the positions of the tail nodes are each stored in one
+    * contiguous array, so that scanning the tail nodes of a node is a
+    * sequential memory read. The storage policy is defined in
+    * <code>csr_directed_graph.h</code>.
+    */
+   struct CSRStorage final {};
+   
+   /**
+    * The <code>MappedStorage</code> storage policy serves a read-only
+    * directed graph straight out of a memory-mapped binary directed graph
+    * file, without parsing the file or allocating any node. The storage
+    * policy is defined in <code>mapped_directed_graph.h</code>.
+    */
+   struct MappedStorage final {};
+   
+   /**
+    * The <code>StableStorage</code> storage policy names the nodes of a
+    * directed graph by handles that stay valid while other nodes are inserted
+    * and erased. Erasing a node leaves a tombstone that is reused by a later
+    * node, until the directed graph is compacted. The storage policy is
+    * defined in <code>stable_directed_graph.h</code>.
+    */
+   struct StableStorage final {};
+   
+   /**
+    * The <code>SharedStorage</code> storage policy makes every copy of a
+    * directed graph share its nodes until one of the copies modifies them, so
+    * copies and snapshots take constant time. The storage policy is defined in
+    * <code>shared_directed_graph.h</code>.
+    */
+   struct SharedStorage final {};
+   
+   /**
+    * The <code>BitsetStorage</code> storage policy keeps the directed edges
+    * of a directed graph in a packed adjacency matrix, one bit for each
+    * ordered pair of nodes, which suits small, dense directed graphs. The
+    * storage policy is defined in <code>bitset_directed_graph.h</code>.
+    */
+   struct BitsetStorage final {};
+   
+   /**
+    * The <code>CompressedStorage</code> storage policy keeps the directed
+    * edges of a read-optimized directed graph as sorted tail nodes, with the
+    * gaps between them packed into as few bytes as they need, which suits
+    * directed graphs too large for the other storage policies. The storage
+    * policy is defined in <code>compressed_directed_graph.h</code>.
+    */
+   struct CompressedStorage final {};
+   
+   /**
+    * The <code>StaticStorage</code> storage policy keeps a directed graph of
+    * at most <i>V</i> nodes and <i>E</i> directed edges in fixed-size arrays
+    * inside the directed graph itself, with no heap allocation, so that a
+    * directed graph can be built and queried in a constant expression. The
+    * storage policy is defined in <code>static_directed_graph.h</code>.
+    *
+    * @param V   the largest number of nodes
+    * @param E   the largest number of directed edges
+    */
+   template<size_t V, size_t E>
+   struct StaticStorage final {};
+   
+   template<typename T, typename S = LinkedStorage,
+      typename A = std::allocator<T>>
+   class DirectedGraph;
+   
    /**
     * In mathematics, and more specifically in graph theory,
     * <b>directed graphs</b> are collections of nodes connected by edges, where
     * the edges have a direction associated with them.
     *
+    * The primary template implements the <code>LinkedStorage</code> storage
+    * policy. The nodes, the vectors of adjacent nodes, and the directed edges
+    * are all allocated with the specified allocator, so a directed graph can
+    * draw all of its memory from an arena or a pool (see
+    * <code>pmr::DirectedGraph</code>).
+    *
     * @param T   the type of the elements
+    * @param S   the storage policy
+    * @param A   the allocator type
     *
     * @author Kris Torres
     */
-   template<typename T>
+   template<typename T, typename S, typename A>
    class DirectedGraph
    {
    public:
       
-      // Class
+      // Classes
+      class Batch;
+      class Cursor;
       class Iterator;
+      class NeighborIterator;
+      class Neighbors;
+      class VertexIterator;
+      class Vertices;
+      
+      // Type
+      typedef A allocator_type;
       
       // Constructors
       DirectedGraph();
-      explicit DirectedGraph(const size_t& n);
-      DirectedGraph(const size_t& n, const T& val);
-      DirectedGraph(const std::vector<T>& v);
-      DirectedGraph(const std::initializer_list<T> il);
+      explicit DirectedGraph(const A& alloc);
+      explicit DirectedGraph(const size_t& n, const A& alloc = A());
+      DirectedGraph(const size_t& n, const T& val, const A& alloc = A());
+      DirectedGraph(const std::vector<T>& v, const A& alloc = A());
+      DirectedGraph(std::vector<T>&& v, const A& alloc = A());
+      DirectedGraph(const std::initializer_list<T> il, const A& alloc = A());
       DirectedGraph(const DirectedGraph& rhs);
-      DirectedGraph(DirectedGraph&& rhs);
+      DirectedGraph(const DirectedGraph& rhs, const A& alloc);
+      DirectedGraph(DirectedGraph&& rhs) noexcept;
       
       // Assignment operators
       DirectedGraph& operator=(const DirectedGraph& rhs);
-      DirectedGraph& operator=(DirectedGraph&& rhs);
+      DirectedGraph& operator=(DirectedGraph&& rhs)
+         noexcept(std::allocator_traits<A>
+            ::propagate_on_container_move_assignment::value);
       
       // Destructor
       virtual ~DirectedGraph();
       
       // Mutators
       T& at(const size_t& k);
+      Batch batch();
       Iterator begin();
       void clear();
       void connect(const size_t& from, const size_t& to);
+      template<typename InputIterator>
+      void connect_bulk(InputIterator first, InputIterator last);
+      void connect_bulk(
+         const std::initializer_list<std::pair<size_t, size_t>> il);
+      void dedupe_edges();
+      void disable_edge_index();
       void disconnect(const size_t& k);
       void disconnect(const size_t& from, const size_t& to);
+      template<typename... Args>
+      void emplace_back(Args&&... args);
+      void enable_edge_index();
       void erase(const size_t& k);
+      T* find(const size_t& k) noexcept;
       T& front();
       T& operator[](const size_t& k);
+      void permute(const std::vector<size_t>& mapping);
       void push_back(const T& val);
-      void swap(DirectedGraph& rhs);
+      void push_back(T&& val);
+      void remove_self_loops();
+      std::vector<size_t> reorder(const Ordering& strategy);
+      void reserve(const size_t& nodes, const size_t& edges = 0);
+#ifdef PIC_10C_DIRECTED_GRAPH_STATS
+      GraphStats& stats();
+#endif
+      void swap(DirectedGraph& rhs) noexcept;
+      bool try_connect(const size_t& from, const size_t& to);
+      bool try_disconnect(const size_t& from, const size_t& to);
       
       // Accessors
+      Adjacency adjacency() const;
       T at(const size_t& k) const;
+      Cursor cursor(const size_t& k) const;
+      size_t edge_count(const size_t& from, const size_t& to) const;
+      bool edge_index_enabled() const;
+      size_t edges() const;
       bool empty() const;
+      const T* find(const size_t& k) const noexcept;
       T front() const;
+      A get_allocator() const;
+      bool has_edge(const size_t& from, const size_t& to) const;
+      size_t hash() const;
+      Neighbors in_neighbors(const size_t& k) const;
       size_t indegree(const size_t& k) const;
+      Neighbors neighbors(const size_t& k) const;
       T operator[](const size_t& k) const;
       size_t outdegree(const size_t& k) const;
       bool simple() const;
       size_t size() const;
+#ifdef PIC_10C_DIRECTED_GRAPH_STATS
+      const GraphStats& stats() const;
+#endif
+      size_t structural_hash() const;
+      Vertices vertices() const;
       
       // Relational operators
       bool operator==(const DirectedGraph& rhs) const;
       bool operator!=(const DirectedGraph& rhs) const;
       
       // Friend
-      template<typename U>
+      template<typename U, typename V, typename W>
       friend std::ostream& operator<<(std::ostream& out,
-         const DirectedGraph<U>& rhs);
+         const DirectedGraph<U, V, W>& rhs);
       
    private:
       
       // Classes
       class Node;
-      class DirectedEdge;
+      class EdgeHash;
       
-      // Accessor
-      void test_index(const size_t& k, const std::string& error) const;
+      // Types
+      template<typename U>
+      using Allocator =
+         typename std::allocator_traits<A>::template rebind_alloc<U>;
+      typedef std::vector<Node*, Allocator<Node*>> Links;
+      typedef std::vector<size_t, Allocator<size_t>> Indices;
+      typedef std::pair<const Node*, const Node*> EdgeKey;
+      typedef std::unordered_map<EdgeKey, size_t, EdgeHash,
+         std::equal_to<EdgeKey>, Allocator<std::pair<const EdgeKey, size_t>>>
+         EdgeIndex;
+      
+      // Mutators
+      void add_edge_hash(const size_t& from, const size_t& to);
+      void copy_edges(const DirectedGraph& rhs);
+      void index_edge(const Node* head, const Node* tail);
+      void link(const size_t& from, const size_t& to);
+      void rehash_edges();
+      void remove_edge_hash(const size_t& from, const size_t& to);
+      void renumber(const size_t& first);
+      void unindex_edge(const Node* head, const Node* tail);
+      static void unique_links(Links& links, Indices& marks,
+         const size_t& stamp);
+      bool unlink(const size_t& from, const size_t& to);
+      
+      // Accessors
+      static size_t edge_hash(const size_t& from, const size_t& to);
+      template<typename... Args>
+      std::shared_ptr<Node> make_node(const size_t& index, Args&&... args)
+         const;
+      GraphStats::Probe record(const GraphStats::Operation& op) const;
+      void test_index(const size_t& k, const char* error) const;
       
       /**
        * The vector buffer into which the nodes in this directed graph are
        * stored.
        */
-      std::vector<std::shared_ptr<Node>> buffer_;
+      std::vector<std::shared_ptr<Node>, Allocator<std::shared_ptr<Node>>>
+         buffer_;
+      
+      /**
+       * The number of directed edges between each pair of nodes that has any,
+       * if <code>indexed_</code> is set.
+       */
+      EdgeIndex edge_index_;
+      
+      /** Whether <code>edge_index_</code> is kept up to date. */
+      bool indexed_;
+      
+      /** The number of directed edges in this directed graph. */
+      size_t edges_;
+      
+      /**
+       * The sum of the hashes of the directed edges in this directed graph,
+       * which does not depend on the order in which they were connected.
+       */
+      size_t edge_hashes_;
+#ifdef PIC_10C_DIRECTED_GRAPH_STATS
       
       /**
-       * The vector buffer into which the directed edges in this directed graph
-       * are stored.
+       * The stats of the operations called on this directed graph, which are
+       * neither copied nor moved with it.
        */
-      std::vector<DirectedEdge> path_;
+      mutable GraphStats stats_;
+#endif
    };
    
    /**
@@ -128,8 +327,8 @@ namespace Kris_Torres_UCLA_PIC_10C_Winter_2014
     *
     * @author Kris Torres
     */
-   template<typename T>
-   class DirectedGraph<T>::Iterator
+   template<typename T, typename S, typename A>
+   class DirectedGraph<T, S, A>::Iterator
    {
    public:
       
@@ -142,8 +341,10 @@ namespace Kris_Torres_UCLA_PIC_10C_Winter_2014
       // Mutators
       void next(const size_t& k);
       T& operator*();
+      void prev(const size_t& k);
       
       // Accessors
+      size_t indegree() const;
       T operator*() const;
       T* operator->() const;
       size_t outdegree() const;
@@ -153,7 +354,7 @@ namespace Kris_Torres_UCLA_PIC_10C_Winter_2014
       bool operator!=(const Iterator& rhs) const;
       
       // Friend
-      friend class DirectedGraph<T>;
+      friend class DirectedGraph<T, S, A>;
       
    private:
       
@@ -161,95 +362,499 @@ namespace Kris_Torres_UCLA_PIC_10C_Winter_2014
       std::shared_ptr<Node> position_;
       
       /** The directed graph that this iterator traverses. */
-      DirectedGraph<T>* container_;
+      DirectedGraph<T, S, A>* container_;
    };
    
    /**
-    * In mathematics, and more specifically in graph theory, <b>nodes</b> are
-    * the fundamental units of which graphs are formed. In a diagram of a graph,
-    * nodes are labeled with extra information that enables it to be
-    * distinguished from other nodes.
+    * A <b>cursor</b> is a lightweight, read-only position in a directed graph:
+    * the directed graph and the position of one of its nodes. Unlike an
+    * iterator, a cursor shares the ownership of no node, so copying it and
+    * moving it along the directed edges never touches a reference count, and
+    * its value is read by reference. A cursor is invalidated when the
+    * directed graph is destroyed or a node before its position is erased.
+    *
+    * @author Kris Torres
     */
-   template<typename T>
-   class DirectedGraph<T>::Node final
+   template<typename T, typename S, typename A>
+   class DirectedGraph<T, S, A>::Cursor final
    {
    public:
       
-      // Constructor
-      explicit Node(const T& val);
+      // Accessors
+      size_t index() const;
+      size_t indegree() const;
+      Neighbors in_neighbors() const;
+      Neighbors neighbors() const;
+      Cursor next(const size_t& k) const;
+      const T& operator*() const;
+      const T* operator->() const;
+      size_t outdegree() const;
+      Cursor prev(const size_t& k) const;
+      
+      // Relational operators
+      bool operator==(const Cursor& rhs) const;
+      bool operator!=(const Cursor& rhs) const;
       
       // Friends
-      friend class DirectedGraph<T>;
-      friend class DirectedGraph<T>::Iterator;
+      friend class DirectedGraph<T, S, A>;
+      friend class DirectedGraph<T, S, A>::VertexIterator;
       
    private:
       
-      /** The data of this node in the directed graph. */
-      T data_;
+      // Constructor
+      Cursor(const DirectedGraph* graph, const size_t& index);
       
-      /** The tail endpoints adjacent to this node. */
-      std::vector<std::weak_ptr<Node>> next_;
+      /** The directed graph into which this cursor points. */
+      const DirectedGraph* graph_;
+      
+      /** The position of the node to which this cursor points. */
+      size_t index_;
    };
    
    /**
-    * <b>Directed edges</b> in a directed graph are defined in terms of ordered
-    * pairs of nodes.
+    * A <b>neighbor iterator</b> is a forward iterator over the positions of
+    * the tail nodes or the head nodes of one node in a directed graph. The
+    * positions are read by reference from the adjacent nodes themselves, so
+    * the iterator can be used with the STL algorithms.
+    *
+    * @author Kris Torres
     */
-   template<typename T>
-   class DirectedGraph<T>::DirectedEdge final
+   template<typename T, typename S, typename A>
+   class DirectedGraph<T, S, A>::NeighborIterator final
    {
    public:
       
+      // Types
+      typedef std::forward_iterator_tag iterator_category;
+      typedef size_t value_type;
+      typedef std::ptrdiff_t difference_type;
+      typedef const size_t* pointer;
+      typedef const size_t& reference;
+      
+      // Constructor
+      NeighborIterator();
+      
+      // Mutators
+      NeighborIterator& operator++();
+      NeighborIterator operator++(int);
+      
+      // Accessors
+      reference operator*() const;
+      pointer operator->() const;
+      
+      // Relational operators
+      bool operator==(const NeighborIterator& rhs) const;
+      bool operator!=(const NeighborIterator& rhs) const;
+      
+      // Friend
+      friend class DirectedGraph<T, S, A>::Neighbors;
+      
+   private:
+      
       // Constructor
-      DirectedEdge(const size_t& head, const size_t& tail);
+      explicit NeighborIterator(Node* const* position);
+      
+      /** The link to the current adjacent node. */
+      Node* const* position_;
+   };
+   
+   /**
+    * A <b>neighbors</b> view is a range of the positions of the tail nodes or
+    * the head nodes of one node in a directed graph, in the order of its
+    * vectors of adjacent nodes, which can be traversed with a range-based
+    * <code>for</code> loop. A view is invalidated when the adjacent nodes of
+    * its node change.
+    *
+    * @author Kris Torres
+    */
+   template<typename T, typename S, typename A>
+   class DirectedGraph<T, S, A>::Neighbors final
+   {
+   public:
+      
+      // Types
+      typedef NeighborIterator iterator;
+      typedef NeighborIterator const_iterator;
       
       // Accessors
-      size_t head() const;
-      size_t tail() const;
+      NeighborIterator begin() const;
+      bool empty() const;
+      NeighborIterator end() const;
+      size_t size() const;
+      
+      // Friend
+      friend class DirectedGraph<T, S, A>;
+      
+   private:
+      
+      // Constructor
+      explicit Neighbors(const Links& links);
+      
+      /** The first link of the range. */
+      Node* const* first_;
+      
+      /** The position one past the last link of the range. */
+      Node* const* last_;
+   };
+   
+   /**
+    * A <b>vertex iterator</b> visits the nodes of a directed graph in order,
+    * yielding a cursor to each of them.
+    *
+    * @author Kris Torres
+    */
+   template<typename T, typename S, typename A>
+   class DirectedGraph<T, S, A>::VertexIterator final
+   {
+   public:
+      
+      // Types
+      typedef std::input_iterator_tag iterator_category;
+      typedef Cursor value_type;
+      typedef std::ptrdiff_t difference_type;
+      typedef void pointer;
+      typedef Cursor reference;
+      
+      // Constructor
+      VertexIterator();
+      
+      // Mutators
+      VertexIterator& operator++();
+      VertexIterator operator++(int);
+      
+      // Accessor
+      Cursor operator*() const;
       
       // Relational operators
-      bool operator==(const DirectedEdge& rhs) const;
-      bool operator<(const DirectedEdge& rhs) const;
+      bool operator==(const VertexIterator& rhs) const;
+      bool operator!=(const VertexIterator& rhs) const;
+      
+      // Friend
+      friend class DirectedGraph<T, S, A>::Vertices;
+      
+   private:
+      
+      // Constructor
+      VertexIterator(const DirectedGraph* graph, const size_t& index);
+      
+      /** The directed graph whose nodes are visited. */
+      const DirectedGraph* graph_;
+      
+      /** The position of the current node. */
+      size_t index_;
+   };
+   
+   /**
+    * A <b>vertices</b> view is a range of cursors to all the nodes of a
+    * directed graph, in order, which can be traversed with a range-based
+    * <code>for</code> loop. A view is invalidated when nodes are added to or
+    * removed from its directed graph.
+    *
+    * @author Kris Torres
+    */
+   template<typename T, typename S, typename A>
+   class DirectedGraph<T, S, A>::Vertices final
+   {
+   public:
+      
+      // Types
+      typedef VertexIterator iterator;
+      typedef VertexIterator const_iterator;
+      
+      // Accessors
+      VertexIterator begin() const;
+      bool empty() const;
+      VertexIterator end() const;
+      size_t size() const;
+      
+      // Friend
+      friend class DirectedGraph<T, S, A>;
+      
+   private:
+      
+      // Constructor
+      explicit Vertices(const DirectedGraph* graph);
+      
+      /** The directed graph whose nodes are visited. */
+      const DirectedGraph* graph_;
+   };
+   
+   /**
+    * A <b>batch</b> records directed edges to be connected and disconnected,
+    * and nodes to be disconnected and erased, for a directed graph, and
+    * applies them all at once when it is committed. Applied one at a time,
+    * each change scans the adjacent nodes of the nodes that it touches, and
+    * each erasure renumbers the nodes after it, so <i>B</i> changes can take
+    * <i>O</i>(<i>BE</i>) time. A commit instead sorts the changes by node, by
+    * counting sort, and merges them into each vector of adjacent nodes in a
+    * single pass, in <i>O</i>(<i>V</i> + <i>E</i> + <i>B</i>) time, and can
+    * split that pass among several threads by starting and ending node.
+    *
+    * Committing a batch leaves the directed graph exactly as applying its
+    * changes in order would, down to the order of the adjacent nodes. The
+    * positions given to a batch are those of the nodes when the batch was
+    * started, since the nodes are only erased when it is committed, and an
+    * erased node cannot be given to the batch again. The directed graph must
+    * not be modified while a batch is pending, and a batch that is destroyed
+    * before it is committed changes nothing.
+    *
+    * @author Kris Torres
+    */
+   template<typename T, typename S, typename A>
+   class DirectedGraph<T, S, A>::Batch final
+   {
+   public:
+      
+      // Mutators
+      void clear();
+      void commit(const size_t& threads = 1);
+      void connect(const size_t& from, const size_t& to);
+      void disconnect(const size_t& k);
+      void disconnect(const size_t& from, const size_t& to);
+      void erase(const size_t& k);
+      
+      // Accessors
+      bool empty() const;
+      size_t size() const;
+      
+      // Friend
+      friend class DirectedGraph<T, S, A>;
+      
+   private:
+      
+      /** A directed edge to be connected or disconnected. */
+      struct Change
+      {
+         /** The position of the starting node. */
+         size_t from;
+         
+         /** The position of the ending node. */
+         size_t to;
+         
+         /** The order in which the change was recorded. */
+         size_t stamp;
+         
+         /** Whether the directed edge is connected, not disconnected. */
+         bool connect;
+      };
+      
+      /**
+       * The directed edges to be kept between a pair of nodes: only the
+       * first <code>keep</code> of them, in the order they were connected.
+       */
+      struct Removal
+      {
+         /** The position of the starting node. */
+         size_t from;
+         
+         /** The position of the ending node. */
+         size_t to;
+         
+         /** The number of directed edges that are kept. */
+         size_t keep;
+      };
+      
+      // Types
+      typedef std::vector<Change, Allocator<Change>> Changes;
+      typedef std::vector<Removal, Allocator<Removal>> Removals;
+      typedef std::vector<bool, Allocator<bool>> Marks;
+      
+      /** The nodes whose adjacent nodes are merged by one thread. */
+      struct Shard
+      {
+         // Constructor
+         Shard(const size_t& n, const A& alloc);
+         
+         /** The position of the first node. */
+         size_t first;
+         
+         /** The position past the last node. */
+         size_t last;
+         
+         /** The position of the first change from the nodes. */
+         size_t first_change;
+         
+         /** The position past the last change from the nodes. */
+         size_t last_change;
+         
+         /** The position of the first removal into the nodes. */
+         size_t first_tail;
+         
+         /** The position past the last removal into the nodes. */
+         size_t last_tail;
+         
+         /** Scratch space for each node, left at 0 between uses. */
+         Indices counts;
+         
+         /** Scratch space for each node, left at 0 between uses. */
+         Indices marks;
+         
+         /** The removals from the nodes. */
+         Removals heads;
+         
+         /** The directed edges from the nodes that are still connected. */
+         Changes added;
+      };
+      
+      // Constructor
+      explicit Batch(DirectedGraph* graph);
+      
+      // Mutators
+      template<typename Entry>
+      static void counting_sort(std::vector<Entry, Allocator<Entry>>& entries,
+         size_t Entry::* key, const size_t& n);
+      void filter(Links& links, const size_t& k,
+         typename Removals::const_iterator first,
+         typename Removals::const_iterator last, size_t Removal::* other,
+         Shard& shard);
+      void resolve(Shard& shard);
+      template<typename Shards>
+      void run(Shards& shards, void (Batch::*task)(Shard&));
+      void splice(Shard& shard);
+      
+      // Accessors
+      bool disconnected(const size_t& k, const size_t& first,
+         const size_t& last) const;
+      void test_index(const size_t& k, const char* error) const;
+      
+      /** The directed graph to which the changes are applied. */
+      DirectedGraph* graph_;
+      
+      /** The directed edges to be connected or disconnected. */
+      Changes changes_;
+      
+      /** The position and stamp of each node to be disconnected. */
+      std::vector<std::pair<size_t, size_t>,
+         Allocator<std::pair<size_t, size_t>>> clears_;
+      
+      /** Whether each node is to be erased, or empty if none is. */
+      Marks erased_;
+      
+      /** Whether each node is disconnected, while the batch is committed. */
+      Marks cleared_;
+      
+      /** The removals by ending node, while the batch is committed. */
+      Removals tails_;
+      
+      /** The stamp of the next change. */
+      size_t stamp_;
+   };
+   
+   /**
+    * In mathematics, and more specifically in graph theory, <b>nodes</b> are
+    * the fundamental units of which graphs are formed. In a diagram of a graph,
+    * nodes are labeled with extra information that enables it to be
+    * distinguished from other nodes.<p>
+    *
+    * Each node links to its adjacent nodes by plain pointers, since the
+    * directed graph owns every node and removes all the links to a node before
+    * the node leaves the directed graph. Iterators share the ownership of
+    * the node to which they point, so they can still reach it afterwards.
+    */
+   template<typename T, typename S, typename A>
+   class DirectedGraph<T, S, A>::Node final
+      : public std::enable_shared_from_this<Node>
+   {
+   public:
+      
+      // Constructor
+      template<typename... Args>
+      Node(const A& alloc, const size_t& index, Args&&... args);
+      
+      // Friends
+      friend class DirectedGraph<T, S, A>;
+      friend class DirectedGraph<T, S, A>::Batch;
+      friend class DirectedGraph<T, S, A>::Iterator;
+      template<typename U, typename V, typename W>
+      friend std::ostream& operator<<(std::ostream& out,
+         const DirectedGraph<U, V, W>& rhs);
       
    private:
       
-      /** The position of the starting node for this directed edge. */
-      size_t head_;
+      /** The data of this node in the directed graph. */
+      T data_;
+      
+      /** The position of this node in the directed graph. */
+      size_t index_;
+      
+      /** The tail endpoints adjacent to this node. */
+      Links next_;
+      
+      /** The head endpoints adjacent to this node. */
+      Links prev_;
+   };
+   
+   /**
+    * The <b>edge hash</b> hashes a pair of node addresses for the edge index.
+    * The addresses are mixed, so that the pairs from one node spread across
+    * the buckets even though node addresses share their low bits.
+    */
+   template<typename T, typename S, typename A>
+   class DirectedGraph<T, S, A>::EdgeHash final
+   {
+   public:
       
-      /** The position of the ending node for this directed edge. */
-      size_t tail_;
+      // Accessor
+      size_t operator()(const EdgeKey& key) const;
    };
    
    // Directed graph output operator
-   template<typename T>
-   std::ostream& operator<<(std::ostream& out, const DirectedGraph<T>& rhs);
+   template<typename T, typename S, typename A>
+   std::ostream& operator<<(std::ostream& out,
+      const DirectedGraph<T, S, A>& rhs);
+   
+   // Directed graph swap function
+   template<typename T, typename S, typename A>
+   void swap(DirectedGraph<T, S, A>& lhs, DirectedGraph<T, S, A>& rhs)
+      noexcept;
    
    /** Constructs an empty directed graph, with no nodes. */
-   template<typename T>
-   inline DirectedGraph<T>::DirectedGraph() {}
+   template<typename T, typename S, typename A>
+   inline DirectedGraph<T, S, A>::DirectedGraph()
+      : indexed_(false), edges_(0), edge_hashes_(0) {}
+   
+   /**
+    * Constructs an empty directed graph, with no nodes, that allocates its
+    * memory with the specified allocator.
+    *
+    * @param alloc   the allocator
+    */
+   template<typename T, typename S, typename A>
+   inline DirectedGraph<T, S, A>::DirectedGraph(const A& alloc)
+      : buffer_(alloc), edge_index_(alloc), indexed_(false), edges_(0),
+        edge_hashes_(0) {}
    
    /**
     * Constructs a directed graph with <i>n</i> nodes. Each node has the
     * default value of the specified type for the directed graph.
     *
-    * @param n   the initial number of nodes
+    * @param n       the initial number of nodes
+    * @param alloc   the allocator
     */
-   template<typename T>
-   DirectedGraph<T>::DirectedGraph(const size_t& n)
+   template<typename T, typename S, typename A>
+   DirectedGraph<T, S, A>::DirectedGraph(const size_t& n, const A& alloc)
+      : buffer_(alloc), edge_index_(alloc), indexed_(false), edges_(0),
+        edge_hashes_(0)
    {
-      for (size_t i = 0; i < n; i++) push_back(T());
+      buffer_.reserve(n);
+      for (size_t i = 0; i < n; i++) emplace_back();
    }
    
    /**
     * Constructs a directed graph with <i>n</i> nodes. Each node has the
     * specified value.
     *
-    * @param n     the initial number of nodes
-    * @param val   the value of each node
+    * @param n       the initial number of nodes
+    * @param val     the value of each node
+    * @param alloc   the allocator
     */
-   template<typename T>
-   DirectedGraph<T>::DirectedGraph(const size_t& n, const T& val)
+   template<typename T, typename S, typename A>
+   DirectedGraph<T, S, A>::DirectedGraph(const size_t& n, const T& val,
+      const A& alloc)
+      : buffer_(alloc), edge_index_(alloc), indexed_(false), edges_(0),
+        edge_hashes_(0)
    {
+      buffer_.reserve(n);
       for (size_t i = 0; i < n; i++) push_back(val);
    }
    
@@ -257,23 +862,50 @@ namespace Kris_Torres_UCLA_PIC_10C_Winter_2014
     * Constructs a directed graph that contains nodes with each of the elements
     * in the specified vector.
     *
-    * @param v   the vector of elements
+    * @param v       the vector of elements
+    * @param alloc   the allocator
     */
-   template<typename T>
-   DirectedGraph<T>::DirectedGraph(const std::vector<T>& v)
+   template<typename T, typename S, typename A>
+   DirectedGraph<T, S, A>::DirectedGraph(const std::vector<T>& v,
+      const A& alloc)
+      : buffer_(alloc), edge_index_(alloc), indexed_(false), edges_(0),
+        edge_hashes_(0)
    {
+      buffer_.reserve(v.size());
       for (const auto& element : v) push_back(element);
    }
    
+   /**
+    * Constructs a directed graph that contains nodes with each of the elements
+    * in the specified vector. Each element is moved into its node, and the
+    * vector is left in a valid but unspecified state.
+    *
+    * @param v       the vector of elements
+    * @param alloc   the allocator
+    */
+   template<typename T, typename S, typename A>
+   DirectedGraph<T, S, A>::DirectedGraph(std::vector<T>&& v, const A& alloc)
+      : buffer_(alloc), edge_index_(alloc), indexed_(false), edges_(0),
+        edge_hashes_(0)
+   {
+      buffer_.reserve(v.size());
+      for (auto& element : v) push_back(std::move(element));
+   }
+   
    /**
     * Constructs a directed graph that contains nodes with each of the elements
     * in the specified initializer list.
     *
-    * @param il   the initializer list of elements
+    * @param il      the initializer list of elements
+    * @param alloc   the allocator
     */
-   template<typename T>
-   DirectedGraph<T>::DirectedGraph(const std::initializer_list<T> il)
+   template<typename T, typename S, typename A>
+   DirectedGraph<T, S, A>::DirectedGraph(const std::initializer_list<T> il,
+      const A& alloc)
+      : buffer_(alloc), edge_index_(alloc), indexed_(false), edges_(0),
+        edge_hashes_(0)
    {
+      buffer_.reserve(il.size());
       for (const auto& element : il) push_back(element);
    }
    
@@ -283,26 +915,45 @@ namespace Kris_Torres_UCLA_PIC_10C_Winter_2014
     *
     * @param rhs   the directed graph to be copied
     */
-   template<typename T>
-   DirectedGraph<T>::DirectedGraph(const DirectedGraph& rhs) : path_(rhs.path_)
+   template<typename T, typename S, typename A>
+   DirectedGraph<T, S, A>::DirectedGraph(const DirectedGraph& rhs)
+      : DirectedGraph(rhs, std::allocator_traits<A>
+         ::select_on_container_copy_construction(rhs.get_allocator())) {}
+   
+   /**
+    * Constructs a directed graph with a copy of each of the nodes in the
+    * specified directed graph, allocating its memory with the specified
+    * allocator.
+    *
+    * @param rhs     the directed graph to be copied
+    * @param alloc   the allocator
+    */
+   template<typename T, typename S, typename A>
+   DirectedGraph<T, S, A>::DirectedGraph(const DirectedGraph& rhs,
+      const A& alloc)
+      : buffer_(alloc), edge_index_(alloc), indexed_(rhs.indexed_),
+        edges_(0), edge_hashes_(0)
    {
-      for (const auto& element : rhs.buffer_)
-         buffer_.push_back(std::make_shared<Node>(element -> data_));
-      
-      for (const auto& element : path_)
-         buffer_[element.head()] -> next_.push_back(buffer_[element.tail()]);
+      copy_edges(rhs);
    }
    
    /**
-    * Constructs a directed graph that acquires the nodes in the specified
-    * directed graph. Note that the specified directed graph is left in an
-    * unspecified but valid state.
+    * Constructs a directed graph that acquires the nodes and the directed edges
+    * in the specified directed graph, without allocating. Note that the
+    * specified directed graph is left in an unspecified but valid state.
     *
     * @param rhs   the directed graph to be moved
     */
-   template<typename T>
-   DirectedGraph<T>::DirectedGraph(DirectedGraph&& rhs)
-      : buffer_(std::move(rhs.buffer_)), path_(rhs.path_) {}
+   template<typename T, typename S, typename A>
+   DirectedGraph<T, S, A>::DirectedGraph(DirectedGraph&& rhs) noexcept
+      : buffer_(std::move(rhs.buffer_)),
+        edge_index_(std::move(rhs.edge_index_)), indexed_(rhs.indexed_),
+        edges_(rhs.edges_), edge_hashes_(rhs.edge_hashes_)
+   {
+      rhs.buffer_.clear();
+      rhs.edge_index_.clear();
+      rhs.edges_ = rhs.edge_hashes_ = 0;
+   }
    
    /**
     * Copies all the nodes in the specified directed graph into this directed
@@ -312,50 +963,74 @@ namespace Kris_Torres_UCLA_PIC_10C_Winter_2014
     *
     * @return this directed graph after the assignment
     */
-   template<typename T>
-   DirectedGraph<T>& DirectedGraph<T>::operator=(const DirectedGraph& rhs)
+   template<typename T, typename S, typename A>
+   DirectedGraph<T, S, A>& DirectedGraph<T, S, A>
+      ::operator=(const DirectedGraph& rhs)
    {
       // Tests for self-assignment.
       if (this != &rhs)
       {
          clear();
-         path_ = rhs.path_;
-         
-         for (const auto& element : rhs.buffer_)
-            buffer_.push_back(std::make_shared<Node>(element -> data_));
-         
-         for (const auto& element : path_)
-            buffer_[element.head()] -> next_.push_back(buffer_[element.tail()]);
+         indexed_ = rhs.indexed_;
+         copy_edges(rhs);
       }
       
       return *this;
    }
    
    /**
-    * Moves all the nodes in the specified directed graph into this directed
-    * graph, with the former left in an unspecified but valid state.
+    * Moves all the nodes and the directed edges in the specified directed
+    * graph into this directed graph, with the former left in an unspecified
+    * but valid state. Nothing is allocated unless the allocators of the two
+    * directed graphs compare unequal and do not propagate, in which case the
+    * nodes are copied instead.
     *
     * @param rhs   the directed graph to be moved
     *
     * @return this directed graph after the assignment
     */
-   template<typename T>
-   DirectedGraph<T>& DirectedGraph<T>::operator=(DirectedGraph&& rhs)
+   template<typename T, typename S, typename A>
+   DirectedGraph<T, S, A>& DirectedGraph<T, S, A>
+      ::operator=(DirectedGraph&& rhs)
+      noexcept(std::allocator_traits<A>
+         ::propagate_on_container_move_assignment::value)
    {
+      typedef typename std::allocator_traits<A>
+         ::propagate_on_container_move_assignment propagate;
+      
       // Tests for self-assignment.
       if (this != &rhs)
       {
          clear();
-         buffer_ = std::move(rhs.buffer_);
-         path_ = rhs.path_;
-      }
-      
-      return *this;
-   }
+         
+         if (propagate::value || get_allocator() == rhs.get_allocator())
+         {
+            buffer_ = std::move(rhs.buffer_);
+            edge_index_ = std::move(rhs.edge_index_);
+            indexed_ = rhs.indexed_;
+            edges_ = rhs.edges_;
+            edge_hashes_ = rhs.edge_hashes_;
+         }
+         
+         // Copies the nodes into the memory of this directed graph.
+         else *this = rhs;
+         
+         rhs.clear();
+      }
+      
+      return *this;
+   }
    
-   /** Destroys this directed graph. */
-   template<typename T>
-   inline DirectedGraph<T>::~DirectedGraph() {}
+   /**
+    * Destroys this directed graph. The nodes are unlinked first, since an
+    * iterator may keep a node alive after its directed graph is gone, and the
+    * links of such a node would otherwise point to freed nodes.
+    */
+   template<typename T, typename S, typename A>
+   inline DirectedGraph<T, S, A>::~DirectedGraph()
+   {
+      clear();
+   }
    
    /**
     * Returns a reference to the value of the node at position <i>k</i> in this
@@ -374,8 +1049,8 @@ namespace Kris_Torres_UCLA_PIC_10C_Winter_2014
     *
     * @throws std::out_of_range if <i>k</i> is out of bounds
     */
-   template<typename T>
-   T& DirectedGraph<T>::at(const size_t& k)
+   template<typename T, typename S, typename A>
+   T& DirectedGraph<T, S, A>::at(const size_t& k)
    {
       // Tests if k is valid.
       test_index(k, "Invalid node index in directed graph: ");
@@ -383,6 +1058,19 @@ namespace Kris_Torres_UCLA_PIC_10C_Winter_2014
       return buffer_[k] -> data_;
    }
    
+   /**
+    * Starts a batch of changes to this directed graph (see
+    * <code>Batch</code>), which are only applied when the batch is
+    * committed.
+    *
+    * @return the batch
+    */
+   template<typename T, typename S, typename A>
+   inline typename DirectedGraph<T, S, A>::Batch DirectedGraph<T, S, A>::batch()
+   {
+      return Batch(this);
+   }
+   
    /**
     * Returns an iterator pointing to the first node in this directed graph.
     *
@@ -390,8 +1078,8 @@ namespace Kris_Torres_UCLA_PIC_10C_Winter_2014
     *
     * @throws std::out_of_range if this directed graph is empty
     */
-   template<typename T>
-   typename DirectedGraph<T>::Iterator DirectedGraph<T>::begin()
+   template<typename T, typename S, typename A>
+   typename DirectedGraph<T, S, A>::Iterator DirectedGraph<T, S, A>::begin()
    {
       // Tests if the directed graph is empty.
       if (empty()) throw std::out_of_range("Empty directed graph");
@@ -406,13 +1094,19 @@ namespace Kris_Torres_UCLA_PIC_10C_Winter_2014
     * Removes all nodes from this directed graph, leaving the directed graph
     * with no nodes.
     */
-   template<typename T>
-   void DirectedGraph<T>::clear()
+   template<typename T, typename S, typename A>
+   void DirectedGraph<T, S, A>::clear()
    {
       // Removes all the directed edges.
-      for (size_t i = 0; i < size(); i++) disconnect(i);
+      for (const auto& element : buffer_)
+      {
+         element -> next_.clear();
+         element -> prev_.clear();
+      }
       
       buffer_.clear();
+      edge_index_.clear();
+      edges_ = edge_hashes_ = 0;
    }
    
    /**
@@ -430,16 +1124,123 @@ namespace Kris_Torres_UCLA_PIC_10C_Winter_2014
     * @throws std::out_of_range if either <code>from</code> or <code>to</code>
     * is out of bounds
     */
-   template<typename T>
-   void DirectedGraph<T>::connect(const size_t& from, const size_t& to)
+   template<typename T, typename S, typename A>
+   void DirectedGraph<T, S, A>::connect(const size_t& from, const size_t& to)
    {
       // Tests if the starting and ending node indices are valid.
       test_index(from, "Invalid starting node index in directed graph: ");
       test_index(to, "Invalid ending node index in directed graph: ");
       
-      buffer_[from] -> next_.push_back(buffer_[to]);
-      path_.push_back(DirectedEdge(from, to));
-      std::stable_sort(path_.begin(), path_.end());
+      link(from, to);
+   }
+   
+   /**
+    * Connects a directed edge for each (starting node, ending node) pair of
+    * positions in the range [<code>first</code>, <code>last</code>) in this
+    * directed graph.<p>
+    *
+    * The function automatically checks whether any position in the range is
+    * greater than or equal to the number of nodes in the directed graph,
+    * throwing an <code>std::out_of_range</code> exception if it is. In that
+    * case, no directed edge is connected.
+    *
+    * @param first   the iterator to the first pair of positions
+    * @param last    the iterator past the last pair of positions
+    *
+    * @throws std::out_of_range if any position in the range is out of bounds
+    */
+   template<typename T, typename S, typename A>
+   template<typename InputIterator>
+   void DirectedGraph<T, S, A>::connect_bulk(InputIterator first,
+      InputIterator last)
+   {
+      auto probe = record(GraphStats::connect);
+      std::vector<std::pair<size_t, size_t>,
+         Allocator<std::pair<size_t, size_t>>> edges(get_allocator());
+      
+      // Tests if the starting and ending node indices are valid.
+      for (; first != last; ++first)
+      {
+         const size_t from = (*first).first;
+         const size_t to = (*first).second;
+         test_index(from, "Invalid starting node index in directed graph: ");
+         test_index(to, "Invalid ending node index in directed graph: ");
+         if (edges.size() == edges.capacity()) probe.allocate();
+         edges.push_back(std::make_pair(from, to));
+      }
+      
+      for (const auto& element : edges)
+      {
+         const std::shared_ptr<Node>& head = buffer_[element.first];
+         const std::shared_ptr<Node>& tail = buffer_[element.second];
+         if (head -> next_.size() == head -> next_.capacity()) probe.allocate();
+         if (tail -> prev_.size() == tail -> prev_.capacity()) probe.allocate();
+         head -> next_.push_back(tail.get());
+         tail -> prev_.push_back(head.get());
+         if (indexed_) index_edge(head.get(), tail.get());
+         add_edge_hash(element.first, element.second);
+      }
+   }
+   
+   /**
+    * Connects a directed edge for each (starting node, ending node) pair of
+    * positions in the specified initializer list in this directed graph.<p>
+    *
+    * The function automatically checks whether any position in the list is
+    * greater than or equal to the number of nodes in the directed graph,
+    * throwing an <code>std::out_of_range</code> exception if it is. In that
+    * case, no directed edge is connected.
+    *
+    * @param il   the initializer list of pairs of positions
+    *
+    * @throws std::out_of_range if any position in the list is out of bounds
+    */
+   template<typename T, typename S, typename A>
+   inline void DirectedGraph<T, S, A>::connect_bulk(
+      const std::initializer_list<std::pair<size_t, size_t>> il)
+   {
+      connect_bulk(il.begin(), il.end());
+   }
+   
+   /**
+    * Removes the multiple directed edges in this directed graph, so that at
+    * most one directed edge is left from each starting node to each ending
+    * node. The directed edge that was connected first is kept, and the order
+    * of the others is unchanged.<p>
+    *
+    * Each ending node is marked with the last starting node that reached it,
+    * so the function takes linear time in the number of nodes and directed
+    * edges.
+    */
+   template<typename T, typename S, typename A>
+   void DirectedGraph<T, S, A>::dedupe_edges()
+   {
+      Indices marks(size(), static_cast<size_t>(-1), get_allocator());
+      for (size_t i = 0; i < size(); i++)
+         unique_links(buffer_[i] -> next_, marks, i);
+      
+      // Marks each starting node with the last ending node that reached it.
+      std::fill(marks.begin(), marks.end(), static_cast<size_t>(-1));
+      for (size_t i = 0; i < size(); i++)
+         unique_links(buffer_[i] -> prev_, marks, i);
+      
+      if (indexed_)
+      {
+         for (auto& element : edge_index_) element.second = 1;
+      }
+      
+      rehash_edges();
+   }
+   
+   /**
+    * Stops keeping the edge index of this directed graph, and frees its
+    * memory (see <code>enable_edge_index</code>).
+    */
+   template<typename T, typename S, typename A>
+   void DirectedGraph<T, S, A>::disable_edge_index()
+   {
+      indexed_ = false;
+      EdgeIndex(get_allocator()).swap(edge_index_);
    }
    
    /**
@@ -454,30 +1255,46 @@ namespace Kris_Torres_UCLA_PIC_10C_Winter_2014
     *
     * @throws std::out_of_range if <i>k</i> is out of bounds
     */
-   template<typename T>
-   void DirectedGraph<T>::disconnect(const size_t& k)
+   template<typename T, typename S, typename A>
+   void DirectedGraph<T, S, A>::disconnect(const size_t& k)
    {
       // Tests if k is valid.
       test_index(k, "Invalid node index in directed graph: ");
       
-      buffer_[k] -> next_.clear();
+      auto probe = record(GraphStats::disconnect_node);
+      const std::shared_ptr<Node>& node = buffer_[k];
       
-      // Removes all the directed edges whose ending node is the given node.
-      for (auto& element : buffer_)
+      auto test = [&](const Node* element)
       {
-         std::vector<std::weak_ptr<Node>>& edge = element -> next_;
-         
-         for (auto pos = edge.begin(); pos != edge.end(); pos++)
-            if (pos -> lock() == buffer_[k]) { edge.erase(pos); pos--; }
+         return element == node.get();
+      };
+      
+      // Removes the given node from the adjacent nodes of its neighbors.
+      for (const auto& element : node -> next_)
+      {
+         Node* tail = element;
+         Links& edge = tail -> prev_;
+         probe.scan(edge.size());
+         edge.erase(std::remove_if(edge.begin(), edge.end(), test), edge.end());
+         if (indexed_) unindex_edge(node.get(), tail);
+         remove_edge_hash(k, tail -> index_);
       }
       
-      auto test = [&](const DirectedEdge& e)
+      for (const auto& element : node -> prev_)
       {
-         return e.head() == k || e.tail() == k;
-      };
+         Node* head = element;
+         Links& edge = head -> next_;
+         probe.scan(edge.size());
+         edge.erase(std::remove_if(edge.begin(), edge.end(), test), edge.end());
+         
+         // A loop was already unindexed with the tail nodes.
+         if (head == node.get()) continue;
+         if (indexed_) unindex_edge(head, node.get());
+         remove_edge_hash(head -> index_, k);
+      }
       
-      path_.erase(std::remove_if(path_.begin(), path_.end(), test),
-         path_.end());
+      node -> next_.clear();
+      node -> prev_.clear();
    }
    
    /**
@@ -495,37 +1312,62 @@ namespace Kris_Torres_UCLA_PIC_10C_Winter_2014
     * @throws std::out_of_range if either <code>from</code> or <code>to</code>
     * is out of bounds
     */
-   template<typename T>
-   void DirectedGraph<T>::disconnect(const size_t& from, const size_t& to)
+   template<typename T, typename S, typename A>
+   void DirectedGraph<T, S, A>::disconnect(const size_t& from, const size_t& to)
    {
       // Tests if the starting and ending node indices are valid.
       test_index(from, "Invalid starting node index in directed graph: ");
       test_index(to, "Invalid ending node index in directed graph: ");
       
-      // Removes the rightmost occurrence of the given directed edge.
-      std::vector<std::weak_ptr<Node>>& edge = buffer_[from] -> next_;
+      unlink(from, to);
+   }
+   
+   /**
+    * Adds a node to this directed graph, after its current last node. The
+    * value of the new node is constructed in place from the specified
+    * arguments.
+    *
+    * @param args   the arguments with which to construct the value
+    */
+   template<typename T, typename S, typename A>
+   template<typename... Args>
+   inline void DirectedGraph<T, S, A>::emplace_back(Args&&... args)
+   {
+      buffer_.push_back(make_node(size(), std::forward<Args>(args)...));
+   }
+   
+   /**
+    * Starts keeping an <b>edge index</b> for this directed graph: a hash table
+    * from each pair of nodes to the number of directed edges between them.
+    * While the edge index is kept, <code>has_edge</code> and
+    * <code>edge_count</code> take constant time on average, and disconnecting
+    * a missing directed edge returns in constant time on average. Connecting
+    * and disconnecting directed edges update the edge index in constant time
+    * on average.<p>
+    *
+    * Building the edge index takes linear time in the number of directed
+    * edges. The edge index is copied and moved with this directed graph.
+    */
+   template<typename T, typename S, typename A>
+   void DirectedGraph<T, S, A>::enable_edge_index()
+   {
+      if (indexed_) return;
       
-      for (size_t i = edge.size(); i > 0; i--)
-      {
-         if (edge[i - 1].lock() == buffer_[to])
-         {
-            edge.erase(edge.begin() + i - 1);
-            break;
-         }
-      }
+      edge_index_.clear();
       
-      for (size_t i = path_.size(); i > 0; i--)
+      for (const auto& node : buffer_)
       {
-         if (path_[i - 1] == DirectedEdge(from, to))
-         {
-            path_.erase(path_.begin() + i - 1);
-            return;
-         }
+         for (const auto& element : node -> next_)
+            index_edge(node.get(), element);
       }
+      
+      indexed_ = true;
    }
    
    /**
-    * Removes the node at position <i>k</i> from this directed graph.<p>
+    * Removes the node at position <i>k</i> from this directed graph. The nodes
+    * after position <i>k</i> are moved down by one position, and the directed
+    * edges between them are kept.<p>
     *
     * The function automatically checks whether <i>k</i> is greater than or
     * equal to the number of nodes in the directed graph, throwing an
@@ -535,14 +1377,56 @@ namespace Kris_Torres_UCLA_PIC_10C_Winter_2014
     *
     * @throws std::out_of_range if <i>k</i> is out of bounds
     */
-   template<typename T>
-   void DirectedGraph<T>::erase(const size_t& k)
+   template<typename T, typename S, typename A>
+   void DirectedGraph<T, S, A>::erase(const size_t& k)
    {
       // Tests if k is valid.
       test_index(k, "Invalid node index in directed graph: ");
       
+      auto probe = record(GraphStats::erase);
       disconnect(k);
+      
+      // Rehashes the directed edges whose nodes are moved down, each once.
+      for (size_t i = k + 1; i < size(); i++)
+      {
+         const Node* node = buffer_[i].get();
+         probe.scan(node -> next_.size() + node -> prev_.size());
+         
+         for (const auto& element : node -> next_)
+         {
+            const size_t tail = element -> index_;
+            remove_edge_hash(i, tail);
+            add_edge_hash(i - 1, tail > k ? tail - 1 : tail);
+         }
+         
+         for (const auto& element : node -> prev_)
+         {
+            const size_t head = element -> index_;
+            if (head > k) continue;
+            
+            remove_edge_hash(head, i);
+            add_edge_hash(head, i - 1);
+         }
+      }
+      
       buffer_.erase(buffer_.begin() + k);
+      renumber(k);
+   }
+   
+   /**
+    * Returns a pointer to the value of the node at position <i>k</i> in this
+    * directed graph, or a null pointer if <i>k</i> is out of bounds. Unlike
+    * <code>at</code>, the function never throws.
+    *
+    * @param k   the position of the node
+    *
+    * @return a pointer to the value of the node at position <i>k</i>, or
+    * <code>nullptr</code>
+    */
+   template<typename T, typename S, typename A>
+   inline T* DirectedGraph<T, S, A>::find(const size_t& k) noexcept
+   {
+      return k < size() ? &buffer_[k] -> data_ : nullptr;
    }
    
    /**
@@ -552,8 +1436,8 @@ namespace Kris_Torres_UCLA_PIC_10C_Winter_2014
     *
     * @throws std::out_of_range if this directed graph is empty
     */
-   template<typename T>
-   T& DirectedGraph<T>::front()
+   template<typename T, typename S, typename A>
+   T& DirectedGraph<T, S, A>::front()
    {
       // Tests if the directed graph is empty.
       if (empty()) throw std::out_of_range("Empty directed graph");
@@ -569,499 +1453,2476 @@ namespace Kris_Torres_UCLA_PIC_10C_Winter_2014
     *
     * @return a reference to the value of the node at position <i>k</i>
     */
-   template<typename T>
-   inline T& DirectedGraph<T>::operator[](const size_t& k)
+   template<typename T, typename S, typename A>
+   inline T& DirectedGraph<T, S, A>::operator[](const size_t& k)
    {
       return buffer_[k] -> data_;
    }
    
+   /**
+    * Moves each node of this directed graph to a new position, given by the
+    * specified mapping from the current position of each node to its new
+    * position. The values, the directed edges, and the order of the tail
+    * nodes of each node are kept, so only the position of each node changes.
+    * Nothing is copied, and the function takes linear time in the number of
+    * nodes and directed edges.
+    *
+    * @param mapping   the new position of the node at each position
+    *
+    * @throws std::invalid_argument if the mapping is not a permutation of the
+    * positions of the nodes
+    */
+   template<typename T, typename S, typename A>
+   void DirectedGraph<T, S, A>::permute(const std::vector<size_t>& mapping)
+   {
+      // Tests if the mapping is a permutation.
+      if (mapping.size() != size())
+         throw std::invalid_argument("Invalid permutation of directed graph");
+      
+      std::vector<bool> taken(size(), false);
+      
+      for (const auto& position : mapping)
+      {
+         if (position >= size() || taken[position])
+         {
+            throw std::invalid_argument(
+               "Invalid permutation of directed graph");
+         }
+         taken[position] = true;
+      }
+      
+      std::vector<std::shared_ptr<Node>, Allocator<std::shared_ptr<Node>>>
+         buffer(size(), nullptr, get_allocator());
+      for (size_t i = 0; i < size(); i++)
+         buffer[mapping[i]] = std::move(buffer_[i]);
+      
+      buffer_.swap(buffer);
+      renumber(0);
+      rehash_edges();
+   }
+   
    /**
     * Adds a node with the specified value to this directed graph, after its
     * current last node.
     *
     * @param val   the value of the new node
     */
-   template<typename T>
-   inline void DirectedGraph<T>::push_back(const T& val)
+   template<typename T, typename S, typename A>
+   inline void DirectedGraph<T, S, A>::push_back(const T& val)
    {
-      buffer_.push_back(std::make_shared<Node>(val));
+      buffer_.push_back(make_node(size(), val));
    }
    
    /**
-    * Exchanges the content of this directed graph with the content of the
-    * specified directed graph.
+    * Adds a node with the specified value to this directed graph, after its
+    * current last node. The value is moved into the new node.
     *
-    * @param rhs   the directed graph to be swapped
+    * @param val   the value of the new node
     */
-   template<typename T>
-   void DirectedGraph<T>::swap(DirectedGraph<T>& rhs)
+   template<typename T, typename S, typename A>
+   inline void DirectedGraph<T, S, A>::push_back(T&& val)
    {
-      DirectedGraph<T> chs = *this;
-      *this = rhs;
-      rhs = chs;
+      buffer_.push_back(make_node(size(), std::move(val)));
    }
    
    /**
-    * Returns the value of the node at position <i>k</i> in this directed
-    * graph.<p>
+    * Removes every loop (directed edge from a node to itself) in this directed
+    * graph, in linear time in the number of nodes and directed edges.
+    */
+   template<typename T, typename S, typename A>
+   void DirectedGraph<T, S, A>::remove_self_loops()
+   {
+      for (const auto& node : buffer_)
+      {
+         auto test = [&](const Node* element)
+         {
+            return element == node.get();
+         };
+         
+         Links& edge = node -> next_;
+         const size_t count = edge.size();
+         edge.erase(std::remove_if(edge.begin(), edge.end(), test), edge.end());
+         
+         for (size_t i = edge.size(); i < count; i++)
+            remove_edge_hash(node -> index_, node -> index_);
+         
+         Links& reverse = node -> prev_;
+         reverse.erase(std::remove_if(reverse.begin(), reverse.end(), test),
+            reverse.end());
+         
+         if (indexed_) edge_index_.erase(EdgeKey(node.get(), node.get()));
+      }
+   }
+   
+   /**
+    * Relabels the nodes of this directed graph in the specified ordering, so
+    * that the nodes visited together by a traversal are stored together (see
+    * <code>vertex_order</code>), and returns the new position of the node at
+    * each former position, with which positions kept outside the directed
+    * graph can be translated. The snapshots taken afterwards by
+    * <code>adjacency</code> then have the improved locality.
     *
-    * The function automatically checks whether <i>k</i> is within the bounds of
-    * valid positions in the directed graph, throwing an
-    * <code>std::out_of_range</code> exception if it is not (i.e., if <i>k</i>
-    * is greater than or equal to the number of nodes in the directed graph).
-    * This is in contrast with member <code>operator[]</code>, which does not
-    * check against bounds.
+    * @param strategy   the ordering
     *
-    * @param k   the position of the node
+    * @return the new position of the node at each former position
+    */
+   template<typename T, typename S, typename A>
+   std::vector<size_t> DirectedGraph<T, S, A>::reorder(
+      const Ordering& strategy)
+   {
+      const std::vector<size_t> order = vertex_order(adjacency(), strategy);
+      std::vector<size_t> mapping(size());
+      for (size_t i = 0; i < size(); i++) mapping[order[i]] = i;
+      
+      permute(mapping);
+      return mapping;
+   }
+   
+   /**
+    * Reserves memory for at least the specified numbers of nodes and directed
+    * edges, so that adding up to that many of each does not reallocate the
+    * vector of nodes or rehash the edge index. Each node is still allocated
+    * on its own.
     *
-    * @return the value of the node at position <i>k</i>
+    * @param nodes   the number of nodes
+    * @param edges   the number of directed edges
+    */
+   template<typename T, typename S, typename A>
+   inline void DirectedGraph<T, S, A>::reserve(const size_t& nodes,
+      const size_t& edges)
+   {
+      buffer_.reserve(nodes);
+      if (indexed_) edge_index_.reserve(edges);
+   }
+#ifdef PIC_10C_DIRECTED_GRAPH_STATS
+   
+   /**
+    * Returns a reference to the stats of the operations called on this
+    * directed graph, through which they can be reset or reported (see
+    * <code>GraphStats</code>).
     *
-    * @throws std::out_of_range if <i>k</i> is out of bounds
+    * @return a reference to the stats
     */
-   template<typename T>
-   T DirectedGraph<T>::at(const size_t& k) const
+   template<typename T, typename S, typename A>
+   inline GraphStats& DirectedGraph<T, S, A>::stats()
    {
-      // Tests if k is valid.
-      test_index(k, "Invalid node index in directed graph: ");
-      
-      return buffer_[k] -> data_;
+      return stats_;
    }
+#endif
    
    /**
-    * Tests if this directed graph is empty (i.e., if the directed graph
-    * contains no nodes).
+    * Exchanges the content of this directed graph with the content of the
+    * specified directed graph. No node or directed edge is copied or
+    * allocated. As with the standard containers, the allocators of the two
+    * directed graphs must compare equal unless they propagate on swap.
     *
-    * @return <code>true</code> if this directed graph is empty, or
-    * <code>false</code> otherwise
+    * @param rhs   the directed graph to be swapped
     */
-   template<typename T>
-   inline bool DirectedGraph<T>::empty() const { return buffer_.empty(); }
+   template<typename T, typename S, typename A>
+   void DirectedGraph<T, S, A>::swap(DirectedGraph<T, S, A>& rhs) noexcept
+   {
+      buffer_.swap(rhs.buffer_);
+      edge_index_.swap(rhs.edge_index_);
+      std::swap(indexed_, rhs.indexed_);
+      std::swap(edges_, rhs.edges_);
+      std::swap(edge_hashes_, rhs.edge_hashes_);
+   }
    
    /**
-    * Returns the value of the first node in this directed graph.
+    * Connects a directed edge from the specified starting node to the specified
+    * ending node in this directed graph, if both positions are valid. Unlike
+    * <code>connect</code>, the function reports invalid positions by its
+    * result instead of throwing an exception.
     *
-    * @return the value of the first node
+    * @param from   the position of the starting node
+    * @param to     the position of the ending node
     *
-    * @throws std::out_of_range if this directed graph is empty
+    * @return <code>true</code> if the directed edge was connected, or
+    * <code>false</code> if either position is out of bounds
     */
-   template<typename T>
-   T DirectedGraph<T>::front() const
+   template<typename T, typename S, typename A>
+   inline bool DirectedGraph<T, S, A>::try_connect(const size_t& from,
+      const size_t& to)
    {
-      // Tests if the directed graph is empty.
-      if (empty()) throw std::out_of_range("Empty directed graph");
+      if (from >= size() || to >= size()) return false;
       
-      return buffer_.front() -> data_;
+      link(from, to);
+      return true;
    }
    
    /**
-    * Returns the <b>indegree</b> of the node at position <i>k</i> in this
-    * directed graph (i.e., the number of head nodes adjacent to the node at
-    * position <i>k</i>).<p>
-    *
-    * The function automatically checks whether <i>k</i> is greater than or
-    * equal to the number of nodes in the directed graph, throwing an
-    * <code>std::out_of_range</code> exception if it is not.
+    * Disconnects a directed edge from the specified starting node to the
+    * specified ending node in this directed graph, if both positions are valid
+    * and there is such a directed edge. Unlike <code>disconnect</code>, the
+    * function reports invalid positions by its result instead of throwing an
+    * exception.
     *
-    * @param k   the position of the node
+    * @param from   the position of the starting node
+    * @param to     the position of the ending node
     *
-    * @return the indegree
+    * @return <code>true</code> if a directed edge was disconnected, or
+    * <code>false</code> if either position is out of bounds or there is no
+    * such directed edge
+    */
+   template<typename T, typename S, typename A>
+   inline bool DirectedGraph<T, S, A>::try_disconnect(const size_t& from,
+      const size_t& to)
+   {
+      return from < size() && to < size() && unlink(from, to);
+   }
+   
+   /**
+    * Returns a snapshot of the directed edges in this directed graph, with the
+    * tail nodes of each node in the order in which they were connected. The
+    * snapshot is not updated when this directed graph is modified.
     *
-    * @throws std::out_of_range if <i>k</i> is out of bounds
+    * @return the adjacency of this directed graph
     */
-   template<typename T>
-   size_t DirectedGraph<T>::indegree(const size_t& k) const
+   template<typename T, typename S, typename A>
+   Adjacency DirectedGraph<T, S, A>::adjacency() const
    {
-      // Tests if k is valid.
-      test_index(k, "Invalid node index in directed graph: ");
-      
-      size_t head = 0;
+      auto probe = record(GraphStats::adjacency);
+      std::vector<std::pair<size_t, size_t>> edges;
       
-      // Counts the number of head nodes adjacent to the given node.
-      for (const auto& row : buffer_)
+      for (const auto& node : buffer_)
       {
-         for (const auto& column : row -> next_)
-            if (column.lock() == buffer_[k]) head++;
+         probe.scan(node -> next_.size());
+         
+         for (const auto& element : node -> next_)
+         {
+            const size_t tail = element -> index_;
+            if (edges.size() == edges.capacity()) probe.allocate();
+            edges.push_back(std::make_pair(node -> index_, tail));
+         }
       }
       
-      return head;
+      return Adjacency(size(), edges);
    }
    
    /**
-    * Returns the value of the node at position <i>k</i> in this directed graph.
+    * Returns the value of the node at position <i>k</i> in this directed
+    * graph.<p>
+    *
+    * The function automatically checks whether <i>k</i> is within the bounds of
+    * valid positions in the directed graph, throwing an
+    * <code>std::out_of_range</code> exception if it is not (i.e., if <i>k</i>
+    * is greater than or equal to the number of nodes in the directed graph).
+    * This is in contrast with member <code>operator[]</code>, which does not
+    * check against bounds.
     *
     * @param k   the position of the node
     *
     * @return the value of the node at position <i>k</i>
+    *
+    * @throws std::out_of_range if <i>k</i> is out of bounds
     */
-   template<typename T>
-   inline T DirectedGraph<T>::operator[](const size_t& k) const
+   template<typename T, typename S, typename A>
+   T DirectedGraph<T, S, A>::at(const size_t& k) const
    {
+      // Tests if k is valid.
+      test_index(k, "Invalid node index in directed graph: ");
+      
       return buffer_[k] -> data_;
    }
    
    /**
-    * Returns the <b>outdegree</b> of the node at position <i>k</i> in this
-    * directed graph (i.e., the number of tail nodes adjacent to the node at
-    * position <i>k</i>).<p>
+    * Returns a cursor to the node at position <i>k</i> in this directed graph
+    * (see <code>Cursor</code>).<p>
     *
     * The function automatically checks whether <i>k</i> is greater than or
     * equal to the number of nodes in the directed graph, throwing an
-    * <code>std::out_of_range</code> exception if it is not.
+    * <code>std::out_of_range</code> exception if it is.
     *
     * @param k   the position of the node
     *
-    * @return the outdegree
+    * @return a cursor to the node
     *
     * @throws std::out_of_range if <i>k</i> is out of bounds
     */
-   template<typename T>
-   size_t DirectedGraph<T>::outdegree(const size_t& k) const
+   template<typename T, typename S, typename A>
+   inline typename DirectedGraph<T, S, A>::Cursor
+      DirectedGraph<T, S, A>::cursor(const size_t& k) const
    {
       // Tests if k is valid.
       test_index(k, "Invalid node index in directed graph: ");
       
-      return buffer_[k] -> next_.size();
+      return Cursor(this, k);
    }
    
    /**
-    * Tests if this directed graph is simple, that is, if the directed graph has
-    * no loops and no multiple directed edges (edges with the same starting and
-    * ending nodes).
+    * Returns the number of directed edges from the specified starting node to
+    * the specified ending node in this directed graph. The function takes
+    * constant time on average if the edge index is kept, and otherwise scans
+    * the shorter of the two vectors of adjacent nodes.<p>
     *
-    * @return <code>true</code> if this directed graph is simple, or
-    * <code>false</code> otherwise
+    * The function automatically checks whether <code>from</code> and
+    * <code>to</code> are greater than or equal to the number of nodes in the
+    * directed graph, throwing an <code>std::out_of_range</code> exception if it
+    * is not.
+    *
+    * @param from   the position of the starting node
+    * @param to     the position of the ending node
+    *
+    * @return the number of directed edges
+    *
+    * @throws std::out_of_range if either <code>from</code> or <code>to</code>
+    * is out of bounds
     */
-   template<typename T>
-   bool DirectedGraph<T>::simple() const
+   template<typename T, typename S, typename A>
+   size_t DirectedGraph<T, S, A>::edge_count(const size_t& from,
+      const size_t& to) const
    {
-      for (auto i = buffer_.begin(); i != buffer_.end(); i++)
+      // Tests if the starting and ending node indices are valid.
+      test_index(from, "Invalid starting node index in directed graph: ");
+      test_index(to, "Invalid ending node index in directed graph: ");
+      
+      auto probe = record(GraphStats::find_edge);
+      const std::shared_ptr<Node>& head = buffer_[from];
+      const std::shared_ptr<Node>& tail = buffer_[to];
+      
+      if (indexed_)
       {
-         std::vector<std::weak_ptr<Node>>& edge = (*i) -> next_;
-         
-         for (auto j = edge.begin(); j != edge.end(); j++)
-         {
-            // Tests if the current node has a loop.
-            if (*i == j -> lock()) return false;
-            
-            // Tests if this directed graph has multiple directed edges.
-            for (auto k = edge.begin(); k != edge.end(); k++)
-               if (j != k && j -> lock() == k -> lock()) return false;
-         }
+         auto position = edge_index_.find(EdgeKey(head.get(), tail.get()));
+         return position == edge_index_.end() ? 0 : position -> second;
+      }
+      
+      size_t count = 0;
+      
+      if (head -> next_.size() <= tail -> prev_.size())
+      {
+         probe.scan(head -> next_.size());
+         for (const auto& element : head -> next_)
+            if (element == tail.get()) count++;
+      }
+      else
+      {
+         probe.scan(tail -> prev_.size());
+         for (const auto& element : tail -> prev_)
+            if (element == head.get()) count++;
+      }
+      
+      return count;
+   }
+   
+   /**
+    * Tests if this directed graph keeps an edge index (see
+    * <code>enable_edge_index</code>).
+    *
+    * @return <code>true</code> if this directed graph keeps an edge index, or
+    * <code>false</code> otherwise
+    */
+   template<typename T, typename S, typename A>
+   inline bool DirectedGraph<T, S, A>::edge_index_enabled() const
+   {
+      return indexed_;
+   }
+   
+   /**
+    * Returns the number of directed edges in this directed graph, in constant
+    * time.
+    *
+    * @return the number of directed edges
+    */
+   template<typename T, typename S, typename A>
+   inline size_t DirectedGraph<T, S, A>::edges() const
+   {
+      return edges_;
+   }
+   
+   /**
+    * Tests if this directed graph is empty (i.e., if the directed graph
+    * contains no nodes).
+    *
+    * @return <code>true</code> if this directed graph is empty, or
+    * <code>false</code> otherwise
+    */
+   template<typename T, typename S, typename A>
+   inline bool DirectedGraph<T, S, A>::empty() const { return buffer_.empty(); }
+   
+   /**
+    * Returns a pointer to the value of the node at position <i>k</i> in this
+    * directed graph, or a null pointer if <i>k</i> is out of bounds. Unlike
+    * <code>at</code>, the function never throws.
+    *
+    * @param k   the position of the node
+    *
+    * @return a pointer to the value of the node at position <i>k</i>, or
+    * <code>nullptr</code>
+    */
+   template<typename T, typename S, typename A>
+   inline const T* DirectedGraph<T, S, A>::find(const size_t& k) const noexcept
+   {
+      return k < size() ? &buffer_[k] -> data_ : nullptr;
+   }
+   
+   /**
+    * Returns the value of the first node in this directed graph.
+    *
+    * @return the value of the first node
+    *
+    * @throws std::out_of_range if this directed graph is empty
+    */
+   template<typename T, typename S, typename A>
+   T DirectedGraph<T, S, A>::front() const
+   {
+      // Tests if the directed graph is empty.
+      if (empty()) throw std::out_of_range("Empty directed graph");
+      
+      return buffer_.front() -> data_;
+   }
+   
+   /**
+    * Returns a copy of the allocator with which this directed graph allocates
+    * its memory.
+    *
+    * @return the allocator
+    */
+   template<typename T, typename S, typename A>
+   inline A DirectedGraph<T, S, A>::get_allocator() const
+   {
+      return A(buffer_.get_allocator());
+   }
+   
+   /**
+    * Tests if this directed graph has a directed edge from the specified
+    * starting node to the specified ending node. The function takes constant
+    * time on average if the edge index is kept, and otherwise scans the
+    * shorter of the two vectors of adjacent nodes.<p>
+    *
+    * The function automatically checks whether <code>from</code> and
+    * <code>to</code> are greater than or equal to the number of nodes in the
+    * directed graph, throwing an <code>std::out_of_range</code> exception if it
+    * is not.
+    *
+    * @param from   the position of the starting node
+    * @param to     the position of the ending node
+    *
+    * @return <code>true</code> if the directed edge exists, or
+    * <code>false</code> otherwise
+    *
+    * @throws std::out_of_range if either <code>from</code> or <code>to</code>
+    * is out of bounds
+    */
+   template<typename T, typename S, typename A>
+   bool DirectedGraph<T, S, A>::has_edge(const size_t& from, const size_t& to)
+      const
+   {
+      // Tests if the starting and ending node indices are valid.
+      test_index(from, "Invalid starting node index in directed graph: ");
+      test_index(to, "Invalid ending node index in directed graph: ");
+      
+      auto probe = record(GraphStats::find_edge);
+      const std::shared_ptr<Node>& head = buffer_[from];
+      const std::shared_ptr<Node>& tail = buffer_[to];
+      
+      if (indexed_)
+      {
+         return edge_index_.find(EdgeKey(head.get(), tail.get()))
+            != edge_index_.end();
+      }
+      
+      if (head -> next_.size() <= tail -> prev_.size())
+      {
+         for (const auto& element : head -> next_)
+         {
+            probe.scan();
+            if (element == tail.get()) return true;
+         }
+      }
+      else
+      {
+         for (const auto& element : tail -> prev_)
+         {
+            probe.scan();
+            if (element == head.get()) return true;
+         }
+      }
+      
+      return false;
+   }
+   
+   /**
+    * Returns a hash of the content of this directed graph: its structural hash
+    * combined with the hash of the value of each node, in order. The function
+    * takes linear time in the number of nodes, since the values can be
+    * modified through references without the directed graph noticing. Equal
+    * directed graphs have equal hashes.
+    *
+    * @return the hash of this directed graph
+    */
+   template<typename T, typename S, typename A>
+   size_t DirectedGraph<T, S, A>::hash() const
+   {
+      size_t result = structural_hash();
+      
+      for (const auto& node : buffer_)
+      {
+         const size_t value = std::hash<T>()(node -> data_);
+         result ^= value + static_cast<size_t>(0x9e3779b97f4a7c15ULL)
+            + (result << 6) + (result >> 2);
+      }
+      
+      return result;
+   }
+   
+   /**
+    * Returns the positions of the head nodes of the node at position <i>k</i>
+    * in this directed graph, without copying them. The order of the head
+    * nodes of a node is unspecified.<p>
+    *
+    * The function automatically checks whether <i>k</i> is greater than or
+    * equal to the number of nodes in the directed graph, throwing an
+    * <code>std::out_of_range</code> exception if it is.
+    *
+    * @param k   the position of the node
+    *
+    * @return the view of the head node positions
+    *
+    * @throws std::out_of_range if <i>k</i> is out of bounds
+    */
+   template<typename T, typename S, typename A>
+   inline typename DirectedGraph<T, S, A>::Neighbors
+      DirectedGraph<T, S, A>::in_neighbors(const size_t& k) const
+   {
+      // Tests if k is valid.
+      test_index(k, "Invalid node index in directed graph: ");
+      
+      return Neighbors(buffer_[k] -> prev_);
+   }
+   
+   /**
+    * Returns the <b>indegree</b> of the node at position <i>k</i> in this
+    * directed graph (i.e., the number of head nodes adjacent to the node at
+    * position <i>k</i>).<p>
+    *
+    * The function automatically checks whether <i>k</i> is greater than or
+    * equal to the number of nodes in the directed graph, throwing an
+    * <code>std::out_of_range</code> exception if it is not.
+    *
+    * @param k   the position of the node
+    *
+    * @return the indegree
+    *
+    * @throws std::out_of_range if <i>k</i> is out of bounds
+    */
+   template<typename T, typename S, typename A>
+   size_t DirectedGraph<T, S, A>::indegree(const size_t& k) const
+   {
+      // Tests if k is valid.
+      test_index(k, "Invalid node index in directed graph: ");
+      
+      auto probe = record(GraphStats::indegree);
+      return buffer_[k] -> prev_.size();
+   }
+   
+   /**
+    * Returns the positions of the tail nodes of the node at position <i>k</i>
+    * in this directed graph, in the order in which they were connected,
+    * without copying them.<p>
+    *
+    * The function automatically checks whether <i>k</i> is greater than or
+    * equal to the number of nodes in the directed graph, throwing an
+    * <code>std::out_of_range</code> exception if it is.
+    *
+    * @param k   the position of the node
+    *
+    * @return the view of the tail node positions
+    *
+    * @throws std::out_of_range if <i>k</i> is out of bounds
+    */
+   template<typename T, typename S, typename A>
+   inline typename DirectedGraph<T, S, A>::Neighbors
+      DirectedGraph<T, S, A>::neighbors(const size_t& k) const
+   {
+      // Tests if k is valid.
+      test_index(k, "Invalid node index in directed graph: ");
+      
+      return Neighbors(buffer_[k] -> next_);
+   }
+   
+   /**
+    * Returns the value of the node at position <i>k</i> in this directed graph.
+    *
+    * @param k   the position of the node
+    *
+    * @return the value of the node at position <i>k</i>
+    */
+   template<typename T, typename S, typename A>
+   inline T DirectedGraph<T, S, A>::operator[](const size_t& k) const
+   {
+      return buffer_[k] -> data_;
+   }
+   
+   /**
+    * Returns the <b>outdegree</b> of the node at position <i>k</i> in this
+    * directed graph (i.e., the number of tail nodes adjacent to the node at
+    * position <i>k</i>).<p>
+    *
+    * The function automatically checks whether <i>k</i> is greater than or
+    * equal to the number of nodes in the directed graph, throwing an
+    * <code>std::out_of_range</code> exception if it is not.
+    *
+    * @param k   the position of the node
+    *
+    * @return the outdegree
+    *
+    * @throws std::out_of_range if <i>k</i> is out of bounds
+    */
+   template<typename T, typename S, typename A>
+   size_t DirectedGraph<T, S, A>::outdegree(const size_t& k) const
+   {
+      // Tests if k is valid.
+      test_index(k, "Invalid node index in directed graph: ");
+      
+      return buffer_[k] -> next_.size();
+   }
+   
+   /**
+    * Tests if this directed graph is simple, that is, if the directed graph has
+    * no loops and no multiple directed edges (edges with the same starting and
+    * ending nodes). Each ending node is marked with the last starting node
+    * that reached it, so the test takes linear time.
+    *
+    * @return <code>true</code> if this directed graph is simple, or
+    * <code>false</code> otherwise
+    */
+   template<typename T, typename S, typename A>
+   bool DirectedGraph<T, S, A>::simple() const
+   {
+      Indices marks(size(), static_cast<size_t>(-1), get_allocator());
+      
+      for (size_t i = 0; i < size(); i++)
+      {
+         for (const auto& element : buffer_[i] -> next_)
+         {
+            const size_t tail = element -> index_;
+            
+            // Tests if the current node has a loop or a multiple directed edge.
+            if (tail == i || marks[tail] == i) return false;
+            marks[tail] = i;
+         }
+      }
+      
+      return true;
+   }
+   
+   /**
+    * Returns the number of nodes in this directed graph.
+    *
+    * @return the number of nodes
+    */
+   template<typename T, typename S, typename A>
+   inline size_t DirectedGraph<T, S, A>::size() const { return buffer_.size(); }
+#ifdef PIC_10C_DIRECTED_GRAPH_STATS
+   
+   /**
+    * Returns the stats of the operations called on this directed graph (see
+    * <code>GraphStats</code>).
+    *
+    * @return the stats
+    */
+   template<typename T, typename S, typename A>
+   inline const GraphStats& DirectedGraph<T, S, A>::stats() const
+   {
+      return stats_;
+   }
+#endif
+   
+   /**
+    * Returns a hash of the structure of this directed graph, in constant time:
+    * its number of nodes and its directed edges, but not the values of its
+    * nodes or the order in which the directed edges were connected. The hash
+    * is kept up to date as nodes and directed edges are added and removed.
+    *
+    * @return the structural hash of this directed graph
+    */
+   template<typename T, typename S, typename A>
+   inline size_t DirectedGraph<T, S, A>::structural_hash() const
+   {
+      return edge_hash(size(), edges_) ^ edge_hashes_;
+   }
+   
+   /**
+    * Returns a view of cursors to all the nodes in this directed graph, in
+    * order (see <code>Vertices</code>).
+    *
+    * @return the view of the nodes
+    */
+   template<typename T, typename S, typename A>
+   inline typename DirectedGraph<T, S, A>::Vertices
+      DirectedGraph<T, S, A>::vertices() const
+   {
+      return Vertices(this);
+   }
+   
+   /**
+    * Tests if this directed graph and the specified directed graph are equal.
+    *
+    * @param rhs   the directed graph to compare with this directed graph
+    *
+    * @return <code>true</code> if this directed graph and the specified
+    * directed graph are equal, or <code>false</code> otherwise
+    */
+   template<typename T, typename S, typename A>
+   bool DirectedGraph<T, S, A>::operator==(const DirectedGraph& rhs) const
+   {
+      // Tests if the two directed graphs have the same number of nodes and the
+      // same directed edges, as far as constant time can tell.
+      if (size() != rhs.size() || edges_ != rhs.edges_
+         || edge_hashes_ != rhs.edge_hashes_)
+         return false;
+      
+      // Tests if the two directed graphs have the same nodes.
+      for (size_t i = 0; i < size(); i++)
+         if (buffer_[i] -> data_ != rhs.buffer_[i] -> data_) return false;
+      
+      // Tests if the two directed graphs have the same directed edges, in the
+      // order in which they were connected.
+      for (size_t i = 0; i < size(); i++)
+      {
+         const Links& edge = buffer_[i] -> next_;
+         const Links& other = rhs.buffer_[i] -> next_;
+         if (edge.size() != other.size()) return false;
+         
+         for (size_t j = 0; j < edge.size(); j++)
+            if (edge[j] -> index_ != other[j] -> index_)
+               return false;
       }
       
       return true;
    }
    
    /**
-    * Returns the number of nodes in this directed graph.
+    * Tests if this directed graph and the specified directed graph are unequal.
+    *
+    * @param rhs   the directed graph to compare with this directed graph
+    *
+    * @return <code>true</code> if this directed graph and the specified
+    * directed graph are unequal, or <code>false</code> otherwise
+    */
+   template<typename T, typename S, typename A>
+   inline bool DirectedGraph<T, S, A>::operator!=(const DirectedGraph& rhs)
+      const
+   {
+      return !(*this == rhs);
+   }
+   
+   /**
+    * Counts one more directed edge from the node at position <i>from</i> to
+    * the node at position <i>to</i> in the structural hash.
+    *
+    * @param from   the position of the starting node
+    * @param to     the position of the ending node
+    */
+   template<typename T, typename S, typename A>
+   inline void DirectedGraph<T, S, A>::add_edge_hash(const size_t& from,
+      const size_t& to)
+   {
+      edges_++;
+      edge_hashes_ += edge_hash(from, to);
+   }
+   
+   /**
+    * Copies the nodes and the directed edges in the specified directed graph
+    * into this empty directed graph. The tail nodes of each node keep the order
+    * in which they were connected.
+    *
+    * @param rhs   the directed graph to be copied
+    */
+   template<typename T, typename S, typename A>
+   void DirectedGraph<T, S, A>::copy_edges(const DirectedGraph& rhs)
+   {
+      auto probe = record(GraphStats::copy);
+      if (buffer_.capacity() < rhs.size()) probe.allocate();
+      buffer_.reserve(rhs.size());
+      
+      probe.allocate(rhs.size());
+      
+      // Sizes the vectors of adjacent nodes once, so that linking the copies
+      // never grows them.
+      for (const auto& element : rhs.buffer_)
+      {
+         buffer_.push_back(make_node(size(), element -> data_));
+         const std::shared_ptr<Node>& node = buffer_.back();
+         
+         if (!element -> next_.empty()) probe.allocate();
+         if (!element -> prev_.empty()) probe.allocate();
+         node -> next_.reserve(element -> next_.size());
+         node -> prev_.reserve(element -> prev_.size());
+      }
+      
+      for (size_t i = 0; i < size(); i++)
+      {
+         const std::shared_ptr<Node>& head = buffer_[i];
+         probe.scan(rhs.buffer_[i] -> next_.size());
+         
+         for (const auto& element : rhs.buffer_[i] -> next_)
+         {
+            const std::shared_ptr<Node>& tail =
+               buffer_[element -> index_];
+            head -> next_.push_back(tail.get());
+            tail -> prev_.push_back(head.get());
+            if (indexed_) index_edge(head.get(), tail.get());
+         }
+      }
+      
+      edges_ = rhs.edges_;
+      edge_hashes_ = rhs.edge_hashes_;
+   }
+   
+   /**
+    * Counts one more directed edge from the specified starting node to the
+    * specified ending node in the edge index.
+    *
+    * @param head   the starting node
+    * @param tail   the ending node
+    */
+   template<typename T, typename S, typename A>
+   inline void DirectedGraph<T, S, A>::index_edge(const Node* head,
+      const Node* tail)
+   {
+      edge_index_[EdgeKey(head, tail)]++;
+   }
+   
+   /**
+    * Connects a directed edge from the node at position <i>from</i> to the
+    * node at position <i>to</i>, which must both be valid.
+    *
+    * @param from   the position of the starting node
+    * @param to     the position of the ending node
+    */
+   template<typename T, typename S, typename A>
+   void DirectedGraph<T, S, A>::link(const size_t& from, const size_t& to)
+   {
+      auto probe = record(GraphStats::connect);
+      Links& next = buffer_[from] -> next_;
+      Links& prev = buffer_[to] -> prev_;
+      if (next.size() == next.capacity()) probe.allocate();
+      if (prev.size() == prev.capacity()) probe.allocate();
+      
+      next.push_back(buffer_[to].get());
+      prev.push_back(buffer_[from].get());
+      if (indexed_) index_edge(buffer_[from].get(), buffer_[to].get());
+      add_edge_hash(from, to);
+   }
+   
+   /**
+    * Recomputes the structural hash from every directed edge in this directed
+    * graph, in linear time.
+    */
+   template<typename T, typename S, typename A>
+   void DirectedGraph<T, S, A>::rehash_edges()
+   {
+      edges_ = edge_hashes_ = 0;
+      
+      for (const auto& node : buffer_)
+      {
+         for (const auto& element : node -> next_)
+            add_edge_hash(node -> index_, element -> index_);
+      }
+   }
+   
+   /**
+    * Counts one less directed edge from the node at position <i>from</i> to
+    * the node at position <i>to</i> in the structural hash.
+    *
+    * @param from   the position of the starting node
+    * @param to     the position of the ending node
+    */
+   template<typename T, typename S, typename A>
+   inline void DirectedGraph<T, S, A>::remove_edge_hash(const size_t& from,
+      const size_t& to)
+   {
+      edges_--;
+      edge_hashes_ -= edge_hash(from, to);
+   }
+   
+   /**
+    * Updates the positions stored in the nodes from position <i>first</i> on,
+    * after the node that was there has been removed.
+    *
+    * @param first   the position of the first node to be renumbered
+    */
+   template<typename T, typename S, typename A>
+   inline void DirectedGraph<T, S, A>::renumber(const size_t& first)
+   {
+      for (size_t i = first; i < size(); i++) buffer_[i] -> index_ = i;
+   }
+   
+   /**
+    * Counts one less directed edge from the specified starting node to the
+    * specified ending node in the edge index, which must count at least one.
+    *
+    * @param head   the starting node
+    * @param tail   the ending node
+    */
+   template<typename T, typename S, typename A>
+   inline void DirectedGraph<T, S, A>::unindex_edge(const Node* head,
+      const Node* tail)
+   {
+      auto position = edge_index_.find(EdgeKey(head, tail));
+      if (--position -> second == 0) edge_index_.erase(position);
+   }
+   
+   /**
+    * Removes every link after the first one to each node from the specified
+    * vector of links. Each node that is reached is marked with the specified
+    * stamp, so a vector of marks can be reused for every vector of links as
+    * long as each one is given a different stamp.
+    *
+    * @param links   the vector of links to adjacent nodes
+    * @param marks   the last stamp with which each node was marked
+    * @param stamp   the stamp for this vector of links
+    */
+   template<typename T, typename S, typename A>
+   void DirectedGraph<T, S, A>::unique_links(Links& links, Indices& marks,
+      const size_t& stamp)
+   {
+      size_t count = 0;
+      
+      for (size_t i = 0; i < links.size(); i++)
+      {
+         size_t& mark = marks[links[i] -> index_];
+         if (mark == stamp) continue;
+         
+         mark = stamp;
+         if (count != i) links[count] = std::move(links[i]);
+         count++;
+      }
+      
+      links.erase(links.begin() + count, links.end());
+   }
+   
+   /**
+    * Disconnects the rightmost directed edge from the node at position
+    * <i>from</i> to the node at position <i>to</i>, which must both be valid.
+    *
+    * @param from   the position of the starting node
+    * @param to     the position of the ending node
+    *
+    * @return <code>true</code> if a directed edge was disconnected, or
+    * <code>false</code> if there is no such directed edge
+    */
+   template<typename T, typename S, typename A>
+   bool DirectedGraph<T, S, A>::unlink(const size_t& from, const size_t& to)
+   {
+      auto probe = record(GraphStats::disconnect_edge);
+      const std::shared_ptr<Node>& head = buffer_[from];
+      const std::shared_ptr<Node>& tail = buffer_[to];
+      
+      // Tests if the given directed edge is missing, in constant time.
+      if (indexed_)
+      {
+         if (edge_index_.find(EdgeKey(head.get(), tail.get()))
+             == edge_index_.end())
+            return false;
+         
+         unindex_edge(head.get(), tail.get());
+      }
+      
+      // Removes the rightmost occurrence of the given directed edge.
+      Links& edge = head -> next_;
+      bool found = false;
+      
+      for (size_t i = edge.size(); i > 0; i--)
+      {
+         probe.scan();
+         
+         if (edge[i - 1] == tail.get())
+         {
+            edge.erase(edge.begin() + i - 1);
+            found = true;
+            break;
+         }
+      }
+      
+      if (!found) return false;
+      remove_edge_hash(from, to);
+      
+      Links& reverse = tail -> prev_;
+      
+      for (size_t i = reverse.size(); i > 0; i--)
+      {
+         probe.scan();
+         
+         if (reverse[i - 1] == head.get())
+         {
+            reverse.erase(reverse.begin() + i - 1);
+            break;
+         }
+      }
+      
+      return true;
+   }
+   
+   /**
+    * Returns the hash of a directed edge from the node at position
+    * <i>from</i> to the node at position <i>to</i>. The positions are mixed
+    * thoroughly, so that the sum of the hashes of different sets of directed
+    * edges rarely collides.
+    *
+    * @param from   the position of the starting node
+    * @param to     the position of the ending node
+    *
+    * @return the hash of the directed edge
+    */
+   template<typename T, typename S, typename A>
+   inline size_t DirectedGraph<T, S, A>::edge_hash(const size_t& from,
+      const size_t& to)
+   {
+      unsigned long long x = from * 0x9e3779b97f4a7c15ULL + to;
+      x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+      x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+      return static_cast<size_t>(x ^ (x >> 31));
+   }
+   
+   /**
+    * Allocates a node at the specified position, along with its vectors of
+    * adjacent nodes, with the allocator of this directed graph. The value of
+    * the node is constructed in place from the specified arguments.
+    *
+    * @param index   the position of the node
+    * @param args    the arguments with which to construct the value
+    *
+    * @return a pointer to the new node
+    */
+   template<typename T, typename S, typename A>
+   template<typename... Args>
+   inline std::shared_ptr<typename DirectedGraph<T, S, A>::Node>
+      DirectedGraph<T, S, A>::make_node(const size_t& index, Args&&... args)
+      const
+   {
+      return std::allocate_shared<Node>(get_allocator(), get_allocator(), index,
+         std::forward<Args>(args)...);
+   }
+   
+   /**
+    * Returns a probe that records one call of the specified operation in the
+    * stats of this directed graph, or that records nothing if the stats are
+    * not kept.
+    *
+    * @param op   the operation
+    *
+    * @return the probe
+    */
+   template<typename T, typename S, typename A>
+   inline GraphStats::Probe DirectedGraph<T, S, A>::record(
+      const GraphStats::Operation& op) const
+   {
+#ifdef PIC_10C_DIRECTED_GRAPH_STATS
+      return GraphStats::Probe(stats_, op);
+#else
+      static_cast<void>(op);
+      return GraphStats::Probe();
+#endif
+   }
+   
+   /**
+    * Tests if <i>k</i> is within the bounds of valid positions in the directed
+    * graph, throwing an <code>std::out_of_range</code> exception if it is not
+    * (i.e., if <i>k</i> is greater than or equal to the number of nodes in the
+    * directed graph).
+    *
+    * @param k       the position of the node
+    * @param error   the error message
+    *
+    * @throws std::out_of_range if <i>k</i> is out of bounds
+    */
+   template<typename T, typename S, typename A>
+   void DirectedGraph<T, S, A>::test_index(const size_t& k,
+      const char* error) const
+   {
+      if (k >= size()) throw_index_error(error, k);
+   }
+   
+   /** Constructs an iterator that does not point into any directed graph. */
+   template<typename T, typename S, typename A>
+   inline DirectedGraph<T, S, A>::Iterator::Iterator()
+      : position_(nullptr), container_(nullptr) {}
+   
+   /** Destroys this iterator. */
+   template<typename T, typename S, typename A>
+   inline DirectedGraph<T, S, A>::Iterator::~Iterator() {}
+   
+   /**
+    * Moves this iterator to the <i>k</i><sup>th</sup> tail node.<p>
+    *
+    * The function automatically checks whether <i>k</i> is greater than or
+    * equal to the outdegree of the node to which this iterator points, throwing
+    * an <code>std::out_of_range</code> exception if it is not.
+    *
+    * @param k    the tail node index
+    *
+    * @throws std::logic_error if this iterator does not point into any directed
+    * graph
+    * @throws std::out_of_range if <i>k</i> is out of bounds
+    */
+   template<typename T, typename S, typename A>
+   void DirectedGraph<T, S, A>::Iterator::next(const size_t& k)
+   {
+      // Tests if this iterator points into a directed graph.
+      if (position_ == nullptr)
+         throw std::logic_error("Iterator does not point to a directed graph");
+      
+      // Tests if k is valid.
+      if (k >= outdegree())
+         throw_index_error("Invalid tail node index for iterator: ", k);
+      
+      position_ = position_ -> next_[k] -> shared_from_this();
+   }
+   
+   /**
+    * Returns a reference to the value at the current position of this iterator.
+    *
+    * @return a reference to the value of the node to which this iterator points
+    *
+    * @throws std::logic_error if this iterator does not point into any directed
+    * graph
+    */
+   template<typename T, typename S, typename A>
+   T& DirectedGraph<T, S, A>::Iterator::operator*()
+   {
+      // Tests if this iterator points into a directed graph.
+      if (position_ == nullptr)
+         throw std::logic_error("Iterator does not point to a directed graph");
+      
+      return position_ -> data_;
+   }
+   
+   /**
+    * Moves this iterator to the <i>k</i><sup>th</sup> head node. The order of
+    * the head nodes of a node is unspecified.<p>
+    *
+    * The function automatically checks whether <i>k</i> is greater than or
+    * equal to the indegree of the node to which this iterator points, throwing
+    * an <code>std::out_of_range</code> exception if it is not.
+    *
+    * @param k    the head node index
+    *
+    * @throws std::logic_error if this iterator does not point into any directed
+    * graph
+    * @throws std::out_of_range if <i>k</i> is out of bounds
+    */
+   template<typename T, typename S, typename A>
+   void DirectedGraph<T, S, A>::Iterator::prev(const size_t& k)
+   {
+      // Tests if this iterator points into a directed graph.
+      if (position_ == nullptr)
+         throw std::logic_error("Iterator does not point to a directed graph");
+      
+      // Tests if k is valid.
+      if (k >= indegree())
+         throw_index_error("Invalid head node index for iterator: ", k);
+      
+      position_ = position_ -> prev_[k] -> shared_from_this();
+   }
+   
+   /**
+    * Returns the indegree at the current position of this iterator.
+    *
+    * @return the indegree of the node to which this iterator points
+    *
+    * @throws std::logic_error if this iterator does not point into any directed
+    * graph
+    */
+   template<typename T, typename S, typename A>
+   size_t DirectedGraph<T, S, A>::Iterator::indegree() const
+   {
+      // Tests if this iterator points into a directed graph.
+      if (position_ == nullptr)
+         throw std::logic_error("Iterator does not point to a directed graph");
+      
+      return position_ -> prev_.size();
+   }
+   
+   /**
+    * Returns the value at the current position of this iterator.
+    *
+    * @return the value of the node to which this iterator points
+    *
+    * @throws std::logic_error if this iterator does not point into any directed
+    * graph
+    */
+   template<typename T, typename S, typename A>
+   T DirectedGraph<T, S, A>::Iterator::operator*() const
+   {
+      // Tests if this iterator points into a directed graph.
+      if (position_ == nullptr)
+         throw std::logic_error("Iterator does not point to a directed graph");
+      
+      return position_ -> data_;
+   }
+   
+   /**
+    * Returns a pointer to the value at the current position of this iterator.
+    *
+    * @return a pointer to the value of the node to which this iterator points
+    *
+    * @throws std::logic_error if this iterator does not point into any directed
+    * graph
+    */
+   template<typename T, typename S, typename A>
+   T* DirectedGraph<T, S, A>::Iterator::operator->() const
+   {
+      // Tests if this iterator points into a directed graph.
+      if (position_ == nullptr)
+         throw std::logic_error("Iterator does not point to a directed graph");
+      
+      return &position_ -> data_;
+   }
+   
+   /**
+    * Returns the outdegree at the current position of this iterator.
+    *
+    * @return the outdegree of the node to which this iterator points
+    *
+    * @throws std::logic_error if this iterator does not point into any directed
+    * graph
+    */
+   template<typename T, typename S, typename A>
+   size_t DirectedGraph<T, S, A>::Iterator::outdegree() const
+   {
+      // Tests if this iterator points into a directed graph.
+      if (position_ == nullptr)
+         throw std::logic_error("Iterator does not point to a directed graph");
+      
+      return position_ -> next_.size();
+   }
+   
+   /**
+    * Tests if this iterator and the specified iterator are equal.
+    *
+    * @param rhs   the iterator to compare with this iterator
+    *
+    * @return <code>true</code> if this iterator and the specified iterator are
+    * equal, or <code>false</code> otherwise
+    */
+   template<typename T, typename S, typename A>
+   inline bool DirectedGraph<T, S, A>::Iterator
+      ::operator==(const Iterator& rhs) const
+   {
+      return position_ == rhs.position_;
+   }
+   
+   /**
+    * Tests if this iterator and the specified iterator are unequal.
+    *
+    * @param rhs   the iterator to compare with this iterator
+    *
+    * @return <code>true</code> if this iterator and the specified iterator are
+    * unequal, or <code>false</code> otherwise
+    */
+   template<typename T, typename S, typename A>
+   inline bool DirectedGraph<T, S, A>::Iterator
+      ::operator!=(const Iterator& rhs) const
+   {
+      return position_ != rhs.position_;
+   }
+   
+   /**
+    * Constructs a cursor to the node at the specified position in the
+    * specified directed graph.
+    *
+    * @param graph   the directed graph
+    * @param index   the position of the node
+    */
+   template<typename T, typename S, typename A>
+   inline DirectedGraph<T, S, A>::Cursor::Cursor(const DirectedGraph* graph,
+      const size_t& index) : graph_(graph), index_(index) {}
+   
+   /**
+    * Returns the position of the node to which this cursor points.
+    *
+    * @return the position of the node
+    */
+   template<typename T, typename S, typename A>
+   inline size_t DirectedGraph<T, S, A>::Cursor::index() const
+   {
+      return index_;
+   }
+   
+   /**
+    * Returns the indegree of the node to which this cursor points.
+    *
+    * @return the indegree of the node
+    */
+   template<typename T, typename S, typename A>
+   inline size_t DirectedGraph<T, S, A>::Cursor::indegree() const
+   {
+      return graph_ -> buffer_[index_] -> prev_.size();
+   }
+   
+   /**
+    * Returns the positions of the head nodes of the node to which this cursor
+    * points.
+    *
+    * @return the view of the head node positions
+    */
+   template<typename T, typename S, typename A>
+   inline typename DirectedGraph<T, S, A>::Neighbors
+      DirectedGraph<T, S, A>::Cursor::in_neighbors() const
+   {
+      return Neighbors(graph_ -> buffer_[index_] -> prev_);
+   }
+   
+   /**
+    * Returns the positions of the tail nodes of the node to which this cursor
+    * points, in the order in which they were connected.
+    *
+    * @return the view of the tail node positions
+    */
+   template<typename T, typename S, typename A>
+   inline typename DirectedGraph<T, S, A>::Neighbors
+      DirectedGraph<T, S, A>::Cursor::neighbors() const
+   {
+      return Neighbors(graph_ -> buffer_[index_] -> next_);
+   }
+   
+   /**
+    * Returns a cursor to the <i>k</i><sup>th</sup> tail node of the node to
+    * which this cursor points.<p>
+    *
+    * The function automatically checks whether <i>k</i> is greater than or
+    * equal to the outdegree of the node, throwing an
+    * <code>std::out_of_range</code> exception if it is.
+    *
+    * @param k   the tail node index
+    *
+    * @return a cursor to the tail node
+    *
+    * @throws std::out_of_range if <i>k</i> is out of bounds
+    */
+   template<typename T, typename S, typename A>
+   typename DirectedGraph<T, S, A>::Cursor
+      DirectedGraph<T, S, A>::Cursor::next(const size_t& k) const
+   {
+      const Links& links = graph_ -> buffer_[index_] -> next_;
+      
+      // Tests if k is valid.
+      if (k >= links.size())
+         throw_index_error("Invalid tail node index for cursor: ", k);
+      
+      return Cursor(graph_, links[k] -> index_);
+   }
+   
+   /**
+    * Returns a reference to the value of the node to which this cursor points.
+    *
+    * @return a reference to the value of the node
+    */
+   template<typename T, typename S, typename A>
+   inline const T& DirectedGraph<T, S, A>::Cursor::operator*() const
+   {
+      return graph_ -> buffer_[index_] -> data_;
+   }
+   
+   /**
+    * Returns a pointer to the value of the node to which this cursor points.
+    *
+    * @return a pointer to the value of the node
+    */
+   template<typename T, typename S, typename A>
+   inline const T* DirectedGraph<T, S, A>::Cursor::operator->() const
+   {
+      return &graph_ -> buffer_[index_] -> data_;
+   }
+   
+   /**
+    * Returns the outdegree of the node to which this cursor points.
+    *
+    * @return the outdegree of the node
+    */
+   template<typename T, typename S, typename A>
+   inline size_t DirectedGraph<T, S, A>::Cursor::outdegree() const
+   {
+      return graph_ -> buffer_[index_] -> next_.size();
+   }
+   
+   /**
+    * Returns a cursor to the <i>k</i><sup>th</sup> head node of the node to
+    * which this cursor points. The order of the head nodes of a node is
+    * unspecified.<p>
+    *
+    * The function automatically checks whether <i>k</i> is greater than or
+    * equal to the indegree of the node, throwing an
+    * <code>std::out_of_range</code> exception if it is.
+    *
+    * @param k   the head node index
+    *
+    * @return a cursor to the head node
+    *
+    * @throws std::out_of_range if <i>k</i> is out of bounds
+    */
+   template<typename T, typename S, typename A>
+   typename DirectedGraph<T, S, A>::Cursor
+      DirectedGraph<T, S, A>::Cursor::prev(const size_t& k) const
+   {
+      const Links& links = graph_ -> buffer_[index_] -> prev_;
+      
+      // Tests if k is valid.
+      if (k >= links.size())
+         throw_index_error("Invalid head node index for cursor: ", k);
+      
+      return Cursor(graph_, links[k] -> index_);
+   }
+   
+   /**
+    * Tests if this cursor and the specified cursor point to the same node.
+    *
+    * @param rhs   the other cursor
+    *
+    * @return <code>true</code> if the two cursors are equal, or
+    * <code>false</code> otherwise
+    */
+   template<typename T, typename S, typename A>
+   inline bool DirectedGraph<T, S, A>::Cursor::operator==(const Cursor& rhs)
+      const
+   {
+      return graph_ == rhs.graph_ && index_ == rhs.index_;
+   }
+   
+   /**
+    * Tests if this cursor and the specified cursor point to different nodes.
+    *
+    * @param rhs   the other cursor
+    *
+    * @return <code>true</code> if the two cursors are unequal, or
+    * <code>false</code> otherwise
+    */
+   template<typename T, typename S, typename A>
+   inline bool DirectedGraph<T, S, A>::Cursor::operator!=(const Cursor& rhs)
+      const
+   {
+      return !(*this == rhs);
+   }
+   
+   /** Constructs a neighbor iterator that points to no adjacent node. */
+   template<typename T, typename S, typename A>
+   inline DirectedGraph<T, S, A>::NeighborIterator::NeighborIterator()
+      : position_(nullptr) {}
+   
+   /**
+    * Constructs a neighbor iterator that points to the specified link.
+    *
+    * @param position   the link to the adjacent node
+    */
+   template<typename T, typename S, typename A>
+   inline DirectedGraph<T, S, A>::NeighborIterator::NeighborIterator(
+      Node* const* position) : position_(position) {}
+   
+   /**
+    * Moves this neighbor iterator to the next adjacent node.
+    *
+    * @return this neighbor iterator after it is moved
+    */
+   template<typename T, typename S, typename A>
+   inline typename DirectedGraph<T, S, A>::NeighborIterator&
+      DirectedGraph<T, S, A>::NeighborIterator::operator++()
+   {
+      ++position_;
+      return *this;
+   }
+   
+   /**
+    * Moves this neighbor iterator to the next adjacent node.
+    *
+    * @return a copy of this neighbor iterator before it is moved
+    */
+   template<typename T, typename S, typename A>
+   inline typename DirectedGraph<T, S, A>::NeighborIterator
+      DirectedGraph<T, S, A>::NeighborIterator::operator++(int)
+   {
+      NeighborIterator copy = *this;
+      ++position_;
+      return copy;
+   }
+   
+   /**
+    * Returns a reference to the position of the current adjacent node.
+    *
+    * @return a reference to the position of the adjacent node
+    */
+   template<typename T, typename S, typename A>
+   inline const size_t& DirectedGraph<T, S, A>::NeighborIterator::operator*()
+      const
+   {
+      return (*position_) -> index_;
+   }
+   
+   /**
+    * Returns a pointer to the position of the current adjacent node.
+    *
+    * @return a pointer to the position of the adjacent node
+    */
+   template<typename T, typename S, typename A>
+   inline const size_t* DirectedGraph<T, S, A>::NeighborIterator::operator->()
+      const
+   {
+      return &(*position_) -> index_;
+   }
+   
+   /**
+    * Tests if this neighbor iterator and the specified neighbor iterator
+    * point to the same link.
+    *
+    * @param rhs   the other neighbor iterator
+    *
+    * @return <code>true</code> if the two neighbor iterators are equal, or
+    * <code>false</code> otherwise
+    */
+   template<typename T, typename S, typename A>
+   inline bool DirectedGraph<T, S, A>::NeighborIterator::operator==(
+      const NeighborIterator& rhs) const
+   {
+      return position_ == rhs.position_;
+   }
+   
+   /**
+    * Tests if this neighbor iterator and the specified neighbor iterator
+    * point to different links.
+    *
+    * @param rhs   the other neighbor iterator
+    *
+    * @return <code>true</code> if the two neighbor iterators are unequal, or
+    * <code>false</code> otherwise
+    */
+   template<typename T, typename S, typename A>
+   inline bool DirectedGraph<T, S, A>::NeighborIterator::operator!=(
+      const NeighborIterator& rhs) const
+   {
+      return position_ != rhs.position_;
+   }
+   
+   /**
+    * Constructs a view of the positions of the nodes in the specified vector
+    * of links.
+    *
+    * @param links   the vector of links to adjacent nodes
+    */
+   template<typename T, typename S, typename A>
+   inline DirectedGraph<T, S, A>::Neighbors::Neighbors(const Links& links)
+      : first_(links.data()), last_(links.data() + links.size()) {}
+   
+   /**
+    * Returns an iterator to the first adjacent node in this view.
+    *
+    * @return an iterator to the first adjacent node
+    */
+   template<typename T, typename S, typename A>
+   inline typename DirectedGraph<T, S, A>::NeighborIterator
+      DirectedGraph<T, S, A>::Neighbors::begin() const
+   {
+      return NeighborIterator(first_);
+   }
+   
+   /**
+    * Tests if this view is empty.
+    *
+    * @return <code>true</code> if this view has no adjacent nodes, or
+    * <code>false</code> otherwise
+    */
+   template<typename T, typename S, typename A>
+   inline bool DirectedGraph<T, S, A>::Neighbors::empty() const
+   {
+      return first_ == last_;
+   }
+   
+   /**
+    * Returns an iterator past the last adjacent node in this view.
+    *
+    * @return an iterator past the last adjacent node
+    */
+   template<typename T, typename S, typename A>
+   inline typename DirectedGraph<T, S, A>::NeighborIterator
+      DirectedGraph<T, S, A>::Neighbors::end() const
+   {
+      return NeighborIterator(last_);
+   }
+   
+   /**
+    * Returns the number of adjacent nodes in this view.
+    *
+    * @return the number of adjacent nodes
+    */
+   template<typename T, typename S, typename A>
+   inline size_t DirectedGraph<T, S, A>::Neighbors::size() const
+   {
+      return last_ - first_;
+   }
+   
+   /** Constructs a vertex iterator that points into no directed graph. */
+   template<typename T, typename S, typename A>
+   inline DirectedGraph<T, S, A>::VertexIterator::VertexIterator()
+      : graph_(nullptr), index_(0) {}
+   
+   /**
+    * Constructs a vertex iterator to the node at the specified position in
+    * the specified directed graph.
+    *
+    * @param graph   the directed graph
+    * @param index   the position of the node
+    */
+   template<typename T, typename S, typename A>
+   inline DirectedGraph<T, S, A>::VertexIterator::VertexIterator(
+      const DirectedGraph* graph, const size_t& index)
+      : graph_(graph), index_(index) {}
+   
+   /**
+    * Moves this vertex iterator to the next node.
+    *
+    * @return this vertex iterator after it is moved
+    */
+   template<typename T, typename S, typename A>
+   inline typename DirectedGraph<T, S, A>::VertexIterator&
+      DirectedGraph<T, S, A>::VertexIterator::operator++()
+   {
+      ++index_;
+      return *this;
+   }
+   
+   /**
+    * Moves this vertex iterator to the next node.
+    *
+    * @return a copy of this vertex iterator before it is moved
+    */
+   template<typename T, typename S, typename A>
+   inline typename DirectedGraph<T, S, A>::VertexIterator
+      DirectedGraph<T, S, A>::VertexIterator::operator++(int)
+   {
+      VertexIterator copy = *this;
+      ++index_;
+      return copy;
+   }
+   
+   /**
+    * Returns a cursor to the current node.
+    *
+    * @return a cursor to the node
+    */
+   template<typename T, typename S, typename A>
+   inline typename DirectedGraph<T, S, A>::Cursor
+      DirectedGraph<T, S, A>::VertexIterator::operator*() const
+   {
+      return Cursor(graph_, index_);
+   }
+   
+   /**
+    * Tests if this vertex iterator and the specified vertex iterator point to
+    * the same node.
+    *
+    * @param rhs   the other vertex iterator
+    *
+    * @return <code>true</code> if the two vertex iterators are equal, or
+    * <code>false</code> otherwise
+    */
+   template<typename T, typename S, typename A>
+   inline bool DirectedGraph<T, S, A>::VertexIterator::operator==(
+      const VertexIterator& rhs) const
+   {
+      return graph_ == rhs.graph_ && index_ == rhs.index_;
+   }
+   
+   /**
+    * Tests if this vertex iterator and the specified vertex iterator point to
+    * different nodes.
+    *
+    * @param rhs   the other vertex iterator
+    *
+    * @return <code>true</code> if the two vertex iterators are unequal, or
+    * <code>false</code> otherwise
+    */
+   template<typename T, typename S, typename A>
+   inline bool DirectedGraph<T, S, A>::VertexIterator::operator!=(
+      const VertexIterator& rhs) const
+   {
+      return !(*this == rhs);
+   }
+   
+   /**
+    * Constructs a view of all the nodes in the specified directed graph.
+    *
+    * @param graph   the directed graph
+    */
+   template<typename T, typename S, typename A>
+   inline DirectedGraph<T, S, A>::Vertices::Vertices(const DirectedGraph* graph)
+      : graph_(graph) {}
+   
+   /**
+    * Returns an iterator to the first node in this view.
+    *
+    * @return an iterator to the first node
+    */
+   template<typename T, typename S, typename A>
+   inline typename DirectedGraph<T, S, A>::VertexIterator
+      DirectedGraph<T, S, A>::Vertices::begin() const
+   {
+      return VertexIterator(graph_, 0);
+   }
+   
+   /**
+    * Tests if this view is empty.
+    *
+    * @return <code>true</code> if the directed graph has no nodes, or
+    * <code>false</code> otherwise
+    */
+   template<typename T, typename S, typename A>
+   inline bool DirectedGraph<T, S, A>::Vertices::empty() const
+   {
+      return graph_ -> empty();
+   }
+   
+   /**
+    * Returns an iterator past the last node in this view.
+    *
+    * @return an iterator past the last node
+    */
+   template<typename T, typename S, typename A>
+   inline typename DirectedGraph<T, S, A>::VertexIterator
+      DirectedGraph<T, S, A>::Vertices::end() const
+   {
+      return VertexIterator(graph_, graph_ -> size());
+   }
+   
+   /**
+    * Returns the number of nodes in this view.
+    *
+    * @return the number of nodes
+    */
+   template<typename T, typename S, typename A>
+   inline size_t DirectedGraph<T, S, A>::Vertices::size() const
+   {
+      return graph_ -> size();
+   }
+   
+   /**
+    * Constructs a batch of changes to the specified directed graph.
+    *
+    * @param graph   the directed graph
+    */
+   template<typename T, typename S, typename A>
+   inline DirectedGraph<T, S, A>::Batch::Batch(DirectedGraph* graph)
+      : graph_(graph), changes_(graph -> get_allocator()),
+        clears_(graph -> get_allocator()), erased_(graph -> get_allocator()),
+        cleared_(graph -> get_allocator()), tails_(graph -> get_allocator()),
+        stamp_(0) {}
+   
+   /** Discards every change recorded in this batch. */
+   template<typename T, typename S, typename A>
+   void DirectedGraph<T, S, A>::Batch::clear()
+   {
+      changes_.clear();
+      clears_.clear();
+      erased_.clear();
+      cleared_.clear();
+      tails_.clear();
+      stamp_ = 0;
+   }
+   
+   /**
+    * Applies every change recorded in this batch to its directed graph, on
+    * the specified number of threads, and leaves the batch empty.<p>
+    *
+    * The changes are grouped by pair of nodes, and the changes to each pair
+    * are resolved in order into the number of its directed edges that are
+    * kept and the directed edges that are still connected at the end. The
+    * nodes are split into one contiguous shard per thread, balanced by the
+    * number of adjacent nodes, and each thread then filters the vectors of
+    * adjacent nodes of its own shard, so no two threads ever write to the
+    * same node. The directed edges that are still connected are appended in
+    * the order they were recorded, and the nodes are erased, by the calling
+    * thread.<p>
+    *
+    * All the memory of the commit, the vectors of adjacent nodes and the edge
+    * index included, is allocated before the directed graph is first changed,
+    * and nothing after that can throw. If an exception is thrown, the
+    * directed graph is left unchanged, and the batch can be committed again.
+    *
+    * @param threads   the number of threads, or 0 for one per hardware thread
+    */
+   template<typename T, typename S, typename A>
+   void DirectedGraph<T, S, A>::Batch::commit(const size_t& threads)
+   {
+      if (empty()) return;
+      
+      DirectedGraph& graph = *graph_;
+      const size_t n = graph.size();
+      const A alloc = graph.get_allocator();
+      tails_.clear();
+      
+      size_t count = threads;
+      if (count == 0) count = std::thread::hardware_concurrency();
+      if (count == 0) count = 1;
+      
+      // Groups the changes by pair of nodes, in the order they were recorded.
+      counting_sort(changes_, &Change::to, n);
+      counting_sort(changes_, &Change::from, n);
+      
+      counting_sort(clears_, &std::pair<size_t, size_t>::first, n);
+      cleared_.assign(n, false);
+      for (const auto& element : clears_) cleared_[element.first] = true;
+      
+      // Gives each shard about the same number of nodes and adjacent nodes.
+      std::vector<Shard, Allocator<Shard>> shards(alloc);
+      shards.reserve(count);
+      const size_t total = n + 2 * graph.edges();
+      size_t work = 0;
+      shards.push_back(Shard(n, alloc));
+      
+      for (size_t i = 0; i < n; i++)
+      {
+         const Node* node = graph.buffer_[i].get();
+         work += 1 + node -> next_.size() + node -> prev_.size();
+         shards.back().last = i + 1;
+         
+         if (shards.size() < count && i + 1 < n
+            && work * count >= total * shards.size())
+         {
+            shards.push_back(Shard(n, alloc));
+            shards.back().first = shards.back().last = i + 1;
+         }
+      }
+      
+      for (auto& element : shards)
+      {
+         auto compare = [](const Change& lhs, const size_t& rhs)
+         {
+            return lhs.from < rhs;
+         };
+         
+         element.first_change = std::lower_bound(changes_.begin(),
+            changes_.end(), element.first, compare) - changes_.begin();
+         element.last_change = std::lower_bound(changes_.begin(),
+            changes_.end(), element.last, compare) - changes_.begin();
+         
+         const size_t changes = element.last_change - element.first_change;
+         element.heads.reserve(changes);
+         element.added.reserve(changes);
+      }
+      
+      run(shards, &Batch::resolve);
+      
+      // Hands each removal to the shard of its ending node.
+      for (const auto& element : shards)
+      {
+         tails_.insert(tails_.end(), element.heads.begin(),
+            element.heads.end());
+      }
+      
+      counting_sort(tails_, &Removal::to, n);
+      
+      for (auto& element : shards)
+      {
+         auto compare = [](const Removal& lhs, const size_t& rhs)
+         {
+            return lhs.to < rhs;
+         };
+         
+         element.first_tail = std::lower_bound(tails_.begin(), tails_.end(),
+            element.first, compare) - tails_.begin();
+         element.last_tail = std::lower_bound(tails_.begin(), tails_.end(),
+            element.last, compare) - tails_.begin();
+      }
+      
+      Changes added(alloc);
+      
+      for (const auto& element : shards)
+         added.insert(added.end(), element.added.begin(), element.added.end());
+      
+      counting_sort(added, &Change::stamp, stamp_);
+      
+      // Makes room for the remaining directed edges, which the splice only
+      // makes more of.
+      Indices heads(n, 0, alloc);
+      Indices tails(n, 0, alloc);
+      
+      for (const auto& element : added)
+      {
+         heads[element.from]++;
+         tails[element.to]++;
+      }
+      
+      for (size_t i = 0; i < n; i++)
+      {
+         Node* node = graph.buffer_[i].get();
+         if (heads[i] != 0)
+            node -> next_.reserve(node -> next_.size() + heads[i]);
+         if (tails[i] != 0)
+            node -> prev_.reserve(node -> prev_.size() + tails[i]);
+      }
+      
+      // Builds the edge index of the result from the current one.
+      EdgeIndex index(alloc);
+      
+      if (graph.indexed_)
+      {
+         index = graph.edge_index_;
+         
+         for (const auto& element : clears_)
+         {
+            const Node* node = graph.buffer_[element.first].get();
+            for (const auto& link : node -> next_)
+               index.erase(EdgeKey(node, link));
+            for (const auto& link : node -> prev_)
+               index.erase(EdgeKey(link, node));
+         }
+         
+         for (const auto& element : tails_)
+         {
+            const EdgeKey key(graph.buffer_[element.from].get(),
+               graph.buffer_[element.to].get());
+            if (element.keep == 0) index.erase(key);
+            else index[key] = element.keep;
+         }
+         
+         for (const auto& element : added)
+         {
+            index[EdgeKey(graph.buffer_[element.from].get(),
+               graph.buffer_[element.to].get())]++;
+         }
+      }
+      
+      // Nothing from here on can throw.
+      run(shards, &Batch::splice);
+      
+      // Connects the remaining directed edges in the order they were recorded.
+      for (const auto& element : added)
+      {
+         Node* head = graph.buffer_[element.from].get();
+         Node* tail = graph.buffer_[element.to].get();
+         head -> next_.push_back(tail);
+         tail -> prev_.push_back(head);
+      }
+      
+      // Erases the nodes, which have no adjacent nodes left.
+      if (!erased_.empty())
+      {
+         size_t kept = 0;
+         
+         for (size_t i = 0; i < n; i++)
+         {
+            if (erased_[i]) continue;
+            if (kept != i) graph.buffer_[kept] = std::move(graph.buffer_[i]);
+            kept++;
+         }
+         
+         graph.buffer_.erase(graph.buffer_.begin() + kept, graph.buffer_.end());
+         graph.renumber(0);
+      }
+      
+      graph.rehash_edges();
+      if (graph.indexed_) graph.edge_index_.swap(index);
+      
+      clear();
+   }
+   
+   /**
+    * Records a directed edge to be connected from the specified starting node
+    * to the specified ending node.<p>
     *
-    * @return the number of nodes
-    */
-   template<typename T>
-   inline size_t DirectedGraph<T>::size() const { return buffer_.size(); }
-   
-   /**
-    * Tests if this directed graph and the specified directed graph are equal.
+    * The function automatically checks whether <code>from</code> and
+    * <code>to</code> are valid positions of nodes that are not erased by this
+    * batch, throwing an <code>std::out_of_range</code> exception if they are
+    * not.
     *
-    * @param rhs   the directed graph to compare with this directed graph
+    * @param from   the position of the starting node
+    * @param to     the position of the ending node
     *
-    * @return <code>true</code> if this directed graph and the specified
-    * directed graph are equal, or <code>false</code> otherwise
+    * @throws std::out_of_range if either <code>from</code> or <code>to</code>
+    * is out of bounds
     */
-   template<typename T>
-   bool DirectedGraph<T>::operator==(const DirectedGraph& rhs) const
+   template<typename T, typename S, typename A>
+   void DirectedGraph<T, S, A>::Batch::connect(const size_t& from,
+      const size_t& to)
    {
-      // Tests if the two directed graphs have the same number of nodes.
-      if (size() != rhs.size()) return false;
-      
-      // Tests if the two directed graphs have the same nodes.
-      for (size_t i = 0; i < size(); i++)
-         if (buffer_[i] -> data_ != rhs.buffer_[i] -> data_) return false;
-      
-      // Tests if the two directed graphs have the same directed edges.
-      if (path_ != rhs.path_) return false;
+      // Tests if the starting and ending node indices are valid.
+      test_index(from, "Invalid starting node index in directed graph: ");
+      test_index(to, "Invalid ending node index in directed graph: ");
       
-      return true;
+      changes_.push_back(Change{ from, to, stamp_++, true });
    }
    
    /**
-    * Tests if this directed graph and the specified directed graph are unequal.
+    * Records all head nodes and all tail nodes adjacent to the node at
+    * position <i>k</i> to be disconnected from it.<p>
     *
-    * @param rhs   the directed graph to compare with this directed graph
+    * The function automatically checks whether <i>k</i> is a valid position
+    * of a node that is not erased by this batch, throwing an
+    * <code>std::out_of_range</code> exception if it is not.
     *
-    * @return <code>true</code> if this directed graph and the specified
-    * directed graph are unequal, or <code>false</code> otherwise
+    * @param k   the position of the node
+    *
+    * @throws std::out_of_range if <i>k</i> is out of bounds
     */
-   template<typename T>
-   bool DirectedGraph<T>::operator!=(const DirectedGraph& rhs) const
+   template<typename T, typename S, typename A>
+   void DirectedGraph<T, S, A>::Batch::disconnect(const size_t& k)
    {
-      // Tests if the two directed graphs have the same number of nodes.
-      if (size() != rhs.size()) return true;
-      
-      // Tests if the two directed graphs have the same nodes.
-      for (size_t i = 0; i < size(); i++)
-         if (buffer_[i] -> data_ != rhs.buffer_[i] -> data_) return true;
-      
-      // Tests if the two directed graphs have the same directed edges.
-      if (path_ != rhs.path_) return true;
+      // Tests if k is valid.
+      test_index(k, "Invalid node index in directed graph: ");
       
-      return false;
+      clears_.push_back(std::make_pair(k, stamp_++));
    }
    
    /**
-    * Tests if <i>k</i> is within the bounds of valid positions in the directed
-    * graph, throwing an <code>std::out_of_range</code> exception if it is not
-    * (i.e., if <i>k</i> is greater than or equal to the number of nodes in the
-    * directed graph).
+    * Records a directed edge to be disconnected from the specified starting
+    * node to the specified ending node. As with
+    * <code>DirectedGraph::disconnect</code>, the rightmost such directed edge
+    * at that point is disconnected, if there is any.<p>
     *
-    * @param k       the position of the node
-    * @param error   the error message
+    * The function automatically checks whether <code>from</code> and
+    * <code>to</code> are valid positions of nodes that are not erased by this
+    * batch, throwing an <code>std::out_of_range</code> exception if they are
+    * not.
     *
-    * @throws std::out_of_range if <i>k</i> is out of bounds
+    * @param from   the position of the starting node
+    * @param to     the position of the ending node
+    *
+    * @throws std::out_of_range if either <code>from</code> or <code>to</code>
+    * is out of bounds
     */
-   template<typename T>
-   void DirectedGraph<T>::test_index(const size_t& k, const std::string& error) const
+   template<typename T, typename S, typename A>
+   void DirectedGraph<T, S, A>::Batch::disconnect(const size_t& from,
+      const size_t& to)
    {
-      if (k >= size())
-         throw std::out_of_range(error + boost::lexical_cast<std::string>(k));
+      // Tests if the starting and ending node indices are valid.
+      test_index(from, "Invalid starting node index in directed graph: ");
+      test_index(to, "Invalid ending node index in directed graph: ");
+      
+      changes_.push_back(Change{ from, to, stamp_++, false });
    }
    
-   /** Constructs an iterator that does not point into any directed graph. */
-   template<typename T>
-   inline DirectedGraph<T>::Iterator::Iterator()
-      : position_(nullptr), container_(nullptr) {}
-   
-   /** Destroys this iterator. */
-   template<typename T>
-   inline DirectedGraph<T>::Iterator::~Iterator() {}
-   
    /**
-    * Moves this iterator to the <i>k</i><sup>th</sup> tail node.<p>
+    * Records the node at position <i>k</i> to be erased, after all of its
+    * adjacent nodes are disconnected. The node keeps its position until this
+    * batch is committed.<p>
     *
-    * The function automatically checks whether <i>k</i> is greater than or
-    * equal to the outdegree of the node to which this iterator points, throwing
-    * an <code>std::out_of_range</code> exception if it is not.
+    * The function automatically checks whether <i>k</i> is a valid position
+    * of a node that is not erased by this batch, throwing an
+    * <code>std::out_of_range</code> exception if it is not.
     *
-    * @param k    the tail node index
+    * @param k   the position of the node
     *
-    * @throws std::logic_error if this iterator does not point into any directed
-    * graph
     * @throws std::out_of_range if <i>k</i> is out of bounds
     */
-   template<typename T>
-   void DirectedGraph<T>::Iterator::next(const size_t& k)
+   template<typename T, typename S, typename A>
+   void DirectedGraph<T, S, A>::Batch::erase(const size_t& k)
    {
-      // Tests if this iterator points into a directed graph.
-      if (position_ == nullptr)
-         throw std::logic_error("Iterator does not point to a directed graph");
-      
-      // Tests if k is valid.
-      if (k >= outdegree())
-      {
-         throw std::out_of_range("Invalid tail node index for iterator: "
-            + boost::lexical_cast<std::string>(k));
-      }
+      disconnect(k);
       
-      position_ = position_ -> next_[k].lock();
+      if (erased_.empty()) erased_.assign(graph_ -> size(), false);
+      erased_[k] = true;
    }
    
    /**
-    * Returns a reference to the value at the current position of this iterator.
-    *
-    * @return a reference to the value of the node to which this iterator points
+    * Tests if this batch is empty.
     *
-    * @throws std::logic_error if this iterator does not point into any directed
-    * graph
+    * @return <code>true</code> if no change has been recorded, or
+    * <code>false</code> otherwise
     */
-   template<typename T>
-   T& DirectedGraph<T>::Iterator::operator*()
+   template<typename T, typename S, typename A>
+   inline bool DirectedGraph<T, S, A>::Batch::empty() const
    {
-      // Tests if this iterator points into a directed graph.
-      if (position_ == nullptr)
-         throw std::logic_error("Iterator does not point to a directed graph");
-      
-      return position_ -> data_;
+      return stamp_ == 0;
    }
    
    /**
-    * Returns the value at the current position of this iterator.
+    * Returns the number of changes recorded in this batch.
     *
-    * @return the value of the node to which this iterator points
-    *
-    * @throws std::logic_error if this iterator does not point into any directed
-    * graph
+    * @return the number of changes
     */
-   template<typename T>
-   T DirectedGraph<T>::Iterator::operator*() const
+   template<typename T, typename S, typename A>
+   inline size_t DirectedGraph<T, S, A>::Batch::size() const
    {
-      // Tests if this iterator points into a directed graph.
-      if (position_ == nullptr)
-         throw std::logic_error("Iterator does not point to a directed graph");
-      
-      return position_ -> data_;
+      return stamp_;
    }
    
    /**
-    * Returns a pointer to the value at the current position of this iterator.
-    *
-    * @return a pointer to the value of the node to which this iterator points
+    * Sorts the specified changes, removals, or disconnections stably by the
+    * specified key, a position less than <i>n</i>, by counting sort, in
+    * <i>O</i>(<i>n</i> + <i>B</i>) time.
     *
-    * @throws std::logic_error if this iterator does not point into any directed
-    * graph
+    * @param entries   the changes, removals, or disconnections
+    * @param key       the key
+    * @param n         the bound of the key
     */
-   template<typename T>
-   T* DirectedGraph<T>::Iterator::operator->() const
+   template<typename T, typename S, typename A>
+   template<typename Entry>
+   void DirectedGraph<T, S, A>::Batch::counting_sort(
+      std::vector<Entry, Allocator<Entry>>& entries, size_t Entry::* key,
+      const size_t& n)
    {
-      // Tests if this iterator points into a directed graph.
-      if (position_ == nullptr)
-         throw std::logic_error("Iterator does not point to a directed graph");
+      if (entries.empty()) return;
       
-      return &position_ -> data_;
+      Indices start(n + 1, 0, entries.get_allocator());
+      for (const auto& element : entries) start[element.*key + 1]++;
+      for (size_t i = 0; i < n; i++) start[i + 1] += start[i];
+      
+      std::vector<Entry, Allocator<Entry>> sorted(entries.size(),
+         entries.front(), entries.get_allocator());
+      for (const auto& element : entries)
+         sorted[start[element.*key]++] = element;
+      
+      entries.swap(sorted);
    }
    
    /**
-    * Returns the outdegree at the current position of this iterator.
-    *
-    * @return the outdegree of the node to which this iterator points
+    * Removes from the specified vector of adjacent nodes of the node at
+    * position <i>k</i> every node that is disconnected, and every directed
+    * edge to or from another node past the number that the removals in the
+    * range [<code>first</code>, <code>last</code>) keep.
     *
-    * @throws std::logic_error if this iterator does not point into any directed
-    * graph
+    * @param links   the vector of adjacent nodes
+    * @param k       the position of the node
+    * @param first   the iterator to the first removal of the node
+    * @param last    the iterator past the last removal of the node
+    * @param other   the position in each removal of the other node
+    * @param shard   the shard of the node
     */
-   template<typename T>
-   size_t DirectedGraph<T>::Iterator::outdegree() const
+   template<typename T, typename S, typename A>
+   void DirectedGraph<T, S, A>::Batch::filter(Links& links, const size_t& k,
+      typename Removals::const_iterator first,
+      typename Removals::const_iterator last, size_t Removal::* other,
+      Shard& shard)
    {
-      // Tests if this iterator points into a directed graph.
-      if (position_ == nullptr)
-         throw std::logic_error("Iterator does not point to a directed graph");
+      if (cleared_[k])
+      {
+         links.clear();
+         return;
+      }
       
-      return position_ -> next_.size();
+      for (auto i = first; i != last; ++i)
+         shard.counts[(*i).*other] = i -> keep + 1;
+      
+      size_t count = 0;
+      
+      for (size_t i = 0; i < links.size(); i++)
+      {
+         const size_t position = links[i] -> index_;
+         if (cleared_[position]) continue;
+         
+         // Keeps only the first directed edges to a node with a removal.
+         const size_t limit = shard.counts[position];
+         if (limit != 0 && ++shard.marks[position] >= limit) continue;
+         
+         links[count++] = links[i];
+      }
+      
+      links.erase(links.begin() + count, links.end());
+      
+      for (auto i = first; i != last; ++i)
+         shard.counts[(*i).*other] = shard.marks[(*i).*other] = 0;
    }
    
    /**
-    * Tests if this iterator and the specified iterator are equal.
-    *
-    * @param rhs   the iterator to compare with this iterator
-    *
-    * @return <code>true</code> if this iterator and the specified iterator are
-    * equal, or <code>false</code> otherwise
+    * Resolves the changes from the nodes of the specified shard, pair of
+    * nodes by pair of nodes, into the number of directed edges between each
+    * pair that are kept and the directed edges that are still connected at
+    * the end. A disconnection takes the last directed edge connected by this
+    * batch first, since that is the rightmost one, and only then one of the
+    * directed edges that were already there.
+    *
+    * @param shard   the shard
     */
-   template<typename T>
-   inline bool DirectedGraph<T>::Iterator::operator==(const Iterator& rhs) const
+   template<typename T, typename S, typename A>
+   void DirectedGraph<T, S, A>::Batch::resolve(Shard& shard)
    {
-      return position_ == rhs.position_;
+      size_t i = shard.first_change;
+      
+      while (i < shard.last_change)
+      {
+         const size_t from = changes_[i].from;
+         size_t end = i;
+         while (end < shard.last_change && changes_[end].from == from) end++;
+         
+         // Counts the directed edges to each ending node that is changed.
+         for (size_t j = i; j < end; j++) shard.marks[changes_[j].to] = 1;
+         
+         for (const auto& element : graph_ -> buffer_[from] -> next_)
+         {
+            const size_t to = element -> index_;
+            if (shard.marks[to] != 0) shard.counts[to]++;
+         }
+         
+         while (i < end)
+         {
+            const size_t to = changes_[i].to;
+            const size_t original = shard.counts[to];
+            const size_t base = shard.added.size();
+            const bool cleared = cleared_[from] || cleared_[to];
+            size_t kept = original;
+            size_t stamp = 0;
+            
+            auto wiped = [&](const size_t& last)
+            {
+               return cleared && (disconnected(from, stamp, last)
+                  || disconnected(to, stamp, last));
+            };
+            
+            for (; i < end && changes_[i].to == to; i++)
+            {
+               const Change& change = changes_[i];
+               
+               if (wiped(change.stamp))
+               {
+                  kept = 0;
+                  shard.added.erase(shard.added.begin() + base,
+                     shard.added.end());
+               }
+               
+               if (change.connect) shard.added.push_back(change);
+               else if (shard.added.size() > base) shard.added.pop_back();
+               else if (kept > 0) kept--;
+               
+               stamp = change.stamp;
+            }
+            
+            if (wiped(stamp_))
+               shard.added.erase(shard.added.begin() + base, shard.added.end());
+            
+            // A disconnected node loses all of its directed edges anyway.
+            if (kept < original && !cleared)
+               shard.heads.push_back(Removal{ from, to, kept });
+            
+            shard.counts[to] = shard.marks[to] = 0;
+         }
+      }
    }
    
    /**
-    * Tests if this iterator and the specified iterator are unequal.
-    *
-    * @param rhs   the iterator to compare with this iterator
+    * Runs the specified task on each of the specified shards, one thread per
+    * shard. A shard whose thread cannot be started is taken by the calling
+    * thread, so the function only throws if the task does, or before the task
+    * is first run.
     *
-    * @return <code>true</code> if this iterator and the specified iterator are
-    * unequal, or <code>false</code> otherwise
+    * @param shards   the shards
+    * @param task     the task
     */
-   template<typename T>
-   inline bool DirectedGraph<T>::Iterator::operator!=(const Iterator& rhs) const
+   template<typename T, typename S, typename A>
+   template<typename Shards>
+   void DirectedGraph<T, S, A>::Batch::run(Shards& shards,
+      void (Batch::*task)(Shard&))
    {
-      return position_ != rhs.position_;
+      // The calling thread takes the first shard.
+      std::vector<std::thread> workers;
+      workers.reserve(shards.size() - 1);
+      
+      for (size_t i = 1; i < shards.size(); i++)
+      {
+         try
+         {
+            workers.push_back(std::thread(task, this, std::ref(shards[i])));
+         }
+         catch (const std::system_error&)
+         {
+            (this ->* task)(shards[i]);
+         }
+      }
+      
+      (this ->* task)(shards[0]);
+      for (auto& worker : workers) worker.join();
    }
    
    /**
-    * Constructs a node with the specified value.
+    * Filters the tail nodes and the head nodes of each node in the specified
+    * shard (see <code>filter</code>). Without any node to be disconnected,
+    * only the nodes with a removal are filtered.
     *
-    * @param val   the value to store in this node
+    * @param shard   the shard
     */
-   template<typename T>
-   inline DirectedGraph<T>::Node::Node(const T& val) : data_(val) {}
+   template<typename T, typename S, typename A>
+   void DirectedGraph<T, S, A>::Batch::splice(Shard& shard)
+   {
+      auto head = shard.heads.cbegin();
+      auto tail = tails_.cbegin() + shard.first_tail;
+      const auto tails = tails_.cbegin() + shard.last_tail;
+      
+      for (size_t i = shard.first; i < shard.last; i++)
+      {
+         Node* node = graph_ -> buffer_[i].get();
+         
+         auto first = head;
+         while (head != shard.heads.cend() && head -> from == i) ++head;
+         if (!clears_.empty() || first != head)
+            filter(node -> next_, i, first, head, &Removal::to, shard);
+         
+         first = tail;
+         while (tail != tails && tail -> to == i) ++tail;
+         if (!clears_.empty() || first != tail)
+            filter(node -> prev_, i, first, tail, &Removal::from, shard);
+      }
+   }
    
    /**
-    * Constructs a directed edge with the specified starting node and the
-    * specified ending node.
+    * Tests if the node at position <i>k</i> is recorded to be disconnected
+    * between the specified stamps.
     *
-    * @param from   the position of the starting node
-    * @param to     the position of the ending node
+    * @param k       the position of the node
+    * @param first   the stamp from which to look
+    * @param last    the stamp before which to look
+    *
+    * @return <code>true</code> if the node is disconnected in between, or
+    * <code>false</code> otherwise
     */
-   template<typename T>
-   inline DirectedGraph<T>::DirectedEdge::DirectedEdge(const size_t& head,
-      const size_t& tail)
-      : head_(head), tail_(tail) {}
+   template<typename T, typename S, typename A>
+   inline bool DirectedGraph<T, S, A>::Batch::disconnected(const size_t& k,
+      const size_t& first, const size_t& last) const
+   {
+      auto position = std::lower_bound(clears_.begin(), clears_.end(),
+         std::make_pair(k, first));
+      return position != clears_.end() && position -> first == k
+         && position -> second < last;
+   }
    
    /**
-    * Returns the position of the starting node for this directed edge.
+    * Tests if <i>k</i> is a valid position of a node that is not erased by
+    * this batch.
     *
-    * @return the position of the starting node
+    * @param k       the position of a node
+    * @param error   the error message, to which <i>k</i> is appended
+    *
+    * @throws std::out_of_range if <i>k</i> is out of bounds
     */
-   template<typename T>
-   inline size_t DirectedGraph<T>::DirectedEdge::head() const { return head_; }
+   template<typename T, typename S, typename A>
+   inline void DirectedGraph<T, S, A>::Batch::test_index(const size_t& k,
+      const char* error) const
+   {
+      if (k >= graph_ -> size() || (!erased_.empty() && erased_[k]))
+         throw_index_error(error, k);
+   }
    
    /**
-    * Returns the position of the ending node for this directed edge.
+    * Constructs a shard with no nodes, and with scratch space for the
+    * specified number of nodes allocated with the specified allocator.
     *
-    * @return the position of the ending node
+    * @param n       the number of nodes in the directed graph
+    * @param alloc   the allocator
     */
-   template<typename T>
-   inline size_t DirectedGraph<T>::DirectedEdge::tail() const { return tail_; }
+   template<typename T, typename S, typename A>
+   inline DirectedGraph<T, S, A>::Batch::Shard::Shard(const size_t& n,
+      const A& alloc)
+      : first(0), last(0), first_change(0), last_change(0), first_tail(0),
+        last_tail(0), counts(n, 0, alloc), marks(n, 0, alloc), heads(alloc),
+        added(alloc) {}
    
    /**
-    * Tests if the positions of the starting and ending nodes for this directed
-    * edge are equal to those of the specified directed edge.
+    * Constructs a node at the specified position whose value is constructed in
+    * place from the specified arguments, and whose vectors of adjacent nodes
+    * allocate their memory with the specified allocator.
     *
-    * @param rhs   the directed edge to compare with this directed edge
-    *
-    * @return <code>true</code> if the positions of the starting and ending
-    * nodes for this directed edge are equal to those of the specified directed
-    * edge, or <code>false</code> otherwise
+    * @param alloc   the allocator
+    * @param index   the position of the node in the directed graph
+    * @param args    the arguments with which to construct the value
     */
-   template<typename T>
-   inline bool DirectedGraph<T>::DirectedEdge
-      ::operator==(const DirectedEdge& rhs) const
-   {
-      return head_ == rhs.head_ && tail_ == rhs.tail_;
-   }
+   template<typename T, typename S, typename A>
+   template<typename... Args>
+   inline DirectedGraph<T, S, A>::Node::Node(const A& alloc,
+      const size_t& index, Args&&... args)
+      : data_(std::forward<Args>(args)...), index_(index), next_(alloc),
+        prev_(alloc) {}
    
    /**
-    * Tests if the position of the starting node for this directed edge is less
-    * than that of the specified directed edge.
+    * Returns the hash of the specified pair of node addresses.
     *
-    * @param rhs   the directed edge to compare with this directed edge
+    * @param key   the addresses of the starting and ending nodes
     *
-    * @return <code>true</code> if the position of the starting node for this
-    * directed edge is less than that of the specified directed edge, or
-    * <code>false</code> otherwise
+    * @return the hash of the pair
     */
-   template<typename T>
-   inline bool DirectedGraph<T>::DirectedEdge
-      ::operator<(const DirectedEdge& rhs) const
+   template<typename T, typename S, typename A>
+   inline size_t DirectedGraph<T, S, A>::EdgeHash::operator()(
+      const EdgeKey& key) const
    {
-      return head_ < rhs.head_;
+      const size_t head = std::hash<const Node*>()(key.first);
+      const size_t tail = std::hash<const Node*>()(key.second);
+      return head ^ (tail + static_cast<size_t>(0x9e3779b97f4a7c15ULL)
+         + (head << 6) + (head >> 2));
    }
    
    /**
     * Outputs the specified directed graph with the specified output stream.
+    * The output stream is not flushed; <code>GraphWriter</code> writes large
+    * directed graphs faster.
     *
     * @param out   the output stream
     * @param rhs   the directed graph to be outputted
     *
     * @return the stream after the output
     */
-   template<typename T>
-   std::ostream& operator<<(std::ostream& out, const DirectedGraph<T>& rhs)
+   template<typename T, typename S, typename A>
+   std::ostream& operator<<(std::ostream& out,
+      const DirectedGraph<T, S, A>& rhs)
    {
-      for (size_t i = 0; i < rhs.size(); i++)
+      for (const auto& node : rhs.buffer_)
       {
          // Outputs the current node by itself if it is disconnected.
-         if (rhs.indegree(i) == 0 && rhs.outdegree(i) == 0)
-            out << rhs[i] << std::endl;
+         if (node -> next_.empty() && node -> prev_.empty())
+            out << node -> data_ << '\n';
          
          // Outputs the starting and ending nodes for each directed edge.
          else
          {
-            for (const auto& element : rhs.buffer_[i] -> next_)
-               out << rhs[i] << " -> " << element.lock() -> data_ << std::endl;
+            for (const auto& element : node -> next_)
+            {
+               out << node -> data_ << " -> " << element -> data_
+                  << '\n';
+            }
          }
       }
       
       return out;
    }
+   
+   /**
+    * Exchanges the contents of the two specified directed graphs. This
+    * overload is found by argument-dependent lookup, so standard algorithms
+    * swap directed graphs without copying them.
+    *
+    * @param lhs   the first directed graph to be swapped
+    * @param rhs   the second directed graph to be swapped
+    */
+   template<typename T, typename S, typename A>
+   inline void swap(DirectedGraph<T, S, A>& lhs, DirectedGraph<T, S, A>& rhs)
+      noexcept
+   {
+      lhs.swap(rhs);
+   }
+   
+#if __cplusplus >= 201703L
+   /**
+    * The <code>pmr</code> namespace contains the <code>DirectedGraph</code>
+    * alias template for directed graphs that allocate their memory from an
+    * <code>std::pmr::memory_resource</code>, such as an
+    * <code>std::pmr::monotonic_buffer_resource</code> arena or an
+    * <code>std::pmr::unsynchronized_pool_resource</code> pool.
+    */
+   namespace pmr
+   {
+      template<typename T, typename S = LinkedStorage>
+      using DirectedGraph = Kris_Torres_UCLA_PIC_10C_Winter_2014
+         ::DirectedGraph<T, S, std::pmr::polymorphic_allocator<T>>;
+   }
+#endif
+}
+
+namespace std
+{
+   /**
+    * The hash of a directed graph with the <code>LinkedStorage</code> storage
+    * policy, which is consistent with <code>operator==</code> (see
+    * <code>DirectedGraph::hash</code>).
+    *
+    * @param T   the type of the elements
+    * @param A   the allocator type
+    */
+   template<typename T, typename A>
+   struct hash<Kris_Torres_UCLA_PIC_10C_Winter_2014::DirectedGraph<T,
+      Kris_Torres_UCLA_PIC_10C_Winter_2014::LinkedStorage, A>>
+   {
+      size_t operator()(const Kris_Torres_UCLA_PIC_10C_Winter_2014
+         ::DirectedGraph<T, Kris_Torres_UCLA_PIC_10C_Winter_2014
+         ::LinkedStorage, A>& graph) const
+      {
+         return graph.hash();
+      }
+   };
 }
 
 #endif   // PIC_10C_DIRECTED_GRAPH_H_
\ No newline at end of file
@@ -0,0 +1,595 @@
+/**
+ * Benchmarks of the operations of the <code>DirectedGraph</code> class, on
+ * directed graphs of several sizes and densities. Each benchmark takes the
+ * number of nodes and the density (0 for <i>sparse</i>, 1 for
+ * <i>power-law</i>, and 2 for <i>dense</i>) as its two arguments.<p>
+ *
+ * Build the benchmarks against Google Benchmark, and compare a run with the
+ * checked-in baseline, <code>directed_graph_benchmark.json</code>, with the
+ * <code>compare.py</code> tool of Google Benchmark. The baseline was recorded
+ * with a minimum time of 0.05 seconds for each benchmark, since the mutating
+ * benchmarks rebuild their directed graph outside the timed region of every
+ * iteration:
+ *
+ * <pre>
+ * g++ -std=c++11 -O2 -DNDEBUG -I. directed_graph_benchmark.cpp \
+ *    -lbenchmark -lpthread -o directed_graph_benchmark
+ * ./directed_graph_benchmark --benchmark_min_time=0.05 \
+ *    --benchmark_out=run.json --benchmark_out_format=json
+ * compare.py benchmarks directed_graph_benchmark.json run.json
+ * </pre>
+ *
+ * @file directed_graph_benchmark.cpp
+ *
+ * @author Kris Torres
+ *
+ * @date 2026-10-14
+ *
+ * @version 1.0
+ */
+
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <sstream>
+#include <utility>
+#include <vector>
+#include "benchmark/benchmark.h"
+#include "directed_graph.h"
+#include "compressed_directed_graph.h"
+#include "static_directed_graph.h"
+#include "graph_traversal.h"
+
+using namespace Kris_Torres_UCLA_PIC_10C_Winter_2014;
+
+namespace
+{
+   typedef DirectedGraph<int> Graph;
+   typedef std::vector<std::pair<size_t, size_t>> Edges;
+   
+   /** The densities of the benchmarked directed graphs. */
+   enum Density { sparse, power_law, dense };
+   
+   /** The number of mutations timed in each iteration of a benchmark. */
+   const size_t batch = 64;
+   
+   /** The average outdegree of the sparse and power-law directed graphs. */
+   const size_t degree = 4;
+   
+   /**
+    * Returns the directed edges of a random directed graph with <i>n</i>
+    * nodes and the specified density. A sparse directed graph has uniformly
+    * random directed edges; a power-law directed graph is grown by
+    * preferential attachment, so a few nodes have most of the head nodes; and
+    * a dense directed graph has a directed edge for about a quarter of the
+    * ordered pairs of nodes. The same arguments always give the same directed
+    * edges.
+    *
+    * @param n         the number of nodes
+    * @param density   the density
+    *
+    * @return the directed edges
+    */
+   Edges make_edges(const size_t& n, const int64_t& density)
+   {
+      std::mt19937_64 random(2014);
+      Edges result;
+      
+      if (density == sparse)
+      {
+         for (size_t i = 0; i < n * degree; i++)
+            result.push_back(std::make_pair(random() % n, random() % n));
+      }
+      
+      else if (density == power_law)
+      {
+         // Attaches each node to the endpoints of random existing edges.
+         for (size_t i = 1; i < n; i++)
+         {
+            for (size_t j = 0; j < degree; j++)
+            {
+               const size_t to = result.empty() || random() % 4 == 0
+                  ? random() % i : result[random() % result.size()].second;
+               result.push_back(std::make_pair(i, to));
+            }
+         }
+      }
+      
+      else
+      {
+         for (size_t i = 0; i < n; i++)
+         {
+            for (size_t j = 0; j < n; j++)
+               if (random() % 4 == 0) result.push_back(std::make_pair(i, j));
+         }
+      }
+      
+      return result;
+   }
+   
+   /**
+    * Returns a directed graph with <i>n</i> nodes, numbered by position, and
+    * the specified directed edges.
+    *
+    * @param n       the number of nodes
+    * @param edges   the directed edges
+    *
+    * @return the directed graph
+    */
+   Graph make_graph(const size_t& n, const Edges& edges)
+   {
+      Graph result;
+      result.reserve(n, edges.size());
+      
+      for (size_t i = 0; i < n; i++) result.push_back(static_cast<int>(i));
+      for (const auto& edge : edges) result.connect(edge.first, edge.second);
+      
+      return result;
+   }
+   
+   /**
+    * Labels the specified benchmark with its density, and reports the number
+    * of directed edges.
+    *
+    * @param state   the state of the benchmark
+    * @param edges   the number of directed edges
+    */
+   void describe(benchmark::State& state, const size_t& edges)
+   {
+      static const char* const names[] = { "sparse", "power-law", "dense" };
+      state.SetLabel(names[state.range(1)]);
+      state.counters["edges"] = static_cast<double>(edges);
+   }
+   
+   /**
+    * Sets the arguments of the specified benchmark to every size and density.
+    * The dense directed graphs are kept small, since their number of directed
+    * edges grows with the square of their size.
+    *
+    * @param benchmark   the benchmark
+    */
+   void sizes(benchmark::internal::Benchmark* benchmark)
+   {
+      for (const int64_t n : { 256, 1024, 4096 })
+      {
+         for (int64_t density = sparse; density <= dense; density++)
+            if (density != dense || n <= 1024) benchmark -> Args({n, density});
+      }
+   }
+   
+   void push_back(benchmark::State& state)
+   {
+      const size_t n = state.range(0);
+      
+      for (auto _ : state)
+      {
+         Graph graph;
+         for (size_t i = 0; i < n; i++) graph.push_back(static_cast<int>(i));
+         benchmark::DoNotOptimize(graph.size());
+      }
+      
+      describe(state, 0);
+      state.SetItemsProcessed(state.iterations() * n);
+   }
+   
+   void connect(benchmark::State& state)
+   {
+      const size_t n = state.range(0);
+      const Edges edges = make_edges(n, state.range(1));
+      
+      for (auto _ : state)
+      {
+         state.PauseTiming();
+         Graph graph = make_graph(n, Edges());
+         state.ResumeTiming();
+         
+         for (const auto& edge : edges) graph.connect(edge.first, edge.second);
+         benchmark::ClobberMemory();
+         
+         state.PauseTiming();
+         graph.clear();
+         state.ResumeTiming();
+      }
+      
+      describe(state, edges.size());
+      state.SetItemsProcessed(state.iterations() * edges.size());
+   }
+   
+   void disconnect_edge(benchmark::State& state)
+   {
+      const size_t n = state.range(0);
+      const Edges edges = make_edges(n, state.range(1));
+      std::mt19937_64 random(10);
+      
+      for (auto _ : state)
+      {
+         state.PauseTiming();
+         Graph graph = make_graph(n, edges);
+         state.ResumeTiming();
+         
+         for (size_t i = 0; i < batch; i++)
+         {
+            const auto& edge = edges[random() % edges.size()];
+            graph.disconnect(edge.first, edge.second);
+         }
+         
+         benchmark::ClobberMemory();
+         
+         state.PauseTiming();
+         graph.clear();
+         state.ResumeTiming();
+      }
+      
+      describe(state, edges.size());
+      state.SetItemsProcessed(state.iterations() * batch);
+   }
+   
+   /**
+    * Times the disconnection of a quarter of the directed edges, one at a
+    * time, to compare with the same disconnections committed in a batch.
+    *
+    * @param state   the state of the benchmark
+    */
+   void disconnect_many(benchmark::State& state)
+   {
+      const size_t n = state.range(0);
+      const Edges edges = make_edges(n, state.range(1));
+      std::mt19937_64 random(10);
+      
+      for (auto _ : state)
+      {
+         state.PauseTiming();
+         Graph graph = make_graph(n, edges);
+         state.ResumeTiming();
+         
+         for (size_t i = 0; i < edges.size() / 4; i++)
+         {
+            const auto& edge = edges[random() % edges.size()];
+            graph.disconnect(edge.first, edge.second);
+         }
+         
+         benchmark::ClobberMemory();
+         
+         state.PauseTiming();
+         graph.clear();
+         state.ResumeTiming();
+      }
+      
+      describe(state, edges.size());
+      state.SetItemsProcessed(state.iterations() * (edges.size() / 4));
+   }
+   
+   void commit(benchmark::State& state)
+   {
+      const size_t n = state.range(0);
+      const Edges edges = make_edges(n, state.range(1));
+      std::mt19937_64 random(10);
+      
+      for (auto _ : state)
+      {
+         state.PauseTiming();
+         Graph graph = make_graph(n, edges);
+         state.ResumeTiming();
+         
+         Graph::Batch changes = graph.batch();
+         
+         for (size_t i = 0; i < edges.size() / 4; i++)
+         {
+            const auto& edge = edges[random() % edges.size()];
+            changes.disconnect(edge.first, edge.second);
+         }
+         
+         changes.commit();
+         benchmark::ClobberMemory();
+         
+         state.PauseTiming();
+         graph.clear();
+         state.ResumeTiming();
+      }
+      
+      describe(state, edges.size());
+      state.SetItemsProcessed(state.iterations() * (edges.size() / 4));
+   }
+   
+   void disconnect_node(benchmark::State& state)
+   {
+      const size_t n = state.range(0);
+      const Edges edges = make_edges(n, state.range(1));
+      std::mt19937_64 random(10);
+      
+      for (auto _ : state)
+      {
+         state.PauseTiming();
+         Graph graph = make_graph(n, edges);
+         state.ResumeTiming();
+         
+         for (size_t i = 0; i < batch; i++) graph.disconnect(random() % n);
+         benchmark::ClobberMemory();
+         
+         state.PauseTiming();
+         graph.clear();
+         state.ResumeTiming();
+      }
+      
+      describe(state, edges.size());
+      state.SetItemsProcessed(state.iterations() * batch);
+   }
+   
+   void erase(benchmark::State& state)
+   {
+      const size_t n = state.range(0);
+      const Edges edges = make_edges(n, state.range(1));
+      std::mt19937_64 random(10);
+      
+      for (auto _ : state)
+      {
+         state.PauseTiming();
+         Graph graph = make_graph(n, edges);
+         state.ResumeTiming();
+         
+         for (size_t i = 0; i < batch; i++) graph.erase(random() % (n - i));
+         benchmark::ClobberMemory();
+         
+         state.PauseTiming();
+         graph.clear();
+         state.ResumeTiming();
+      }
+      
+      describe(state, edges.size());
+      state.SetItemsProcessed(state.iterations() * batch);
+   }
+   
+   void indegree(benchmark::State& state)
+   {
+      const size_t n = state.range(0);
+      const Edges edges = make_edges(n, state.range(1));
+      const Graph graph = make_graph(n, edges);
+      
+      for (auto _ : state)
+      {
+         size_t total = 0;
+         for (size_t i = 0; i < n; i++) total += graph.indegree(i);
+         benchmark::DoNotOptimize(total);
+      }
+      
+      describe(state, edges.size());
+      state.SetItemsProcessed(state.iterations() * n);
+   }
+   
+   void simple(benchmark::State& state)
+   {
+      const size_t n = state.range(0);
+      const Edges edges = make_edges(n, state.range(1));
+      Graph graph = make_graph(n, edges);
+      
+      // Keeps the directed graph simple, so that every directed edge is tested.
+      graph.remove_self_loops();
+      graph.dedupe_edges();
+      
+      for (auto _ : state) benchmark::DoNotOptimize(graph.simple());
+      
+      describe(state, edges.size());
+      state.SetItemsProcessed(state.iterations() * edges.size());
+   }
+   
+   void copy(benchmark::State& state)
+   {
+      const size_t n = state.range(0);
+      const Edges edges = make_edges(n, state.range(1));
+      const Graph graph = make_graph(n, edges);
+      
+      for (auto _ : state)
+      {
+         Graph result(graph);
+         benchmark::DoNotOptimize(result.size());
+      }
+      
+      describe(state, edges.size());
+      state.SetItemsProcessed(state.iterations() * edges.size());
+   }
+   
+   void move(benchmark::State& state)
+   {
+      const size_t n = state.range(0);
+      const Edges edges = make_edges(n, state.range(1));
+      Graph graph = make_graph(n, edges);
+      
+      for (auto _ : state)
+      {
+         Graph result(std::move(graph));
+         graph = std::move(result);
+         benchmark::DoNotOptimize(graph.size());
+      }
+      
+      describe(state, edges.size());
+   }
+   
+   void swap(benchmark::State& state)
+   {
+      const size_t n = state.range(0);
+      const Edges edges = make_edges(n, state.range(1));
+      Graph graph = make_graph(n, edges);
+      Graph other;
+      
+      for (auto _ : state)
+      {
+         graph.swap(other);
+         benchmark::DoNotOptimize(graph.size());
+      }
+      
+      describe(state, edges.size());
+   }
+   
+   void equal(benchmark::State& state)
+   {
+      const size_t n = state.range(0);
+      const Edges edges = make_edges(n, state.range(1));
+      const Graph graph = make_graph(n, edges);
+      const Graph other = make_graph(n, edges);
+      
+      for (auto _ : state) benchmark::DoNotOptimize(graph == other);
+      
+      describe(state, edges.size());
+      state.SetItemsProcessed(state.iterations() * edges.size());
+   }
+   
+   void output(benchmark::State& state)
+   {
+      const size_t n = state.range(0);
+      const Edges edges = make_edges(n, state.range(1));
+      const Graph graph = make_graph(n, edges);
+      std::ostringstream out;
+      
+      for (auto _ : state)
+      {
+         out.str(std::string());
+         out << graph;
+         benchmark::DoNotOptimize(out.tellp());
+      }
+      
+      describe(state, edges.size());
+      state.SetItemsProcessed(state.iterations() * edges.size());
+   }
+   
+   void reorder(benchmark::State& state, const Ordering& strategy)
+   {
+      const size_t n = state.range(0);
+      const Edges edges = make_edges(n, state.range(1));
+      const Graph graph = make_graph(n, edges);
+      const Adjacency adjacency = graph.adjacency();
+      
+      for (auto _ : state)
+         benchmark::DoNotOptimize(vertex_order(adjacency, strategy).data());
+      
+      describe(state, edges.size());
+   }
+   
+   /**
+    * Times a breadth-first search from the last node, and reports the number
+    * of nodes that it visits as the items. A power-law directed graph only
+    * reaches a few of its nodes from there, since its directed edges lead to
+    * the older nodes, which have fewer directed edges of their own.
+    *
+    * @param state   the state of the benchmark
+    */
+   void traverse(benchmark::State& state)
+   {
+      const size_t n = state.range(0);
+      const Edges edges = make_edges(n, state.range(1));
+      const Adjacency adjacency = make_graph(n, edges).adjacency();
+      
+      size_t visited = 0;
+      
+      for (auto _ : state)
+      {
+         visited = 0;
+         bfs(adjacency, n - 1, [&](const size_t&) { visited++; });
+         benchmark::DoNotOptimize(visited);
+      }
+      
+      describe(state, edges.size());
+      state.counters["visited"] = static_cast<double>(visited);
+      state.SetItemsProcessed(state.iterations() * visited);
+   }
+   
+   void traverse_compressed(benchmark::State& state)
+   {
+      const size_t n = state.range(0);
+      const Edges edges = make_edges(n, state.range(1));
+      const DirectedGraph<int, CompressedStorage> graph(make_graph(n, edges));
+      
+      size_t visited = 0;
+      
+      for (auto _ : state)
+      {
+         visited = 0;
+         bfs(graph, n - 1, [&](const size_t&) { visited++; });
+         benchmark::DoNotOptimize(visited);
+      }
+      
+      describe(state, edges.size());
+      state.counters["bytes"] = static_cast<double>(graph.bytes());
+      state.counters["visited"] = static_cast<double>(visited);
+      state.SetItemsProcessed(state.iterations() * visited);
+   }
+   
+   void traverse_static(benchmark::State& state)
+   {
+      typedef StaticDirectedGraph<int, 4096, (1 << 19)> StaticGraph;
+      
+      const size_t n = state.range(0);
+      const Edges edges = make_edges(n, state.range(1));
+      
+      // The arrays of the largest directed graph are too large for the stack.
+      const std::unique_ptr<StaticGraph> graph(new StaticGraph());
+      for (size_t i = 0; i < n; i++) graph -> push_back(static_cast<int>(i));
+      for (const auto& edge : edges) graph -> connect(edge.first, edge.second);
+      
+      size_t visited = 0;
+      
+      for (auto _ : state)
+      {
+         visited = 0;
+         bfs(*graph, n - 1, [&](const size_t&) { visited++; });
+         benchmark::DoNotOptimize(visited);
+      }
+      
+      describe(state, edges.size());
+      state.counters["visited"] = static_cast<double>(visited);
+      state.SetItemsProcessed(state.iterations() * visited);
+   }
+   
+   void traverse_reordered(benchmark::State& state, const Ordering& strategy)
+   {
+      const size_t n = state.range(0);
+      const Edges edges = make_edges(n, state.range(1));
+      Graph graph = make_graph(n, edges);
+      
+      // Starts from the same node as the traversal of the original order.
+      const size_t source = graph.reorder(strategy)[n - 1];
+      const Adjacency adjacency = graph.adjacency();
+      
+      size_t visited = 0;
+      
+      for (auto _ : state)
+      {
+         visited = 0;
+         bfs(adjacency, source, [&](const size_t&) { visited++; });
+         benchmark::DoNotOptimize(visited);
+      }
+      
+      describe(state, edges.size());
+      state.counters["visited"] = static_cast<double>(visited);
+      state.SetItemsProcessed(state.iterations() * visited);
+   }
+}
+
+BENCHMARK(push_back) -> Apply(sizes);
+BENCHMARK(connect) -> Apply(sizes);
+BENCHMARK(disconnect_edge) -> Apply(sizes);
+BENCHMARK(disconnect_many) -> Apply(sizes);
+BENCHMARK(commit) -> Apply(sizes);
+BENCHMARK(disconnect_node) -> Apply(sizes);
+BENCHMARK(erase) -> Apply(sizes);
+BENCHMARK(indegree) -> Apply(sizes);
+BENCHMARK(simple) -> Apply(sizes);
+BENCHMARK(copy) -> Apply(sizes);
+BENCHMARK(move) -> Apply(sizes);
+BENCHMARK(swap) -> Apply(sizes);
+BENCHMARK(equal) -> Apply(sizes);
+BENCHMARK(output) -> Apply(sizes);
+BENCHMARK_CAPTURE(reorder, degree, Ordering::degree) -> Apply(sizes);
+BENCHMARK_CAPTURE(reorder, rcm, Ordering::reverse_cuthill_mckee)
+   -> Apply(sizes);
+BENCHMARK_CAPTURE(reorder, gorder, Ordering::gorder) -> Apply(sizes);
+BENCHMARK(traverse) -> Apply(sizes);
+BENCHMARK(traverse_compressed) -> Apply(sizes);
+BENCHMARK(traverse_static) -> Apply(sizes);
+BENCHMARK_CAPTURE(traverse_reordered, degree, Ordering::degree)
+   -> Apply(sizes);
+BENCHMARK_CAPTURE(traverse_reordered, rcm, Ordering::reverse_cuthill_mckee)
+   -> Apply(sizes);
+BENCHMARK_CAPTURE(traverse_reordered, gorder, Ordering::gorder)
+   -> Apply(sizes);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,165 @@
+/**
+ * Declarations and definitions of the <code>GraphFileHeader</code> structure
+ * and the layout of the binary directed graph file format.
+ *
+ * @file graph_file.h
+ *
+ * @author Kris Torres
+ *
+ * @date 2026-10-14
+ *
+ * @version 1.0
+ */
+
+#ifndef PIC_10C_GRAPH_FILE_H_
+#define PIC_10C_GRAPH_FILE_H_
+
+#include <cstdint>
+#include <cstring>
+
+namespace Kris_Torres_UCLA_PIC_10C_Winter_2014
+{
+   /**
+    * The <b>header</b> of a binary directed graph file. A binary directed
+    * graph file holds, in order:
+    *
+    * <ol>
+    * <li>this header;</li>
+    * <li>the <i>n</i> + 1 row offsets of the tail nodes;</li>
+    * <li>the <i>m</i> tail node positions, grouped by starting node;</li>
+    * <li>the <i>n</i> + 1 row offsets of the head nodes;</li>
+    * <li>the <i>m</i> head node positions, grouped by ending node;</li>
+    * <li>padding up to a multiple of 64 bytes; and</li>
+    * <li>the <i>n</i> values of the nodes, as raw bytes.</li>
+    * </ol>
+    *
+    * Every offset and node position is a <code>size_t</code> in the byte
+    * order of the machine that wrote the file, and the header records both,
+    * so a file is only read on a machine with the same layout. Every section
+    * is aligned for its type when the file is mapped at a page boundary.
+    *
+    * @author Kris Torres
+    */
+   struct GraphFileHeader final
+   {
+      // Constants
+      static const std::uint32_t current_version = 1;
+      static const std::uint32_t byte_order_mark = 0x01020304;
+      
+      // Constructors
+      GraphFileHeader();
+      GraphFileHeader(const std::uint64_t& n, const std::uint64_t& m,
+         const std::uint32_t& size, const std::uint32_t& alignment);
+      
+      // Accessors
+      std::uint64_t heads_offset() const;
+      bool valid() const;
+      
+      /** The magic number, which is <code>"PIC10CDG"</code>. */
+      char magic[8];
+      
+      /** The version of the file format. */
+      std::uint32_t version;
+      
+      /** The byte order mark, as written by the machine. */
+      std::uint32_t byte_order;
+      
+      /** The size of each offset and node position, in bytes. */
+      std::uint32_t index_size;
+      
+      /** The size of each value, in bytes. */
+      std::uint32_t value_size;
+      
+      /** The alignment of each value, in bytes. */
+      std::uint32_t value_alignment;
+      
+      /** Reserved, and always 0. */
+      std::uint32_t reserved;
+      
+      /** The number of nodes. */
+      std::uint64_t nodes;
+      
+      /** The number of directed edges. */
+      std::uint64_t edges;
+      
+      /** The position of the values, in bytes from the start of the file. */
+      std::uint64_t values_offset;
+      
+      /** The size of the whole file, in bytes. */
+      std::uint64_t file_size;
+   };
+   
+   /** Constructs a header with every field set to 0. */
+   inline GraphFileHeader::GraphFileHeader()
+   {
+      std::memset(this, 0, sizeof *this);
+   }
+   
+   /**
+    * Constructs the header of a binary directed graph file with <i>n</i> nodes
+    * and <i>m</i> directed edges, whose values have the specified size and
+    * alignment.
+    *
+    * @param n           the number of nodes
+    * @param m           the number of directed edges
+    * @param size        the size of each value, in bytes
+    * @param alignment   the alignment of each value, in bytes
+    */
+   inline GraphFileHeader::GraphFileHeader(const std::uint64_t& n,
+      const std::uint64_t& m, const std::uint32_t& size,
+      const std::uint32_t& alignment)
+   {
+      std::memset(this, 0, sizeof *this);
+      std::memcpy(magic, "PIC10CDG", sizeof magic);
+      version = current_version;
+      byte_order = byte_order_mark;
+      index_size = sizeof(size_t);
+      value_size = size;
+      value_alignment = alignment;
+      nodes = n;
+      edges = m;
+      
+      const std::uint64_t end = sizeof(GraphFileHeader)
+         + 2 * (nodes + 1 + edges) * index_size;
+      values_offset = (end + 63) / 64 * 64;
+      file_size = values_offset + nodes * value_size;
+   }
+   
+   /**
+    * Returns the position of the row offsets of the head nodes, in bytes from
+    * the start of the file.
+    *
+    * @return the position of the row offsets of the head nodes
+    */
+   inline std::uint64_t GraphFileHeader::heads_offset() const
+   {
+      return sizeof(GraphFileHeader) + (nodes + 1 + edges) * index_size;
+   }
+   
+   /**
+    * Tests if this header was written by this version of the file format, on
+    * a machine with the same byte order and the same size of
+    * <code>size_t</code>, and if its layout is consistent.
+    *
+    * @return <code>true</code> if this header can be read, or
+    * <code>false</code> otherwise
+    */
+   inline bool GraphFileHeader::valid() const
+   {
+      if (std::memcmp(magic, "PIC10CDG", sizeof magic) != 0
+          || version != current_version || byte_order != byte_order_mark
+          || index_size != sizeof(size_t) || value_alignment > 64)
+         return false;
+      
+      // Tests if the counts are small enough for the layout not to overflow.
+      const std::uint64_t limit = std::uint64_t(1) << 48;
+      if (nodes >= limit || edges >= limit || value_size >= 1 << 16)
+         return false;
+      
+      const GraphFileHeader layout(nodes, edges, value_size, value_alignment);
+      return values_offset == layout.values_offset
+         && file_size == layout.file_size;
+   }
+}
+
+#endif   // PIC_10C_GRAPH_FILE_H_
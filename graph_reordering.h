@@ -0,0 +1,345 @@
+/**
+ * Declarations and definitions of the <code>Ordering</code> enumeration, and
+ * the <code>degree_order</code>, <code>rcm_order</code>, <code>gorder</code>,
+ * and <code>vertex_order</code> functions.
+ *
+ * @file graph_reordering.h
+ *
+ * @author Kris Torres
+ *
+ * @date 2026-10-14
+ *
+ * @version 1.0
+ */
+
+#ifndef PIC_10C_GRAPH_REORDERING_H_
+#define PIC_10C_GRAPH_REORDERING_H_
+
+#include <cmath>
+#include <vector>
+#include <algorithm>
+#include "adjacency.h"
+
+namespace Kris_Torres_UCLA_PIC_10C_Winter_2014
+{
+   template<typename T, typename S, typename A>
+   class DirectedGraph;
+   
+   /**
+    * The <b>orderings</b> that relabel the nodes of a directed graph so that
+    * nodes visited together are stored together (see
+    * <code>vertex_order</code>).
+    */
+   enum class Ordering
+   {
+      /** The nodes by decreasing degree (see <code>degree_order</code>). */
+      degree,
+      
+      /** The reverse Cuthill-McKee order (see <code>rcm_order</code>). */
+      reverse_cuthill_mckee,
+      
+      /** The Gorder order (see <code>gorder</code>). */
+      gorder
+   };
+   
+   /**
+    * Returns the nodes of the specified adjacency by decreasing degree, the
+    * number of directed edges that enter or leave each node, with ties kept
+    * in the order of their positions. Placing the hubs first keeps the nodes
+    * that most traversals reach in a few cache lines. The nodes are sorted by
+    * counting sort, in linear time.
+    *
+    * @param graph   the adjacency of the directed graph
+    *
+    * @return the positions of the nodes in their new order
+    */
+   inline std::vector<size_t> degree_order(const Adjacency& graph)
+   {
+      const size_t n = graph.size();
+      std::vector<size_t> degree(n);
+      size_t largest = 0;
+      
+      for (size_t i = 0; i < n; i++)
+      {
+         degree[i] = graph.indegree(i) + graph.outdegree(i);
+         largest = std::max(largest, degree[i]);
+      }
+      
+      // Counts the nodes of each degree, from the largest degree down.
+      std::vector<size_t> start(largest + 2, 0);
+      for (size_t i = 0; i < n; i++) start[largest - degree[i] + 1]++;
+      for (size_t d = 0; d <= largest; d++) start[d + 1] += start[d];
+      
+      std::vector<size_t> result(n);
+      for (size_t i = 0; i < n; i++) result[start[largest - degree[i]]++] = i;
+      
+      return result;
+   }
+   
+   /**
+    * Returns the nodes of the specified directed graph by decreasing degree.
+    *
+    * @param graph   the directed graph
+    *
+    * @return the positions of the nodes in their new order
+    */
+   template<typename T, typename S, typename A>
+   inline std::vector<size_t> degree_order(const DirectedGraph<T, S, A>& graph)
+   {
+      return degree_order(graph.adjacency());
+   }
+   
+   /**
+    * Returns the nodes of the specified adjacency in <i>reverse
+    * Cuthill-McKee</i> order, which keeps the directed edges close to the
+    * diagonal of the adjacency matrix, so that the adjacent nodes of a node
+    * are stored near it. The directed edges are followed in both directions.
+    * Each weakly connected component is searched breadth-first from one of
+    * its nodes of least degree, visiting the adjacent nodes of each node by
+    * increasing degree, and the whole order is then reversed.
+    *
+    * @param graph   the adjacency of the directed graph
+    *
+    * @return the positions of the nodes in their new order
+    */
+   inline std::vector<size_t> rcm_order(const Adjacency& graph)
+   {
+      const size_t n = graph.size();
+      std::vector<size_t> degree(n);
+      for (size_t i = 0; i < n; i++)
+         degree[i] = graph.indegree(i) + graph.outdegree(i);
+      
+      // Starts each component at a node of least degree.
+      std::vector<size_t> starts(n);
+      for (size_t i = 0; i < n; i++) starts[i] = i;
+      
+      std::stable_sort(starts.begin(), starts.end(),
+         [&](const size_t& lhs, const size_t& rhs)
+         {
+            return degree[lhs] < degree[rhs];
+         });
+      
+      std::vector<bool> visited(n, false);
+      std::vector<size_t> result;
+      result.reserve(n);
+      
+      auto by_degree = [&](const size_t& lhs, const size_t& rhs)
+      {
+         return degree[lhs] < degree[rhs]
+            || (degree[lhs] == degree[rhs] && lhs < rhs);
+      };
+      
+      for (const auto& start : starts)
+      {
+         if (visited[start]) continue;
+         
+         visited[start] = true;
+         result.push_back(start);
+         
+         for (size_t i = result.size() - 1; i < result.size(); i++)
+         {
+            const size_t node = result[i];
+            const size_t first = result.size();
+            
+            for (const auto& tail : graph.next(node))
+            {
+               if (visited[tail]) continue;
+               visited[tail] = true;
+               result.push_back(tail);
+            }
+            
+            for (const auto& head : graph.prev(node))
+            {
+               if (visited[head]) continue;
+               visited[head] = true;
+               result.push_back(head);
+            }
+            
+            std::sort(result.begin() + first, result.end(), by_degree);
+         }
+      }
+      
+      std::reverse(result.begin(), result.end());
+      return result;
+   }
+   
+   /**
+    * Returns the nodes of the specified directed graph in reverse
+    * Cuthill-McKee order.
+    *
+    * @param graph   the directed graph
+    *
+    * @return the positions of the nodes in their new order
+    */
+   template<typename T, typename S, typename A>
+   inline std::vector<size_t> rcm_order(const DirectedGraph<T, S, A>& graph)
+   {
+      return rcm_order(graph.adjacency());
+   }
+   
+   /**
+    * Returns the nodes of the specified adjacency in <i>Gorder</i> order (Wei
+    * et al., 2016), which places next to each other the nodes that are likely
+    * to be visited together. The nodes are placed greedily: the next node is
+    * the one with the highest score with the last <i>w</i> nodes placed,
+    * where two nodes score one point for each directed edge between them and
+    * one point for each head node that they share. Head nodes with an
+    * outdegree above the square root of the number of nodes are not counted
+    * as shared, since they would tie almost every pair of nodes together.<p>
+    *
+    * The scores are kept in a bucket queue, since they only ever change by
+    * one, so each score update takes constant time. The first node is the
+    * node of highest indegree.
+    *
+    * @param graph    the adjacency of the directed graph
+    * @param window   the number of placed nodes, <i>w</i>, that score the
+    *                 next node
+    *
+    * @return the positions of the nodes in their new order
+    */
+   inline std::vector<size_t> gorder(const Adjacency& graph,
+      const size_t& window = 5)
+   {
+      const size_t n = graph.size();
+      const size_t none = static_cast<size_t>(-1);
+      const size_t hub = static_cast<size_t>(std::sqrt(static_cast<double>(n)));
+      
+      // Keeps each unplaced node in the doubly linked list of its score.
+      std::vector<size_t> score(n, 0);
+      std::vector<size_t> before(n, none);
+      std::vector<size_t> after(n, none);
+      std::vector<size_t> bucket(1, none);
+      std::vector<bool> placed(n, false);
+      size_t top = 0;
+      
+      auto unlink = [&](const size_t& k)
+      {
+         if (before[k] != none) after[before[k]] = after[k];
+         else bucket[score[k]] = after[k];
+         if (after[k] != none) before[after[k]] = before[k];
+      };
+      
+      auto link = [&](const size_t& k)
+      {
+         before[k] = none;
+         after[k] = bucket[score[k]];
+         if (after[k] != none) before[after[k]] = k;
+         bucket[score[k]] = k;
+      };
+      
+      for (size_t i = n; i > 0; i--) link(i - 1);
+      
+      // Adds the specified change to the score of each unplaced node that
+      // scores with the specified node.
+      auto update = [&](const size_t& k, const bool& increase)
+      {
+         auto change = [&](const size_t& other)
+         {
+            if (placed[other]) return;
+            
+            unlink(other);
+            
+            if (increase)
+            {
+               if (++score[other] == bucket.size()) bucket.push_back(none);
+               top = std::max(top, score[other]);
+            }
+            else score[other]--;
+            
+            link(other);
+         };
+         
+         for (const auto& tail : graph.next(k)) change(tail);
+         
+         for (const auto& head : graph.prev(k))
+         {
+            change(head);
+            if (graph.outdegree(head) > hub) continue;
+            
+            for (const auto& sibling : graph.next(head))
+               if (sibling != k) change(sibling);
+         }
+      };
+      
+      std::vector<size_t> result;
+      result.reserve(n);
+      
+      // Starts at the node of highest indegree.
+      size_t next = 0;
+      for (size_t i = 1; i < n; i++)
+         if (graph.indegree(i) > graph.indegree(next)) next = i;
+      
+      while (result.size() < n)
+      {
+         unlink(next);
+         placed[next] = true;
+         result.push_back(next);
+         
+         update(next, true);
+         if (result.size() > window)
+            update(result[result.size() - window - 1], false);
+         
+         if (result.size() == n) break;
+         
+         while (bucket[top] == none) top--;
+         next = bucket[top];
+      }
+      
+      return result;
+   }
+   
+   /**
+    * Returns the nodes of the specified directed graph in Gorder order.
+    *
+    * @param graph    the directed graph
+    * @param window   the number of placed nodes that score the next node
+    *
+    * @return the positions of the nodes in their new order
+    */
+   template<typename T, typename S, typename A>
+   inline std::vector<size_t> gorder(const DirectedGraph<T, S, A>& graph,
+      const size_t& window = 5)
+   {
+      return gorder(graph.adjacency(), window);
+   }
+   
+   /**
+    * Returns the nodes of the specified adjacency in the specified ordering.
+    *
+    * @param graph      the adjacency of the directed graph
+    * @param strategy   the ordering
+    *
+    * @return the positions of the nodes in their new order
+    */
+   inline std::vector<size_t> vertex_order(const Adjacency& graph,
+      const Ordering& strategy)
+   {
+      switch (strategy)
+      {
+         case Ordering::degree:
+            return degree_order(graph);
+         case Ordering::reverse_cuthill_mckee:
+            return rcm_order(graph);
+         default:
+            return gorder(graph);
+      }
+   }
+   
+   /**
+    * Returns the nodes of the specified directed graph in the specified
+    * ordering.
+    *
+    * @param graph      the directed graph
+    * @param strategy   the ordering
+    *
+    * @return the positions of the nodes in their new order
+    */
+   template<typename T, typename S, typename A>
+   inline std::vector<size_t> vertex_order(const DirectedGraph<T, S, A>& graph,
+      const Ordering& strategy)
+   {
+      return vertex_order(graph.adjacency(), strategy);
+   }
+}
+
+#endif   // PIC_10C_GRAPH_REORDERING_H_
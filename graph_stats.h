@@ -0,0 +1,349 @@
+/**
+ * Declarations and definitions of the <code>GraphStats</code> class, and
+ * <code>operator<<</code> for the <code>GraphStats</code> class.
+ *
+ * @file graph_stats.h
+ *
+ * @author Kris Torres
+ *
+ * @date 2026-10-14
+ *
+ * @version 1.0
+ */
+
+#ifndef PIC_10C_GRAPH_STATS_H_
+#define PIC_10C_GRAPH_STATS_H_
+
+#include <cstddef>
+#include <chrono>
+#include <ostream>
+
+namespace Kris_Torres_UCLA_PIC_10C_Winter_2014
+{
+   /**
+    * The <b>graph stats</b> of a directed graph count, for each of its costly
+    * operations, how many times it was called, how many adjacent nodes it
+    * scanned, how many blocks of memory it allocated, and how long it took in
+    * total. The time of an operation
+    * includes the time of the operations that it calls.<p>
+    *
+    * A directed graph keeps its stats only if
+    * <code>PIC_10C_DIRECTED_GRAPH_STATS</code> is defined before
+    * <code>directed_graph.h</code> is included, and then exposes them through
+    * its <code>stats</code> function. Otherwise every probe is empty, and the
+    * compiler removes it along with the counting around it. While the stats
+    * are kept, even the accessors of a directed graph modify it, so they must
+    * not be called from several threads at once.
+    *
+    * @author Kris Torres
+    */
+   class GraphStats final
+   {
+   public:
+      
+      // Classes
+      class Probe;
+      
+      /** The counters of one operation. */
+      struct Counters
+      {
+         /** The number of calls. */
+         size_t calls;
+         
+         /** The number of adjacent nodes scanned. */
+         size_t scanned;
+         
+         /** The number of blocks of memory allocated. */
+         size_t allocations;
+         
+         /** The total time of the calls. */
+         std::chrono::nanoseconds time;
+      };
+      
+      // Type
+      
+      /** The operations that are counted. */
+      enum Operation
+      {
+         adjacency, connect, copy, disconnect_edge, disconnect_node, erase,
+         find_edge, indegree, operations
+      };
+      
+      // Constructor
+      GraphStats();
+      
+      // Mutators
+      Counters& operator[](const Operation& op);
+      void report(std::ostream& out, const std::chrono::nanoseconds& interval);
+      void reset();
+      
+      // Accessors
+      const Counters& operator[](const Operation& op) const;
+      static const char* name(const Operation& op);
+      
+      // Friend
+      friend std::ostream& operator<<(std::ostream& out,
+         const GraphStats& rhs);
+      
+   private:
+      
+      // Types
+      typedef std::chrono::steady_clock Clock;
+      
+      // Mutator
+      void tick(const Clock::time_point& now);
+      
+      /** The counters of each operation. */
+      Counters counters_[operations];
+      
+      /** The stream to which the stats are reported, or a null pointer. */
+      std::ostream* out_;
+      
+      /** The time between two reports. */
+      std::chrono::nanoseconds interval_;
+      
+      /** The time of the last report. */
+      Clock::time_point reported_;
+   };
+   
+#ifdef PIC_10C_DIRECTED_GRAPH_STATS
+   
+   /**
+    * A <b>probe</b> records one call of an operation in the stats of a
+    * directed graph. The call is timed from the construction of the probe to
+    * its destruction, and the work that the call does is added to the
+    * counters of the operation as it goes.
+    *
+    * @author Kris Torres
+    */
+   class GraphStats::Probe final
+   {
+   public:
+      
+      // Constructors
+      Probe(GraphStats& stats, const Operation& op);
+      Probe(Probe&& rhs);
+      Probe(const Probe&) = delete;
+      
+      // Assignment operator
+      Probe& operator=(const Probe&) = delete;
+      
+      // Destructor
+      ~Probe();
+      
+      // Mutators
+      void allocate(const size_t& n = 1);
+      void scan(const size_t& n = 1);
+      
+   private:
+      
+      /** The stats of the directed graph, or a null pointer once moved. */
+      GraphStats* stats_;
+      
+      /** The counters of the operation. */
+      Counters* counters_;
+      
+      /** The time at which the call started. */
+      Clock::time_point start_;
+   };
+   
+#else
+   
+   /**
+    * A <b>probe</b> records one call of an operation in the stats of a
+    * directed graph. Since the stats are not kept, this probe records
+    * nothing.
+    *
+    * @author Kris Torres
+    */
+   class GraphStats::Probe final
+   {
+   public:
+      
+      // Destructor
+      ~Probe() {}
+      
+      // Mutators
+      void allocate(const size_t& = 1) {}
+      void scan(const size_t& = 1) {}
+   };
+   
+#endif
+   
+   // Graph stats output operator
+   std::ostream& operator<<(std::ostream& out, const GraphStats& rhs);
+   
+   /** Constructs graph stats with every counter at 0. */
+   inline GraphStats::GraphStats() : out_(nullptr), interval_(0)
+   {
+      reset();
+   }
+   
+   /**
+    * Returns a reference to the counters of the specified operation.
+    *
+    * @param op   the operation
+    *
+    * @return a reference to the counters
+    */
+   inline GraphStats::Counters& GraphStats::operator[](const Operation& op)
+   {
+      return counters_[op];
+   }
+   
+   /**
+    * Reports these stats to the specified output stream whenever the
+    * specified time has passed since the last report, at the end of the next
+    * operation that is counted.
+    *
+    * @param out        the output stream
+    * @param interval   the time between two reports
+    */
+   inline void GraphStats::report(std::ostream& out,
+      const std::chrono::nanoseconds& interval)
+   {
+      out_ = &out;
+      interval_ = interval;
+      reported_ = Clock::now();
+   }
+   
+   /** Sets every counter in these stats to 0. */
+   inline void GraphStats::reset()
+   {
+      for (auto& element : counters_)
+      {
+         element.calls = element.scanned = element.allocations = 0;
+         element.time = std::chrono::nanoseconds(0);
+      }
+   }
+   
+   /**
+    * Returns the counters of the specified operation.
+    *
+    * @param op   the operation
+    *
+    * @return the counters
+    */
+   inline const GraphStats::Counters& GraphStats::operator[](
+      const Operation& op) const
+   {
+      return counters_[op];
+   }
+   
+   /**
+    * Returns the name of the specified operation, as it is reported.
+    *
+    * @param op   the operation
+    *
+    * @return the name of the operation
+    */
+   inline const char* GraphStats::name(const Operation& op)
+   {
+      static const char* const names[operations] =
+      {
+         "adjacency", "connect", "copy", "disconnect_edge", "disconnect_node",
+         "erase", "find_edge", "indegree"
+      };
+      
+      return names[op];
+   }
+   
+   /**
+    * Reports these stats if the time between two reports has passed.
+    *
+    * @param now   the current time
+    */
+   inline void GraphStats::tick(const Clock::time_point& now)
+   {
+      if (out_ == nullptr || now - reported_ < interval_) return;
+      
+      *out_ << *this;
+      reported_ = now;
+   }
+   
+#ifdef PIC_10C_DIRECTED_GRAPH_STATS
+   
+   /**
+    * Constructs a probe that records one call of the specified operation in
+    * the specified stats, and starts timing it.
+    *
+    * @param stats   the stats of the directed graph
+    * @param op      the operation
+    */
+   inline GraphStats::Probe::Probe(GraphStats& stats, const Operation& op)
+      : stats_(&stats), counters_(&stats[op]), start_(Clock::now()) {}
+   
+   /**
+    * Constructs a probe that takes over the call recorded by the specified
+    * probe.
+    *
+    * @param rhs   the probe to be moved
+    */
+   inline GraphStats::Probe::Probe(Probe&& rhs)
+      : stats_(rhs.stats_), counters_(rhs.counters_), start_(rhs.start_)
+   {
+      rhs.stats_ = nullptr;
+   }
+   
+   /** Stops timing the call, and counts it. */
+   inline GraphStats::Probe::~Probe()
+   {
+      if (stats_ == nullptr) return;
+      
+      const Clock::time_point now = Clock::now();
+      counters_ -> calls++;
+      counters_ -> time +=
+         std::chrono::duration_cast<std::chrono::nanoseconds>(now - start_);
+      stats_ -> tick(now);
+   }
+   
+   /**
+    * Counts the specified number of blocks of memory allocated by the call.
+    *
+    * @param n   the number of blocks
+    */
+   inline void GraphStats::Probe::allocate(const size_t& n)
+   {
+      counters_ -> allocations += n;
+   }
+   
+   /**
+    * Counts the specified number of adjacent nodes scanned by the call.
+    *
+    * @param n   the number of adjacent nodes
+    */
+   inline void GraphStats::Probe::scan(const size_t& n)
+   {
+      counters_ -> scanned += n;
+   }
+   
+#endif
+   
+   /**
+    * Prints the counters of each operation that was called in the specified
+    * stats, one operation per line, with the average time of a call.
+    *
+    * @param out   the output stream
+    * @param rhs   the stats to be printed
+    *
+    * @return the output stream after the stats are printed
+    */
+   inline std::ostream& operator<<(std::ostream& out, const GraphStats& rhs)
+   {
+      for (size_t i = 0; i < GraphStats::operations; i++)
+      {
+         const GraphStats::Operation op = static_cast<GraphStats::Operation>(i);
+         const GraphStats::Counters& counters = rhs[op];
+         if (counters.calls == 0) continue;
+         
+         out << GraphStats::name(op) << ": " << counters.calls << " calls, "
+            << counters.scanned << " scanned, " << counters.allocations
+            << " allocations, " << counters.time.count() / counters.calls
+            << " ns/call\n";
+      }
+      
+      return out;
+   }
+}
+
+#endif   // PIC_10C_GRAPH_STATS_H_
@@ -0,0 +1,516 @@
+/**
+ * Declarations and definitions of the <code>bfs</code>, <code>dfs</code>, and
+ * <code>parallel_bfs</code> graph traversal functions, and the
+ * <code>ParallelBFS</code> class.
+ *
+ * @file graph_traversal.h
+ *
+ * @author Kris Torres
+ *
+ * @date 2026-10-14
+ *
+ * @version 1.0
+ */
+
+#ifndef PIC_10C_GRAPH_TRAVERSAL_H_
+#define PIC_10C_GRAPH_TRAVERSAL_H_
+
+#include <string>
+#include <vector>
+#include <stdexcept>
+#include <algorithm>
+#include <utility>
+#include <atomic>
+#include <thread>
+#include <cstdint>
+#include "adjacency.h"
+#include "barrier.h"
+#include "directed_graph.h"
+#include "index_error.h"
+
+namespace Kris_Torres_UCLA_PIC_10C_Winter_2014
+{
+   /** The depth of a node that cannot be reached from the source node. */
+   const size_t unreachable = static_cast<size_t>(-1);
+   
+   /**
+    * A <b>direction-optimizing breadth-first search</b> finds the depth of
+    * every node reachable from a source node, one level at a time, on a fixed
+    * set of threads.<p>
+    *
+    * While the frontier is small, each level is expanded <i>top-down</i>: the
+    * threads scan the tail nodes of the frontier and claim each unvisited one
+    * with an atomic operation. Once the directed edges leaving the frontier
+    * outnumber a fraction of the unexplored ones, each level is expanded
+    * <i>bottom-up</i> instead: every unvisited node scans its head nodes for
+    * one in a frontier bitmap, and stops at the first one that it finds. The
+    * search switches back to top-down once the frontier shrinks again.<p>
+    *
+    * The threads are started once per search and meet at a barrier after
+    * every level, so a search on a large directed graph scales with the number
+    * of threads instead of paying for a thread per level.
+    *
+    * @author Kris Torres
+    */
+   class ParallelBFS final
+   {
+   public:
+      
+      // Constructor
+      explicit ParallelBFS(const Adjacency& graph, const size_t& threads = 0);
+      
+      // Mutator
+      std::vector<size_t> run(const size_t& source);
+      
+      // Accessor
+      size_t threads() const;
+      
+   private:
+      
+      // Constants
+      static const size_t alpha = 14;
+      static const size_t beta = 24;
+      static const size_t chunk = 64;
+      
+      // Mutators
+      void advance();
+      void step_bottom_up(const size_t& id);
+      void step_top_down(const size_t& id);
+      void work(const size_t& id, Barrier& barrier);
+      
+      /** The directed graph to be searched. */
+      const Adjacency* graph_;
+      
+      /** The number of threads that search the directed graph. */
+      size_t threads_;
+      
+      /** The depth of each node, or <code>unreachable</code>. */
+      std::vector<size_t> depth_;
+      
+      /** The bitmap of the visited nodes, 64 nodes per word. */
+      std::vector<std::atomic<std::uint64_t>> visited_;
+      
+      /** The bitmap of the nodes in the frontier, for bottom-up levels. */
+      std::vector<std::uint64_t> bitmap_;
+      
+      /** The nodes in the frontier. */
+      std::vector<size_t> frontier_;
+      
+      /** The nodes that each thread has added to the next frontier. */
+      std::vector<std::vector<size_t>> next_;
+      
+      /** The next unclaimed chunk of work in the current level. */
+      std::atomic<size_t> cursor_;
+      
+      /** The depth of the frontier. */
+      size_t level_;
+      
+      /** The number of directed edges leaving the unvisited nodes. */
+      size_t unexplored_;
+      
+      /** Whether the current level is expanded bottom-up. */
+      bool bottom_up_;
+      
+      /** Whether the search is over. */
+      bool done_;
+   };
+   
+   /**
+    * Visits each node reachable from the node at position <i>source</i> in the
+    * specified adjacency in breadth-first order, starting with the source node
+    * itself. The tail nodes of each node are visited in the order in which
+    * they were connected.
+    *
+    * @param Visitor   the type of the function called on each node
+    *
+    * @param graph    the adjacency of the directed graph
+    * @param source   the position of the source node
+    * @param visit    the function called with the position of each node
+    *
+    * @throws std::out_of_range if <i>source</i> is at least the number of nodes
+    */
+   template<typename Visitor>
+   void bfs(const Adjacency& graph, const size_t& source, Visitor visit)
+   {
+      // Tests if source is valid.
+      if (source >= graph.size())
+         throw_index_error("Invalid source node index in directed graph: ",
+            source);
+      
+      std::vector<bool> visited(graph.size(), false);
+      std::vector<size_t> queue;
+      queue.reserve(graph.size());
+      queue.push_back(source);
+      visited[source] = true;
+      
+      for (size_t i = 0; i < queue.size(); i++)
+      {
+         const size_t node = queue[i];
+         visit(node);
+         
+         for (const auto& tail : graph.next(node))
+         {
+            if (!visited[tail])
+            {
+               visited[tail] = true;
+               queue.push_back(tail);
+            }
+         }
+      }
+   }
+   
+   /**
+    * Visits each node reachable from the node at position <i>source</i> in the
+    * specified directed graph in breadth-first order, starting with the source
+    * node itself.
+    *
+    * @param Visitor   the type of the function called on each node
+    *
+    * @param graph    the directed graph
+    * @param source   the position of the source node
+    * @param visit    the function called with the position of each node
+    *
+    * @throws std::out_of_range if <i>source</i> is at least the number of nodes
+    */
+   template<typename T, typename S, typename A, typename Visitor>
+   inline void bfs(const DirectedGraph<T, S, A>& graph, const size_t& source,
+      Visitor visit)
+   {
+      bfs(graph.adjacency(), source, visit);
+   }
+   
+   /**
+    * Visits each node reachable from the node at position <i>source</i> in the
+    * specified adjacency in depth-first order, starting with the source node
+    * itself. Each node is visited before its tail nodes, and the tail nodes of
+    * each node are followed in the order in which they were connected. The
+    * search keeps its own stack, so it does not overflow the call stack on a
+    * long path.
+    *
+    * @param Visitor   the type of the function called on each node
+    *
+    * @param graph    the adjacency of the directed graph
+    * @param source   the position of the source node
+    * @param visit    the function called with the position of each node
+    *
+    * @throws std::out_of_range if <i>source</i> is at least the number of nodes
+    */
+   template<typename Visitor>
+   void dfs(const Adjacency& graph, const size_t& source, Visitor visit)
+   {
+      // Tests if source is valid.
+      if (source >= graph.size())
+         throw_index_error("Invalid source node index in directed graph: ",
+            source);
+      
+      // Each entry holds a node and the tail nodes that it has left to follow.
+      std::vector<bool> visited(graph.size(), false);
+      std::vector<std::pair<size_t, Adjacency::Range>> stack;
+      visited[source] = true;
+      visit(source);
+      stack.push_back(std::make_pair(source, graph.next(source)));
+      
+      while (!stack.empty())
+      {
+         Adjacency::Range& tails = stack.back().second;
+         
+         if (tails.empty())
+         {
+            stack.pop_back();
+            continue;
+         }
+         
+         const size_t tail = *tails.begin();
+         tails = Adjacency::Range(tails.begin() + 1, tails.end());
+         
+         if (!visited[tail])
+         {
+            visited[tail] = true;
+            visit(tail);
+            stack.push_back(std::make_pair(tail, graph.next(tail)));
+         }
+      }
+   }
+   
+   /**
+    * Visits each node reachable from the node at position <i>source</i> in the
+    * specified directed graph in depth-first order, starting with the source
+    * node itself.
+    *
+    * @param Visitor   the type of the function called on each node
+    *
+    * @param graph    the directed graph
+    * @param source   the position of the source node
+    * @param visit    the function called with the position of each node
+    *
+    * @throws std::out_of_range if <i>source</i> is at least the number of nodes
+    */
+   template<typename T, typename S, typename A, typename Visitor>
+   inline void dfs(const DirectedGraph<T, S, A>& graph, const size_t& source,
+      Visitor visit)
+   {
+      dfs(graph.adjacency(), source, visit);
+   }
+   
+   /**
+    * Returns the depth of each node in the specified adjacency from the node
+    * at position <i>source</i>, found by a direction-optimizing breadth-first
+    * search on the specified number of threads (see <code>ParallelBFS</code>).
+    *
+    * @param graph     the adjacency of the directed graph
+    * @param source    the position of the source node
+    * @param threads   the number of threads, or 0 for one per hardware thread
+    *
+    * @return the depth of each node, or <code>unreachable</code> for each node
+    * that cannot be reached from the source node
+    *
+    * @throws std::out_of_range if <i>source</i> is at least the number of nodes
+    */
+   inline std::vector<size_t> parallel_bfs(const Adjacency& graph,
+      const size_t& source, const size_t& threads = 0)
+   {
+      return ParallelBFS(graph, threads).run(source);
+   }
+   
+   /**
+    * Returns the depth of each node in the specified directed graph from the
+    * node at position <i>source</i>, found by a direction-optimizing
+    * breadth-first search on the specified number of threads.
+    *
+    * @param graph     the directed graph
+    * @param source    the position of the source node
+    * @param threads   the number of threads, or 0 for one per hardware thread
+    *
+    * @return the depth of each node, or <code>unreachable</code> for each node
+    * that cannot be reached from the source node
+    *
+    * @throws std::out_of_range if <i>source</i> is at least the number of nodes
+    */
+   template<typename T, typename S, typename A>
+   inline std::vector<size_t> parallel_bfs(const DirectedGraph<T, S, A>& graph,
+      const size_t& source, const size_t& threads = 0)
+   {
+      return parallel_bfs(graph.adjacency(), source, threads);
+   }
+   
+   /**
+    * Constructs a direction-optimizing breadth-first search of the specified
+    * adjacency on the specified number of threads. The adjacency must outlive
+    * the search.
+    *
+    * @param graph     the adjacency of the directed graph
+    * @param threads   the number of threads, or 0 for one per hardware thread
+    */
+   inline ParallelBFS::ParallelBFS(const Adjacency& graph,
+      const size_t& threads)
+      : graph_(&graph), threads_(threads), visited_((graph.size() + 63) / 64),
+        bitmap_((graph.size() + 63) / 64), cursor_(0), level_(0),
+        unexplored_(0), bottom_up_(false), done_(false)
+   {
+      if (threads_ == 0) threads_ = std::thread::hardware_concurrency();
+      if (threads_ == 0) threads_ = 1;
+      
+      next_.resize(threads_);
+   }
+   
+   /**
+    * Searches the directed graph from the node at position <i>source</i>.
+    *
+    * @param source   the position of the source node
+    *
+    * @return the depth of each node, or <code>unreachable</code> for each node
+    * that cannot be reached from the source node
+    *
+    * @throws std::out_of_range if <i>source</i> is at least the number of nodes
+    */
+   inline std::vector<size_t> ParallelBFS::run(const size_t& source)
+   {
+      // Tests if source is valid.
+      if (source >= graph_ -> size())
+         throw_index_error("Invalid source node index in directed graph: ",
+            source);
+      
+      // Starts a new search from the source node.
+      depth_.assign(graph_ -> size(), unreachable);
+      for (auto& word : visited_) word.store(0, std::memory_order_relaxed);
+      depth_[source] = 0;
+      visited_[source / 64].store(std::uint64_t(1) << source % 64,
+         std::memory_order_relaxed);
+      frontier_.assign(1, source);
+      cursor_.store(0);
+      level_ = 0;
+      unexplored_ = graph_ -> edges() - graph_ -> outdegree(source);
+      bottom_up_ = false;
+      done_ = false;
+      
+      // The calling thread takes part in the search as thread 0.
+      Barrier barrier(threads_);
+      std::vector<std::thread> workers;
+      
+      for (size_t i = 1; i < threads_; i++)
+         workers.push_back(std::thread(&ParallelBFS::work, this, i,
+            std::ref(barrier)));
+      
+      work(0, barrier);
+      for (auto& worker : workers) worker.join();
+      
+      return std::move(depth_);
+   }
+   
+   /**
+    * Returns the number of threads that search the directed graph.
+    *
+    * @return the number of threads
+    */
+   inline size_t ParallelBFS::threads() const
+   {
+      return threads_;
+   }
+   
+   /**
+    * Gathers the next frontier from all of the threads, and decides whether
+    * the next level is expanded top-down or bottom-up. Only thread 0 calls
+    * this function, while the other threads wait at the barrier.
+    */
+   inline void ParallelBFS::advance()
+   {
+      frontier_.clear();
+      
+      for (auto& nodes : next_)
+      {
+         frontier_.insert(frontier_.end(), nodes.begin(), nodes.end());
+         nodes.clear();
+      }
+      
+      if (frontier_.empty())
+      {
+         done_ = true;
+         return;
+      }
+      
+      // Counts the directed edges leaving the frontier.
+      size_t scout = 0;
+      for (const auto& node : frontier_) scout += graph_ -> outdegree(node);
+      unexplored_ -= scout;
+      level_++;
+      
+      if (!bottom_up_ && scout > unexplored_ / alpha)
+         bottom_up_ = true;
+      else if (bottom_up_ && frontier_.size() < graph_ -> size() / beta)
+         bottom_up_ = false;
+      
+      if (bottom_up_)
+      {
+         std::fill(bitmap_.begin(), bitmap_.end(), 0);
+         for (const auto& node : frontier_)
+            bitmap_[node / 64] |= std::uint64_t(1) << node % 64;
+      }
+      
+      cursor_.store(0);
+   }
+   
+   /**
+    * Expands the current level bottom-up: each unvisited node in the claimed
+    * chunks of the bitmap looks for a head node in the frontier. Each chunk is
+    * a whole number of words of the bitmap, so every word of
+    * <code>visited_</code> is only written by one thread.
+    *
+    * @param id   the position of the thread
+    */
+   inline void ParallelBFS::step_bottom_up(const size_t& id)
+   {
+      const size_t words = visited_.size();
+      const size_t n = graph_ -> size();
+      
+      for (size_t first = cursor_.fetch_add(chunk); first < words;
+           first = cursor_.fetch_add(chunk))
+      {
+         const size_t last = std::min(first + chunk, words);
+         
+         for (size_t word = first; word < last; word++)
+         {
+            std::uint64_t seen = visited_[word].load(std::memory_order_relaxed);
+            if (~seen == 0) continue;
+            
+            for (size_t node = word * 64; node < std::min(n, word * 64 + 64);
+                 node++)
+            {
+               const std::uint64_t bit = std::uint64_t(1) << node % 64;
+               if (seen & bit) continue;
+               
+               for (const auto& head : graph_ -> prev(node))
+               {
+                  if (bitmap_[head / 64] & std::uint64_t(1) << head % 64)
+                  {
+                     depth_[node] = level_ + 1;
+                     seen |= bit;
+                     next_[id].push_back(node);
+                     break;
+                  }
+               }
+            }
+            
+            visited_[word].store(seen, std::memory_order_relaxed);
+         }
+      }
+   }
+   
+   /**
+    * Expands the current level top-down: the tail nodes of each node in the
+    * claimed chunks of the frontier are claimed by setting their bits in
+    * <code>visited_</code>, and the thread that sets a bit first adds that
+    * node to the next frontier.
+    *
+    * @param id   the position of the thread
+    */
+   inline void ParallelBFS::step_top_down(const size_t& id)
+   {
+      const size_t count = frontier_.size();
+      
+      for (size_t first = cursor_.fetch_add(chunk); first < count;
+           first = cursor_.fetch_add(chunk))
+      {
+         const size_t last = std::min(first + chunk, count);
+         
+         for (size_t i = first; i < last; i++)
+         {
+            for (const auto& tail : graph_ -> next(frontier_[i]))
+            {
+               std::atomic<std::uint64_t>& word = visited_[tail / 64];
+               const std::uint64_t bit = std::uint64_t(1) << tail % 64;
+               
+               if (word.load(std::memory_order_relaxed) & bit) continue;
+               if (word.fetch_or(bit, std::memory_order_relaxed) & bit)
+                  continue;
+               
+               depth_[tail] = level_ + 1;
+               next_[id].push_back(tail);
+            }
+         }
+      }
+   }
+   
+   /**
+    * Expands levels of the search until the frontier is empty. The barrier
+    * orders the writes of each level before the reads of the next one.
+    *
+    * @param id        the position of the thread
+    * @param barrier   the barrier at which the threads meet
+    */
+   inline void ParallelBFS::work(const size_t& id, Barrier& barrier)
+   {
+      while (true)
+      {
+         if (bottom_up_) step_bottom_up(id);
+         else step_top_down(id);
+         
+         barrier.wait();
+         if (id == 0) advance();
+         barrier.wait();
+         
+         if (done_) return;
+      }
+   }
+}
+
+#endif   // PIC_10C_GRAPH_TRAVERSAL_H_
@@ -0,0 +1,349 @@
+/**
+ * Declarations and definitions of the <code>GraphWriter</code> class.
+ *
+ * @file graph_writer.h
+ *
+ * @author Kris Torres
+ *
+ * @date 2026-10-14
+ *
+ * @version 1.0
+ */
+
+#ifndef PIC_10C_GRAPH_WRITER_H_
+#define PIC_10C_GRAPH_WRITER_H_
+
+#include <string>
+#include <vector>
+#include <ostream>
+#include <sstream>
+#include <type_traits>
+#include "adjacency.h"
+#include "graph_file.h"
+#include "directed_graph.h"
+
+namespace Kris_Torres_UCLA_PIC_10C_Winter_2014
+{
+   /**
+    * A <b>graph writer</b> streams directed graphs to an output stream in
+    * large buffered chunks. The value of each node is formatted only once, so
+    * writing a directed edge is two copies into the buffer, and the buffer is
+    * handed to the output stream only when it is full. The output stream is
+    * never flushed by the graph writer.<p>
+    *
+    * Three formats are supported: the <i>text</i> format, which is the same
+    * as the output of <code>operator<<</code> (one line for each directed
+    * edge, and one line for each node that has no directed edges); the
+    * <i>DOT</i> format of Graphviz, in which the nodes are named by their
+    * positions and labeled with their values; and the <i>binary</i> format
+    * (see <code>GraphFileHeader</code>), which can be mapped straight into
+    * memory by <code>DirectedGraph&lt;T, MappedStorage&gt;</code>.<p>
+    *
+    * A graph writer only calls the <code>const</code> members of a directed
+    * graph, and takes a snapshot of its directed edges before it writes any of
+    * them, so it can write a directed graph that other threads are reading at
+    * the same time. The directed graph must not be modified while it is being
+    * written.
+    *
+    * @author Kris Torres
+    */
+   class GraphWriter final
+   {
+   public:
+      
+      // Constructor
+      explicit GraphWriter(std::ostream& out, const size_t& capacity = 65536);
+      
+      // Deleted copy operations
+      GraphWriter(const GraphWriter& rhs) = delete;
+      GraphWriter& operator=(const GraphWriter& rhs) = delete;
+      
+      // Mutators
+      void flush();
+      template<typename T, typename S, typename A>
+      void write_binary(const DirectedGraph<T, S, A>& graph);
+      template<typename T, typename S, typename A>
+      void write_dot(const DirectedGraph<T, S, A>& graph,
+         const std::string& name = "G");
+      template<typename T, typename S, typename A>
+      void write_text(const DirectedGraph<T, S, A>& graph);
+      
+   private:
+      
+      // Mutators
+      void append(const char& c);
+      void append(const std::string& s);
+      void append_bytes(const void* data, const size_t& size);
+      void append_index(size_t k);
+      void append_quoted(const std::string& s);
+      
+      // Helper
+      template<typename T, typename S, typename A>
+      static std::vector<std::string> labels(
+         const DirectedGraph<T, S, A>& graph);
+      
+      /** The output stream to which the buffer is written. */
+      std::ostream* out_;
+      
+      /** The buffer into which the output is gathered. */
+      std::string buffer_;
+      
+      /** The number of characters after which the buffer is written. */
+      size_t capacity_;
+   };
+   
+   /**
+    * Constructs a graph writer that writes to the specified output stream in
+    * chunks of about the specified number of characters.
+    *
+    * @param out        the output stream
+    * @param capacity   the number of characters to gather before each write
+    */
+   inline GraphWriter::GraphWriter(std::ostream& out, const size_t& capacity)
+      : out_(&out), capacity_(capacity)
+   {
+      buffer_.reserve(capacity_ + 256);
+   }
+   
+   /**
+    * Writes the gathered output to the output stream, without flushing the
+    * output stream itself.
+    */
+   inline void GraphWriter::flush()
+   {
+      out_ -> write(buffer_.data(), buffer_.size());
+      buffer_.clear();
+   }
+   
+   /**
+    * Writes the specified directed graph in the binary format. The output
+    * stream should be opened in binary mode.
+    *
+    * @param graph   the directed graph to be written
+    */
+   template<typename T, typename S, typename A>
+   void GraphWriter::write_binary(const DirectedGraph<T, S, A>& graph)
+   {
+      static_assert(std::is_trivially_copyable<T>::value,
+         "The binary format needs trivially copyable values");
+      
+      const Adjacency adjacency = graph.adjacency();
+      const GraphFileHeader header(adjacency.size(), adjacency.edges(),
+         sizeof(T), alignof(T));
+      
+      append_bytes(&header, sizeof header);
+      append_bytes(adjacency.offsets_.data(),
+         adjacency.offsets_.size() * sizeof(size_t));
+      append_bytes(adjacency.targets_.data(),
+         adjacency.targets_.size() * sizeof(size_t));
+      append_bytes(adjacency.reverse_offsets_.data(),
+         adjacency.reverse_offsets_.size() * sizeof(size_t));
+      append_bytes(adjacency.sources_.data(),
+         adjacency.sources_.size() * sizeof(size_t));
+      
+      // Pads the directed edges up to the position of the values.
+      const size_t end = header.heads_offset()
+         + (header.nodes + 1 + header.edges) * sizeof(size_t);
+      append(std::string(header.values_offset - end, '\0'));
+      
+      for (size_t i = 0; i < graph.size(); i++)
+      {
+         const T value = graph[i];
+         append_bytes(&value, sizeof value);
+      }
+      
+      flush();
+   }
+   
+   /**
+    * Writes the specified directed graph in the DOT format.
+    *
+    * @param graph   the directed graph to be written
+    * @param name    the name of the graph in the DOT output
+    */
+   template<typename T, typename S, typename A>
+   void GraphWriter::write_dot(const DirectedGraph<T, S, A>& graph,
+      const std::string& name)
+   {
+      const Adjacency adjacency = graph.adjacency();
+      const std::vector<std::string> values = labels(graph);
+      
+      append("digraph ");
+      append_quoted(name);
+      append(" {\n");
+      
+      for (size_t i = 0; i < values.size(); i++)
+      {
+         append("   ");
+         append_index(i);
+         append(" [label=");
+         append_quoted(values[i]);
+         append("];\n");
+      }
+      
+      for (size_t i = 0; i < adjacency.size(); i++)
+      {
+         for (const auto& tail : adjacency.next(i))
+         {
+            append("   ");
+            append_index(i);
+            append(" -> ");
+            append_index(tail);
+            append(";\n");
+         }
+      }
+      
+      append("}\n");
+      flush();
+   }
+   
+   /**
+    * Writes the specified directed graph in the text format, which is the
+    * same as the output of <code>operator<<</code>.
+    *
+    * @param graph   the directed graph to be written
+    */
+   template<typename T, typename S, typename A>
+   void GraphWriter::write_text(const DirectedGraph<T, S, A>& graph)
+   {
+      const Adjacency adjacency = graph.adjacency();
+      const std::vector<std::string> values = labels(graph);
+      
+      for (size_t i = 0; i < adjacency.size(); i++)
+      {
+         // Writes the current node by itself if it is disconnected.
+         if (adjacency.indegree(i) == 0 && adjacency.outdegree(i) == 0)
+         {
+            append(values[i]);
+            append('\n');
+         }
+         
+         // Writes the starting and ending nodes for each directed edge.
+         else
+         {
+            for (const auto& tail : adjacency.next(i))
+            {
+               append(values[i]);
+               append(" -> ");
+               append(values[tail]);
+               append('\n');
+            }
+         }
+      }
+      
+      flush();
+   }
+   
+   /**
+    * Adds the specified character to the buffer.
+    *
+    * @param c   the character
+    */
+   inline void GraphWriter::append(const char& c)
+   {
+      buffer_.push_back(c);
+      if (buffer_.size() >= capacity_) flush();
+   }
+   
+   /**
+    * Adds the specified string to the buffer.
+    *
+    * @param s   the string
+    */
+   inline void GraphWriter::append(const std::string& s)
+   {
+      buffer_.append(s);
+      if (buffer_.size() >= capacity_) flush();
+   }
+   
+   /**
+    * Adds the specified number of raw bytes to the buffer.
+    *
+    * @param data   the position of the first byte
+    * @param size   the number of bytes
+    */
+   inline void GraphWriter::append_bytes(const void* data, const size_t& size)
+   {
+      // Writes a large block straight to the output stream.
+      if (buffer_.size() + size >= capacity_)
+      {
+         flush();
+         
+         if (size >= capacity_)
+         {
+            out_ -> write(static_cast<const char*>(data), size);
+            return;
+         }
+      }
+      
+      buffer_.append(static_cast<const char*>(data), size);
+   }
+   
+   /**
+    * Adds the decimal digits of the specified node position to the buffer.
+    *
+    * @param k   the position of the node
+    */
+   inline void GraphWriter::append_index(size_t k)
+   {
+      char digits[24];
+      char* first = digits + sizeof digits;
+      
+      do
+      {
+         *--first = static_cast<char>('0' + k % 10);
+         k /= 10;
+      } while (k != 0);
+      
+      buffer_.append(first, digits + sizeof digits);
+      if (buffer_.size() >= capacity_) flush();
+   }
+   
+   /**
+    * Adds the specified string to the buffer as a quoted DOT identifier,
+    * escaping each quotation mark and backslash.
+    *
+    * @param s   the string
+    */
+   inline void GraphWriter::append_quoted(const std::string& s)
+   {
+      buffer_.push_back('"');
+      
+      for (const auto& c : s)
+      {
+         if (c == '"' || c == '\\') buffer_.push_back('\\');
+         buffer_.push_back(c);
+      }
+      
+      buffer_.push_back('"');
+      if (buffer_.size() >= capacity_) flush();
+   }
+   
+   /**
+    * Returns the value of each node in the specified directed graph, formatted
+    * with <code>operator<<</code>.
+    *
+    * @param graph   the directed graph
+    *
+    * @return the formatted value of each node
+    */
+   template<typename T, typename S, typename A>
+   std::vector<std::string> GraphWriter::labels(
+      const DirectedGraph<T, S, A>& graph)
+   {
+      std::vector<std::string> result;
+      result.reserve(graph.size());
+      std::ostringstream stream;
+      
+      for (size_t i = 0; i < graph.size(); i++)
+      {
+         stream.str(std::string());
+         stream << graph[i];
+         result.push_back(stream.str());
+      }
+      
+      return result;
+   }
+}
+
+#endif   // PIC_10C_GRAPH_WRITER_H_
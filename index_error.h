@@ -0,0 +1,52 @@
+/**
+ * Declaration and definition of the <code>throw_index_error</code> function.
+ *
+ * @file index_error.h
+ *
+ * @author Kris Torres
+ *
+ * @date 2026-10-14
+ *
+ * @version 1.0
+ */
+
+#ifndef PIC_10C_INDEX_ERROR_H_
+#define PIC_10C_INDEX_ERROR_H_
+
+#include <cstddef>
+#include <string>
+#include <stdexcept>
+#include "boost/lexical_cast.hpp"
+
+/**
+ * Marks a function as rarely called, so that the compiler keeps it out of
+ * line and moves the branches that lead to it away from the code around
+ * them.
+ */
+#if defined(__GNUC__) || defined(__clang__)
+#define PIC_10C_COLD __attribute__((cold, noinline))
+#else
+#define PIC_10C_COLD
+#endif
+
+namespace Kris_Torres_UCLA_PIC_10C_Winter_2014
+{
+   /**
+    * Throws an <code>std::out_of_range</code> exception whose message is the
+    * specified error message followed by the specified position. The bounds
+    * checks of the directed graphs call this function only once a position
+    * is known to be invalid, so a valid position never builds a string.
+    *
+    * @param error   the error message
+    * @param k       the invalid position
+    *
+    * @throws std::out_of_range always
+    */
+   [[noreturn]] PIC_10C_COLD inline void throw_index_error(const char* error,
+      const size_t& k)
+   {
+      throw std::out_of_range(error + boost::lexical_cast<std::string>(k));
+   }
+}
+
+#endif   // PIC_10C_INDEX_ERROR_H_
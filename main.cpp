@@ -1,8 +1,1511 @@
+/**
+ * A standalone query server for a directed graph in the binary directed
+ * graph format, as written by <code>GraphWriter::write_binary</code> from a
+ * <code>DirectedGraph&lt;int&gt;</code>. The file is memory-mapped, so the
+ * server starts without parsing it, and every query reads the directed
+ * graph in place.<p>
+ *
+ * The server answers one request per line over TCP, in the order of the
+ * requests on each connection, with one response per line:
+ *
+ * <pre>
+ * DEGREE k     OK indegree outdegree
+ * NEXT k       OK count tail...
+ * PREV k       OK count head...
+ * HAS s t      OK 1 if there is a directed edge from s to t, or OK 0
+ * REACH s t    OK 1 if t is reachable from s, or OK 0
+ * PATH s t     OK length s ... t for a shortest path, or OK -1
+ * STATS        OK with the counts and the latency percentiles
+ * QUIT         closes the connection
+ * </pre>
+ *
+ * An invalid request is answered with <code>ERR</code> and a message. The
+ * connections are served by C++20 coroutines on one event loop thread, which
+ * answers the cheap requests at once. The searches, for the
+ * <code>REACH</code> and <code>PATH</code> requests, run on a pool of worker
+ * threads, and the searches from the same source node that are waiting for a
+ * worker are batched into one breadth-first search. The latency of each
+ * request, from its arrival to its response, is kept in a histogram, so the
+ * tail latency is reported by <code>STATS</code> and when the server stops
+ * on <code>SIGINT</code> or <code>SIGTERM</code>:
+ *
+ * <pre>
+ * g++ -std=c++20 -O2 -DNDEBUG -I. main.cpp -pthread -o graph_server
+ * ./graph_server graph.bin [port [threads [address]]]
+ * </pre>
+ *
+ * @file main.cpp
+ *
+ * @author Kris Torres
+ *
+ * @date 2026-10-14
+ *
+ * @version 1.0
+ */
+
+#include <algorithm>
+#include <cerrno>
+#include <csignal>
+#include <cstdint>
+#include <cstring>
+#include <chrono>
+#include <condition_variable>
+#include <coroutine>
+#include <deque>
+#include <exception>
+#include <functional>
 #include <iostream>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/signalfd.h>
+#include <sys/socket.h>
+#include <unistd.h>
 #include "directed_graph.h"
+#include "mapped_directed_graph.h"
+
+using namespace Kris_Torres_UCLA_PIC_10C_Winter_2014;
+
+namespace
+{
+   typedef DirectedGraph<int, MappedStorage> Graph;
+   typedef std::chrono::steady_clock Clock;
+   
+   /** The position that marks a node as not reached. */
+   const size_t none = static_cast<size_t>(-1);
+   
+   /** The longest request line, in bytes. */
+   const size_t max_line = 4096;
+   
+   /**
+    * Blocks <code>SIGINT</code> and <code>SIGTERM</code> in the calling
+    * thread, and in every thread that it starts afterwards.
+    *
+    * @return a descriptor that becomes readable when either signal arrives,
+    * or -1 if it cannot be created
+    */
+   int block_signals()
+   {
+      sigset_t mask;
+      sigemptyset(&mask);
+      sigaddset(&mask, SIGINT);
+      sigaddset(&mask, SIGTERM);
+      pthread_sigmask(SIG_BLOCK, &mask, nullptr);
+      
+      return ::signalfd(-1, &mask, SFD_NONBLOCK | SFD_CLOEXEC);
+   }
+   
+   /**
+    * A <b>task</b> is a coroutine that starts at once and destroys itself
+    * when it returns, so it needs no owner.
+    */
+   struct Task
+   {
+      struct promise_type
+      {
+         Task get_return_object() { return Task(); }
+         std::suspend_never initial_suspend() noexcept { return {}; }
+         std::suspend_never final_suspend() noexcept { return {}; }
+         void return_void() {}
+         void unhandled_exception() { std::terminate(); }
+      };
+   };
+   
+   /**
+    * A <b>descriptor</b> owns a file descriptor, and closes it when it is
+    * destroyed.
+    *
+    * @author Kris Torres
+    */
+   class Descriptor final
+   {
+   public:
+      
+      // Constructors
+      explicit Descriptor(const int& fd = -1);
+      Descriptor(const Descriptor&) = delete;
+      
+      // Assignment operator
+      Descriptor& operator=(const Descriptor&) = delete;
+      
+      // Destructor
+      ~Descriptor();
+      
+      // Mutator
+      void reset(const int& fd = -1);
+      
+      // Accessor
+      int get() const;
+      
+   private:
+      
+      /** The file descriptor, or -1. */
+      int fd_;
+   };
+   
+   /**
+    * An <b>event loop</b> resumes the coroutines that wait for a file
+    * descriptor to become readable or writable, and runs the functions that
+    * other threads post to it, all on the thread that runs the loop. The
+    * loop stops on <code>SIGINT</code> or <code>SIGTERM</code>, which it
+    * blocks in the thread that constructs it and in every thread started
+    * afterwards.
+    *
+    * @author Kris Torres
+    */
+   class EventLoop final
+   {
+   public:
+      
+      // Class
+      class Awaiter;
+      
+      // Constructor
+      EventLoop();
+      
+      // Mutators
+      void forget(const int& fd);
+      void post(std::function<void()> function);
+      void run();
+      Awaiter wait(const int& fd, const uint32_t& events);
+      void watch(const int& fd);
+      
+   private:
+      
+      // Mutator
+      void arm(const int& fd, const uint32_t& events,
+         const std::coroutine_handle<>& handle);
+      
+      /** The epoll instance. */
+      Descriptor epoll_;
+      
+      /** The event counter that other threads signal after posting. */
+      Descriptor wakeup_;
+      
+      /** The descriptor that becomes readable on a stopping signal. */
+      Descriptor signals_;
+      
+      /** The coroutine that waits for each file descriptor. */
+      std::unordered_map<int, std::coroutine_handle<>> waiting_;
+      
+      /** The lock on the posted functions. */
+      std::mutex mutex_;
+      
+      /** The functions posted by other threads. */
+      std::vector<std::function<void()>> posted_;
+   };
+   
+   /**
+    * An <b>awaiter</b> suspends a coroutine until a file descriptor is ready
+    * for the specified events.
+    *
+    * @author Kris Torres
+    */
+   class EventLoop::Awaiter final
+   {
+   public:
+      
+      // Constructor
+      Awaiter(EventLoop& loop, const int& fd, const uint32_t& events);
+      
+      // Accessors
+      bool await_ready() const noexcept;
+      void await_resume() const noexcept;
+      void await_suspend(const std::coroutine_handle<>& handle);
+      
+   private:
+      
+      /** The event loop. */
+      EventLoop& loop_;
+      
+      /** The file descriptor. */
+      int fd_;
+      
+      /** The events. */
+      uint32_t events_;
+   };
+   
+   /**
+    * A <b>worker pool</b> runs jobs on a fixed number of threads, in the
+    * order in which they were submitted.
+    *
+    * @author Kris Torres
+    */
+   class WorkerPool final
+   {
+   public:
+      
+      // Constructor
+      explicit WorkerPool(const size_t& threads = 0);
+      
+      // Destructor
+      ~WorkerPool();
+      
+      // Mutators
+      void stop();
+      void submit(std::function<void()> job);
+      
+      // Accessor
+      size_t threads() const;
+      
+   private:
+      
+      // Mutator
+      void work();
+      
+      /** The lock on the jobs. */
+      std::mutex mutex_;
+      
+      /** Signaled when a job is submitted or the pool stops. */
+      std::condition_variable ready_;
+      
+      /** The jobs that no worker has started. */
+      std::deque<std::function<void()>> jobs_;
+      
+      /** Whether the pool is stopping. */
+      bool stopped_;
+      
+      /** The worker threads. */
+      std::vector<std::thread> workers_;
+   };
+   
+   /**
+    * A <b>latency histogram</b> counts durations in buckets that grow
+    * geometrically, eight to each power of 2, so that any percentile is
+    * known to within an eighth of itself in constant memory.
+    *
+    * @author Kris Torres
+    */
+   class LatencyHistogram final
+   {
+   public:
+      
+      // Constructor
+      LatencyHistogram();
+      
+      // Mutator
+      void record(const Clock::duration& time);
+      
+      // Accessors
+      size_t count() const;
+      std::chrono::nanoseconds max() const;
+      std::chrono::nanoseconds percentile(const double& p) const;
+      
+   private:
+      
+      // Accessors
+      static size_t bucket(const uint64_t& ns);
+      static uint64_t bound(const size_t& bucket);
+      
+      /** The number of durations in each bucket. */
+      std::vector<size_t> counts_;
+      
+      /** The number of durations. */
+      size_t count_;
+      
+      /** The longest duration, in nanoseconds. */
+      uint64_t max_;
+   };
+   
+   /**
+    * A <b>server</b> answers the queries on a directed graph from the
+    * connections to a listening socket.
+    *
+    * @author Kris Torres
+    */
+   class Server final
+   {
+   public:
+      
+      // Constructor
+      Server(const Graph& graph, const uint16_t& port, const size_t& threads,
+         const std::string& address);
+      
+      // Mutator
+      void run();
+      
+      // Accessor
+      std::string stats() const;
+      
+   private:
+      
+      // Classes
+      class Response;
+      class Scope;
+      
+      /** A request, parsed from one line. */
+      struct Request
+      {
+         /** The command. */
+         std::string command;
+         
+         /** The source node, or the only node. */
+         size_t source;
+         
+         /** The target node. */
+         size_t target;
+      };
+      
+      /** The response to a request, which may still be on a worker thread. */
+      struct Pending
+      {
+         /** The time at which the request arrived. */
+         Clock::time_point start;
+         
+         /** The response, once it is done. */
+         std::string text;
+         
+         /** Whether the response is done. */
+         bool done;
+         
+         /** The connection that waits for the response, if any. */
+         std::coroutine_handle<> handle;
+      };
+      
+      /** A search that waits for the response. */
+      struct Waiter
+      {
+         /** The request. */
+         Request request;
+         
+         /** The response. */
+         std::shared_ptr<Pending> pending;
+      };
+      
+      /** The searches from one source node, which are done together. */
+      struct Batch
+      {
+         /** The source node. */
+         size_t source;
+         
+         /** The lock on the searches. */
+         std::mutex mutex;
+         
+         /** Whether a worker has taken the searches. */
+         bool started;
+         
+         /** The searches. */
+         std::vector<Waiter> waiters;
+      };
+      
+      // Mutators
+      Task listen();
+      Task serve(int fd);
+      void search(const std::shared_ptr<Batch>& batch);
+      std::shared_ptr<Pending> submit(const std::string& line, bool& quit);
+      
+      // Accessors
+      std::string answer(const Request& request) const;
+      
+      /** The directed graph. */
+      const Graph& graph_;
+      
+      /** The event loop, which must block the signals before any thread. */
+      EventLoop loop_;
+      
+      /** The listening socket. */
+      Descriptor listener_;
+      
+      /**
+       * A spare descriptor, which is closed when the process runs out of
+       * descriptors, so that a connection can be accepted and refused.
+       */
+      Descriptor spare_;
+      
+      /** The workers of the searches. */
+      WorkerPool pool_;
+      
+      /** The batch of searches that no worker has taken, by source node. */
+      std::unordered_map<size_t, std::shared_ptr<Batch>> open_;
+      
+      /** The coroutines that are running, to be destroyed on shutdown. */
+      std::unordered_set<void*> tasks_;
+      
+      /** The latency of the requests. */
+      LatencyHistogram latencies_;
+      
+      /** The number of searches. */
+      size_t searches_;
+      
+      /** The number of searches batched into another one. */
+      size_t batched_;
+      
+      /** The number of open connections. */
+      size_t connections_;
+      
+      /** The number of connections refused for want of a descriptor. */
+      size_t refused_;
+   };
+   
+   /**
+    * A <b>response</b> awaiter suspends a connection until a response is
+    * done, in the order of the requests.
+    *
+    * @author Kris Torres
+    */
+   class Server::Response final
+   {
+   public:
+      
+      // Constructor
+      explicit Response(const std::shared_ptr<Pending>& pending);
+      
+      // Accessors
+      bool await_ready() const noexcept;
+      std::string await_resume() const;
+      void await_suspend(const std::coroutine_handle<>& handle) const;
+      
+   private:
+      
+      /** The response. */
+      std::shared_ptr<Pending> pending_;
+   };
+   
+   /**
+    * A <b>scope</b> records a running coroutine in the server while it lives.
+    * Awaiting the scope records the coroutine without suspending it.
+    *
+    * @author Kris Torres
+    */
+   class Server::Scope final
+   {
+   public:
+      
+      // Constructors
+      explicit Scope(Server& server);
+      Scope(const Scope&) = delete;
+      
+      // Assignment operator
+      Scope& operator=(const Scope&) = delete;
+      
+      // Destructor
+      ~Scope();
+      
+      // Accessors
+      bool await_ready() const noexcept;
+      void await_resume() const noexcept;
+      bool await_suspend(const std::coroutine_handle<>& handle);
+      
+   private:
+      
+      /** The server. */
+      Server& server_;
+      
+      /** The coroutine, once it is recorded. */
+      void* address_;
+   };
+   
+   /**
+    * Constructs a descriptor that owns the specified file descriptor.
+    *
+    * @param fd   the file descriptor, or -1
+    */
+   inline Descriptor::Descriptor(const int& fd) : fd_(fd) {}
+   
+   /** Closes the file descriptor. */
+   inline Descriptor::~Descriptor()
+   {
+      if (fd_ >= 0) ::close(fd_);
+   }
+   
+   /**
+    * Closes the file descriptor, and then owns the specified one instead.
+    *
+    * @param fd   the file descriptor, or -1
+    */
+   inline void Descriptor::reset(const int& fd)
+   {
+      if (fd_ >= 0) ::close(fd_);
+      fd_ = fd;
+   }
+   
+   /**
+    * Returns the file descriptor.
+    *
+    * @return the file descriptor
+    */
+   inline int Descriptor::get() const
+   {
+      return fd_;
+   }
+   
+   /**
+    * Constructs an event loop, and blocks the stopping signals.
+    *
+    * @throws std::runtime_error if the descriptors cannot be created
+    */
+   EventLoop::EventLoop()
+      : epoll_(::epoll_create1(EPOLL_CLOEXEC)),
+        wakeup_(::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC)),
+        signals_(block_signals())
+   {
+      if (epoll_.get() < 0 || wakeup_.get() < 0 || signals_.get() < 0)
+         throw std::runtime_error("Cannot create event loop");
+      
+      for (const int fd : { wakeup_.get(), signals_.get() })
+      {
+         epoll_event event = {};
+         event.events = EPOLLIN;
+         event.data.fd = fd;
+         ::epoll_ctl(epoll_.get(), EPOLL_CTL_ADD, fd, &event);
+      }
+   }
+   
+   /**
+    * Stops watching the specified file descriptor, before it is closed.
+    *
+    * @param fd   the file descriptor
+    */
+   void EventLoop::forget(const int& fd)
+   {
+      ::epoll_ctl(epoll_.get(), EPOLL_CTL_DEL, fd, nullptr);
+      waiting_.erase(fd);
+   }
+   
+   /**
+    * Posts the specified function to be run on the thread of the loop. The
+    * function may be called from any thread.
+    *
+    * @param function   the function
+    */
+   void EventLoop::post(std::function<void()> function)
+   {
+      {
+         std::lock_guard<std::mutex> lock(mutex_);
+         posted_.push_back(std::move(function));
+      }
+      
+      const uint64_t one = 1;
+      ssize_t written = ::write(wakeup_.get(), &one, sizeof one);
+      (void) written;
+   }
+   
+   /**
+    * Runs the loop until a stopping signal arrives. An event on a file
+    * descriptor resumes the coroutine that waits for it.
+    */
+   void EventLoop::run()
+   {
+      epoll_event events[64];
+      
+      while (true)
+      {
+         const int count = ::epoll_wait(epoll_.get(), events, 64, -1);
+         if (count < 0 && errno != EINTR)
+            throw std::runtime_error("Cannot wait for events");
+         
+         for (int i = 0; i < count; i++)
+         {
+            const int fd = events[i].data.fd;
+            
+            if (fd == signals_.get()) return;
+            
+            if (fd == wakeup_.get())
+            {
+               uint64_t value = 0;
+               ssize_t read = ::read(fd, &value, sizeof value);
+               (void) read;
+               
+               std::vector<std::function<void()>> functions;
+               {
+                  std::lock_guard<std::mutex> lock(mutex_);
+                  functions.swap(posted_);
+               }
+               
+               for (auto& function : functions) function();
+               continue;
+            }
+            
+            // The coroutine may have been destroyed by an earlier event.
+            const auto waiter = waiting_.find(fd);
+            if (waiter == waiting_.end()) continue;
+            
+            const std::coroutine_handle<> handle = waiter -> second;
+            waiting_.erase(waiter);
+            handle.resume();
+         }
+      }
+   }
+   
+   /**
+    * Returns an awaiter that suspends a coroutine until the specified file
+    * descriptor, which must be watched, is ready for the specified events.
+    *
+    * @param fd       the file descriptor
+    * @param events   the events, <code>EPOLLIN</code> or <code>EPOLLOUT</code>
+    *
+    * @return the awaiter
+    */
+   inline EventLoop::Awaiter EventLoop::wait(const int& fd,
+      const uint32_t& events)
+   {
+      return Awaiter(*this, fd, events);
+   }
+   
+   /**
+    * Starts watching the specified file descriptor, for no events yet.
+    *
+    * @param fd   the file descriptor
+    */
+   void EventLoop::watch(const int& fd)
+   {
+      epoll_event event = {};
+      event.data.fd = fd;
+      ::epoll_ctl(epoll_.get(), EPOLL_CTL_ADD, fd, &event);
+   }
+   
+   /**
+    * Arms the specified file descriptor for one event, to resume the
+    * specified coroutine. An armed descriptor that is already ready fires at
+    * once, so no event is lost between a failed read and the wait.
+    *
+    * @param fd       the file descriptor
+    * @param events   the events
+    * @param handle   the coroutine
+    */
+   void EventLoop::arm(const int& fd, const uint32_t& events,
+      const std::coroutine_handle<>& handle)
+   {
+      epoll_event event = {};
+      event.events = events | EPOLLONESHOT | EPOLLRDHUP;
+      event.data.fd = fd;
+      ::epoll_ctl(epoll_.get(), EPOLL_CTL_MOD, fd, &event);
+      waiting_[fd] = handle;
+   }
+   
+   /**
+    * Constructs an awaiter for the specified events on the specified file
+    * descriptor.
+    *
+    * @param loop     the event loop
+    * @param fd       the file descriptor
+    * @param events   the events
+    */
+   inline EventLoop::Awaiter::Awaiter(EventLoop& loop, const int& fd,
+      const uint32_t& events)
+      : loop_(loop), fd_(fd), events_(events) {}
+   
+   /**
+    * Returns <code>false</code>, since the coroutine always waits for the
+    * next event.
+    *
+    * @return <code>false</code>
+    */
+   inline bool EventLoop::Awaiter::await_ready() const noexcept
+   {
+      return false;
+   }
+   
+   /** Resumes the coroutine once the event arrives. */
+   inline void EventLoop::Awaiter::await_resume() const noexcept {}
+   
+   /**
+    * Arms the file descriptor to resume the specified coroutine.
+    *
+    * @param handle   the coroutine
+    */
+   inline void EventLoop::Awaiter::await_suspend(
+      const std::coroutine_handle<>& handle)
+   {
+      loop_.arm(fd_, events_, handle);
+   }
+   
+   /**
+    * Constructs a worker pool with the specified number of threads.
+    *
+    * @param threads   the number of threads, or 0 for one per hardware thread
+    */
+   WorkerPool::WorkerPool(const size_t& threads) : stopped_(false)
+   {
+      size_t count = threads;
+      
+      if (count == 0)
+      {
+         count = std::thread::hardware_concurrency();
+         if (count == 0) count = 1;
+      }
+      
+      for (size_t i = 0; i < count; i++)
+         workers_.push_back(std::thread(&WorkerPool::work, this));
+   }
+   
+   /** Stops the pool, and waits for its threads. */
+   inline WorkerPool::~WorkerPool()
+   {
+      stop();
+   }
+   
+   /**
+    * Drops the jobs that no worker has started, and waits for the workers to
+    * finish the others.
+    */
+   void WorkerPool::stop()
+   {
+      {
+         std::lock_guard<std::mutex> lock(mutex_);
+         stopped_ = true;
+         jobs_.clear();
+      }
+      
+      ready_.notify_all();
+      for (auto& worker : workers_) if (worker.joinable()) worker.join();
+   }
+   
+   /**
+    * Submits the specified job, to be run on the next free worker.
+    *
+    * @param job   the job
+    */
+   void WorkerPool::submit(std::function<void()> job)
+   {
+      {
+         std::lock_guard<std::mutex> lock(mutex_);
+         jobs_.push_back(std::move(job));
+      }
+      
+      ready_.notify_one();
+   }
+   
+   /**
+    * Returns the number of threads in this pool.
+    *
+    * @return the number of threads
+    */
+   inline size_t WorkerPool::threads() const
+   {
+      return workers_.size();
+   }
+   
+   /** Runs the jobs, one at a time, until the pool stops. */
+   void WorkerPool::work()
+   {
+      while (true)
+      {
+         std::function<void()> job;
+         
+         {
+            std::unique_lock<std::mutex> lock(mutex_);
+            ready_.wait(lock, [&] { return stopped_ || !jobs_.empty(); });
+            if (stopped_) return;
+            
+            job = std::move(jobs_.front());
+            jobs_.pop_front();
+         }
+         
+         job();
+      }
+   }
+   
+   /** Constructs an empty latency histogram. */
+   inline LatencyHistogram::LatencyHistogram()
+      : counts_(bucket(~0ULL) + 1, 0), count_(0), max_(0) {}
+   
+   /**
+    * Counts the specified duration.
+    *
+    * @param time   the duration
+    */
+   void LatencyHistogram::record(const Clock::duration& time)
+   {
+      const uint64_t ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+         time).count();
+      
+      counts_[bucket(ns)]++;
+      count_++;
+      max_ = std::max(max_, ns);
+   }
+   
+   /**
+    * Returns the number of durations counted.
+    *
+    * @return the number of durations
+    */
+   inline size_t LatencyHistogram::count() const
+   {
+      return count_;
+   }
+   
+   /**
+    * Returns the longest duration counted.
+    *
+    * @return the longest duration
+    */
+   inline std::chrono::nanoseconds LatencyHistogram::max() const
+   {
+      return std::chrono::nanoseconds(max_);
+   }
+   
+   /**
+    * Returns the duration below which the specified fraction of the
+    * durations fall, rounded up to the end of its bucket.
+    *
+    * @param p   the fraction, from 0 to 1
+    *
+    * @return the duration
+    */
+   std::chrono::nanoseconds LatencyHistogram::percentile(const double& p)
+      const
+   {
+      const double rank = p * count_;
+      size_t sum = 0;
+      
+      for (size_t i = 0; i < counts_.size(); i++)
+      {
+         sum += counts_[i];
+         
+         if (sum > 0 && sum >= rank)
+            return std::chrono::nanoseconds(std::min(bound(i), max_));
+      }
+      
+      return max();
+   }
+   
+   /**
+    * Returns the bucket of a duration: the durations below 8 ns have a bucket
+    * each, and each power of 2 above is split into 8 buckets by the 3 bits
+    * after its leading bit.
+    *
+    * @param ns   the duration, in nanoseconds
+    *
+    * @return the bucket
+    */
+   inline size_t LatencyHistogram::bucket(const uint64_t& ns)
+   {
+      if (ns < 8) return ns;
+      
+      const size_t exponent = 63 - __builtin_clzll(ns);
+      return 8 * (exponent - 2) + ((ns >> (exponent - 3)) & 7);
+   }
+   
+   /**
+    * Returns the longest duration in the specified bucket.
+    *
+    * @param bucket   the bucket
+    *
+    * @return the duration, in nanoseconds
+    */
+   inline uint64_t LatencyHistogram::bound(const size_t& bucket)
+   {
+      if (bucket < 8) return bucket;
+      
+      const size_t shift = bucket / 8 - 1;
+      const uint64_t first = (8 + bucket % 8) << shift;
+      return first + ((1ULL << shift) - 1);
+   }
+   
+   /**
+    * Constructs a server for the specified directed graph that listens on
+    * the specified address and port.
+    *
+    * @param graph     the directed graph
+    * @param port      the port
+    * @param threads   the number of worker threads, or 0 for one per hardware
+    *                  thread
+    * @param address   the IPv4 address
+    *
+    * @throws std::runtime_error if the socket cannot listen
+    */
+   Server::Server(const Graph& graph, const uint16_t& port,
+      const size_t& threads, const std::string& address)
+      : graph_(graph), loop_(),
+        listener_(::socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK
+           | SOCK_CLOEXEC, 0)),
+        spare_(::open("/dev/null", O_RDONLY | O_CLOEXEC)), pool_(threads),
+        searches_(0), batched_(0), connections_(0), refused_(0)
+   {
+      sockaddr_in endpoint = {};
+      endpoint.sin_family = AF_INET;
+      endpoint.sin_port = htons(port);
+      
+      if (::inet_pton(AF_INET, address.c_str(), &endpoint.sin_addr) != 1)
+         throw std::runtime_error("Invalid address: " + address);
+      
+      const int yes = 1;
+      ::setsockopt(listener_.get(), SOL_SOCKET, SO_REUSEADDR, &yes,
+         sizeof yes);
+      
+      if (listener_.get() < 0
+          || ::bind(listener_.get(), reinterpret_cast<sockaddr*>(&endpoint),
+             sizeof endpoint) != 0
+          || ::listen(listener_.get(), SOMAXCONN) != 0)
+      {
+         throw std::runtime_error("Cannot listen on " + address + ":"
+            + std::to_string(port) + ": " + std::strerror(errno));
+      }
+      
+      loop_.watch(listener_.get());
+   }
+   
+   /**
+    * Serves the connections until a stopping signal arrives, and then
+    * destroys the connections that are still open.
+    */
+   void Server::run()
+   {
+      listen();
+      loop_.run();
+      
+      // No search can finish once the pool has stopped.
+      pool_.stop();
+      
+      const std::unordered_set<void*> tasks = tasks_;
+      for (const auto& element : tasks)
+         std::coroutine_handle<>::from_address(element).destroy();
+      
+      open_.clear();
+   }
+   
+   /**
+    * Returns the counts and the latency percentiles of the requests so far.
+    *
+    * @return the statistics, on one line
+    */
+   std::string Server::stats() const
+   {
+      auto us = [](const std::chrono::nanoseconds& time)
+      {
+         std::ostringstream out;
+         out << time.count() / 1000.0;
+         return out.str();
+      };
+      
+      return "requests=" + std::to_string(latencies_.count())
+         + " searches=" + std::to_string(searches_)
+         + " batched=" + std::to_string(batched_)
+         + " connections=" + std::to_string(connections_)
+         + " refused=" + std::to_string(refused_)
+         + " threads=" + std::to_string(pool_.threads())
+         + " p50_us=" + us(latencies_.percentile(0.5))
+         + " p99_us=" + us(latencies_.percentile(0.99))
+         + " p999_us=" + us(latencies_.percentile(0.999))
+         + " max_us=" + us(latencies_.max());
+   }
+   
+   /**
+    * Accepts the connections, and serves each in its own coroutine. When the
+    * process runs out of descriptors, the listening socket stays readable,
+    * so the connection is accepted on the spare descriptor and closed at
+    * once, instead of being waited for over and over.
+    */
+   Task Server::listen()
+   {
+      Scope scope(*this);
+      co_await scope;
+      
+      while (true)
+      {
+         const int fd = ::accept4(listener_.get(), nullptr, nullptr,
+            SOCK_NONBLOCK | SOCK_CLOEXEC);
+         
+         if (fd >= 0)
+         {
+            const int yes = 1;
+            ::setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &yes, sizeof yes);
+            serve(fd);
+         }
+         
+         // Refuses the connection, which would otherwise stay pending.
+         else if ((errno == EMFILE || errno == ENFILE) && spare_.get() >= 0)
+         {
+            spare_.reset();
+            const int refused = ::accept4(listener_.get(), nullptr, nullptr,
+               SOCK_CLOEXEC);
+            if (refused >= 0) ::close(refused);
+            spare_.reset(::open("/dev/null", O_RDONLY | O_CLOEXEC));
+            
+            // The descriptors run out before the pending connections do.
+            if (refused >= 0) refused_++;
+            else co_await loop_.wait(listener_.get(), EPOLLIN);
+         }
+         
+         // Waits for the next connection.
+         else if (errno != EINTR && errno != ECONNABORTED)
+         {
+            if (spare_.get() < 0)
+               spare_.reset(::open("/dev/null", O_RDONLY | O_CLOEXEC));
+            co_await loop_.wait(listener_.get(), EPOLLIN);
+         }
+      }
+   }
+   
+   /**
+    * Serves the connection on the specified socket until the client closes
+    * it or quits. The requests that have arrived are all submitted before
+    * any response is awaited, so the searches of one client are batched too,
+    * and the responses are then sent in order.
+    *
+    * @param fd   the socket, by value, since the coroutine outlives the caller
+    */
+   Task Server::serve(int fd)
+   {
+      const Descriptor socket(fd);
+      Scope scope(*this);
+      co_await scope;
+      
+      loop_.watch(fd);
+      connections_++;
+      
+      std::string input;
+      std::string output;
+      std::vector<std::shared_ptr<Pending>> pending;
+      char buffer[4096];
+      bool quit = false;
+      
+      while (!quit)
+      {
+         const ssize_t count = ::recv(fd, buffer, sizeof buffer, 0);
+         
+         if (count == 0) break;
+         
+         if (count < 0)
+         {
+            if (errno == EINTR) continue;
+            if (errno != EAGAIN && errno != EWOULDBLOCK) break;
+            
+            co_await loop_.wait(fd, EPOLLIN);
+            continue;
+         }
+         
+         input.append(buffer, count);
+         
+         // Submits every complete line.
+         size_t first = 0;
+         
+         for (size_t last = input.find('\n'); last != std::string::npos
+            && !quit; last = input.find('\n', first))
+         {
+            std::string line = input.substr(first, last - first);
+            if (!line.empty() && line.back() == '\r') line.pop_back();
+            first = last + 1;
+            
+            std::shared_ptr<Pending> response = submit(line, quit);
+            if (response) pending.push_back(response);
+         }
+         
+         input.erase(0, first);
+         
+         if (input.size() > max_line)
+         {
+            auto response = std::make_shared<Pending>();
+            response -> start = Clock::now();
+            response -> text = "ERR Request too long";
+            response -> done = true;
+            pending.push_back(response);
+            quit = true;
+         }
+         
+         for (const auto& element : pending)
+         {
+            output += co_await Response(element);
+            output += '\n';
+            latencies_.record(Clock::now() - element -> start);
+         }
+         
+         pending.clear();
+         
+         // Sends the responses.
+         for (size_t sent = 0; sent < output.size(); )
+         {
+            const ssize_t written = ::send(fd, output.data() + sent,
+               output.size() - sent, MSG_NOSIGNAL);
+            
+            if (written >= 0) sent += written;
+            else if (errno == EAGAIN || errno == EWOULDBLOCK)
+               co_await loop_.wait(fd, EPOLLOUT);
+            else if (errno != EINTR)
+            {
+               quit = true;
+               break;
+            }
+         }
+         
+         output.clear();
+      }
+      
+      connections_--;
+      loop_.forget(fd);
+   }
+   
+   /**
+    * Parses the specified request line, and either answers it at once, or
+    * submits its search to a batch of searches from the same source node.
+    *
+    * @param line   the request line
+    * @param quit   set to <code>true</code> if the request is to quit
+    *
+    * @return the response, or a null pointer if there is none
+    */
+   std::shared_ptr<Server::Pending> Server::submit(const std::string& line,
+      bool& quit)
+   {
+      auto result = std::make_shared<Pending>();
+      result -> start = Clock::now();
+      result -> done = true;
+      
+      std::istringstream in(line);
+      Request request = { std::string(), 0, 0 };
+      in >> request.command;
+      
+      if (request.command.empty()) return nullptr;
+      
+      if (request.command == "QUIT")
+      {
+         quit = true;
+         return nullptr;
+      }
+      
+      const bool pair = request.command == "HAS" || request.command == "REACH"
+         || request.command == "PATH";
+      const bool single = request.command == "DEGREE"
+         || request.command == "NEXT" || request.command == "PREV";
+      
+      if (request.command == "STATS")
+      {
+         result -> text = "OK " + stats();
+         return result;
+      }
+      
+      if (!pair && !single)
+      {
+         result -> text = "ERR Unknown command: " + request.command;
+         return result;
+      }
+      
+      std::string rest;
+      in >> request.source;
+      if (pair) in >> request.target;
+      
+      if (in.fail() || (in >> rest))
+      {
+         result -> text = "ERR Invalid request: " + line;
+         return result;
+      }
+      
+      try
+      {
+         // Tests if the nodes are valid before the search is queued.
+         graph_.outdegree(request.source);
+         if (pair) graph_.indegree(request.target);
+         
+         if (request.command != "REACH" && request.command != "PATH")
+         {
+            result -> text = answer(request);
+            return result;
+         }
+      }
+      catch (const std::exception& e)
+      {
+         result -> text = std::string("ERR ") + e.what();
+         return result;
+      }
+      
+      // Joins the batch from the same source, if no worker has taken it.
+      result -> done = false;
+      searches_++;
+      
+      std::shared_ptr<Batch>& batch = open_[request.source];
+      
+      if (batch)
+      {
+         std::lock_guard<std::mutex> lock(batch -> mutex);
+         
+         if (!batch -> started)
+         {
+            batch -> waiters.push_back(Waiter{ request, result });
+            batched_++;
+            return result;
+         }
+      }
+      
+      batch = std::make_shared<Batch>();
+      batch -> source = request.source;
+      batch -> started = false;
+      batch -> waiters.push_back(Waiter{ request, result });
+      
+      const std::shared_ptr<Batch> job = batch;
+      pool_.submit([this, job] { search(job); });
+      
+      return result;
+   }
+   
+   /**
+    * Answers the specified request that needs no search. The nodes of the
+    * request must be valid.
+    *
+    * @param request   the request
+    *
+    * @return the response
+    */
+   std::string Server::answer(const Request& request) const
+   {
+      const size_t k = request.source;
+      
+      if (request.command == "DEGREE")
+      {
+         return "OK " + std::to_string(graph_.indegree(k)) + " "
+            + std::to_string(graph_.outdegree(k));
+      }
+      
+      if (request.command == "HAS")
+         return graph_.has_edge(k, request.target) ? "OK 1" : "OK 0";
+      
+      const Adjacency::Range range = request.command == "NEXT"
+         ? graph_.next(k) : graph_.prev(k);
+      
+      std::string result = "OK " + std::to_string(range.size());
+      
+      for (const auto& element : range)
+      {
+         result += ' ';
+         result += std::to_string(element);
+      }
+      
+      return result;
+   }
+   
+   /**
+    * Answers the searches of the specified batch with one breadth-first
+    * search from their source node, which stops once it has reached every
+    * target node, and posts the responses to the event loop. The function
+    * runs on a worker thread.
+    *
+    * @param batch   the batch
+    */
+   void Server::search(const std::shared_ptr<Batch>& batch)
+   {
+      std::vector<Waiter> waiters;
+      
+      {
+         std::lock_guard<std::mutex> lock(batch -> mutex);
+         batch -> started = true;
+         waiters.swap(batch -> waiters);
+      }
+      
+      // Keeps the parents between searches, and resets the nodes reached.
+      thread_local std::vector<size_t> parent;
+      if (parent.size() != graph_.size()) parent.assign(graph_.size(), none);
+      
+      std::vector<size_t> targets;
+      for (const auto& element : waiters)
+         targets.push_back(element.request.target);
+      
+      std::sort(targets.begin(), targets.end());
+      targets.erase(std::unique(targets.begin(), targets.end()),
+         targets.end());
+      
+      auto wanted = [&](const size_t& k)
+      {
+         return std::binary_search(targets.begin(), targets.end(), k);
+      };
+      
+      const size_t source = batch -> source;
+      std::vector<size_t> queue(1, source);
+      size_t remaining = targets.size() - wanted(source);
+      parent[source] = source;
+      
+      for (size_t i = 0; i < queue.size() && remaining > 0; i++)
+      {
+         for (const auto& tail : graph_.next(queue[i]))
+         {
+            if (parent[tail] != none) continue;
+            
+            parent[tail] = queue[i];
+            queue.push_back(tail);
+            if (wanted(tail)) remaining--;
+         }
+      }
+      
+      std::vector<std::string> texts;
+      
+      for (const auto& element : waiters)
+      {
+         const size_t target = element.request.target;
+         
+         if (element.request.command == "REACH")
+            texts.push_back(parent[target] != none ? "OK 1" : "OK 0");
+         
+         else if (parent[target] == none) texts.push_back("OK -1");
+         
+         else
+         {
+            std::vector<size_t> path(1, target);
+            while (path.back() != source) path.push_back(parent[path.back()]);
+            
+            std::string text = "OK " + std::to_string(path.size() - 1);
+            
+            for (auto node = path.rbegin(); node != path.rend(); ++node)
+               text += " " + std::to_string(*node);
+            
+            texts.push_back(text);
+         }
+      }
+      
+      for (const auto& element : queue) parent[element] = none;
+      
+      // The responses are handed over on the thread of the loop.
+      loop_.post([this, batch, waiters, texts]
+         {
+            const auto open = open_.find(batch -> source);
+            if (open != open_.end() && open -> second == batch)
+               open_.erase(open);
+         
+            for (size_t i = 0; i < waiters.size(); i++)
+            {
+               waiters[i].pending -> text = texts[i];
+               waiters[i].pending -> done = true;
+            }
+         
+            // Resumes each connection once, after every response is done.
+            for (const auto& element : waiters)
+            {
+               const std::coroutine_handle<> handle =
+                  element.pending -> handle;
+               element.pending -> handle = nullptr;
+               if (handle) handle.resume();
+            }
+         });
+   }
+   
+   /**
+    * Constructs an awaiter for the specified response.
+    *
+    * @param pending   the response
+    */
+   inline Server::Response::Response(const std::shared_ptr<Pending>& pending)
+      : pending_(pending) {}
+   
+   /**
+    * Tests if the response is already done.
+    *
+    * @return <code>true</code> if the response is done, or
+    * <code>false</code> otherwise
+    */
+   inline bool Server::Response::await_ready() const noexcept
+   {
+      return pending_ -> done;
+   }
+   
+   /**
+    * Returns the response.
+    *
+    * @return the response
+    */
+   inline std::string Server::Response::await_resume() const
+   {
+      return std::move(pending_ -> text);
+   }
+   
+   /**
+    * Records the specified connection to be resumed when the response is
+    * done.
+    *
+    * @param handle   the connection
+    */
+   inline void Server::Response::await_suspend(
+      const std::coroutine_handle<>& handle) const
+   {
+      pending_ -> handle = handle;
+   }
+   
+   /**
+    * Constructs a scope in the specified server.
+    *
+    * @param server   the server
+    */
+   inline Server::Scope::Scope(Server& server)
+      : server_(server), address_(nullptr) {}
+   
+   /** Forgets the coroutine. */
+   inline Server::Scope::~Scope()
+   {
+      if (address_ != nullptr) server_.tasks_.erase(address_);
+   }
+   
+   /**
+    * Returns <code>false</code>, so that the coroutine is recorded.
+    *
+    * @return <code>false</code>
+    */
+   inline bool Server::Scope::await_ready() const noexcept
+   {
+      return false;
+   }
+   
+   /** Continues the coroutine. */
+   inline void Server::Scope::await_resume() const noexcept {}
+   
+   /**
+    * Records the specified coroutine, and continues it at once.
+    *
+    * @param handle   the coroutine
+    *
+    * @return <code>false</code>
+    */
+   inline bool Server::Scope::await_suspend(
+      const std::coroutine_handle<>& handle)
+   {
+      address_ = handle.address();
+      server_.tasks_.insert(address_);
+      return false;
+   }
+}
 
-int main()
+/**
+ * Serves the directed graph in the binary directed graph file named by the
+ * first argument, on the port named by the second (7214 by default), with
+ * the number of worker threads named by the third (one per hardware thread
+ * by default), on the IPv4 address named by the fourth (127.0.0.1 by
+ * default).
+ *
+ * @param argc   the number of arguments
+ * @param argv   the arguments
+ *
+ * @return 0 once the server stops, or 1 if it cannot start
+ */
+int main(int argc, char** argv)
 {
-   std::cout << "Hello, world!" << std::endl;
+   if (argc < 2 || argc > 5)
+   {
+      std::cerr << "Usage: " << argv[0]
+         << " graph-file [port [threads [address]]]\n";
+      return 1;
+   }
+   
+   try
+   {
+      const Graph graph(argv[1]);
+      const unsigned long port = argc > 2 ? std::stoul(argv[2]) : 7214;
+      const unsigned long threads = argc > 3 ? std::stoul(argv[3]) : 0;
+      const std::string address = argc > 4 ? argv[4] : "127.0.0.1";
+      
+      if (port > 65535)
+         throw std::invalid_argument("Invalid port: " + std::to_string(port));
+      
+      Server server(graph, static_cast<uint16_t>(port), threads, address);
+      std::cout << "Serving " << graph.size() << " nodes on " << address
+         << ":" << port << std::endl;
+      
+      server.run();
+      std::cout << server.stats() << std::endl;
+   }
+   catch (const std::exception& e)
+   {
+      std::cerr << e.what() << '\n';
+      return 1;
+   }
+   
    return 0;
-}
\ No newline at end of file
+}
@@ -0,0 +1,663 @@
+/**
+ * Declarations and definitions of the <code>DirectedGraph</code> class for the
+ * <code>MappedStorage</code> storage policy, and <code>operator<<</code> for
+ * that class.
+ *
+ * @file mapped_directed_graph.h
+ *
+ * @author Kris Torres
+ *
+ * @date 2026-10-14
+ *
+ * @version 1.0
+ */
+
+#ifndef PIC_10C_MAPPED_DIRECTED_GRAPH_H_
+#define PIC_10C_MAPPED_DIRECTED_GRAPH_H_
+
+#include <string>
+#include <vector>
+#include <stdexcept>
+#include <algorithm>
+#include <utility>
+#include <ostream>
+#include <type_traits>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include "adjacency.h"
+#include "directed_graph.h"
+#include "graph_file.h"
+
+namespace Kris_Torres_UCLA_PIC_10C_Winter_2014
+{
+   /**
+    * A read-only directed graph served straight out of a memory-mapped binary
+    * directed graph file, as written by <code>GraphWriter::write_binary</code>.
+    * Opening the file maps it and checks its header, so no directed edge is
+    * parsed and no node is allocated; the pages of the file are only read
+    * from disk when they are first touched.<p>
+    *
+    * The interface is the <code>const</code> part of the interface of the
+    * other storage policies, and the values of the nodes are returned by
+    * reference into the mapping. The directed graph can be moved but not
+    * copied, since it owns the mapping. The file is trusted: only its header
+    * and the ends of its row offsets are checked.
+    *
+    * @param T   the type of the elements, which must be trivially copyable
+    * @param A   the allocator type, which is not used
+    *
+    * @author Kris Torres
+    */
+   template<typename T, typename A>
+   class DirectedGraph<T, MappedStorage, A>
+   {
+      static_assert(std::is_trivially_copyable<T>::value,
+         "A mapped directed graph needs trivially copyable values");
+      
+   public:
+      
+      // Constructors
+      explicit DirectedGraph(const std::string& path);
+      DirectedGraph(const DirectedGraph& rhs) = delete;
+      DirectedGraph(DirectedGraph&& rhs) noexcept;
+      
+      // Assignment operators
+      DirectedGraph& operator=(const DirectedGraph& rhs) = delete;
+      DirectedGraph& operator=(DirectedGraph&& rhs) noexcept;
+      
+      // Destructor
+      virtual ~DirectedGraph();
+      
+      // Mutator
+      void swap(DirectedGraph& rhs) noexcept;
+      
+      // Accessors
+      Adjacency adjacency() const;
+      const T& at(const size_t& k) const;
+      size_t edge_count(const size_t& from, const size_t& to) const;
+      bool empty() const;
+      const T& front() const;
+      bool has_edge(const size_t& from, const size_t& to) const;
+      size_t indegree(const size_t& k) const;
+      Adjacency::Range next(const size_t& k) const;
+      const T& operator[](const size_t& k) const;
+      size_t outdegree(const size_t& k) const;
+      Adjacency::Range prev(const size_t& k) const;
+      bool simple() const;
+      size_t size() const;
+      
+      // Relational operators
+      bool operator==(const DirectedGraph& rhs) const;
+      bool operator!=(const DirectedGraph& rhs) const;
+      
+      // Friend
+      template<typename U, typename V>
+      friend std::ostream& operator<<(std::ostream& out,
+         const DirectedGraph<U, MappedStorage, V>& rhs);
+      
+   private:
+      
+      // Mutator
+      void unmap() noexcept;
+      
+      // Accessor
+      void test_index(const size_t& k, const char* error) const;
+      
+      /** The start of the mapping, or <code>nullptr</code> if there is none. */
+      void* mapping_;
+      
+      /** The size of the mapping, in bytes. */
+      size_t length_;
+      
+      /** The number of nodes in this directed graph. */
+      size_t size_;
+      
+      /** The row offsets of the tail nodes. */
+      const size_t* offsets_;
+      
+      /** The tail node positions of all the directed edges. */
+      const size_t* targets_;
+      
+      /** The row offsets of the head nodes. */
+      const size_t* reverse_offsets_;
+      
+      /** The head node positions of all the directed edges. */
+      const size_t* sources_;
+      
+      /** The values of the nodes. */
+      const T* values_;
+   };
+   
+   // Directed graph output operator
+   template<typename T, typename A>
+   std::ostream& operator<<(std::ostream& out,
+      const DirectedGraph<T, MappedStorage, A>& rhs);
+   
+   /**
+    * Constructs a read-only directed graph by mapping the binary directed
+    * graph file at the specified path.
+    *
+    * @param path   the path of the binary directed graph file
+    *
+    * @throws std::runtime_error if the file cannot be opened or mapped, or if
+    * it is not a binary directed graph file with values of this type
+    */
+   template<typename T, typename A>
+   DirectedGraph<T, MappedStorage, A>::DirectedGraph(const std::string& path)
+      : mapping_(nullptr), length_(0), size_(0), offsets_(nullptr),
+        targets_(nullptr), reverse_offsets_(nullptr), sources_(nullptr),
+        values_(nullptr)
+   {
+      const int file = ::open(path.c_str(), O_RDONLY);
+      if (file < 0)
+         throw std::runtime_error("Cannot open graph file: " + path);
+      
+      struct stat status;
+      if (::fstat(file, &status) != 0
+          || static_cast<size_t>(status.st_size) < sizeof(GraphFileHeader))
+      {
+         ::close(file);
+         throw std::runtime_error("Invalid graph file: " + path);
+      }
+      
+      // The mapping stays valid after the file is closed.
+      length_ = status.st_size;
+      mapping_ = ::mmap(nullptr, length_, PROT_READ, MAP_PRIVATE, file, 0);
+      ::close(file);
+      
+      if (mapping_ == MAP_FAILED)
+      {
+         mapping_ = nullptr;
+         throw std::runtime_error("Cannot map graph file: " + path);
+      }
+      
+      // Tests if the header matches the file and the type of the values.
+      const char* data = static_cast<const char*>(mapping_);
+      const GraphFileHeader* header
+         = reinterpret_cast<const GraphFileHeader*>(data);
+      
+      if (!header -> valid() || header -> file_size != length_
+          || header -> value_size != sizeof(T)
+          || header -> value_alignment != alignof(T))
+      {
+         unmap();
+         throw std::runtime_error("Invalid graph file: " + path);
+      }
+      
+      size_ = header -> nodes;
+      offsets_ = reinterpret_cast<const size_t*>(data
+         + sizeof(GraphFileHeader));
+      targets_ = offsets_ + size_ + 1;
+      reverse_offsets_ = reinterpret_cast<const size_t*>(data
+         + header -> heads_offset());
+      sources_ = reverse_offsets_ + size_ + 1;
+      values_ = reinterpret_cast<const T*>(data + header -> values_offset);
+      
+      // Tests if the row offsets span exactly the directed edges.
+      if (offsets_[0] != 0 || offsets_[size_] != header -> edges
+          || reverse_offsets_[0] != 0
+          || reverse_offsets_[size_] != header -> edges)
+      {
+         unmap();
+         throw std::runtime_error("Invalid graph file: " + path);
+      }
+   }
+   
+   /**
+    * Constructs a directed graph that takes over the mapping of the specified
+    * directed graph, which is left empty.
+    *
+    * @param rhs   the directed graph to be moved
+    */
+   template<typename T, typename A>
+   DirectedGraph<T, MappedStorage, A>::DirectedGraph(DirectedGraph&& rhs)
+      noexcept
+      : mapping_(rhs.mapping_), length_(rhs.length_), size_(rhs.size_),
+        offsets_(rhs.offsets_), targets_(rhs.targets_),
+        reverse_offsets_(rhs.reverse_offsets_), sources_(rhs.sources_),
+        values_(rhs.values_)
+   {
+      rhs.mapping_ = nullptr;
+      rhs.length_ = 0;
+      rhs.size_ = 0;
+   }
+   
+   /**
+    * Moves the mapping of the specified directed graph to this directed graph,
+    * and unmaps the previous mapping of this directed graph. The specified
+    * directed graph is left empty.
+    *
+    * @param rhs   the directed graph to be moved
+    *
+    * @return this directed graph
+    */
+   template<typename T, typename A>
+   DirectedGraph<T, MappedStorage, A>& DirectedGraph<T, MappedStorage, A>
+      ::operator=(DirectedGraph&& rhs) noexcept
+   {
+      // Tests for self-assignment.
+      if (this != &rhs)
+      {
+         unmap();
+         swap(rhs);
+      }
+      
+      return *this;
+   }
+   
+   /** Destroys this directed graph, and unmaps the file. */
+   template<typename T, typename A>
+   inline DirectedGraph<T, MappedStorage, A>::~DirectedGraph()
+   {
+      unmap();
+   }
+   
+   /**
+    * Exchanges the mappings of this directed graph and the specified directed
+    * graph.
+    *
+    * @param rhs   the directed graph to be swapped with this directed graph
+    */
+   template<typename T, typename A>
+   void DirectedGraph<T, MappedStorage, A>::swap(DirectedGraph& rhs) noexcept
+   {
+      std::swap(mapping_, rhs.mapping_);
+      std::swap(length_, rhs.length_);
+      std::swap(size_, rhs.size_);
+      std::swap(offsets_, rhs.offsets_);
+      std::swap(targets_, rhs.targets_);
+      std::swap(reverse_offsets_, rhs.reverse_offsets_);
+      std::swap(sources_, rhs.sources_);
+      std::swap(values_, rhs.values_);
+   }
+   
+   /**
+    * Returns a snapshot of the directed edges in this directed graph, copied
+    * out of the mapping.
+    *
+    * @return the adjacency of this directed graph
+    */
+   template<typename T, typename A>
+   Adjacency DirectedGraph<T, MappedStorage, A>::adjacency() const
+   {
+      Adjacency result;
+      
+      if (!empty())
+      {
+         const size_t edges = offsets_[size_];
+         result.offsets_.assign(offsets_, offsets_ + size_ + 1);
+         result.targets_.assign(targets_, targets_ + edges);
+         result.reverse_offsets_.assign(reverse_offsets_,
+            reverse_offsets_ + size_ + 1);
+         result.sources_.assign(sources_, sources_ + edges);
+      }
+      
+      return result;
+   }
+   
+   /**
+    * Returns a reference to the value of the node at position <i>k</i> in this
+    * directed graph.
+    *
+    * @param k   the position of the node
+    *
+    * @return the value of the node
+    *
+    * @throws std::out_of_range if <i>k</i> is at least the number of nodes
+    */
+   template<typename T, typename A>
+   const T& DirectedGraph<T, MappedStorage, A>::at(const size_t& k) const
+   {
+      // Tests if k is valid.
+      test_index(k, "Invalid node index in directed graph: ");
+      
+      return values_[k];
+   }
+   
+   /**
+    * Returns the number of directed edges from the specified starting node to
+    * the specified ending node in this directed graph. The function scans the
+    * shorter of the row of tail nodes of the starting node and the row of head
+    * nodes of the ending node.<p>
+    *
+    * The function automatically checks whether <code>from</code> and
+    * <code>to</code> are greater than or equal to the number of nodes in the
+    * directed graph, throwing an <code>std::out_of_range</code> exception if it
+    * is not.
+    *
+    * @param from   the position of the starting node
+    * @param to     the position of the ending node
+    *
+    * @return the number of directed edges
+    *
+    * @throws std::out_of_range if either <code>from</code> or <code>to</code>
+    * is out of bounds
+    */
+   template<typename T, typename A>
+   size_t DirectedGraph<T, MappedStorage, A>::edge_count(const size_t& from,
+      const size_t& to) const
+   {
+      // Tests if the starting and ending node indices are valid.
+      test_index(from, "Invalid starting node index in directed graph: ");
+      test_index(to, "Invalid ending node index in directed graph: ");
+      
+      if (offsets_[from + 1] - offsets_[from]
+          <= reverse_offsets_[to + 1] - reverse_offsets_[to])
+      {
+         return std::count(targets_ + offsets_[from],
+            targets_ + offsets_[from + 1], to);
+      }
+      
+      return std::count(sources_ + reverse_offsets_[to],
+         sources_ + reverse_offsets_[to + 1], from);
+   }
+   
+   /**
+    * Tests if this directed graph is empty (i.e., if the directed graph
+    * contains no nodes).
+    *
+    * @return <code>true</code> if this directed graph is empty, or
+    * <code>false</code> otherwise
+    */
+   template<typename T, typename A>
+   inline bool DirectedGraph<T, MappedStorage, A>::empty() const
+   {
+      return size_ == 0;
+   }
+   
+   /**
+    * Returns a reference to the value of the first node in this directed
+    * graph.
+    *
+    * @return the value of the first node
+    *
+    * @throws std::out_of_range if this directed graph is empty
+    */
+   template<typename T, typename A>
+   const T& DirectedGraph<T, MappedStorage, A>::front() const
+   {
+      // Tests if the directed graph is empty.
+      if (empty()) throw std::out_of_range("Empty directed graph");
+      
+      return values_[0];
+   }
+   
+   /**
+    * Tests if this directed graph has a directed edge from the specified
+    * starting node to the specified ending node. The function scans the
+    * shorter of the row of tail nodes of the starting node and the row of head
+    * nodes of the ending node.<p>
+    *
+    * The function automatically checks whether <code>from</code> and
+    * <code>to</code> are greater than or equal to the number of nodes in the
+    * directed graph, throwing an <code>std::out_of_range</code> exception if it
+    * is not.
+    *
+    * @param from   the position of the starting node
+    * @param to     the position of the ending node
+    *
+    * @return <code>true</code> if the directed edge exists, or
+    * <code>false</code> otherwise
+    *
+    * @throws std::out_of_range if either <code>from</code> or <code>to</code>
+    * is out of bounds
+    */
+   template<typename T, typename A>
+   bool DirectedGraph<T, MappedStorage, A>::has_edge(const size_t& from,
+      const size_t& to) const
+   {
+      // Tests if the starting and ending node indices are valid.
+      test_index(from, "Invalid starting node index in directed graph: ");
+      test_index(to, "Invalid ending node index in directed graph: ");
+      
+      if (offsets_[from + 1] - offsets_[from]
+          <= reverse_offsets_[to + 1] - reverse_offsets_[to])
+      {
+         const auto last = targets_ + offsets_[from + 1];
+         return std::find(targets_ + offsets_[from], last, to) != last;
+      }
+      
+      const auto last = sources_ + reverse_offsets_[to + 1];
+      return std::find(sources_ + reverse_offsets_[to], last, from) != last;
+   }
+   
+   /**
+    * Returns the <b>indegree</b> of the node at position <i>k</i> in this
+    * directed graph.
+    *
+    * @param k   the position of the node
+    *
+    * @return the indegree of the node
+    *
+    * @throws std::out_of_range if <i>k</i> is at least the number of nodes
+    */
+   template<typename T, typename A>
+   size_t DirectedGraph<T, MappedStorage, A>::indegree(const size_t& k) const
+   {
+      // Tests if k is valid.
+      test_index(k, "Invalid node index in directed graph: ");
+      
+      return reverse_offsets_[k + 1] - reverse_offsets_[k];
+   }
+   
+   /**
+    * Returns the tail nodes adjacent to the node at position <i>k</i> in this
+    * directed graph, straight out of the mapping.
+    *
+    * @param k   the position of the node
+    *
+    * @return the range of the tail node positions
+    *
+    * @throws std::out_of_range if <i>k</i> is at least the number of nodes
+    */
+   template<typename T, typename A>
+   Adjacency::Range DirectedGraph<T, MappedStorage, A>::next(const size_t& k)
+      const
+   {
+      // Tests if k is valid.
+      test_index(k, "Invalid node index in directed graph: ");
+      
+      return Adjacency::Range(targets_ + offsets_[k],
+         targets_ + offsets_[k + 1]);
+   }
+   
+   /**
+    * Returns a reference to the value of the node at position <i>k</i> in this
+    * directed graph. The position is not checked.
+    *
+    * @param k   the position of the node
+    *
+    * @return the value of the node
+    */
+   template<typename T, typename A>
+   inline const T& DirectedGraph<T, MappedStorage, A>
+      ::operator[](const size_t& k) const
+   {
+      return values_[k];
+   }
+   
+   /**
+    * Returns the <b>outdegree</b> of the node at position <i>k</i> in this
+    * directed graph.
+    *
+    * @param k   the position of the node
+    *
+    * @return the outdegree of the node
+    *
+    * @throws std::out_of_range if <i>k</i> is at least the number of nodes
+    */
+   template<typename T, typename A>
+   size_t DirectedGraph<T, MappedStorage, A>::outdegree(const size_t& k) const
+   {
+      // Tests if k is valid.
+      test_index(k, "Invalid node index in directed graph: ");
+      
+      return offsets_[k + 1] - offsets_[k];
+   }
+   
+   /**
+    * Returns the head nodes adjacent to the node at position <i>k</i> in this
+    * directed graph, straight out of the mapping.
+    *
+    * @param k   the position of the node
+    *
+    * @return the range of the head node positions
+    *
+    * @throws std::out_of_range if <i>k</i> is at least the number of nodes
+    */
+   template<typename T, typename A>
+   Adjacency::Range DirectedGraph<T, MappedStorage, A>::prev(const size_t& k)
+      const
+   {
+      // Tests if k is valid.
+      test_index(k, "Invalid node index in directed graph: ");
+      
+      return Adjacency::Range(sources_ + reverse_offsets_[k],
+         sources_ + reverse_offsets_[k + 1]);
+   }
+   
+   /**
+    * Tests if this directed graph is simple, that is, if the directed graph has
+    * no loops and no multiple directed edges (edges with the same starting and
+    * ending nodes). Each ending node is marked with the last starting node
+    * that reached it, so the test takes linear time.
+    *
+    * @return <code>true</code> if this directed graph is simple, or
+    * <code>false</code> otherwise
+    */
+   template<typename T, typename A>
+   bool DirectedGraph<T, MappedStorage, A>::simple() const
+   {
+      std::vector<size_t> marks(size_, static_cast<size_t>(-1));
+      
+      for (size_t i = 0; i < size_; i++)
+      {
+         for (size_t j = offsets_[i]; j < offsets_[i + 1]; j++)
+         {
+            // Tests if the current node has a loop or a multiple directed edge.
+            if (targets_[j] == i || marks[targets_[j]] == i) return false;
+            marks[targets_[j]] = i;
+         }
+      }
+      
+      return true;
+   }
+   
+   /**
+    * Returns the number of nodes in this directed graph.
+    *
+    * @return the number of nodes
+    */
+   template<typename T, typename A>
+   inline size_t DirectedGraph<T, MappedStorage, A>::size() const
+   {
+      return size_;
+   }
+   
+   /**
+    * Tests if this directed graph and the specified directed graph are equal.
+    *
+    * @param rhs   the directed graph to compare with this directed graph
+    *
+    * @return <code>true</code> if this directed graph and the specified
+    * directed graph are equal, or <code>false</code> otherwise
+    */
+   template<typename T, typename A>
+   bool DirectedGraph<T, MappedStorage, A>
+      ::operator==(const DirectedGraph& rhs) const
+   {
+      if (size_ != rhs.size_) return false;
+      if (empty()) return true;
+      
+      // Tests if the two directed graphs have the same directed edges.
+      const size_t edges = offsets_[size_];
+      if (!std::equal(offsets_, offsets_ + size_ + 1, rhs.offsets_)
+          || !std::equal(targets_, targets_ + edges, rhs.targets_))
+         return false;
+      
+      // Tests if the two directed graphs have the same nodes.
+      for (size_t i = 0; i < size_; i++)
+         if (values_[i] != rhs.values_[i]) return false;
+      
+      return true;
+   }
+   
+   /**
+    * Tests if this directed graph and the specified directed graph are unequal.
+    *
+    * @param rhs   the directed graph to compare with this directed graph
+    *
+    * @return <code>true</code> if this directed graph and the specified
+    * directed graph are unequal, or <code>false</code> otherwise
+    */
+   template<typename T, typename A>
+   inline bool DirectedGraph<T, MappedStorage, A>
+      ::operator!=(const DirectedGraph& rhs) const
+   {
+      return !(*this == rhs);
+   }
+   
+   /** Unmaps the file, if this directed graph has a mapping. */
+   template<typename T, typename A>
+   void DirectedGraph<T, MappedStorage, A>::unmap() noexcept
+   {
+      if (mapping_ != nullptr) ::munmap(mapping_, length_);
+      
+      mapping_ = nullptr;
+      length_ = 0;
+      size_ = 0;
+   }
+   
+   /**
+    * Tests if the specified position is a valid node position in this
+    * directed graph.
+    *
+    * @param k       the position of the node
+    * @param error   the error message
+    *
+    * @throws std::out_of_range if <i>k</i> is at least the number of nodes
+    */
+   template<typename T, typename A>
+   void DirectedGraph<T, MappedStorage, A>::test_index(const size_t& k,
+      const char* error) const
+   {
+      if (k >= size_) throw_index_error(error, k);
+   }
+   
+   /**
+    * Outputs the specified directed graph with the specified output stream.
+    *
+    * @param out   the output stream
+    * @param rhs   the directed graph to be outputted
+    *
+    * @return the stream after the output
+    */
+   template<typename T, typename A>
+   std::ostream& operator<<(std::ostream& out,
+      const DirectedGraph<T, MappedStorage, A>& rhs)
+   {
+      for (size_t i = 0; i < rhs.size_; i++)
+      {
+         // Outputs the current node by itself if it is disconnected.
+         if (rhs.offsets_[i] == rhs.offsets_[i + 1]
+             && rhs.reverse_offsets_[i] == rhs.reverse_offsets_[i + 1])
+            out << rhs.values_[i] << '\n';
+         
+         // Outputs the starting and ending nodes for each directed edge.
+         else
+         {
+            for (size_t j = rhs.offsets_[i]; j < rhs.offsets_[i + 1]; j++)
+            {
+               out << rhs.values_[i] << " -> " << rhs.values_[rhs.targets_[j]]
+                  << '\n';
+            }
+         }
+      }
+      
+      return out;
+   }
+}
+
+#endif   // PIC_10C_MAPPED_DIRECTED_GRAPH_H_
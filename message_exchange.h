@@ -0,0 +1,421 @@
+/**
+ * Declarations and definitions of the <code>MessageExchange</code> class.
+ *
+ * @file message_exchange.h
+ *
+ * @author Kris Torres
+ *
+ * @date 2026-10-14
+ *
+ * @version 1.0
+ */
+
+#ifndef PIC_10C_MESSAGE_EXCHANGE_H_
+#define PIC_10C_MESSAGE_EXCHANGE_H_
+
+#include <cstddef>
+#include <cstring>
+#include <vector>
+#include <algorithm>
+#include <utility>
+#include "barrier.h"
+
+namespace Kris_Torres_UCLA_PIC_10C_Winter_2014
+{
+   /**
+    * A <b>message exchange</b> carries the messages between a fixed set of
+    * parties that compute in <i>bulk-synchronous</i> supersteps: in each
+    * superstep, every party sends its messages, and then every party calls
+    * <code>synchronize</code>, which waits for all the others and sums a
+    * value over all of them. The messages sent in a superstep can be
+    * received from the end of that superstep until the end of the next
+    * one.<p>
+    *
+    * A message is addressed to a position on the receiving party, and may
+    * carry a value. The messages from one party to another in a superstep
+    * are batched into one buffer, and compressed on the way in: they are
+    * sorted by position, the gaps between the positions are written as
+    * variable-length integers, and so are the counts and the integer values,
+    * so that a dense batch of positions takes about one byte per message.
+    * The buffers are the only thing that the parties share, so they could be
+    * carried between processes instead.<p>
+    *
+    * The buffers and the sums are kept twice, once for each parity of
+    * superstep, so a party may already send the messages of the next
+    * superstep while the others are still receiving the last ones.
+    *
+    * @author Kris Torres
+    */
+   class MessageExchange final
+   {
+   public:
+      
+      // Constructor
+      explicit MessageExchange(const size_t& parties);
+      
+      // Mutators
+      void receive(const size_t& to, std::vector<size_t>& positions);
+      template<typename V>
+      void receive(const size_t& to,
+         std::vector<std::pair<size_t, V>>& messages);
+      void send(const size_t& from, const size_t& to,
+         std::vector<size_t>& positions);
+      template<typename V>
+      void send(const size_t& from, const size_t& to,
+         std::vector<std::pair<size_t, V>>& messages);
+      double synchronize(const size_t& party, const double& value = 0);
+      
+      // Accessors
+      size_t bytes() const;
+      size_t parties() const;
+      
+   private:
+      
+      // Types
+      typedef std::vector<unsigned char> Buffer;
+      
+      // Mutators
+      static void put(Buffer& buffer, const size_t& value);
+      static void put(Buffer& buffer, const double& value);
+      Buffer& outbox(const size_t& from, const size_t& to);
+      
+      // Accessors
+      static void get(const unsigned char*& position, size_t& value);
+      static void get(const unsigned char*& position, double& value);
+      const Buffer& inbox(const size_t& from, const size_t& to) const;
+      
+      /** The barrier at which the parties meet after every superstep. */
+      Barrier barrier_;
+      
+      /** The number of parties. */
+      size_t parties_;
+      
+      /** The buffer from each party to each party, for each parity. */
+      std::vector<Buffer> buffers_[2];
+      
+      /** The value of each party in the sum, for each parity. */
+      std::vector<double> values_[2];
+      
+      /** The number of supersteps that each party has finished. */
+      std::vector<size_t> steps_;
+      
+      /** The number of bytes that each party has sent. */
+      std::vector<size_t> bytes_;
+   };
+   
+   /**
+    * Constructs a message exchange between the specified number of parties,
+    * which are numbered from 0.
+    *
+    * @param parties   the number of parties
+    */
+   inline MessageExchange::MessageExchange(const size_t& parties)
+      : barrier_(parties), parties_(parties), steps_(parties, 0),
+        bytes_(parties, 0)
+   {
+      for (size_t i = 0; i < 2; i++)
+      {
+         buffers_[i].resize(parties * parties);
+         values_[i].assign(parties, 0);
+      }
+   }
+   
+   /**
+    * Receives the positions sent to the specified party in the last
+    * superstep, in order of the sending party, and sorted within the
+    * messages from each party.
+    *
+    * @param to          the receiving party
+    * @param positions   the vector into which the positions are received
+    */
+   inline void MessageExchange::receive(const size_t& to,
+      std::vector<size_t>& positions)
+   {
+      positions.clear();
+      
+      for (size_t i = 0; i < parties_; i++)
+      {
+         const Buffer& buffer = inbox(i, to);
+         const unsigned char* position = buffer.data();
+         const unsigned char* last = position + buffer.size();
+         
+         while (position != last)
+         {
+            size_t count = 0;
+            size_t k = 0;
+            get(position, count);
+            
+            for (size_t j = 0; j < count; j++)
+            {
+               size_t gap = 0;
+               get(position, gap);
+               k += gap;
+               positions.push_back(k);
+            }
+         }
+      }
+   }
+   
+   /**
+    * Receives the messages sent to the specified party in the last
+    * superstep, in order of the sending party, and sorted by position within
+    * the messages from each party.
+    *
+    * @param V   the type of the values, <code>size_t</code> or
+    *            <code>double</code>
+    *
+    * @param to         the receiving party
+    * @param messages   the vector into which the messages are received
+    */
+   template<typename V>
+   void MessageExchange::receive(const size_t& to,
+      std::vector<std::pair<size_t, V>>& messages)
+   {
+      messages.clear();
+      
+      for (size_t i = 0; i < parties_; i++)
+      {
+         const Buffer& buffer = inbox(i, to);
+         const unsigned char* position = buffer.data();
+         const unsigned char* last = position + buffer.size();
+         
+         while (position != last)
+         {
+            size_t count = 0;
+            size_t k = 0;
+            get(position, count);
+            
+            for (size_t j = 0; j < count; j++)
+            {
+               size_t gap = 0;
+               V value;
+               get(position, gap);
+               get(position, value);
+               k += gap;
+               messages.push_back(std::make_pair(k, value));
+            }
+         }
+      }
+   }
+   
+   /**
+    * Sends the specified positions from one party to another in the current
+    * superstep, and leaves the vector of positions empty.
+    *
+    * @param from        the sending party
+    * @param to          the receiving party
+    * @param positions   the positions
+    */
+   inline void MessageExchange::send(const size_t& from, const size_t& to,
+      std::vector<size_t>& positions)
+   {
+      if (positions.empty()) return;
+      
+      std::sort(positions.begin(), positions.end());
+      Buffer& buffer = outbox(from, to);
+      const size_t size = buffer.size();
+      put(buffer, positions.size());
+      
+      size_t k = 0;
+      
+      for (const auto& element : positions)
+      {
+         put(buffer, element - k);
+         k = element;
+      }
+      
+      bytes_[from] += buffer.size() - size;
+      positions.clear();
+   }
+   
+   /**
+    * Sends the specified messages from one party to another in the current
+    * superstep, and leaves the vector of messages empty.
+    *
+    * @param V   the type of the values, <code>size_t</code> or
+    *            <code>double</code>
+    *
+    * @param from       the sending party
+    * @param to         the receiving party
+    * @param messages   the messages, each a position and a value
+    */
+   template<typename V>
+   void MessageExchange::send(const size_t& from, const size_t& to,
+      std::vector<std::pair<size_t, V>>& messages)
+   {
+      if (messages.empty()) return;
+      
+      std::sort(messages.begin(), messages.end(),
+         [](const std::pair<size_t, V>& lhs, const std::pair<size_t, V>& rhs)
+         {
+            return lhs.first < rhs.first;
+         });
+      
+      Buffer& buffer = outbox(from, to);
+      const size_t size = buffer.size();
+      put(buffer, messages.size());
+      
+      size_t k = 0;
+      
+      for (const auto& element : messages)
+      {
+         put(buffer, element.first - k);
+         put(buffer, element.second);
+         k = element.first;
+      }
+      
+      bytes_[from] += buffer.size() - size;
+      messages.clear();
+   }
+   
+   /**
+    * Ends the current superstep of the specified party: waits until every
+    * party has ended it, and returns the sum of the specified values of all
+    * of the parties. The messages sent in the superstep can be received
+    * afterwards.
+    *
+    * @param party   the party
+    * @param value   the value of the party
+    *
+    * @return the sum of the values of all of the parties
+    */
+   inline double MessageExchange::synchronize(const size_t& party,
+      const double& value)
+   {
+      const size_t parity = steps_[party] & 1;
+      values_[parity][party] = value;
+      barrier_.wait();
+      
+      double sum = 0;
+      for (const auto& element : values_[parity]) sum += element;
+      
+      // Every party has received the buffers of this parity by now.
+      steps_[party]++;
+      for (size_t i = 0; i < parties_; i++) outbox(party, i).clear();
+      
+      return sum;
+   }
+   
+   /**
+    * Returns the number of bytes sent by all of the parties so far. The
+    * function must not be called while the parties are sending.
+    *
+    * @return the number of bytes
+    */
+   inline size_t MessageExchange::bytes() const
+   {
+      size_t sum = 0;
+      for (const auto& element : bytes_) sum += element;
+      return sum;
+   }
+   
+   /**
+    * Returns the number of parties.
+    *
+    * @return the number of parties
+    */
+   inline size_t MessageExchange::parties() const
+   {
+      return parties_;
+   }
+   
+   /**
+    * Appends the specified integer to the specified buffer as a
+    * variable-length integer, seven bits per byte.
+    *
+    * @param buffer   the buffer
+    * @param value    the integer
+    */
+   inline void MessageExchange::put(Buffer& buffer, const size_t& value)
+   {
+      size_t rest = value;
+      
+      while (rest >= 0x80)
+      {
+         buffer.push_back(static_cast<unsigned char>(rest | 0x80));
+         rest >>= 7;
+      }
+      
+      buffer.push_back(static_cast<unsigned char>(rest));
+   }
+   
+   /**
+    * Appends the bytes of the specified floating-point number to the
+    * specified buffer.
+    *
+    * @param buffer   the buffer
+    * @param value    the floating-point number
+    */
+   inline void MessageExchange::put(Buffer& buffer, const double& value)
+   {
+      unsigned char bytes[sizeof(double)];
+      std::memcpy(bytes, &value, sizeof(double));
+      buffer.insert(buffer.end(), bytes, bytes + sizeof(double));
+   }
+   
+   /**
+    * Returns the buffer from one party to another for the current superstep
+    * of the sending party.
+    *
+    * @param from   the sending party
+    * @param to     the receiving party
+    *
+    * @return the buffer
+    */
+   inline MessageExchange::Buffer& MessageExchange::outbox(const size_t& from,
+      const size_t& to)
+   {
+      return buffers_[steps_[from] & 1][from * parties_ + to];
+   }
+   
+   /**
+    * Reads a variable-length integer, and moves the specified position past
+    * it.
+    *
+    * @param position   the position of the integer
+    * @param value      the integer that is read
+    */
+   inline void MessageExchange::get(const unsigned char*& position,
+      size_t& value)
+   {
+      value = 0;
+      
+      for (size_t shift = 0; ; shift += 7)
+      {
+         const unsigned char byte = *position++;
+         value |= static_cast<size_t>(byte & 0x7f) << shift;
+         if (byte < 0x80) break;
+      }
+   }
+   
+   /**
+    * Reads the bytes of a floating-point number, and moves the specified
+    * position past them.
+    *
+    * @param position   the position of the floating-point number
+    * @param value      the floating-point number that is read
+    */
+   inline void MessageExchange::get(const unsigned char*& position,
+      double& value)
+   {
+      std::memcpy(&value, position, sizeof(double));
+      position += sizeof(double);
+   }
+   
+   /**
+    * Returns the buffer from one party to another for the last superstep of
+    * the receiving party.
+    *
+    * @param from   the sending party
+    * @param to     the receiving party
+    *
+    * @return the buffer
+    */
+   inline const MessageExchange::Buffer& MessageExchange::inbox(
+      const size_t& from, const size_t& to) const
+   {
+      return buffers_[(steps_[to] & 1) ^ 1][from * parties_ + to];
+   }
+}
+
+#endif   // PIC_10C_MESSAGE_EXCHANGE_H_
@@ -0,0 +1,592 @@
+/**
+ * Declarations and definitions of the <code>page_rank</code> and
+ * <code>personalized_page_rank</code> functions, and the
+ * <code>PageRank</code> class.
+ *
+ * @file page_rank.h
+ *
+ * @author Kris Torres
+ *
+ * @date 2026-10-14
+ *
+ * @version 1.0
+ */
+
+#ifndef PIC_10C_PAGE_RANK_H_
+#define PIC_10C_PAGE_RANK_H_
+
+#include <string>
+#include <vector>
+#include <stdexcept>
+#include <algorithm>
+#include <functional>
+#include <thread>
+#include <cmath>
+#include "boost/lexical_cast.hpp"
+#include "adjacency.h"
+#include "barrier.h"
+#include "directed_graph.h"
+
+namespace Kris_Torres_UCLA_PIC_10C_Winter_2014
+{
+   /**
+    * A <b>PageRank</b> computation ranks the nodes of a directed graph by the
+    * stationary distribution of a random walk that follows a random directed
+    * edge with probability <i>d</i>, the <i>damping factor</i>, and otherwise
+    * jumps to a node drawn from the <i>teleport</i> distribution. A walk at a
+    * node with no tail nodes always jumps. The teleport distribution is
+    * uniform for the plain PageRank, or given for the personalized one.<p>
+    *
+    * Each iteration <i>pulls</i>: every node sums the contributions of its
+    * head nodes, read from the transposed rows of the adjacency, so no two
+    * threads ever write to the same node. The contribution of a node is its
+    * rank times the inverse of its outdegree, which is 0 for a node without
+    * tail nodes, computed once per iteration. The ranks and the contributions
+    * are double-buffered, so each iteration reads one pair of arrays and
+    * writes the other.<p>
+    *
+    * The sums of the contributions are gathered one node at a time, since
+    * the head nodes are scattered. The ranks, the contributions, and the
+    * change of the ranks are then computed in blocks of lanes, without any
+    * branch, which the compiler vectorizes.<p>
+    *
+    * The nodes are split into one contiguous partition per thread, balanced
+    * by the number of directed edges that enter them. The threads are started
+    * once per computation and meet at a barrier after every iteration, where
+    * the computation stops once the ranks change by less than the tolerance,
+    * summed over all the nodes.
+    *
+    * @author Kris Torres
+    */
+   class PageRank final
+   {
+   public:
+      
+      // Constructor
+      explicit PageRank(const Adjacency& graph, const size_t& threads = 0);
+      
+      // Mutators
+      std::vector<double> run(const double& damping = 0.85,
+         const double& tolerance = 1e-9,
+         const size_t& max_iterations = 100);
+      std::vector<double> run(const std::vector<double>& personalization,
+         const double& damping = 0.85, const double& tolerance = 1e-9,
+         const size_t& max_iterations = 100);
+      
+      // Accessors
+      size_t iterations() const;
+      size_t threads() const;
+      
+   private:
+      
+      // Mutators
+      void advance();
+      std::vector<double> solve(const double& damping,
+         const double& tolerance, const size_t& max_iterations);
+      void step(const size_t& id);
+      void work(const size_t& id, Barrier& barrier);
+      
+      // Accessors
+      double pull(const size_t& k) const;
+      static void test_damping(const double& damping);
+      
+      /** The directed graph to be ranked. */
+      const Adjacency* graph_;
+      
+      /** The number of threads that rank the directed graph. */
+      size_t threads_;
+      
+      /** The first node of each partition, followed by the number of nodes. */
+      std::vector<size_t> partitions_;
+      
+      /** The probability of jumping to each node. */
+      std::vector<double> teleport_;
+      
+      /** The inverse of the outdegree of each node, or 0 without tail nodes. */
+      std::vector<double> inverse_;
+      
+      /** 1 for each node without tail nodes, or 0 for every other node. */
+      std::vector<double> sinks_;
+      
+      /** The ranks of the nodes in the current and the next iteration. */
+      std::vector<double> rank_[2];
+      
+      /** The contributions of the nodes in the current and next iteration. */
+      std::vector<double> contribution_[2];
+      
+      /** The change of the ranks in the partition of each thread. */
+      std::vector<double> change_;
+      
+      /** The rank of the nodes without tail nodes in each partition. */
+      std::vector<double> dangling_;
+      
+      /** Which of the two buffers holds the current iteration. */
+      size_t current_;
+      
+      /** The damping factor. */
+      double damping_;
+      
+      /** The share of the teleport distribution in the next iteration. */
+      double base_;
+      
+      /** The tolerance on the change of the ranks. */
+      double tolerance_;
+      
+      /** The maximum number of iterations. */
+      size_t max_iterations_;
+      
+      /** The number of iterations done. */
+      size_t iterations_;
+      
+      /** Whether the computation is over. */
+      bool done_;
+   };
+   
+   /**
+    * Returns the PageRank of each node in the specified adjacency, found on
+    * the specified number of threads (see <code>PageRank</code>). The ranks
+    * sum to 1.
+    *
+    * @param graph       the adjacency of the directed graph
+    * @param damping     the damping factor, at least 0 and less than 1
+    * @param tolerance   the change of the ranks, summed over all the nodes,
+    *                    below which the computation stops
+    * @param threads     the number of threads, or 0 for one per hardware
+    *                    thread
+    *
+    * @return the rank of each node
+    *
+    * @throws std::invalid_argument if the damping factor is out of range
+    */
+   inline std::vector<double> page_rank(const Adjacency& graph,
+      const double& damping = 0.85, const double& tolerance = 1e-9,
+      const size_t& threads = 0)
+   {
+      return PageRank(graph, threads).run(damping, tolerance);
+   }
+   
+   /**
+    * Returns the PageRank of each node in the specified directed graph, found
+    * on the specified number of threads. The ranks sum to 1.
+    *
+    * @param graph       the directed graph
+    * @param damping     the damping factor, at least 0 and less than 1
+    * @param tolerance   the change of the ranks, summed over all the nodes,
+    *                    below which the computation stops
+    * @param threads     the number of threads, or 0 for one per hardware
+    *                    thread
+    *
+    * @return the rank of each node
+    *
+    * @throws std::invalid_argument if the damping factor is out of range
+    */
+   template<typename T, typename S, typename A>
+   inline std::vector<double> page_rank(const DirectedGraph<T, S, A>& graph,
+      const double& damping = 0.85, const double& tolerance = 1e-9,
+      const size_t& threads = 0)
+   {
+      return page_rank(graph.adjacency(), damping, tolerance, threads);
+   }
+   
+   /**
+    * Returns the personalized PageRank of each node in the specified
+    * adjacency, with the teleport distribution proportional to the specified
+    * weights, found on the specified number of threads. The ranks sum to 1.
+    *
+    * @param graph             the adjacency of the directed graph
+    * @param personalization   the teleport weight of each node
+    * @param damping           the damping factor, at least 0 and less than 1
+    * @param tolerance         the change of the ranks, summed over all the
+    *                          nodes, below which the computation stops
+    * @param threads           the number of threads, or 0 for one per
+    *                          hardware thread
+    *
+    * @return the rank of each node
+    *
+    * @throws std::invalid_argument if the damping factor is out of range, or
+    * if the weights do not match the nodes, are negative, or sum to 0
+    */
+   inline std::vector<double> personalized_page_rank(const Adjacency& graph,
+      const std::vector<double>& personalization, const double& damping = 0.85,
+      const double& tolerance = 1e-9, const size_t& threads = 0)
+   {
+      return PageRank(graph, threads).run(personalization, damping, tolerance);
+   }
+   
+   /**
+    * Returns the personalized PageRank of each node in the specified directed
+    * graph, with the teleport distribution proportional to the specified
+    * weights, found on the specified number of threads. The ranks sum to 1.
+    *
+    * @param graph             the directed graph
+    * @param personalization   the teleport weight of each node
+    * @param damping           the damping factor, at least 0 and less than 1
+    * @param tolerance         the change of the ranks, summed over all the
+    *                          nodes, below which the computation stops
+    * @param threads           the number of threads, or 0 for one per
+    *                          hardware thread
+    *
+    * @return the rank of each node
+    *
+    * @throws std::invalid_argument if the damping factor is out of range, or
+    * if the weights do not match the nodes, are negative, or sum to 0
+    */
+   template<typename T, typename S, typename A>
+   inline std::vector<double> personalized_page_rank(
+      const DirectedGraph<T, S, A>& graph,
+      const std::vector<double>& personalization, const double& damping = 0.85,
+      const double& tolerance = 1e-9, const size_t& threads = 0)
+   {
+      return personalized_page_rank(graph.adjacency(), personalization,
+         damping, tolerance, threads);
+   }
+   
+   /**
+    * Constructs a PageRank computation of the specified adjacency on the
+    * specified number of threads, and splits the nodes into partitions. The
+    * adjacency must outlive the computation.
+    *
+    * @param graph     the adjacency of the directed graph
+    * @param threads   the number of threads, or 0 for one per hardware thread
+    */
+   inline PageRank::PageRank(const Adjacency& graph, const size_t& threads)
+      : graph_(&graph), threads_(threads), current_(0), damping_(0),
+        base_(0), tolerance_(0), max_iterations_(0), iterations_(0),
+        done_(false)
+   {
+      if (threads_ == 0) threads_ = std::thread::hardware_concurrency();
+      if (threads_ == 0) threads_ = 1;
+      
+      // Gives each partition about the same number of nodes and edges.
+      const size_t n = graph.size();
+      const size_t total = n + graph.edges();
+      partitions_.assign(1, 0);
+      inverse_.assign(n, 0);
+      sinks_.assign(n, 0);
+      size_t work = 0;
+      
+      for (size_t i = 0; i < n; i++)
+      {
+         const size_t degree = graph.outdegree(i);
+         if (degree == 0) sinks_[i] = 1;
+         else inverse_[i] = 1.0 / degree;
+         
+         work += 1 + graph.indegree(i);
+         
+         if (partitions_.size() < threads_
+            && work * threads_ >= total * partitions_.size())
+            partitions_.push_back(i + 1);
+      }
+      
+      while (partitions_.size() <= threads_) partitions_.push_back(n);
+      
+      change_.resize(threads_);
+      dangling_.resize(threads_);
+   }
+   
+   /**
+    * Computes the PageRank of each node, with a uniform teleport
+    * distribution.
+    *
+    * @param damping          the damping factor, at least 0 and less than 1
+    * @param tolerance        the change of the ranks, summed over all the
+    *                         nodes, below which the computation stops
+    * @param max_iterations   the maximum number of iterations
+    *
+    * @return the rank of each node
+    *
+    * @throws std::invalid_argument if the damping factor is out of range
+    */
+   inline std::vector<double> PageRank::run(const double& damping,
+      const double& tolerance, const size_t& max_iterations)
+   {
+      test_damping(damping);
+      
+      const size_t n = graph_ -> size();
+      teleport_.assign(n, n == 0 ? 0 : 1.0 / n);
+      return solve(damping, tolerance, max_iterations);
+   }
+   
+   /**
+    * Computes the personalized PageRank of each node, with the teleport
+    * distribution proportional to the specified weights.
+    *
+    * @param personalization   the teleport weight of each node
+    * @param damping           the damping factor, at least 0 and less than 1
+    * @param tolerance         the change of the ranks, summed over all the
+    *                          nodes, below which the computation stops
+    * @param max_iterations    the maximum number of iterations
+    *
+    * @return the rank of each node
+    *
+    * @throws std::invalid_argument if the damping factor is out of range, or
+    * if the weights do not match the nodes, are negative, or sum to 0
+    */
+   inline std::vector<double> PageRank::run(
+      const std::vector<double>& personalization, const double& damping,
+      const double& tolerance, const size_t& max_iterations)
+   {
+      test_damping(damping);
+      
+      // Tests if the weights form a distribution over the nodes.
+      if (personalization.size() != graph_ -> size())
+      {
+         throw std::invalid_argument("Invalid personalization vector size: "
+            + boost::lexical_cast<std::string>(personalization.size()));
+      }
+      
+      double sum = 0;
+      
+      for (const auto& weight : personalization)
+      {
+         if (!(weight >= 0))
+         {
+            throw std::invalid_argument("Invalid personalization weight: "
+               + boost::lexical_cast<std::string>(weight));
+         }
+         
+         sum += weight;
+      }
+      
+      if (!personalization.empty() && sum == 0)
+         throw std::invalid_argument("Personalization weights sum to 0");
+      
+      teleport_.resize(personalization.size());
+      for (size_t i = 0; i < teleport_.size(); i++)
+         teleport_[i] = personalization[i] / sum;
+      
+      return solve(damping, tolerance, max_iterations);
+   }
+   
+   /**
+    * Returns the number of iterations done by the last computation.
+    *
+    * @return the number of iterations
+    */
+   inline size_t PageRank::iterations() const
+   {
+      return iterations_;
+   }
+   
+   /**
+    * Returns the number of threads that rank the directed graph.
+    *
+    * @return the number of threads
+    */
+   inline size_t PageRank::threads() const
+   {
+      return threads_;
+   }
+   
+   /**
+    * Gathers the change of the ranks and the rank of the nodes without tail
+    * nodes from all of the threads, and decides whether to stop. Only thread
+    * 0 calls this function, while the other threads wait at the barrier.
+    */
+   inline void PageRank::advance()
+   {
+      double change = 0;
+      double dangling = 0;
+      
+      for (size_t i = 0; i < threads_; i++)
+      {
+         change += change_[i];
+         dangling += dangling_[i];
+      }
+      
+      current_ ^= 1;
+      iterations_++;
+      base_ = 1 - damping_ + damping_ * dangling;
+      done_ = change < tolerance_ || iterations_ >= max_iterations_;
+   }
+   
+   /**
+    * Runs the iterations from the teleport distribution, which must already
+    * be set.
+    *
+    * @param damping          the damping factor
+    * @param tolerance        the change of the ranks below which to stop
+    * @param max_iterations   the maximum number of iterations
+    *
+    * @return the rank of each node
+    */
+   inline std::vector<double> PageRank::solve(const double& damping,
+      const double& tolerance, const size_t& max_iterations)
+   {
+      const size_t n = graph_ -> size();
+      damping_ = damping;
+      tolerance_ = tolerance;
+      max_iterations_ = max_iterations;
+      iterations_ = 0;
+      current_ = 0;
+      done_ = n == 0 || max_iterations == 0;
+      
+      // Starts from the teleport distribution.
+      rank_[0] = teleport_;
+      rank_[1].assign(n, 0);
+      contribution_[0].assign(n, 0);
+      contribution_[1].assign(n, 0);
+      double dangling = 0;
+      
+      for (size_t i = 0; i < n; i++)
+      {
+         contribution_[0][i] = rank_[0][i] * inverse_[i];
+         dangling += rank_[0][i] * sinks_[i];
+      }
+      
+      base_ = 1 - damping_ + damping_ * dangling;
+      
+      if (!done_)
+      {
+         // The calling thread takes part in the computation as thread 0.
+         Barrier barrier(threads_);
+         std::vector<std::thread> workers;
+         
+         for (size_t i = 1; i < threads_; i++)
+            workers.push_back(std::thread(&PageRank::work, this, i,
+               std::ref(barrier)));
+         
+         work(0, barrier);
+         for (auto& worker : workers) worker.join();
+      }
+      
+      contribution_[0].clear();
+      contribution_[1].clear();
+      return std::move(rank_[current_]);
+   }
+   
+   /**
+    * Computes the next rank and contribution of each node in the partition of
+    * the specified thread. The sums of the contributions are gathered first,
+    * into the next ranks. The rest is computed in blocks of four lanes, each
+    * of which keeps its own share of the change and of the rank of the nodes
+    * without tail nodes, so that the additions are not reordered; every load
+    * of a block comes before its stores, and the compiler vectorizes the
+    * block without having to test whether the arrays overlap.
+    *
+    * @param id   the position of the thread
+    */
+   inline void PageRank::step(const size_t& id)
+   {
+      const size_t lanes = 4;
+      const size_t first = partitions_[id];
+      const size_t last = partitions_[id + 1];
+      const double base = base_;
+      const double damping = damping_;
+      const double* teleport = teleport_.data();
+      const double* inverse = inverse_.data();
+      const double* sinks = sinks_.data();
+      const double* rank = rank_[current_].data();
+      double* next = rank_[current_ ^ 1].data();
+      double* contribution = contribution_[current_ ^ 1].data();
+      double change[lanes] = { 0, 0, 0, 0 };
+      double dangling[lanes] = { 0, 0, 0, 0 };
+      
+      for (size_t i = first; i < last; i++) next[i] = pull(i);
+      
+      size_t i = first;
+      
+      for (; last - i >= lanes; i += lanes)
+      {
+         double value[lanes];
+         double share[lanes];
+         
+         for (size_t j = 0; j < lanes; j++)
+         {
+            value[j] = base * teleport[i + j] + damping * next[i + j];
+            share[j] = value[j] * inverse[i + j];
+            change[j] += std::fabs(value[j] - rank[i + j]);
+            dangling[j] += value[j] * sinks[i + j];
+         }
+         
+         for (size_t j = 0; j < lanes; j++)
+         {
+            next[i + j] = value[j];
+            contribution[i + j] = share[j];
+         }
+      }
+      
+      for (; i < last; i++)
+      {
+         const double value = base * teleport[i] + damping * next[i];
+         next[i] = value;
+         contribution[i] = value * inverse[i];
+         change[0] += std::fabs(value - rank[i]);
+         dangling[0] += value * sinks[i];
+      }
+      
+      change_[id] = (change[0] + change[1]) + (change[2] + change[3]);
+      dangling_[id] = (dangling[0] + dangling[1]) + (dangling[2] + dangling[3]);
+   }
+   
+   /**
+    * Runs iterations until the ranks converge. The barrier orders the writes
+    * of each iteration before the reads of the next one.
+    *
+    * @param id        the position of the thread
+    * @param barrier   the barrier at which the threads meet
+    */
+   inline void PageRank::work(const size_t& id, Barrier& barrier)
+   {
+      while (true)
+      {
+         step(id);
+         
+         barrier.wait();
+         if (id == 0) advance();
+         barrier.wait();
+         
+         if (done_) return;
+      }
+   }
+   
+   /**
+    * Returns the sum of the contributions of the head nodes of the node at
+    * position <i>k</i> in the current iteration. The gather is scalar, since
+    * a vector gather of scattered contributions is slower than four loads,
+    * but the sum is split over four accumulators, so that consecutive
+    * additions do not wait on each other.
+    *
+    * @param k   the position of the node
+    *
+    * @return the sum of the contributions
+    */
+   inline double PageRank::pull(const size_t& k) const
+   {
+      const double* contribution = contribution_[current_].data();
+      const Adjacency::Range heads = graph_ -> prev(k);
+      const size_t* head = heads.begin();
+      const size_t* last = heads.end();
+      double sum[4] = {0, 0, 0, 0};
+      
+      for (; last - head >= 4; head += 4)
+      {
+         sum[0] += contribution[head[0]];
+         sum[1] += contribution[head[1]];
+         sum[2] += contribution[head[2]];
+         sum[3] += contribution[head[3]];
+      }
+      
+      for (; head != last; head++) sum[0] += contribution[*head];
+      
+      return (sum[0] + sum[1]) + (sum[2] + sum[3]);
+   }
+   
+   /**
+    * Tests if the specified damping factor is at least 0 and less than 1.
+    *
+    * @param damping   the damping factor
+    *
+    * @throws std::invalid_argument if the damping factor is out of range
+    */
+   inline void PageRank::test_damping(const double& damping)
+   {
+      if (!(damping >= 0 && damping < 1))
+      {
+         throw std::invalid_argument("Invalid damping factor: "
+            + boost::lexical_cast<std::string>(damping));
+      }
+   }
+}
+
+#endif   // PIC_10C_PAGE_RANK_H_
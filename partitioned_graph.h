@@ -0,0 +1,1217 @@
+/**
+ * Declarations and definitions of the <code>HashPartitioner</code>,
+ * <code>RangePartitioner</code>, <code>GreedyPartitioner</code>, and
+ * <code>PartitionedGraph</code> classes.
+ *
+ * @file partitioned_graph.h
+ *
+ * @author Kris Torres
+ *
+ * @date 2026-10-14
+ *
+ * @version 1.0
+ */
+
+#ifndef PIC_10C_PARTITIONED_GRAPH_H_
+#define PIC_10C_PARTITIONED_GRAPH_H_
+
+#include <cmath>
+#include <string>
+#include <vector>
+#include <stdexcept>
+#include <algorithm>
+#include <utility>
+#include <functional>
+#include <thread>
+#include <unordered_map>
+#include "boost/lexical_cast.hpp"
+#include "adjacency.h"
+#include "index_error.h"
+#include "message_exchange.h"
+#include "directed_graph.h"
+#include "graph_traversal.h"
+
+namespace Kris_Torres_UCLA_PIC_10C_Winter_2014
+{
+   /**
+    * The <b>hash partitioner</b> assigns each node of a directed graph to a
+    * shard by a hash of its position. The shards get about the same number
+    * of nodes whatever the shape of the directed graph, but about
+    * (<i>k</i> - 1) / <i>k</i> of the directed edges are cut between
+    * <i>k</i> shards.
+    *
+    * @author Kris Torres
+    */
+   class HashPartitioner final
+   {
+   public:
+      
+      // Accessor
+      std::vector<size_t> operator()(const Adjacency& graph,
+         const size_t& shards) const;
+   };
+   
+   /**
+    * The <b>range partitioner</b> assigns contiguous ranges of positions to
+    * the shards, balanced by the number of nodes and adjacent nodes. It cuts
+    * few directed edges when the directed edges mostly join nearby
+    * positions, as they do once the nodes have been reordered (see
+    * <code>DirectedGraph::reorder</code>).
+    *
+    * @author Kris Torres
+    */
+   class RangePartitioner final
+   {
+   public:
+      
+      // Accessor
+      std::vector<size_t> operator()(const Adjacency& graph,
+         const size_t& shards) const;
+   };
+   
+   /**
+    * The <b>greedy partitioner</b> minimizes the directed edges cut between
+    * the shards by <i>linear deterministic greedy</i> streaming (Stanton and
+    * Kliot, 2012): the nodes are taken in order, and each node goes to the
+    * shard that already holds the most of its adjacent nodes, weighed by how
+    * full the shard is. No shard is given more than its share of the nodes
+    * plus the specified slack. The nodes are assigned in
+    * <i>O</i>(<i>V</i> <i>k</i> + <i>E</i>) time for <i>k</i> shards.
+    *
+    * @author Kris Torres
+    */
+   class GreedyPartitioner final
+   {
+   public:
+      
+      // Constructor
+      explicit GreedyPartitioner(const double& slack = 0.1);
+      
+      // Accessor
+      std::vector<size_t> operator()(const Adjacency& graph,
+         const size_t& shards) const;
+      
+   private:
+      
+      /** The fraction by which a shard may exceed its share of the nodes. */
+      double slack_;
+   };
+   
+   /**
+    * A <b>partitioned graph</b> splits a directed graph into shards, each of
+    * them a directed graph of its own, so that the shards could be kept and
+    * searched in separate processes. The nodes are assigned to the shards by
+    * a pluggable partitioner: any function object that takes the adjacency of
+    * the directed graph and the number of shards, and returns the shard of
+    * each node, such as <code>HashPartitioner</code>,
+    * <code>RangePartitioner</code>, or <code>GreedyPartitioner</code>.<p>
+    *
+    * Each shard holds the nodes assigned to it, its <i>owned</i> nodes,
+    * followed by a <i>ghost</i> node for each node of another shard at the
+    * other end of a cut directed edge. A ghost is a copy of its node, and
+    * each cut directed edge is kept in both of its shards, so every directed
+    * edge that enters or leaves an owned node can be followed within its
+    * shard. The owner of each node keeps its <i>mirrors</i>, the positions
+    * of its ghosts in the other shards, to which it sends their updates.<p>
+    *
+    * The searches run one thread per shard, in bulk-synchronous supersteps:
+    * each shard works on its own nodes, then sends batches of updates to the
+    * ghosts, or from the ghosts to their owners, through a
+    * <code>MessageExchange</code>, which compresses each batch. The shards
+    * only share the messages, so the same supersteps would work between
+    * processes.
+    *
+    * @param T   the type of the elements
+    *
+    * @author Kris Torres
+    */
+   template<typename T>
+   class PartitionedGraph final
+   {
+   public:
+      
+      // Constructor
+      template<typename S, typename A, typename Partitioner = HashPartitioner>
+      PartitionedGraph(const DirectedGraph<T, S, A>& graph,
+         const size_t& shards, const Partitioner& partitioner = Partitioner());
+      
+      // Accessors
+      std::vector<size_t> bfs(const size_t& source) const;
+      size_t cut() const;
+      size_t edges() const;
+      size_t ghosts(const size_t& shard) const;
+      size_t global(const size_t& shard, const size_t& k) const;
+      size_t local(const size_t& k) const;
+      size_t owned(const size_t& shard) const;
+      size_t owner(const size_t& k) const;
+      std::vector<double> page_rank(const double& damping = 0.85,
+         const double& tolerance = 1e-9, const size_t& max_iterations = 100)
+         const;
+      const DirectedGraph<T>& shard(const size_t& k) const;
+      size_t shards() const;
+      size_t size() const;
+      std::vector<size_t> strong_components() const;
+      size_t traffic() const;
+      
+   private:
+      
+      /** A shard, with the ghosts of the nodes of the other shards. */
+      struct Part
+      {
+         /** The owned nodes followed by the ghosts. */
+         DirectedGraph<T> graph;
+         
+         /** The number of owned nodes. */
+         size_t owned;
+         
+         /** The position of each node in the whole directed graph. */
+         std::vector<size_t> global;
+         
+         /** The position of the node of each ghost in its own shard. */
+         std::vector<size_t> remote;
+         
+         /** The first mirror of each owned node, and the end of the last. */
+         std::vector<size_t> offsets;
+         
+         /** The shard and the position of the ghost of each mirror. */
+         std::vector<std::pair<size_t, size_t>> mirrors;
+      };
+      
+      // Constant
+      static const size_t none = static_cast<size_t>(-1);
+      
+      // Accessors
+      void rank(const size_t& k, MessageExchange& exchange,
+         const double& damping, const double& tolerance,
+         const size_t& max_iterations, std::vector<double>& result) const;
+      template<typename Task>
+      void run(Task task) const;
+      void search(const size_t& k, MessageExchange& exchange,
+         const size_t& source, std::vector<size_t>& result) const;
+      void split(const size_t& k, MessageExchange& exchange,
+         std::vector<size_t>& result) const;
+      void test_shard(const size_t& k) const;
+      
+      /** The shards. */
+      std::vector<Part> parts_;
+      
+      /** The shard of each node. */
+      std::vector<size_t> owner_;
+      
+      /** The position of each node in its shard. */
+      std::vector<size_t> local_;
+      
+      /** The number of directed edges. */
+      size_t edges_;
+      
+      /** The number of directed edges between different shards. */
+      size_t cut_;
+      
+      /** The number of bytes sent between the shards by the last search. */
+      mutable size_t traffic_;
+   };
+   
+   template<typename T>
+   const size_t PartitionedGraph<T>::none;
+   
+   /**
+    * Returns the shard of each node in the specified adjacency, by a hash of
+    * its position.
+    *
+    * @param graph    the adjacency of the directed graph
+    * @param shards   the number of shards
+    *
+    * @return the shard of each node
+    */
+   inline std::vector<size_t> HashPartitioner::operator()(
+      const Adjacency& graph, const size_t& shards) const
+   {
+      std::vector<size_t> result(graph.size());
+      
+      for (size_t i = 0; i < result.size(); i++)
+      {
+         // Mixes the bits of the position as the SplitMix64 generator does.
+         unsigned long long x = i + 0x9e3779b97f4a7c15ULL;
+         x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+         x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+         result[i] = static_cast<size_t>((x ^ (x >> 31)) % shards);
+      }
+      
+      return result;
+   }
+   
+   /**
+    * Returns the shard of each node in the specified adjacency, by
+    * contiguous ranges of positions.
+    *
+    * @param graph    the adjacency of the directed graph
+    * @param shards   the number of shards
+    *
+    * @return the shard of each node
+    */
+   inline std::vector<size_t> RangePartitioner::operator()(
+      const Adjacency& graph, const size_t& shards) const
+   {
+      // Gives each shard about the same number of nodes and adjacent nodes.
+      const size_t n = graph.size();
+      const size_t total = n + 2 * graph.edges();
+      std::vector<size_t> result(n);
+      size_t shard = 0;
+      size_t work = 0;
+      
+      for (size_t i = 0; i < n; i++)
+      {
+         result[i] = shard;
+         work += 1 + graph.indegree(i) + graph.outdegree(i);
+         if (shard + 1 < shards && work * shards >= total * (shard + 1))
+            shard++;
+      }
+      
+      return result;
+   }
+   
+   /**
+    * Constructs a greedy partitioner that lets a shard exceed its share of
+    * the nodes by the specified fraction.
+    *
+    * @param slack   the fraction, at least 0
+    *
+    * @throws std::invalid_argument if the fraction is negative
+    */
+   inline GreedyPartitioner::GreedyPartitioner(const double& slack)
+      : slack_(slack)
+   {
+      if (!(slack >= 0))
+      {
+         throw std::invalid_argument("Invalid partition slack: "
+            + boost::lexical_cast<std::string>(slack));
+      }
+   }
+   
+   /**
+    * Returns the shard of each node in the specified adjacency, by linear
+    * deterministic greedy streaming.
+    *
+    * @param graph    the adjacency of the directed graph
+    * @param shards   the number of shards
+    *
+    * @return the shard of each node
+    */
+   inline std::vector<size_t> GreedyPartitioner::operator()(
+      const Adjacency& graph, const size_t& shards) const
+   {
+      const size_t n = graph.size();
+      const size_t none = static_cast<size_t>(-1);
+      const double capacity = std::max(1.0,
+         std::ceil(n * (1 + slack_) / shards));
+      
+      std::vector<size_t> result(n, none);
+      std::vector<size_t> sizes(shards, 0);
+      std::vector<size_t> neighbors(shards, 0);
+      
+      for (size_t i = 0; i < n; i++)
+      {
+         // Counts the adjacent nodes already in each shard.
+         for (const auto& element : graph.next(i))
+            if (result[element] != none) neighbors[result[element]]++;
+         
+         for (const auto& element : graph.prev(i))
+            if (result[element] != none) neighbors[result[element]]++;
+         
+         size_t best = none;
+         double score = 0;
+         
+         for (size_t j = 0; j < shards; j++)
+         {
+            if (sizes[j] >= capacity) continue;
+            
+            const double value = neighbors[j] * (1 - sizes[j] / capacity);
+            
+            if (best == none || value > score
+               || (value == score && sizes[j] < sizes[best]))
+            {
+               best = j;
+               score = value;
+            }
+         }
+         
+         result[i] = best;
+         sizes[best]++;
+         std::fill(neighbors.begin(), neighbors.end(), 0);
+      }
+      
+      return result;
+   }
+   
+   /**
+    * Constructs a partitioned graph from the specified directed graph, split
+    * into the specified number of shards by the specified partitioner. The
+    * values of the nodes and the ghosts are copied, and the directed edges
+    * of each owned node keep their order.
+    *
+    * @param S             the storage policy of the directed graph
+    * @param A             the allocator type of the directed graph
+    * @param Partitioner   the type of the partitioner
+    *
+    * @param graph         the directed graph
+    * @param shards        the number of shards, at least 1
+    * @param partitioner   the partitioner
+    *
+    * @throws std::invalid_argument if there is no shard, or if the
+    * partitioner does not assign each node to a shard
+    */
+   template<typename T>
+   template<typename S, typename A, typename Partitioner>
+   PartitionedGraph<T>::PartitionedGraph(const DirectedGraph<T, S, A>& graph,
+      const size_t& shards, const Partitioner& partitioner)
+      : edges_(0), cut_(0), traffic_(0)
+   {
+      if (shards == 0)
+         throw std::invalid_argument("Invalid number of shards: 0");
+      
+      const Adjacency adjacency = graph.adjacency();
+      const size_t n = adjacency.size();
+      owner_ = partitioner(adjacency, shards);
+      
+      // Tests if the partition assigns each node to a shard.
+      if (owner_.size() != n)
+         throw std::invalid_argument("Invalid partition of directed graph");
+      
+      for (const auto& element : owner_)
+      {
+         if (element >= shards)
+            throw std::invalid_argument("Invalid partition of directed graph");
+      }
+      
+      // Numbers the owned nodes of each shard first.
+      parts_.resize(shards);
+      local_.resize(n);
+      
+      for (size_t i = 0; i < n; i++)
+      {
+         Part& part = parts_[owner_[i]];
+         local_[i] = part.global.size();
+         part.global.push_back(i);
+      }
+      
+      for (auto& element : parts_) element.owned = element.global.size();
+      
+      // Adds a ghost to a shard for each node at the other end of a cut edge.
+      std::vector<std::unordered_map<size_t, size_t>> ghosts(shards);
+      std::vector<std::vector<std::pair<size_t, size_t>>> links(shards);
+      
+      auto ghost = [&](const size_t& shard, const size_t& k)
+      {
+         Part& part = parts_[shard];
+         auto result = ghosts[shard].insert(
+            std::make_pair(k, part.global.size()));
+         
+         if (result.second)
+         {
+            part.global.push_back(k);
+            part.remote.push_back(local_[k]);
+         }
+         
+         return result.first -> second;
+      };
+      
+      for (size_t i = 0; i < n; i++)
+      {
+         for (const auto& element : adjacency.next(i))
+         {
+            const size_t from = owner_[i];
+            const size_t to = owner_[element];
+            edges_++;
+            
+            if (from == to)
+            {
+               links[from].push_back(std::make_pair(local_[i],
+                  local_[element]));
+               continue;
+            }
+            
+            cut_++;
+            links[from].push_back(std::make_pair(local_[i],
+               ghost(from, element)));
+            links[to].push_back(std::make_pair(ghost(to, i),
+               local_[element]));
+         }
+      }
+      
+      for (size_t i = 0; i < shards; i++)
+      {
+         Part& part = parts_[i];
+         part.graph.reserve(part.global.size(), links[i].size());
+         for (const auto& element : part.global)
+            part.graph.push_back(graph[element]);
+         part.graph.connect_bulk(links[i].begin(), links[i].end());
+         part.offsets.assign(part.owned + 1, 0);
+      }
+      
+      // Lists the ghosts of each owned node, by counting sort.
+      for (const auto& element : parts_)
+      {
+         for (size_t i = element.owned; i < element.global.size(); i++)
+         {
+            const size_t k = element.global[i];
+            parts_[owner_[k]].offsets[local_[k] + 1]++;
+         }
+      }
+      
+      for (auto& element : parts_)
+      {
+         for (size_t i = 0; i < element.owned; i++)
+            element.offsets[i + 1] += element.offsets[i];
+         element.mirrors.resize(element.offsets.back());
+      }
+      
+      std::vector<std::vector<size_t>> next(shards);
+      for (size_t i = 0; i < shards; i++) next[i] = parts_[i].offsets;
+      
+      for (size_t i = 0; i < shards; i++)
+      {
+         const Part& part = parts_[i];
+         
+         for (size_t j = part.owned; j < part.global.size(); j++)
+         {
+            const size_t k = part.global[j];
+            const size_t shard = owner_[k];
+            parts_[shard].mirrors[next[shard][local_[k]]++] =
+               std::make_pair(i, j);
+         }
+      }
+   }
+   
+   /**
+    * Returns the depth of every node reachable from the node at position
+    * <i>source</i>, found by a level-synchronous breadth-first search across
+    * the shards. Each superstep expands one level: each shard expands the
+    * frontier within its owned nodes, and sends each ghost that it reaches,
+    * at most once per search, to the owner of the ghost.
+    *
+    * @param source   the position of the source node
+    *
+    * @return the depth of each node, or <code>unreachable</code>
+    *
+    * @throws std::out_of_range if <i>source</i> is at least the number of nodes
+    */
+   template<typename T>
+   std::vector<size_t> PartitionedGraph<T>::bfs(const size_t& source) const
+   {
+      // Tests if source is valid.
+      if (source >= size())
+         throw_index_error("Invalid source node index in directed graph: ",
+            source);
+      
+      std::vector<size_t> result(size(), unreachable);
+      
+      run([&](const size_t& k, MessageExchange& exchange)
+         {
+            search(k, exchange, source, result);
+         });
+      
+      return result;
+   }
+   
+   /**
+    * Returns the number of directed edges between nodes in different shards.
+    *
+    * @return the number of cut directed edges
+    */
+   template<typename T>
+   inline size_t PartitionedGraph<T>::cut() const
+   {
+      return cut_;
+   }
+   
+   /**
+    * Returns the number of directed edges in this partitioned graph.
+    *
+    * @return the number of directed edges
+    */
+   template<typename T>
+   inline size_t PartitionedGraph<T>::edges() const
+   {
+      return edges_;
+   }
+   
+   /**
+    * Returns the number of ghosts in the specified shard.
+    *
+    * @param shard   the shard
+    *
+    * @return the number of ghosts
+    *
+    * @throws std::out_of_range if the shard is out of bounds
+    */
+   template<typename T>
+   inline size_t PartitionedGraph<T>::ghosts(const size_t& shard) const
+   {
+      test_shard(shard);
+      return parts_[shard].global.size() - parts_[shard].owned;
+   }
+   
+   /**
+    * Returns the position in the whole directed graph of the node at the
+    * specified position in the specified shard, which is either an owned
+    * node or a ghost.
+    *
+    * @param shard   the shard
+    * @param k       the position of the node in the shard
+    *
+    * @return the position of the node in the whole directed graph
+    *
+    * @throws std::out_of_range if the shard or <i>k</i> is out of bounds
+    */
+   template<typename T>
+   inline size_t PartitionedGraph<T>::global(const size_t& shard,
+      const size_t& k) const
+   {
+      test_shard(shard);
+      
+      // Tests if k is valid.
+      if (k >= parts_[shard].global.size())
+         throw_index_error("Invalid node index in directed graph: ", k);
+      
+      return parts_[shard].global[k];
+   }
+   
+   /**
+    * Returns the position of the node at position <i>k</i> in its shard.
+    *
+    * @param k   the position of the node
+    *
+    * @return the position of the node in its shard
+    *
+    * @throws std::out_of_range if <i>k</i> is out of bounds
+    */
+   template<typename T>
+   inline size_t PartitionedGraph<T>::local(const size_t& k) const
+   {
+      // Tests if k is valid.
+      if (k >= size())
+         throw_index_error("Invalid node index in directed graph: ", k);
+      
+      return local_[k];
+   }
+   
+   /**
+    * Returns the number of owned nodes in the specified shard.
+    *
+    * @param shard   the shard
+    *
+    * @return the number of owned nodes
+    *
+    * @throws std::out_of_range if the shard is out of bounds
+    */
+   template<typename T>
+   inline size_t PartitionedGraph<T>::owned(const size_t& shard) const
+   {
+      test_shard(shard);
+      return parts_[shard].owned;
+   }
+   
+   /**
+    * Returns the shard of the node at position <i>k</i>.
+    *
+    * @param k   the position of the node
+    *
+    * @return the shard of the node
+    *
+    * @throws std::out_of_range if <i>k</i> is out of bounds
+    */
+   template<typename T>
+   inline size_t PartitionedGraph<T>::owner(const size_t& k) const
+   {
+      // Tests if k is valid.
+      if (k >= size())
+         throw_index_error("Invalid node index in directed graph: ", k);
+      
+      return owner_[k];
+   }
+   
+   /**
+    * Returns the PageRank of each node, with a uniform teleport
+    * distribution, computed across the shards as by <code>page_rank</code>.
+    * Each superstep is one iteration: each owner sends the contribution of
+    * each of its nodes to the mirrors of the node, and each shard then pulls
+    * the ranks of its owned nodes from their head nodes, owned or ghosts.
+    * The batches carry only the changed positions and their values, and the
+    * rank of the nodes without tail nodes and the change of the ranks are
+    * summed as the shards synchronize.
+    *
+    * @param damping          the damping factor, at least 0 and less than 1
+    * @param tolerance        the change of the ranks, summed over all the
+    *                         nodes, below which the computation stops
+    * @param max_iterations   the maximum number of iterations
+    *
+    * @return the rank of each node
+    *
+    * @throws std::invalid_argument if the damping factor is out of range
+    */
+   template<typename T>
+   std::vector<double> PartitionedGraph<T>::page_rank(const double& damping,
+      const double& tolerance, const size_t& max_iterations) const
+   {
+      // Tests if the damping factor is valid.
+      if (!(damping >= 0 && damping < 1))
+      {
+         throw std::invalid_argument("Invalid damping factor: "
+            + boost::lexical_cast<std::string>(damping));
+      }
+      
+      std::vector<double> result(size(), 0);
+      if (size() == 0) return result;
+      
+      run([&](const size_t& k, MessageExchange& exchange)
+         {
+            rank(k, exchange, damping, tolerance, max_iterations, result);
+         });
+      
+      return result;
+   }
+   
+   /**
+    * Returns the specified shard: its owned nodes, followed by its ghosts.
+    *
+    * @param k   the shard
+    *
+    * @return the directed graph of the shard
+    *
+    * @throws std::out_of_range if the shard is out of bounds
+    */
+   template<typename T>
+   inline const DirectedGraph<T>& PartitionedGraph<T>::shard(const size_t& k)
+      const
+   {
+      test_shard(k);
+      return parts_[k].graph;
+   }
+   
+   /**
+    * Returns the number of shards.
+    *
+    * @return the number of shards
+    */
+   template<typename T>
+   inline size_t PartitionedGraph<T>::shards() const
+   {
+      return parts_.size();
+   }
+   
+   /**
+    * Returns the number of nodes in this partitioned graph.
+    *
+    * @return the number of nodes
+    */
+   template<typename T>
+   inline size_t PartitionedGraph<T>::size() const
+   {
+      return owner_.size();
+   }
+   
+   /**
+    * Returns the strongly connected component of each node, found across
+    * the shards by trimming and coloring. Each round first trims, one
+    * superstep after another, the nodes with no head nodes or no tail nodes
+    * left, each a component by itself. It then colors each node with the
+    * largest position that reaches it, by propagating the colors along the
+    * directed edges, and searches backward from each node whose color is its
+    * own position through the nodes of its color, which form its component.
+    * Each shard propagates within its owned nodes until nothing changes
+    * before it sends anything, so a superstep covers a whole shard instead
+    * of one directed edge. Like <code>parallel_strong_components</code>, the
+    * components are numbered in no particular order.
+    *
+    * @return the component of each node, from 0 up to the number of
+    * components
+    */
+   template<typename T>
+   std::vector<size_t> PartitionedGraph<T>::strong_components() const
+   {
+      std::vector<size_t> result(size(), none);
+      if (size() == 0) return result;
+      
+      run([&](const size_t& k, MessageExchange& exchange)
+         {
+            split(k, exchange, result);
+         });
+      
+      // Numbers the components by their first node.
+      std::vector<size_t> number(size(), none);
+      size_t count = 0;
+      
+      for (auto& element : result)
+      {
+         if (number[element] == none) number[element] = count++;
+         element = number[element];
+      }
+      
+      return result;
+   }
+   
+   /**
+    * Returns the number of bytes that the shards sent to each other during
+    * the last search. The function must not be called while a search is
+    * running.
+    *
+    * @return the number of bytes
+    */
+   template<typename T>
+   inline size_t PartitionedGraph<T>::traffic() const
+   {
+      return traffic_;
+   }
+   
+   /**
+    * Computes the PageRank of the owned nodes of the specified shard.
+    *
+    * @param k                the shard
+    * @param exchange         the message exchange between the shards
+    * @param damping          the damping factor
+    * @param tolerance        the change of the ranks below which to stop
+    * @param max_iterations   the maximum number of iterations
+    * @param result           the rank of each node
+    */
+   template<typename T>
+   void PartitionedGraph<T>::rank(const size_t& k, MessageExchange& exchange,
+      const double& damping, const double& tolerance,
+      const size_t& max_iterations, std::vector<double>& result) const
+   {
+      const Part& part = parts_[k];
+      const Adjacency graph = part.graph.adjacency();
+      const size_t n = size();
+      
+      std::vector<double> rank(part.owned, 1.0 / n);
+      std::vector<double> next(part.owned);
+      std::vector<double> contribution(graph.size(), 0);
+      std::vector<std::vector<std::pair<size_t, double>>> out(shards());
+      std::vector<std::pair<size_t, double>> in;
+      
+      for (size_t iteration = 0; iteration < max_iterations; iteration++)
+      {
+         double dangling = 0;
+         
+         for (size_t i = 0; i < part.owned; i++)
+         {
+            const size_t degree = graph.outdegree(i);
+            if (degree == 0) dangling += rank[i];
+            contribution[i] = degree == 0 ? 0 : rank[i] / degree;
+            
+            for (size_t j = part.offsets[i]; j < part.offsets[i + 1]; j++)
+            {
+               const auto& mirror = part.mirrors[j];
+               out[mirror.first].push_back(std::make_pair(mirror.second,
+                  contribution[i]));
+            }
+         }
+         
+         for (size_t i = 0; i < shards(); i++) exchange.send(k, i, out[i]);
+         dangling = exchange.synchronize(k, dangling);
+         
+         exchange.receive(k, in);
+         for (const auto& element : in)
+            contribution[element.first] = element.second;
+         
+         // Pulls the rank of each owned node from its head nodes.
+         const double base = (1 - damping + damping * dangling) / n;
+         double change = 0;
+         
+         for (size_t i = 0; i < part.owned; i++)
+         {
+            double sum = 0;
+            for (const auto& element : graph.prev(i))
+               sum += contribution[element];
+            
+            next[i] = base + damping * sum;
+            change += std::fabs(next[i] - rank[i]);
+         }
+         
+         rank.swap(next);
+         if (exchange.synchronize(k, change) < tolerance) break;
+      }
+      
+      for (size_t i = 0; i < part.owned; i++) result[part.global[i]] = rank[i];
+   }
+   
+   /**
+    * Runs the specified task on every shard, one thread per shard, with a
+    * message exchange between them, and records the bytes that they sent.
+    *
+    * @param Task   the type of the task, called with the shard and the
+    *               message exchange
+    *
+    * @param task   the task
+    */
+   template<typename T>
+   template<typename Task>
+   void PartitionedGraph<T>::run(Task task) const
+   {
+      MessageExchange exchange(shards());
+      
+      // The calling thread works on shard 0.
+      std::vector<std::thread> workers;
+      
+      for (size_t i = 1; i < shards(); i++)
+         workers.push_back(std::thread(task, i, std::ref(exchange)));
+      
+      task(0, exchange);
+      for (auto& worker : workers) worker.join();
+      
+      traffic_ = exchange.bytes();
+   }
+   
+   /**
+    * Finds the depth of the owned nodes of the specified shard that are
+    * reachable from the source node.
+    *
+    * @param k          the shard
+    * @param exchange   the message exchange between the shards
+    * @param source     the position of the source node
+    * @param result     the depth of each node
+    */
+   template<typename T>
+   void PartitionedGraph<T>::search(const size_t& k,
+      MessageExchange& exchange, const size_t& source,
+      std::vector<size_t>& result) const
+   {
+      const Part& part = parts_[k];
+      const Adjacency graph = part.graph.adjacency();
+      
+      std::vector<size_t> depth(part.owned, unreachable);
+      std::vector<unsigned char> sent(graph.size() - part.owned, 0);
+      std::vector<size_t> frontier;
+      std::vector<size_t> next;
+      std::vector<std::vector<size_t>> out(shards());
+      std::vector<size_t> in;
+      
+      if (owner_[source] == k)
+      {
+         depth[local_[source]] = 0;
+         frontier.push_back(local_[source]);
+      }
+      
+      for (size_t level = 1; ; level++)
+      {
+         size_t count = 0;
+         
+         for (const auto& element : frontier)
+         {
+            for (const auto& tail : graph.next(element))
+            {
+               if (tail < part.owned)
+               {
+                  if (depth[tail] != unreachable) continue;
+                  depth[tail] = level;
+                  next.push_back(tail);
+               }
+               
+               // Sends each ghost to its owner the first time it is reached.
+               else if (!sent[tail - part.owned])
+               {
+                  sent[tail - part.owned] = 1;
+                  out[owner_[part.global[tail]]].push_back(
+                     part.remote[tail - part.owned]);
+                  count++;
+               }
+            }
+         }
+         
+         count += next.size();
+         for (size_t i = 0; i < shards(); i++) exchange.send(k, i, out[i]);
+         const double total = exchange.synchronize(k, count);
+         
+         exchange.receive(k, in);
+         
+         for (const auto& element : in)
+         {
+            if (depth[element] != unreachable) continue;
+            depth[element] = level;
+            next.push_back(element);
+         }
+         
+         frontier.swap(next);
+         next.clear();
+         if (total == 0) break;
+      }
+      
+      for (size_t i = 0; i < part.owned; i++) result[part.global[i]] = depth[i];
+   }
+   
+   /**
+    * Finds the strongly connected component of the owned nodes of the
+    * specified shard, each labeled by the position of one of its nodes.
+    *
+    * @param k          the shard
+    * @param exchange   the message exchange between the shards
+    * @param result     the label of the component of each node
+    */
+   template<typename T>
+   void PartitionedGraph<T>::split(const size_t& k, MessageExchange& exchange,
+      std::vector<size_t>& result) const
+   {
+      const Part& part = parts_[k];
+      const Adjacency graph = part.graph.adjacency();
+      const size_t owned = part.owned;
+      const size_t ghosts = graph.size() - owned;
+      
+      std::vector<size_t> label(owned, none);
+      std::vector<unsigned char> done(ghosts, 0);
+      std::vector<size_t> in(owned);
+      std::vector<size_t> out(owned);
+      std::vector<size_t> color(owned);
+      std::vector<size_t> sent(ghosts);
+      std::vector<unsigned char> marks(owned);
+      std::vector<unsigned char> queued(ghosts, 0);
+      std::vector<size_t> work;
+      std::vector<size_t> pending;
+      std::vector<std::vector<size_t>> positions(shards());
+      std::vector<std::vector<std::pair<size_t, size_t>>> messages(shards());
+      std::vector<size_t> received;
+      std::vector<std::pair<size_t, size_t>> incoming;
+      size_t remaining = owned;
+      
+      auto alive = [&](const size_t& u)
+      {
+         return u < owned ? label[u] == none : done[u - owned] == 0;
+      };
+      
+      auto owner = [&](const size_t& g)
+      {
+         return owner_[part.global[g]];
+      };
+      
+      // Labels an owned node, and tells its mirrors that it is done.
+      auto assign = [&](const size_t& u, const size_t& value)
+      {
+         label[u] = value;
+         remaining--;
+         
+         for (size_t i = part.offsets[u]; i < part.offsets[u + 1]; i++)
+         {
+            const auto& mirror = part.mirrors[i];
+            positions[mirror.first].push_back(mirror.second);
+         }
+      };
+      
+      // Ends a superstep, and returns the number of messages sent by all.
+      auto exchange_positions = [&](size_t count)
+      {
+         for (size_t i = 0; i < shards(); i++)
+         {
+            count += positions[i].size();
+            exchange.send(k, i, positions[i]);
+         }
+         
+         const double total = exchange.synchronize(k, count);
+         exchange.receive(k, received);
+         return total;
+      };
+      
+      auto exchange_messages = [&](size_t count)
+      {
+         for (size_t i = 0; i < shards(); i++)
+         {
+            count += messages[i].size();
+            exchange.send(k, i, messages[i]);
+         }
+         
+         const double total = exchange.synchronize(k, count);
+         exchange.receive(k, incoming);
+         return total;
+      };
+      
+      auto decrement = [&](std::vector<size_t>& degree, const size_t& v)
+      {
+         if (label[v] == none && degree[v] > 0 && --degree[v] == 0)
+            work.push_back(v);
+      };
+      
+      while (exchange.synchronize(k, static_cast<double>(remaining)) > 0)
+      {
+         // Trims the nodes without head nodes or tail nodes left.
+         for (size_t v = 0; v < owned; v++)
+         {
+            if (label[v] != none) continue;
+            
+            in[v] = out[v] = 0;
+            for (const auto& u : graph.prev(v))
+               if (u != v && alive(u)) in[v]++;
+            
+            for (const auto& u : graph.next(v))
+               if (u != v && alive(u)) out[v]++;
+            
+            if (in[v] == 0 || out[v] == 0) work.push_back(v);
+         }
+         
+         while (true)
+         {
+            while (!work.empty())
+            {
+               const size_t u = work.back();
+               work.pop_back();
+               if (label[u] != none) continue;
+               
+               assign(u, part.global[u]);
+               
+               for (const auto& v : graph.next(u))
+                  if (v != u && v < owned) decrement(in, v);
+               
+               for (const auto& v : graph.prev(u))
+                  if (v != u && v < owned) decrement(out, v);
+            }
+            
+            const double total = exchange_positions(0);
+            
+            for (const auto& g : received)
+            {
+               done[g - owned] = 1;
+               for (const auto& v : graph.next(g)) decrement(in, v);
+               for (const auto& v : graph.prev(g)) decrement(out, v);
+            }
+            
+            if (total == 0) break;
+         }
+         
+         if (exchange.synchronize(k, static_cast<double>(remaining)) == 0)
+            break;
+         
+         // Colors each node with the largest position that reaches it.
+         std::fill(sent.begin(), sent.end(), 0);
+         
+         for (size_t v = 0; v < owned; v++)
+         {
+            marks[v] = label[v] == none;
+            color[v] = part.global[v];
+            if (marks[v]) work.push_back(v);
+         }
+         
+         while (true)
+         {
+            while (!work.empty())
+            {
+               const size_t u = work.back();
+               work.pop_back();
+               marks[u] = 0;
+               
+               for (const auto& v : graph.next(u))
+               {
+                  if (v >= owned)
+                  {
+                     const size_t g = v - owned;
+                     if (done[g] || color[u] <= sent[g]) continue;
+                     if (!queued[g]) pending.push_back(g);
+                     queued[g] = 1;
+                     sent[g] = color[u];
+                  }
+                  
+                  else if (label[v] == none && color[u] > color[v])
+                  {
+                     color[v] = color[u];
+                     if (!marks[v]) work.push_back(v);
+                     marks[v] = 1;
+                  }
+               }
+            }
+            
+            // Sends the largest color that reached each ghost to its owner.
+            for (const auto& g : pending)
+            {
+               messages[owner(g + owned)].push_back(
+                  std::make_pair(part.remote[g], sent[g]));
+               queued[g] = 0;
+            }
+            
+            pending.clear();
+            const double total = exchange_messages(0);
+            
+            for (const auto& element : incoming)
+            {
+               const size_t v = element.first;
+               if (label[v] != none || element.second <= color[v]) continue;
+               
+               color[v] = element.second;
+               if (!marks[v]) work.push_back(v);
+               marks[v] = 1;
+            }
+            
+            if (total == 0) break;
+         }
+         
+         // Searches backward from each node colored with its own position.
+         std::fill(sent.begin(), sent.end(), none);
+         
+         for (size_t v = 0; v < owned; v++)
+         {
+            marks[v] = label[v] == none && color[v] == part.global[v];
+            if (marks[v]) work.push_back(v);
+         }
+         
+         while (true)
+         {
+            while (!work.empty())
+            {
+               const size_t v = work.back();
+               work.pop_back();
+               
+               for (const auto& u : graph.prev(v))
+               {
+                  if (u >= owned)
+                  {
+                     const size_t g = u - owned;
+                     if (done[g] || sent[g] == color[v]) continue;
+                     sent[g] = color[v];
+                     messages[owner(u)].push_back(
+                        std::make_pair(part.remote[g], color[v]));
+                  }
+                  
+                  else if (label[u] == none && !marks[u]
+                     && color[u] == color[v])
+                  {
+                     marks[u] = 1;
+                     work.push_back(u);
+                  }
+               }
+            }
+            
+            const double total = exchange_messages(0);
+            
+            for (const auto& element : incoming)
+            {
+               const size_t u = element.first;
+               if (label[u] != none || marks[u] || color[u] != element.second)
+                  continue;
+               
+               marks[u] = 1;
+               work.push_back(u);
+            }
+            
+            if (total == 0) break;
+         }
+         
+         // Labels the components that were found, and tells the mirrors.
+         for (size_t v = 0; v < owned; v++)
+            if (marks[v]) assign(v, color[v]);
+         
+         exchange_positions(0);
+         for (const auto& g : received) done[g - owned] = 1;
+      }
+      
+      for (size_t i = 0; i < owned; i++) result[part.global[i]] = label[i];
+   }
+   
+   /**
+    * Tests if the specified shard is valid.
+    *
+    * @param k   the shard
+    *
+    * @throws std::out_of_range if the shard is out of bounds
+    */
+   template<typename T>
+   inline void PartitionedGraph<T>::test_shard(const size_t& k) const
+   {
+      if (k >= shards()) throw_index_error("Invalid shard index: ", k);
+   }
+}
+
+#endif   // PIC_10C_PARTITIONED_GRAPH_H_
@@ -0,0 +1,1336 @@
+/**
+ * Declarations and definitions of the <code>DirectedGraph</code> class for the
+ * <code>SharedStorage</code> storage policy, and <code>operator<<</code> for
+ * that class.
+ *
+ * @file shared_directed_graph.h
+ *
+ * @author Kris Torres
+ *
+ * @date 2026-10-14
+ *
+ * @version 1.0
+ */
+
+#ifndef PIC_10C_SHARED_DIRECTED_GRAPH_H_
+#define PIC_10C_SHARED_DIRECTED_GRAPH_H_
+
+#include <string>
+#include <vector>
+#include <stdexcept>
+#include <algorithm>
+#include <memory>
+#include <atomic>
+#include <initializer_list>
+#include <utility>
+#include <ostream>
+#include "adjacency.h"
+#include "directed_graph.h"
+
+namespace Kris_Torres_UCLA_PIC_10C_Winter_2014
+{
+   /**
+    * A directed graph whose copies share their memory until they are
+    * modified. Each node, with its value and the positions of its adjacent
+    * nodes, is kept in its own reference-counted block; the blocks are grouped
+    * into chunks of <code>chunk_size</code> nodes, and the chunks are listed in
+    * a reference-counted table. Copying a directed graph, or taking a
+    * <code>snapshot</code> of it, shares the table, so it takes constant time
+    * and allocates nothing.<p>
+    *
+    * Modifying a directed graph first copies whichever of the table, the
+    * chunk, and the node that it touches are shared with another copy, so the
+    * other copies never see the change. After a snapshot, the first
+    * modification copies the table of chunks, the first modification of each
+    * chunk copies its <code>chunk_size</code> pointers, and the first
+    * modification of each node copies that node. A block is only written to
+    * once no other copy refers to it, so a snapshot can be read by another
+    * thread while this directed graph is being modified.
+    *
+    * @param T   the type of the elements
+    * @param A   the allocator type
+    *
+    * @author Kris Torres
+    */
+   template<typename T, typename A>
+   class DirectedGraph<T, SharedStorage, A>
+   {
+   public:
+      
+      // Type
+      typedef A allocator_type;
+      
+      // Constant
+      static const size_t chunk_size = 64;
+      
+      // Constructors
+      DirectedGraph();
+      explicit DirectedGraph(const A& alloc);
+      explicit DirectedGraph(const size_t& n, const A& alloc = A());
+      DirectedGraph(const size_t& n, const T& val, const A& alloc = A());
+      DirectedGraph(const std::vector<T>& v, const A& alloc = A());
+      DirectedGraph(std::vector<T>&& v, const A& alloc = A());
+      DirectedGraph(const std::initializer_list<T> il, const A& alloc = A());
+      DirectedGraph(const DirectedGraph& rhs);
+      DirectedGraph(const DirectedGraph& rhs, const A& alloc);
+      DirectedGraph(DirectedGraph&& rhs) noexcept;
+      
+      // Assignment operators
+      DirectedGraph& operator=(const DirectedGraph& rhs);
+      DirectedGraph& operator=(DirectedGraph&& rhs) noexcept;
+      
+      // Destructor
+      virtual ~DirectedGraph();
+      
+      // Mutators
+      T& at(const size_t& k);
+      void clear();
+      void connect(const size_t& from, const size_t& to);
+      void disconnect(const size_t& k);
+      void disconnect(const size_t& from, const size_t& to);
+      template<typename... Args>
+      void emplace_back(Args&&... args);
+      void erase(const size_t& k);
+      T& front();
+      T& operator[](const size_t& k);
+      void push_back(const T& val);
+      void push_back(T&& val);
+      void reserve(const size_t& nodes);
+      void swap(DirectedGraph& rhs) noexcept;
+      
+      // Accessors
+      Adjacency adjacency() const;
+      T at(const size_t& k) const;
+      size_t edge_count(const size_t& from, const size_t& to) const;
+      bool empty() const;
+      T front() const;
+      A get_allocator() const;
+      bool has_edge(const size_t& from, const size_t& to) const;
+      size_t indegree(const size_t& k) const;
+      T operator[](const size_t& k) const;
+      size_t outdegree(const size_t& k) const;
+      bool simple() const;
+      size_t size() const;
+      DirectedGraph snapshot() const;
+      
+      // Relational operators
+      bool operator==(const DirectedGraph& rhs) const;
+      bool operator!=(const DirectedGraph& rhs) const;
+      
+      // Friend
+      template<typename U, typename V>
+      friend std::ostream& operator<<(std::ostream& out,
+         const DirectedGraph<U, SharedStorage, V>& rhs);
+      
+   private:
+      
+      // Classes
+      class Chunk;
+      class Node;
+      class Table;
+      
+      // Types
+      template<typename U>
+      using Allocator =
+         typename std::allocator_traits<A>::template rebind_alloc<U>;
+      typedef std::vector<size_t, Allocator<size_t>> Indices;
+      typedef std::vector<std::shared_ptr<Node>,
+         Allocator<std::shared_ptr<Node>>> Nodes;
+      typedef std::vector<std::shared_ptr<Chunk>,
+         Allocator<std::shared_ptr<Chunk>>> Chunks;
+      
+      // Mutators
+      Node& mutable_node(const size_t& k);
+      std::shared_ptr<Node>& mutable_slot(const size_t& k);
+      Table& mutable_table();
+      template<typename U>
+      void unshare(std::shared_ptr<U>& pointer);
+      
+      // Accessors
+      const Node& node(const size_t& k) const;
+      const std::shared_ptr<Node>& slot(const size_t& k) const;
+      void test_index(const size_t& k, const char* error) const;
+      template<typename U>
+      static bool unique(const std::shared_ptr<U>& pointer);
+      
+      /**
+       * The table of chunks of this directed graph, which may be shared with
+       * other copies, or <code>nullptr</code> if none has been allocated.
+       */
+      std::shared_ptr<Table> root_;
+   };
+   
+   /**
+    * A <b>chunk</b> of a shared directed graph holds the pointers to up to
+    * <code>chunk_size</code> consecutive nodes. A chunk is never modified while
+    * it is shared.
+    */
+   template<typename T, typename A>
+   class DirectedGraph<T, SharedStorage, A>::Chunk final
+   {
+   public:
+      
+      // Constructors
+      explicit Chunk(const A& alloc);
+      Chunk(const Chunk& rhs, const A& alloc);
+      
+      // Friend
+      friend class DirectedGraph<T, SharedStorage, A>;
+      
+   private:
+      
+      /** The pointers to the nodes, in the order of their positions. */
+      Nodes nodes_;
+   };
+   
+   /**
+    * A <b>node</b> of a shared directed graph holds its value and the
+    * positions of its adjacent nodes. A node is never modified while it is
+    * shared.
+    */
+   template<typename T, typename A>
+   class DirectedGraph<T, SharedStorage, A>::Node final
+   {
+   public:
+      
+      // Constructors
+      template<typename... Args>
+      Node(const A& alloc, Args&&... args);
+      Node(const Node& rhs, const A& alloc);
+      
+      // Friends
+      friend class DirectedGraph<T, SharedStorage, A>;
+      template<typename U, typename V>
+      friend std::ostream& operator<<(std::ostream& out,
+         const DirectedGraph<U, SharedStorage, V>& rhs);
+      
+   private:
+      
+      /** The data of this node in the directed graph. */
+      T data_;
+      
+      /** The positions of the tail nodes, in the order of connection. */
+      Indices next_;
+      
+      /** The positions of the head nodes, in the order of connection. */
+      Indices prev_;
+   };
+   
+   /**
+    * The <b>table</b> of a shared directed graph lists its chunks of nodes,
+    * along with the allocator with which everything is allocated. A table is
+    * never modified while it is shared.
+    */
+   template<typename T, typename A>
+   class DirectedGraph<T, SharedStorage, A>::Table final
+   {
+   public:
+      
+      // Constructors
+      explicit Table(const A& alloc);
+      Table(const Table& rhs, const A& alloc);
+      
+      // Friend
+      friend class DirectedGraph<T, SharedStorage, A>;
+      
+   private:
+      
+      /** The allocator of the directed graph. */
+      A allocator_;
+      
+      /** The chunks of nodes, all full except possibly the last one. */
+      Chunks chunks_;
+      
+      /** The number of nodes in the directed graph. */
+      size_t size_;
+   };
+   
+   // Directed graph output operator
+   template<typename T, typename A>
+   std::ostream& operator<<(std::ostream& out,
+      const DirectedGraph<T, SharedStorage, A>& rhs);
+   
+   template<typename T, typename A>
+   const size_t DirectedGraph<T, SharedStorage, A>::chunk_size;
+   
+   /** Constructs an empty directed graph, with no nodes. */
+   template<typename T, typename A>
+   inline DirectedGraph<T, SharedStorage, A>::DirectedGraph() {}
+   
+   /**
+    * Constructs an empty directed graph, with no nodes, that allocates its
+    * memory with the specified allocator.
+    *
+    * @param alloc   the allocator
+    */
+   template<typename T, typename A>
+   inline DirectedGraph<T, SharedStorage, A>::DirectedGraph(const A& alloc)
+      : root_(std::allocate_shared<Table>(Allocator<Table>(alloc), alloc)) {}
+   
+   /**
+    * Constructs a directed graph with <i>n</i> nodes. Each node has the
+    * default value of the specified type for the directed graph.
+    *
+    * @param n       the initial number of nodes
+    * @param alloc   the allocator
+    */
+   template<typename T, typename A>
+   DirectedGraph<T, SharedStorage, A>::DirectedGraph(const size_t& n,
+      const A& alloc) : DirectedGraph(alloc)
+   {
+      reserve(n);
+      for (size_t i = 0; i < n; i++) emplace_back();
+   }
+   
+   /**
+    * Constructs a directed graph with <i>n</i> nodes. Each node has the
+    * specified value.
+    *
+    * @param n       the initial number of nodes
+    * @param val     the value of each node
+    * @param alloc   the allocator
+    */
+   template<typename T, typename A>
+   DirectedGraph<T, SharedStorage, A>::DirectedGraph(const size_t& n,
+      const T& val, const A& alloc) : DirectedGraph(alloc)
+   {
+      reserve(n);
+      for (size_t i = 0; i < n; i++) push_back(val);
+   }
+   
+   /**
+    * Constructs a directed graph that contains nodes with each of the elements
+    * in the specified vector.
+    *
+    * @param v       the vector of elements
+    * @param alloc   the allocator
+    */
+   template<typename T, typename A>
+   DirectedGraph<T, SharedStorage, A>::DirectedGraph(const std::vector<T>& v,
+      const A& alloc) : DirectedGraph(alloc)
+   {
+      reserve(v.size());
+      for (const auto& element : v) push_back(element);
+   }
+   
+   /**
+    * Constructs a directed graph that contains nodes with each of the elements
+    * in the specified vector. Each element is moved into its node, and the
+    * vector is left in a valid but unspecified state.
+    *
+    * @param v       the vector of elements
+    * @param alloc   the allocator
+    */
+   template<typename T, typename A>
+   DirectedGraph<T, SharedStorage, A>::DirectedGraph(std::vector<T>&& v,
+      const A& alloc) : DirectedGraph(alloc)
+   {
+      reserve(v.size());
+      for (auto& element : v) push_back(std::move(element));
+   }
+   
+   /**
+    * Constructs a directed graph that contains nodes with each of the elements
+    * in the specified initializer list.
+    *
+    * @param il      the initializer list of elements
+    * @param alloc   the allocator
+    */
+   template<typename T, typename A>
+   DirectedGraph<T, SharedStorage, A>::DirectedGraph(
+      const std::initializer_list<T> il, const A& alloc) : DirectedGraph(alloc)
+   {
+      reserve(il.size());
+      for (const auto& element : il) push_back(element);
+   }
+   
+   /**
+    * Constructs a directed graph that shares all the nodes in the specified
+    * directed graph, in constant time. Either directed graph copies what it
+    * modifies, so the two stay independent.
+    *
+    * @param rhs   the directed graph to be copied
+    */
+   template<typename T, typename A>
+   inline DirectedGraph<T, SharedStorage, A>::DirectedGraph(
+      const DirectedGraph& rhs) : root_(rhs.root_) {}
+   
+   /**
+    * Constructs a directed graph with the nodes in the specified directed
+    * graph that allocates its memory with the specified allocator. The nodes
+    * are shared if the allocators compare equal, and copied otherwise.
+    *
+    * @param rhs     the directed graph to be copied
+    * @param alloc   the allocator
+    */
+   template<typename T, typename A>
+   DirectedGraph<T, SharedStorage, A>::DirectedGraph(const DirectedGraph& rhs,
+      const A& alloc)
+   {
+      if (alloc == rhs.get_allocator())
+      {
+         root_ = rhs.root_;
+         return;
+      }
+      
+      root_ = std::allocate_shared<Table>(Allocator<Table>(alloc), alloc);
+      reserve(rhs.size());
+      
+      for (size_t i = 0; i < rhs.size(); i++)
+      {
+         if (i % chunk_size == 0)
+         {
+            root_ -> chunks_.push_back(std::allocate_shared<Chunk>(
+               Allocator<Chunk>(alloc), alloc));
+         }
+         
+         root_ -> chunks_.back() -> nodes_.push_back(std::allocate_shared<Node>(
+            Allocator<Node>(alloc), rhs.node(i), alloc));
+         root_ -> size_++;
+      }
+   }
+   
+   /**
+    * Constructs a directed graph that acquires the nodes and the directed edges
+    * in the specified directed graph, without allocating. Note that the
+    * specified directed graph is left empty.
+    *
+    * @param rhs   the directed graph to be moved
+    */
+   template<typename T, typename A>
+   inline DirectedGraph<T, SharedStorage, A>::DirectedGraph(
+      DirectedGraph&& rhs) noexcept : root_(std::move(rhs.root_)) {}
+   
+   /**
+    * Makes this directed graph share all the nodes in the specified directed
+    * graph, in constant time.
+    *
+    * @param rhs   the directed graph to be copied
+    *
+    * @return this directed graph after the assignment
+    */
+   template<typename T, typename A>
+   inline DirectedGraph<T, SharedStorage, A>& DirectedGraph<T, SharedStorage,
+      A>::operator=(const DirectedGraph& rhs)
+   {
+      root_ = rhs.root_;
+      return *this;
+   }
+   
+   /**
+    * Moves all the nodes and the directed edges in the specified directed
+    * graph into this directed graph, with the former left empty. The
+    * allocator moves along with the nodes.
+    *
+    * @param rhs   the directed graph to be moved
+    *
+    * @return this directed graph after the assignment
+    */
+   template<typename T, typename A>
+   inline DirectedGraph<T, SharedStorage, A>& DirectedGraph<T, SharedStorage,
+      A>::operator=(DirectedGraph&& rhs) noexcept
+   {
+      // Tests for self-assignment.
+      if (this != &rhs) root_ = std::move(rhs.root_);
+      
+      return *this;
+   }
+   
+   /** Destroys this directed graph. */
+   template<typename T, typename A>
+   inline DirectedGraph<T, SharedStorage, A>::~DirectedGraph() {}
+   
+   /**
+    * Returns a reference to the value of the node at position <i>k</i> in this
+    * directed graph. The node is copied first if it is shared.<p>
+    *
+    * The function automatically checks whether <i>k</i> is within the bounds of
+    * valid positions in the directed graph, throwing an
+    * <code>std::out_of_range</code> exception if it is not (i.e., if <i>k</i>
+    * is greater than or equal to the number of nodes in the directed graph).
+    * This is in contrast with member <code>operator[]</code>, which does not
+    * check against bounds.
+    *
+    * @param k   the position of the node
+    *
+    * @return a reference to the value of the node at position <i>k</i>
+    *
+    * @throws std::out_of_range if <i>k</i> is out of bounds
+    */
+   template<typename T, typename A>
+   T& DirectedGraph<T, SharedStorage, A>::at(const size_t& k)
+   {
+      // Tests if k is valid.
+      test_index(k, "Invalid node index in directed graph: ");
+      
+      return mutable_node(k).data_;
+   }
+   
+   /**
+    * Removes all the nodes in this directed graph, leaving it with a size of
+    * 0. The copies that shared the nodes keep them.
+    */
+   template<typename T, typename A>
+   void DirectedGraph<T, SharedStorage, A>::clear()
+   {
+      if (root_ != nullptr)
+      {
+         root_ = std::allocate_shared<Table>(Allocator<Table>(get_allocator()),
+            get_allocator());
+      }
+   }
+   
+   /**
+    * Connects a directed edge from the specified starting node to the specified
+    * ending node in this directed graph.<p>
+    *
+    * The function automatically checks whether <code>from</code> and
+    * <code>to</code> are greater than or equal to the number of nodes in the
+    * directed graph, throwing an <code>std::out_of_range</code> exception if it
+    * is not.
+    *
+    * @param from   the position of the starting node
+    * @param to     the position of the ending node
+    *
+    * @throws std::out_of_range if either <code>from</code> or <code>to</code>
+    * is out of bounds
+    */
+   template<typename T, typename A>
+   void DirectedGraph<T, SharedStorage, A>::connect(const size_t& from,
+      const size_t& to)
+   {
+      // Tests if the starting and ending node indices are valid.
+      test_index(from, "Invalid starting node index in directed graph: ");
+      test_index(to, "Invalid ending node index in directed graph: ");
+      
+      mutable_node(from).next_.push_back(to);
+      mutable_node(to).prev_.push_back(from);
+   }
+   
+   /**
+    * Disconnects all head nodes and all tail nodes adjacent to the node at
+    * position <i>k</i> in this directed graph.<p>
+    *
+    * The function automatically checks whether <i>k</i> is greater than or
+    * equal to the number of nodes in the directed graph, throwing an
+    * <code>std::out_of_range</code> exception if it is not.
+    *
+    * @param k   the position of the node
+    *
+    * @throws std::out_of_range if <i>k</i> is out of bounds
+    */
+   template<typename T, typename A>
+   void DirectedGraph<T, SharedStorage, A>::disconnect(const size_t& k)
+   {
+      // Tests if k is valid.
+      test_index(k, "Invalid node index in directed graph: ");
+      
+      if (node(k).next_.empty() && node(k).prev_.empty()) return;
+      
+      const Indices tails = node(k).next_;
+      const Indices heads = node(k).prev_;
+      
+      // Removes the given node from the adjacent nodes of its neighbors.
+      for (const auto& tail : tails)
+      {
+         Indices& edge = mutable_node(tail).prev_;
+         edge.erase(std::remove(edge.begin(), edge.end(), k), edge.end());
+      }
+      
+      for (const auto& head : heads)
+      {
+         Indices& edge = mutable_node(head).next_;
+         edge.erase(std::remove(edge.begin(), edge.end(), k), edge.end());
+      }
+      
+      Node& result = mutable_node(k);
+      result.next_.clear();
+      result.prev_.clear();
+   }
+   
+   /**
+    * Disconnects a directed edge from the specified starting node to the
+    * specified ending node in this directed graph. Nothing is copied if there
+    * is no such directed edge.<p>
+    *
+    * The function automatically checks whether <code>from</code> and
+    * <code>to</code> are greater than or equal to the number of nodes in the
+    * directed graph, throwing an <code>std::out_of_range</code> exception if it
+    * is not.
+    *
+    * @param from   the position of the starting node
+    * @param to     the position of the ending node
+    *
+    * @throws std::out_of_range if either <code>from</code> or <code>to</code>
+    * is out of bounds
+    */
+   template<typename T, typename A>
+   void DirectedGraph<T, SharedStorage, A>::disconnect(const size_t& from,
+      const size_t& to)
+   {
+      // Tests if the starting and ending node indices are valid.
+      test_index(from, "Invalid starting node index in directed graph: ");
+      test_index(to, "Invalid ending node index in directed graph: ");
+      
+      if (!has_edge(from, to)) return;
+      
+      // Removes the rightmost occurrence of the given directed edge.
+      Indices& edge = mutable_node(from).next_;
+      edge.erase(std::next(std::find(edge.rbegin(), edge.rend(), to)).base());
+      
+      Indices& reverse = mutable_node(to).prev_;
+      reverse.erase(
+         std::next(std::find(reverse.rbegin(), reverse.rend(), from)).base());
+   }
+   
+   /**
+    * Adds a node to this directed graph, after its current last node. The
+    * value of the new node is constructed in place from the specified
+    * arguments.
+    *
+    * @param args   the arguments with which to construct the value
+    */
+   template<typename T, typename A>
+   template<typename... Args>
+   void DirectedGraph<T, SharedStorage, A>::emplace_back(Args&&... args)
+   {
+      const A alloc = get_allocator();
+      std::shared_ptr<Node> result = std::allocate_shared<Node>(
+         Allocator<Node>(alloc), alloc, std::forward<Args>(args)...);
+      
+      Table& table = mutable_table();
+      
+      if (table.size_ % chunk_size == 0)
+      {
+         table.chunks_.push_back(std::allocate_shared<Chunk>(
+            Allocator<Chunk>(alloc), alloc));
+      }
+      
+      std::shared_ptr<Chunk>& chunk = table.chunks_.back();
+      unshare(chunk);
+      chunk -> nodes_.push_back(std::move(result));
+      table.size_++;
+   }
+   
+   /**
+    * Removes the node at position <i>k</i> from this directed graph. The nodes
+    * after position <i>k</i> are moved down by one position, and the directed
+    * edges between them are kept. Every node with an adjacent node after
+    * position <i>k</i> is renumbered, and copied first if it is shared.<p>
+    *
+    * The function automatically checks whether <i>k</i> is greater than or
+    * equal to the number of nodes in the directed graph, throwing an
+    * <code>std::out_of_range</code> exception if it is not.
+    *
+    * @param k   the position of the node
+    *
+    * @throws std::out_of_range if <i>k</i> is out of bounds
+    */
+   template<typename T, typename A>
+   void DirectedGraph<T, SharedStorage, A>::erase(const size_t& k)
+   {
+      // Tests if k is valid.
+      test_index(k, "Invalid node index in directed graph: ");
+      
+      disconnect(k);
+      
+      // Moves the nodes after position k down by one position.
+      for (size_t i = k; i + 1 < size(); i++)
+      {
+         std::shared_ptr<Node> next = slot(i + 1);
+         mutable_slot(i) = std::move(next);
+      }
+      
+      Table& table = mutable_table();
+      std::shared_ptr<Chunk>& last = table.chunks_.back();
+      unshare(last);
+      last -> nodes_.pop_back();
+      if (last -> nodes_.empty()) table.chunks_.pop_back();
+      table.size_--;
+      
+      // Renumbers the adjacent nodes after position k.
+      auto after = [&](const size_t& j) { return j > k; };
+      
+      for (size_t i = 0; i < size(); i++)
+      {
+         const Node& current = node(i);
+         
+         if (std::none_of(current.next_.begin(), current.next_.end(), after)
+             && std::none_of(current.prev_.begin(), current.prev_.end(), after))
+            continue;
+         
+         Node& result = mutable_node(i);
+         for (auto& j : result.next_) if (j > k) j--;
+         for (auto& j : result.prev_) if (j > k) j--;
+      }
+   }
+   
+   /**
+    * Returns a reference to the value of the first node in this directed graph.
+    * The node is copied first if it is shared.
+    *
+    * @return a reference to the value of the first node
+    *
+    * @throws std::out_of_range if this directed graph is empty
+    */
+   template<typename T, typename A>
+   T& DirectedGraph<T, SharedStorage, A>::front()
+   {
+      // Tests if this directed graph is empty.
+      if (empty())
+         throw std::out_of_range("Cannot access nodes in empty directed graph");
+      
+      return mutable_node(0).data_;
+   }
+   
+   /**
+    * Returns a reference to the value of the node at position <i>k</i> in this
+    * directed graph. The node is copied first if it is shared.
+    *
+    * @param k   the position of the node
+    *
+    * @return a reference to the value of the node at position <i>k</i>
+    */
+   template<typename T, typename A>
+   inline T& DirectedGraph<T, SharedStorage, A>::operator[](const size_t& k)
+   {
+      return mutable_node(k).data_;
+   }
+   
+   /**
+    * Adds a node with the specified value to this directed graph, after its
+    * current last node.
+    *
+    * @param val   the value of the new node
+    */
+   template<typename T, typename A>
+   inline void DirectedGraph<T, SharedStorage, A>::push_back(const T& val)
+   {
+      emplace_back(val);
+   }
+   
+   /**
+    * Adds a node with the specified value to this directed graph, after its
+    * current last node. The value is moved into the new node.
+    *
+    * @param val   the value of the new node
+    */
+   template<typename T, typename A>
+   inline void DirectedGraph<T, SharedStorage, A>::push_back(T&& val)
+   {
+      emplace_back(std::move(val));
+   }
+   
+   /**
+    * Reserves memory in the table for at least the specified number of nodes,
+    * so that adding up to that many nodes does not reallocate the table. The
+    * table is copied first if it is shared.
+    *
+    * @param nodes   the number of nodes
+    */
+   template<typename T, typename A>
+   void DirectedGraph<T, SharedStorage, A>::reserve(const size_t& nodes)
+   {
+      mutable_table().chunks_.reserve((nodes + chunk_size - 1) / chunk_size);
+   }
+   
+   /**
+    * Exchanges the content of this directed graph with the content of the
+    * specified directed graph. No node or directed edge is copied or
+    * allocated, and the allocators are exchanged along with the nodes.
+    *
+    * @param rhs   the directed graph to be swapped
+    */
+   template<typename T, typename A>
+   inline void DirectedGraph<T, SharedStorage, A>::swap(DirectedGraph& rhs)
+      noexcept
+   {
+      root_.swap(rhs.root_);
+   }
+   
+   /**
+    * Returns a snapshot of the directed edges in this directed graph, with the
+    * tail nodes of each node in the order in which they were connected. The
+    * snapshot is not updated when this directed graph is modified.
+    *
+    * @return the adjacency of this directed graph
+    */
+   template<typename T, typename A>
+   Adjacency DirectedGraph<T, SharedStorage, A>::adjacency() const
+   {
+      std::vector<std::pair<size_t, size_t>> edges;
+      
+      for (size_t i = 0; i < size(); i++)
+      {
+         for (const auto& tail : node(i).next_)
+            edges.push_back(std::make_pair(i, tail));
+      }
+      
+      return Adjacency(size(), edges);
+   }
+   
+   /**
+    * Returns the value of the node at position <i>k</i> in this directed
+    * graph.<p>
+    *
+    * The function automatically checks whether <i>k</i> is within the bounds of
+    * valid positions in the directed graph, throwing an
+    * <code>std::out_of_range</code> exception if it is not (i.e., if <i>k</i>
+    * is greater than or equal to the number of nodes in the directed graph).
+    * This is in contrast with member <code>operator[]</code>, which does not
+    * check against bounds.
+    *
+    * @param k   the position of the node
+    *
+    * @return the value of the node at position <i>k</i>
+    *
+    * @throws std::out_of_range if <i>k</i> is out of bounds
+    */
+   template<typename T, typename A>
+   T DirectedGraph<T, SharedStorage, A>::at(const size_t& k) const
+   {
+      // Tests if k is valid.
+      test_index(k, "Invalid node index in directed graph: ");
+      
+      return node(k).data_;
+   }
+   
+   /**
+    * Returns the number of directed edges from the specified starting node to
+    * the specified ending node in this directed graph. The function scans the
+    * shorter of the tail nodes of the starting node and the head nodes of the
+    * ending node.<p>
+    *
+    * The function automatically checks whether <code>from</code> and
+    * <code>to</code> are greater than or equal to the number of nodes in the
+    * directed graph, throwing an <code>std::out_of_range</code> exception if it
+    * is not.
+    *
+    * @param from   the position of the starting node
+    * @param to     the position of the ending node
+    *
+    * @return the number of directed edges
+    *
+    * @throws std::out_of_range if either <code>from</code> or <code>to</code>
+    * is out of bounds
+    */
+   template<typename T, typename A>
+   size_t DirectedGraph<T, SharedStorage, A>::edge_count(const size_t& from,
+      const size_t& to) const
+   {
+      // Tests if the starting and ending node indices are valid.
+      test_index(from, "Invalid starting node index in directed graph: ");
+      test_index(to, "Invalid ending node index in directed graph: ");
+      
+      const Indices& edge = node(from).next_;
+      const Indices& reverse = node(to).prev_;
+      
+      if (edge.size() <= reverse.size())
+         return std::count(edge.begin(), edge.end(), to);
+      
+      return std::count(reverse.begin(), reverse.end(), from);
+   }
+   
+   /**
+    * Tests if this directed graph is empty (i.e., if the directed graph
+    * contains no nodes).
+    *
+    * @return <code>true</code> if this directed graph is empty, or
+    * <code>false</code> otherwise
+    */
+   template<typename T, typename A>
+   inline bool DirectedGraph<T, SharedStorage, A>::empty() const
+   {
+      return size() == 0;
+   }
+   
+   /**
+    * Returns the value of the first node in this directed graph.
+    *
+    * @return the value of the first node
+    *
+    * @throws std::out_of_range if this directed graph is empty
+    */
+   template<typename T, typename A>
+   T DirectedGraph<T, SharedStorage, A>::front() const
+   {
+      // Tests if this directed graph is empty.
+      if (empty())
+         throw std::out_of_range("Cannot access nodes in empty directed graph");
+      
+      return node(0).data_;
+   }
+   
+   /**
+    * Returns the allocator with which this directed graph allocates its
+    * memory.
+    *
+    * @return the allocator of this directed graph
+    */
+   template<typename T, typename A>
+   inline A DirectedGraph<T, SharedStorage, A>::get_allocator() const
+   {
+      return root_ == nullptr ? A() : root_ -> allocator_;
+   }
+   
+   /**
+    * Tests if this directed graph has a directed edge from the specified
+    * starting node to the specified ending node. The function scans the
+    * shorter of the tail nodes of the starting node and the head nodes of the
+    * ending node.<p>
+    *
+    * The function automatically checks whether <code>from</code> and
+    * <code>to</code> are greater than or equal to the number of nodes in the
+    * directed graph, throwing an <code>std::out_of_range</code> exception if it
+    * is not.
+    *
+    * @param from   the position of the starting node
+    * @param to     the position of the ending node
+    *
+    * @return <code>true</code> if the directed edge exists, or
+    * <code>false</code> otherwise
+    *
+    * @throws std::out_of_range if either <code>from</code> or <code>to</code>
+    * is out of bounds
+    */
+   template<typename T, typename A>
+   bool DirectedGraph<T, SharedStorage, A>::has_edge(const size_t& from,
+      const size_t& to) const
+   {
+      // Tests if the starting and ending node indices are valid.
+      test_index(from, "Invalid starting node index in directed graph: ");
+      test_index(to, "Invalid ending node index in directed graph: ");
+      
+      const Indices& edge = node(from).next_;
+      const Indices& reverse = node(to).prev_;
+      
+      if (edge.size() <= reverse.size())
+         return std::find(edge.begin(), edge.end(), to) != edge.end();
+      
+      return std::find(reverse.begin(), reverse.end(), from) != reverse.end();
+   }
+   
+   /**
+    * Returns the <b>indegree</b> of the node at position <i>k</i> in this
+    * directed graph (i.e., the number of head nodes adjacent to the node at
+    * position <i>k</i>).<p>
+    *
+    * The function automatically checks whether <i>k</i> is greater than or
+    * equal to the number of nodes in the directed graph, throwing an
+    * <code>std::out_of_range</code> exception if it is not.
+    *
+    * @param k   the position of the node
+    *
+    * @return the indegree of the node at position <i>k</i>
+    *
+    * @throws std::out_of_range if <i>k</i> is out of bounds
+    */
+   template<typename T, typename A>
+   size_t DirectedGraph<T, SharedStorage, A>::indegree(const size_t& k) const
+   {
+      // Tests if k is valid.
+      test_index(k, "Invalid node index in directed graph: ");
+      
+      return node(k).prev_.size();
+   }
+   
+   /**
+    * Returns the value of the node at position <i>k</i> in this directed graph.
+    *
+    * @param k   the position of the node
+    *
+    * @return the value of the node at position <i>k</i>
+    */
+   template<typename T, typename A>
+   inline T DirectedGraph<T, SharedStorage, A>::operator[](const size_t& k)
+      const
+   {
+      return node(k).data_;
+   }
+   
+   /**
+    * Returns the <b>outdegree</b> of the node at position <i>k</i> in this
+    * directed graph (i.e., the number of tail nodes adjacent to the node at
+    * position <i>k</i>).<p>
+    *
+    * The function automatically checks whether <i>k</i> is greater than or
+    * equal to the number of nodes in the directed graph, throwing an
+    * <code>std::out_of_range</code> exception if it is not.
+    *
+    * @param k   the position of the node
+    *
+    * @return the outdegree of the node at position <i>k</i>
+    *
+    * @throws std::out_of_range if <i>k</i> is out of bounds
+    */
+   template<typename T, typename A>
+   size_t DirectedGraph<T, SharedStorage, A>::outdegree(const size_t& k) const
+   {
+      // Tests if k is valid.
+      test_index(k, "Invalid node index in directed graph: ");
+      
+      return node(k).next_.size();
+   }
+   
+   /**
+    * Tests if this directed graph is simple, that is, if the directed graph has
+    * no loops and no multiple directed edges (edges with the same starting and
+    * ending nodes). Each ending node is marked with the last starting node
+    * that reached it, so the test takes linear time.
+    *
+    * @return <code>true</code> if this directed graph is simple, or
+    * <code>false</code> otherwise
+    */
+   template<typename T, typename A>
+   bool DirectedGraph<T, SharedStorage, A>::simple() const
+   {
+      Indices marks(size(), static_cast<size_t>(-1), get_allocator());
+      
+      for (size_t i = 0; i < size(); i++)
+      {
+         for (const auto& tail : node(i).next_)
+         {
+            // Tests if the current node has a loop or a multiple directed edge.
+            if (tail == i || marks[tail] == i) return false;
+            marks[tail] = i;
+         }
+      }
+      
+      return true;
+   }
+   
+   /**
+    * Returns the number of nodes in this directed graph.
+    *
+    * @return the number of nodes
+    */
+   template<typename T, typename A>
+   inline size_t DirectedGraph<T, SharedStorage, A>::size() const
+   {
+      return root_ == nullptr ? 0 : root_ -> size_;
+   }
+   
+   /**
+    * Returns an immutable snapshot of this directed graph, in constant time.
+    * The snapshot shares all the nodes in this directed graph, and is not
+    * affected when this directed graph is modified afterwards.
+    *
+    * @return the snapshot of this directed graph
+    */
+   template<typename T, typename A>
+   inline DirectedGraph<T, SharedStorage, A>
+      DirectedGraph<T, SharedStorage, A>::snapshot() const
+   {
+      return *this;
+   }
+   
+   /**
+    * Tests if this directed graph and the specified directed graph are equal.
+    * The nodes, chunks, and tables that the two directed graphs share are not
+    * compared, so a directed graph is compared with its own snapshot in time
+    * proportional to what has changed since the snapshot.
+    *
+    * @param rhs   the directed graph to compare with this directed graph
+    *
+    * @return <code>true</code> if this directed graph and the specified
+    * directed graph are equal, or <code>false</code> otherwise
+    */
+   template<typename T, typename A>
+   bool DirectedGraph<T, SharedStorage, A>::operator==(const DirectedGraph& rhs)
+      const
+   {
+      if (root_ == rhs.root_) return true;
+      
+      // Tests if the two directed graphs have the same number of nodes.
+      if (size() != rhs.size()) return false;
+      
+      for (size_t i = 0; i < size(); i++)
+      {
+         const std::shared_ptr<Chunk>& chunk = root_ -> chunks_[i / chunk_size];
+         
+         // Skips the chunks that the two directed graphs share.
+         if (chunk == rhs.root_ -> chunks_[i / chunk_size])
+         {
+            i += chunk -> nodes_.size() - 1;
+            continue;
+         }
+         
+         const std::shared_ptr<Node>& lhs_node = slot(i);
+         const std::shared_ptr<Node>& rhs_node = rhs.slot(i);
+         
+         if (lhs_node == rhs_node) continue;
+         
+         // Tests if the current nodes have the same value and tail nodes.
+         if (!(lhs_node -> data_ == rhs_node -> data_)
+             || lhs_node -> next_ != rhs_node -> next_)
+            return false;
+      }
+      
+      return true;
+   }
+   
+   /**
+    * Tests if this directed graph and the specified directed graph are unequal.
+    *
+    * @param rhs   the directed graph to compare with this directed graph
+    *
+    * @return <code>true</code> if this directed graph and the specified
+    * directed graph are unequal, or <code>false</code> otherwise
+    */
+   template<typename T, typename A>
+   inline bool DirectedGraph<T, SharedStorage, A>
+      ::operator!=(const DirectedGraph& rhs) const
+   {
+      return !(*this == rhs);
+   }
+   
+   /**
+    * Returns the node at position <i>k</i> in this directed graph, copying the
+    * table, the chunk, and the node first if they are shared, so that the node
+    * can be modified.
+    *
+    * @param k   the position of the node
+    *
+    * @return the node at position <i>k</i>
+    */
+   template<typename T, typename A>
+   typename DirectedGraph<T, SharedStorage, A>::Node&
+      DirectedGraph<T, SharedStorage, A>::mutable_node(const size_t& k)
+   {
+      std::shared_ptr<Node>& result = mutable_slot(k);
+      unshare(result);
+      return *result;
+   }
+   
+   /**
+    * Returns the pointer to the node at position <i>k</i> in this directed
+    * graph, copying the table and the chunk first if they are shared, so that
+    * the pointer can be replaced.
+    *
+    * @param k   the position of the node
+    *
+    * @return the pointer to the node at position <i>k</i>
+    */
+   template<typename T, typename A>
+   std::shared_ptr<typename DirectedGraph<T, SharedStorage, A>::Node>&
+      DirectedGraph<T, SharedStorage, A>::mutable_slot(const size_t& k)
+   {
+      std::shared_ptr<Chunk>& chunk = mutable_table().chunks_[k / chunk_size];
+      unshare(chunk);
+      return chunk -> nodes_[k % chunk_size];
+   }
+   
+   /**
+    * Returns the table of this directed graph, allocating it if there is none
+    * and copying it first if it is shared, so that it can be modified.
+    *
+    * @return the table of this directed graph
+    */
+   template<typename T, typename A>
+   typename DirectedGraph<T, SharedStorage, A>::Table&
+      DirectedGraph<T, SharedStorage, A>::mutable_table()
+   {
+      if (root_ == nullptr)
+         root_ = std::allocate_shared<Table>(Allocator<Table>(A()), A());
+      
+      else unshare(root_);
+      
+      return *root_;
+   }
+   
+   /**
+    * Replaces the block to which the specified pointer points with a copy of
+    * it if the block is shared, so that the block can be modified.
+    *
+    * @param pointer   the pointer to the block
+    */
+   template<typename T, typename A>
+   template<typename U>
+   void DirectedGraph<T, SharedStorage, A>::unshare(std::shared_ptr<U>& pointer)
+   {
+      if (unique(pointer)) return;
+      
+      const A alloc = get_allocator();
+      pointer = std::allocate_shared<U>(Allocator<U>(alloc), *pointer, alloc);
+   }
+   
+   /**
+    * Returns the node at position <i>k</i> in this directed graph, which must
+    * not be modified.
+    *
+    * @param k   the position of the node
+    *
+    * @return the node at position <i>k</i>
+    */
+   template<typename T, typename A>
+   inline const typename DirectedGraph<T, SharedStorage, A>::Node&
+      DirectedGraph<T, SharedStorage, A>::node(const size_t& k) const
+   {
+      return *slot(k);
+   }
+   
+   /**
+    * Returns the pointer to the node at position <i>k</i> in this directed
+    * graph, which must not be replaced.
+    *
+    * @param k   the position of the node
+    *
+    * @return the pointer to the node at position <i>k</i>
+    */
+   template<typename T, typename A>
+   inline const std::shared_ptr<typename DirectedGraph<T, SharedStorage, A>
+      ::Node>& DirectedGraph<T, SharedStorage, A>::slot(const size_t& k) const
+   {
+      return root_ -> chunks_[k / chunk_size] -> nodes_[k % chunk_size];
+   }
+   
+   /**
+    * Tests if <i>k</i> is within the bounds of valid positions in the directed
+    * graph, throwing an <code>std::out_of_range</code> exception if it is not
+    * (i.e., if <i>k</i> is greater than or equal to the number of nodes in the
+    * directed graph).
+    *
+    * @param k       the position of the node
+    * @param error   the error message
+    *
+    * @throws std::out_of_range if <i>k</i> is out of bounds
+    */
+   template<typename T, typename A>
+   void DirectedGraph<T, SharedStorage, A>::test_index(const size_t& k,
+      const char* error) const
+   {
+      if (k >= size()) throw_index_error(error, k);
+   }
+   
+   /**
+    * Tests if the specified pointer is the only one to its block, in which
+    * case the block can be modified. The fence orders the modification after
+    * every read of the block through the pointers that have been released by
+    * other threads.
+    *
+    * @param pointer   the pointer to the block
+    *
+    * @return <code>true</code> if no other pointer shares the block, or
+    * <code>false</code> otherwise
+    */
+   template<typename T, typename A>
+   template<typename U>
+   inline bool DirectedGraph<T, SharedStorage, A>::unique(
+      const std::shared_ptr<U>& pointer)
+   {
+      if (pointer.use_count() != 1) return false;
+      
+      std::atomic_thread_fence(std::memory_order_acquire);
+      return true;
+   }
+   
+   /**
+    * Constructs an empty chunk whose pointers are allocated with the specified
+    * allocator.
+    *
+    * @param alloc   the allocator
+    */
+   template<typename T, typename A>
+   inline DirectedGraph<T, SharedStorage, A>::Chunk::Chunk(const A& alloc)
+      : nodes_(alloc)
+   {
+      nodes_.reserve(chunk_size);
+   }
+   
+   /**
+    * Constructs a chunk that shares every node of the specified chunk, and
+    * whose pointers are allocated with the specified allocator.
+    *
+    * @param rhs     the chunk to be copied
+    * @param alloc   the allocator
+    */
+   template<typename T, typename A>
+   DirectedGraph<T, SharedStorage, A>::Chunk::Chunk(const Chunk& rhs,
+      const A& alloc) : nodes_(alloc)
+   {
+      nodes_.reserve(chunk_size);
+      nodes_.insert(nodes_.end(), rhs.nodes_.begin(), rhs.nodes_.end());
+   }
+   
+   /**
+    * Constructs a node whose value is constructed in place from the specified
+    * arguments, and whose vectors of adjacent nodes allocate their memory with
+    * the specified allocator.
+    *
+    * @param alloc   the allocator
+    * @param args    the arguments with which to construct the value
+    */
+   template<typename T, typename A>
+   template<typename... Args>
+   inline DirectedGraph<T, SharedStorage, A>::Node::Node(const A& alloc,
+      Args&&... args)
+      : data_(std::forward<Args>(args)...), next_(alloc), prev_(alloc) {}
+   
+   /**
+    * Constructs a copy of the specified node whose vectors of adjacent nodes
+    * allocate their memory with the specified allocator.
+    *
+    * @param rhs     the node to be copied
+    * @param alloc   the allocator
+    */
+   template<typename T, typename A>
+   inline DirectedGraph<T, SharedStorage, A>::Node::Node(const Node& rhs,
+      const A& alloc)
+      : data_(rhs.data_), next_(rhs.next_, alloc), prev_(rhs.prev_, alloc) {}
+   
+   /**
+    * Constructs an empty table with the specified allocator.
+    *
+    * @param alloc   the allocator
+    */
+   template<typename T, typename A>
+   inline DirectedGraph<T, SharedStorage, A>::Table::Table(const A& alloc)
+      : allocator_(alloc), chunks_(alloc), size_(0) {}
+   
+   /**
+    * Constructs a table that shares every chunk of the specified table, and
+    * that allocates its memory with the specified allocator.
+    *
+    * @param rhs     the table to be copied
+    * @param alloc   the allocator
+    */
+   template<typename T, typename A>
+   inline DirectedGraph<T, SharedStorage, A>::Table::Table(const Table& rhs,
+      const A& alloc)
+      : allocator_(alloc), chunks_(rhs.chunks_, alloc), size_(rhs.size_) {}
+   
+   /**
+    * Outputs the specified directed graph with the specified output stream.
+    * The output stream is not flushed; <code>GraphWriter</code> writes large
+    * directed graphs faster.
+    *
+    * @param out   the output stream
+    * @param rhs   the directed graph to be outputted
+    *
+    * @return the stream after the output
+    */
+   template<typename T, typename A>
+   std::ostream& operator<<(std::ostream& out,
+      const DirectedGraph<T, SharedStorage, A>& rhs)
+   {
+      for (size_t i = 0; i < rhs.size(); i++)
+      {
+         const auto& node = rhs.node(i);
+         
+         // Outputs the current node by itself if it is disconnected.
+         if (node.next_.empty() && node.prev_.empty())
+            out << node.data_ << '\n';
+         
+         // Outputs the starting and ending nodes for each directed edge.
+         else
+         {
+            for (const auto& tail : node.next_)
+               out << node.data_ << " -> " << rhs.node(tail).data_ << '\n';
+         }
+      }
+      
+      return out;
+   }
+}
+
+#endif   // PIC_10C_SHARED_DIRECTED_GRAPH_H_
@@ -0,0 +1,782 @@
+/**
+ * Declarations and definitions of the <code>ShortestPaths</code> class
+ * template and the <code>shortest_paths</code> functions.
+ *
+ * @file shortest_paths.h
+ *
+ * @author Kris Torres
+ *
+ * @date 2026-10-14
+ *
+ * @version 1.0
+ */
+
+#ifndef PIC_10C_SHORTEST_PATHS_H_
+#define PIC_10C_SHORTEST_PATHS_H_
+
+#include <string>
+#include <vector>
+#include <map>
+#include <stdexcept>
+#include <algorithm>
+#include <functional>
+#include <limits>
+#include <type_traits>
+#include <utility>
+#include <atomic>
+#include <thread>
+#include "boost/lexical_cast.hpp"
+#include "index_error.h"
+#include "weighted_adjacency.h"
+
+namespace Kris_Torres_UCLA_PIC_10C_Winter_2014
+{
+   /**
+    * A <b>shortest-path engine</b> finds the distance of every node in a
+    * weighted adjacency from a source node, and keeps its buffers from one
+    * query to the next, so that a query allocates nothing and only resets the
+    * nodes that the previous query reached. Three searches are offered:<p>
+    *
+    * <ul>
+    * <li><code>bfs</code> ignores the weights and counts the directed edges
+    * on each path, which is the fastest search when every weight is 1;</li>
+    * <li><code>dijkstra</code> settles the nodes in order of distance with a
+    * <i>radix heap</i> when the weights are integers, which makes every
+    * operation on the heap cost at most the number of bits in a weight, and
+    * with a binary heap otherwise; and</li>
+    * <li><code>delta_stepping</code> settles the nodes in buckets of width
+    * <i>delta</i>, relaxing the directed edges that leave each bucket on
+    * several threads at once, which suits one query on a very large
+    * weighted adjacency.</li>
+    * </ul>
+    *
+    * For many queries at once, <code>shortest_paths</code> runs one engine
+    * on each thread. An engine must not be shared between threads, and the
+    * weighted adjacency must outlive it.
+    *
+    * @param W   the type of the weights
+    *
+    * @author Kris Torres
+    */
+   template<typename W>
+   class ShortestPaths final
+   {
+   public:
+      
+      // Constructor
+      explicit ShortestPaths(const WeightedAdjacency<W>& graph);
+      
+      // Mutators
+      const std::vector<W>& bfs(const size_t& source);
+      const std::vector<W>& delta_stepping(const size_t& source,
+         const W& delta, const size_t& threads = 0);
+      const std::vector<W>& dijkstra(const size_t& source);
+      
+      // Accessors
+      const std::vector<W>& distances() const;
+      static W infinity();
+      
+   private:
+      
+      // Classes
+      class BinaryHeap;
+      class RadixHeap;
+      
+      // Types
+      typedef typename std::conditional<std::is_integral<W>::value,
+         RadixHeap, BinaryHeap>::type Heap;
+      typedef std::map<size_t, std::vector<size_t>> Buckets;
+      
+      // Constants
+      static const size_t none = static_cast<size_t>(-1);
+      static const size_t parallel_threshold = 1024;
+      
+      // Mutators
+      void merge(Buckets& buckets, const W& delta);
+      void relax(const std::vector<size_t>& frontier, const W& delta,
+         const bool& light, const size_t& threads);
+      void reset(const size_t& source);
+      
+      // Accessor
+      void test_source(const size_t& source) const;
+      
+      /** The weighted adjacency to be searched. */
+      const WeightedAdjacency<W>* graph_;
+      
+      /** The distance of each node from the source node of the last query. */
+      std::vector<W> distances_;
+      
+      /** The nodes that the last query reached. */
+      std::vector<size_t> touched_;
+      
+      /** The heap of tentative distances for <code>dijkstra</code>. */
+      Heap heap_;
+      
+      /** The tentative distances for <code>delta_stepping</code>. */
+      std::vector<std::atomic<W>> tentative_;
+      
+      /** The bucket in which each node is queued, or <code>none</code>. */
+      std::vector<size_t> queued_;
+      
+      /** The last bucket in which each node was settled, plus 1. */
+      std::vector<size_t> settled_;
+      
+      /** The nodes whose distance each thread has lowered in a phase. */
+      std::vector<std::vector<size_t>> updates_;
+   };
+   
+   /**
+    * A <b>binary heap</b> holds tentative distances for the search of
+    * Dijkstra when the weights are not integers.
+    */
+   template<typename W>
+   class ShortestPaths<W>::BinaryHeap final
+   {
+   public:
+      
+      // Mutators
+      void clear();
+      std::pair<W, size_t> pop();
+      void push(const W& key, const size_t& node);
+      
+      // Accessor
+      bool empty() const;
+      
+   private:
+      
+      /** The entries of the heap, with the least distance at the front. */
+      std::vector<std::pair<W, size_t>> entries_;
+   };
+   
+   /**
+    * A <b>radix heap</b> holds tentative distances for the search of Dijkstra
+    * when the weights are integers. It relies on the search extracting the
+    * distances in increasing order: each entry is kept in the bucket given by
+    * the highest bit in which its distance differs from the last extracted
+    * one, and a bucket is only split up again when the lower buckets run out,
+    * so each entry moves down at most once for every bit of a distance.
+    */
+   template<typename W>
+   class ShortestPaths<W>::RadixHeap final
+   {
+   public:
+      
+      // Constructor
+      RadixHeap();
+      
+      // Mutators
+      void clear();
+      std::pair<W, size_t> pop();
+      void push(const W& key, const size_t& node);
+      
+      // Accessor
+      bool empty() const;
+      
+   private:
+      
+      // Type
+      typedef typename std::make_unsigned<
+         typename std::conditional<std::is_integral<W>::value, W, int>::type
+         >::type Key;
+      
+      // Accessor
+      size_t bucket(const Key& key) const;
+      
+      /** The buckets of entries, by the highest bit that differs. */
+      std::vector<std::vector<std::pair<Key, size_t>>> buckets_;
+      
+      /** The last distance extracted from the heap. */
+      Key last_;
+      
+      /** The number of entries in the heap. */
+      size_t size_;
+   };
+   
+   template<typename W>
+   const size_t ShortestPaths<W>::none;
+   
+   template<typename W>
+   const size_t ShortestPaths<W>::parallel_threshold;
+   
+   /**
+    * Returns the distance of every node in the specified weighted adjacency
+    * from the node at position <i>source</i>, found by the search of Dijkstra.
+    *
+    * @param graph    the weighted adjacency of the directed graph
+    * @param source   the position of the source node
+    *
+    * @return the distance of each node, or <code>infinity()</code> for each
+    * node that cannot be reached from the source node
+    *
+    * @throws std::out_of_range if <i>source</i> is at least the number of nodes
+    */
+   template<typename W>
+   inline std::vector<W> shortest_paths(const WeightedAdjacency<W>& graph,
+      const size_t& source)
+   {
+      return ShortestPaths<W>(graph).dijkstra(source);
+   }
+   
+   /**
+    * Returns the distance of every node in the specified weighted adjacency
+    * from each of the specified source nodes, found by the search of Dijkstra
+    * on the specified number of threads. Each thread runs its own engine and
+    * takes the next source node as soon as it finishes the last one.
+    *
+    * @param graph     the weighted adjacency of the directed graph
+    * @param sources   the positions of the source nodes
+    * @param threads   the number of threads, or 0 for one per hardware thread
+    *
+    * @return the distance of each node from each source node, in the order of
+    * the source nodes
+    *
+    * @throws std::out_of_range if some source node is at least the number of
+    * nodes
+    */
+   template<typename W>
+   std::vector<std::vector<W>> shortest_paths(
+      const WeightedAdjacency<W>& graph, const std::vector<size_t>& sources,
+      size_t threads = 0)
+   {
+      // Tests if every source node is valid before any thread is started.
+      for (const auto& source : sources)
+      {
+         if (source >= graph.size())
+            throw_index_error("Invalid source node index in directed graph: ",
+               source);
+      }
+      
+      if (threads == 0) threads = std::thread::hardware_concurrency();
+      if (threads == 0) threads = 1;
+      threads = std::min(threads, std::max<size_t>(sources.size(), 1));
+      
+      std::vector<std::vector<W>> result(sources.size());
+      std::atomic<size_t> cursor(0);
+      
+      auto work = [&]()
+      {
+         ShortestPaths<W> engine(graph);
+         
+         for (size_t i = cursor++; i < sources.size(); i = cursor++)
+            result[i] = engine.dijkstra(sources[i]);
+      };
+      
+      std::vector<std::thread> workers;
+      for (size_t i = 1; i < threads; i++) workers.push_back(std::thread(work));
+      work();
+      for (auto& worker : workers) worker.join();
+      
+      return result;
+   }
+   
+   /**
+    * Constructs a shortest-path engine for the specified weighted adjacency,
+    * which must outlive the engine.
+    *
+    * @param graph   the weighted adjacency of the directed graph
+    */
+   template<typename W>
+   ShortestPaths<W>::ShortestPaths(const WeightedAdjacency<W>& graph)
+      : graph_(&graph), distances_(graph.size(), infinity()),
+        tentative_(graph.size()), queued_(graph.size(), none),
+        settled_(graph.size(), 0)
+   {
+      touched_.reserve(graph.size());
+   }
+   
+   /**
+    * Finds the number of directed edges on a shortest path from the node at
+    * position <i>source</i> to every node, ignoring the weights.
+    *
+    * @param source   the position of the source node
+    *
+    * @return the distance of each node, or <code>infinity()</code> for each
+    * node that cannot be reached from the source node
+    *
+    * @throws std::out_of_range if <i>source</i> is at least the number of nodes
+    */
+   template<typename W>
+   const std::vector<W>& ShortestPaths<W>::bfs(const size_t& source)
+   {
+      test_source(source);
+      reset(source);
+      
+      const std::vector<size_t>& offsets = graph_ -> offsets_;
+      const auto& arcs = graph_ -> arcs_;
+      
+      // The reached nodes are the queue of the search.
+      for (size_t i = 0; i < touched_.size(); i++)
+      {
+         const size_t node = touched_[i];
+         const W distance = distances_[node] + W(1);
+         
+         for (size_t j = offsets[node]; j < offsets[node + 1]; j++)
+         {
+            const size_t tail = arcs[j].target;
+            
+            if (distances_[tail] == infinity())
+            {
+               distances_[tail] = distance;
+               touched_.push_back(tail);
+            }
+         }
+      }
+      
+      return distances_;
+   }
+   
+   /**
+    * Finds the distance of every node from the node at position
+    * <i>source</i> by the delta-stepping search on the specified number of
+    * threads. The nodes are settled in buckets of distances of width
+    * <i>delta</i>; within a bucket, the directed edges no heavier than
+    * <i>delta</i> are relaxed repeatedly until the bucket stays empty, and
+    * the heavier ones are then relaxed once. The directed edges leaving a
+    * large bucket are split among the threads, which lower the tentative
+    * distances with atomic operations.<p>
+    *
+    * A <i>delta</i> near the average weight divided by the average outdegree
+    * usually does well: a smaller one leaves the threads too little work in
+    * each bucket, and a larger one relaxes more directed edges in vain.
+    *
+    * @param source    the position of the source node
+    * @param delta     the width of each bucket, which must be positive
+    * @param threads   the number of threads, or 0 for one per hardware thread
+    *
+    * @return the distance of each node, or <code>infinity()</code> for each
+    * node that cannot be reached from the source node
+    *
+    * @throws std::out_of_range if <i>source</i> is at least the number of nodes
+    * @throws std::invalid_argument if <i>delta</i> is not positive
+    */
+   template<typename W>
+   const std::vector<W>& ShortestPaths<W>::delta_stepping(const size_t& source,
+      const W& delta, const size_t& threads)
+   {
+      test_source(source);
+      
+      if (!(W() < delta))
+      {
+         throw std::invalid_argument("Invalid bucket width in delta-stepping: "
+            + boost::lexical_cast<std::string>(delta));
+      }
+      
+      size_t count = threads;
+      if (count == 0) count = std::thread::hardware_concurrency();
+      if (count == 0) count = 1;
+      updates_.resize(count);
+      
+      for (auto& distance : tentative_)
+         distance.store(infinity(), std::memory_order_relaxed);
+      
+      tentative_[source].store(W(), std::memory_order_relaxed);
+      Buckets buckets;
+      buckets[0].push_back(source);
+      queued_[source] = 0;
+      std::vector<size_t> settled;
+      
+      while (!buckets.empty())
+      {
+         const size_t current = buckets.begin() -> first;
+         settled.clear();
+         
+         // Relaxes the light directed edges until the bucket stays empty.
+         for (auto bucket = buckets.begin(); bucket != buckets.end()
+            && bucket -> first == current; bucket = buckets.begin())
+         {
+            std::vector<size_t> frontier = std::move(bucket -> second);
+            buckets.erase(bucket);
+            
+            // Keeps the nodes that have not moved to a lower bucket since.
+            size_t kept = 0;
+            
+            for (const auto& node : frontier)
+            {
+               if (queued_[node] != current) continue;
+               queued_[node] = none;
+               frontier[kept++] = node;
+               
+               if (settled_[node] != current + 1)
+               {
+                  settled_[node] = current + 1;
+                  settled.push_back(node);
+               }
+            }
+            
+            frontier.resize(kept);
+            relax(frontier, delta, true, count);
+            merge(buckets, delta);
+         }
+         
+         // Relaxes the heavy directed edges of the settled nodes once.
+         relax(settled, delta, false, count);
+         merge(buckets, delta);
+      }
+      
+      // Publishes the distances, and resets the marks for the next query.
+      reset(source);
+      touched_.clear();
+      
+      for (size_t i = 0; i < distances_.size(); i++)
+      {
+         distances_[i] = tentative_[i].load(std::memory_order_relaxed);
+         settled_[i] = 0;
+         if (distances_[i] != infinity()) touched_.push_back(i);
+      }
+      
+      return distances_;
+   }
+   
+   /**
+    * Finds the distance of every node from the node at position
+    * <i>source</i> by the search of Dijkstra.
+    *
+    * @param source   the position of the source node
+    *
+    * @return the distance of each node, or <code>infinity()</code> for each
+    * node that cannot be reached from the source node
+    *
+    * @throws std::out_of_range if <i>source</i> is at least the number of nodes
+    */
+   template<typename W>
+   const std::vector<W>& ShortestPaths<W>::dijkstra(const size_t& source)
+   {
+      test_source(source);
+      reset(source);
+      
+      const std::vector<size_t>& offsets = graph_ -> offsets_;
+      const auto& arcs = graph_ -> arcs_;
+      heap_.clear();
+      heap_.push(W(), source);
+      
+      while (!heap_.empty())
+      {
+         const std::pair<W, size_t> entry = heap_.pop();
+         const size_t node = entry.second;
+         
+         // Skips the entries that a shorter path has since replaced.
+         if (distances_[node] < entry.first) continue;
+         
+         for (size_t j = offsets[node]; j < offsets[node + 1]; j++)
+         {
+            const size_t tail = arcs[j].target;
+            const W distance = entry.first + arcs[j].weight;
+            
+            if (distance < distances_[tail])
+            {
+               if (distances_[tail] == infinity()) touched_.push_back(tail);
+               distances_[tail] = distance;
+               heap_.push(distance, tail);
+            }
+         }
+      }
+      
+      return distances_;
+   }
+   
+   /**
+    * Returns the distance of every node from the source node of the last
+    * query.
+    *
+    * @return the distance of each node, or <code>infinity()</code> for each
+    * node that the last query did not reach
+    */
+   template<typename W>
+   inline const std::vector<W>& ShortestPaths<W>::distances() const
+   {
+      return distances_;
+   }
+   
+   /**
+    * Returns the distance of a node that cannot be reached, which is greater
+    * than every other distance.
+    *
+    * @return the infinite distance
+    */
+   template<typename W>
+   inline W ShortestPaths<W>::infinity()
+   {
+      return std::numeric_limits<W>::has_infinity
+         ? std::numeric_limits<W>::infinity() : std::numeric_limits<W>::max();
+   }
+   
+   /**
+    * Queues each node whose tentative distance was lowered in the last phase
+    * in the bucket of its new distance, unless it is already queued there.
+    *
+    * @param buckets   the buckets of the search
+    * @param delta     the width of each bucket
+    */
+   template<typename W>
+   void ShortestPaths<W>::merge(Buckets& buckets, const W& delta)
+   {
+      for (auto& updates : updates_)
+      {
+         for (const auto& node : updates)
+         {
+            const size_t bucket = static_cast<size_t>(
+               tentative_[node].load(std::memory_order_relaxed) / delta);
+            
+            if (queued_[node] != bucket)
+            {
+               queued_[node] = bucket;
+               buckets[bucket].push_back(node);
+            }
+         }
+         
+         updates.clear();
+      }
+   }
+   
+   /**
+    * Relaxes either the light or the heavy directed edges leaving the
+    * specified nodes, on the specified number of threads if there are enough
+    * nodes to share. Each thread records the nodes whose tentative distance it
+    * lowered.
+    *
+    * @param frontier   the nodes whose directed edges are relaxed
+    * @param delta      the width of each bucket
+    * @param light      whether to relax the directed edges no heavier than
+    *                   <i>delta</i>, rather than the heavier ones
+    * @param threads    the number of threads
+    */
+   template<typename W>
+   void ShortestPaths<W>::relax(const std::vector<size_t>& frontier,
+      const W& delta, const bool& light, const size_t& threads)
+   {
+      const std::vector<size_t>& offsets = graph_ -> offsets_;
+      const auto& arcs = graph_ -> arcs_;
+      
+      auto work = [&](const size_t& id, const size_t& first, const size_t& last)
+      {
+         for (size_t i = first; i < last; i++)
+         {
+            const size_t node = frontier[i];
+            const W base = tentative_[node].load(std::memory_order_relaxed);
+            
+            for (size_t j = offsets[node]; j < offsets[node + 1]; j++)
+            {
+               if ((arcs[j].weight <= delta) != light) continue;
+               
+               const W distance = base + arcs[j].weight;
+               std::atomic<W>& target = tentative_[arcs[j].target];
+               W current = target.load(std::memory_order_relaxed);
+               
+               // Lowers the tentative distance unless another thread did.
+               while (distance < current)
+               {
+                  if (target.compare_exchange_weak(current, distance,
+                     std::memory_order_relaxed))
+                  {
+                     updates_[id].push_back(arcs[j].target);
+                     break;
+                  }
+               }
+            }
+         }
+      };
+      
+      if (threads == 1 || frontier.size() < parallel_threshold)
+      {
+         work(0, 0, frontier.size());
+         return;
+      }
+      
+      std::vector<std::thread> workers;
+      const size_t share = (frontier.size() + threads - 1) / threads;
+      
+      for (size_t i = 1; i < threads; i++)
+      {
+         const size_t first = std::min(i * share, frontier.size());
+         const size_t last = std::min(first + share, frontier.size());
+         workers.push_back(std::thread(work, i, first, last));
+      }
+      
+      work(0, 0, std::min(share, frontier.size()));
+      for (auto& worker : workers) worker.join();
+   }
+   
+   /**
+    * Resets the distances of the nodes that the last query reached, and
+    * starts a new query from the specified source node.
+    *
+    * @param source   the position of the source node
+    */
+   template<typename W>
+   void ShortestPaths<W>::reset(const size_t& source)
+   {
+      for (const auto& node : touched_) distances_[node] = infinity();
+      touched_.clear();
+      
+      distances_[source] = W();
+      touched_.push_back(source);
+   }
+   
+   /**
+    * Tests if <i>source</i> is a valid node position in the weighted
+    * adjacency.
+    *
+    * @param source   the position of the source node
+    *
+    * @throws std::out_of_range if <i>source</i> is at least the number of nodes
+    */
+   template<typename W>
+   inline void ShortestPaths<W>::test_source(const size_t& source) const
+   {
+      if (source >= graph_ -> size())
+         throw_index_error("Invalid source node index in directed graph: ",
+            source);
+   }
+   
+   /** Removes every entry from this binary heap. */
+   template<typename W>
+   inline void ShortestPaths<W>::BinaryHeap::clear()
+   {
+      entries_.clear();
+   }
+   
+   /**
+    * Removes the entry with the least distance from this binary heap.
+    *
+    * @return the distance and the node of the removed entry
+    */
+   template<typename W>
+   inline std::pair<W, size_t> ShortestPaths<W>::BinaryHeap::pop()
+   {
+      std::pop_heap(entries_.begin(), entries_.end(),
+         std::greater<std::pair<W, size_t>>());
+      
+      const std::pair<W, size_t> result = entries_.back();
+      entries_.pop_back();
+      return result;
+   }
+   
+   /**
+    * Adds an entry with the specified distance and node to this binary heap.
+    *
+    * @param key    the distance
+    * @param node   the position of the node
+    */
+   template<typename W>
+   inline void ShortestPaths<W>::BinaryHeap::push(const W& key,
+      const size_t& node)
+   {
+      entries_.push_back(std::make_pair(key, node));
+      std::push_heap(entries_.begin(), entries_.end(),
+         std::greater<std::pair<W, size_t>>());
+   }
+   
+   /**
+    * Tests if this binary heap is empty.
+    *
+    * @return <code>true</code> if this binary heap has no entries, or
+    * <code>false</code> otherwise
+    */
+   template<typename W>
+   inline bool ShortestPaths<W>::BinaryHeap::empty() const
+   {
+      return entries_.empty();
+   }
+   
+   /** Constructs an empty radix heap. */
+   template<typename W>
+   inline ShortestPaths<W>::RadixHeap::RadixHeap()
+      : buckets_(std::numeric_limits<Key>::digits + 1), last_(0), size_(0) {}
+   
+   /** Removes every entry from this radix heap. */
+   template<typename W>
+   inline void ShortestPaths<W>::RadixHeap::clear()
+   {
+      for (auto& bucket : buckets_) bucket.clear();
+      last_ = 0;
+      size_ = 0;
+   }
+   
+   /**
+    * Removes the entry with the least distance from this radix heap. If the
+    * first bucket is empty, the least entry of the next nonempty bucket
+    * becomes the last extracted distance, and that bucket is split up.
+    *
+    * @return the distance and the node of the removed entry
+    */
+   template<typename W>
+   std::pair<W, size_t> ShortestPaths<W>::RadixHeap::pop()
+   {
+      if (buckets_[0].empty())
+      {
+         size_t i = 1;
+         while (buckets_[i].empty()) i++;
+         
+         std::vector<std::pair<Key, size_t>>& split = buckets_[i];
+         last_ = std::min_element(split.begin(), split.end()) -> first;
+         for (const auto& entry : split)
+            buckets_[bucket(entry.first)].push_back(entry);
+         
+         split.clear();
+      }
+      
+      const std::pair<Key, size_t> result = buckets_[0].back();
+      buckets_[0].pop_back();
+      size_--;
+      
+      return std::make_pair(static_cast<W>(result.first), result.second);
+   }
+   
+   /**
+    * Adds an entry with the specified distance and node to this radix heap.
+    * The distance must not be less than the last extracted distance.
+    *
+    * @param key    the distance
+    * @param node   the position of the node
+    */
+   template<typename W>
+   inline void ShortestPaths<W>::RadixHeap::push(const W& key,
+      const size_t& node)
+   {
+      const Key value = static_cast<Key>(key);
+      buckets_[bucket(value)].push_back(std::make_pair(value, node));
+      size_++;
+   }
+   
+   /**
+    * Tests if this radix heap is empty.
+    *
+    * @return <code>true</code> if this radix heap has no entries, or
+    * <code>false</code> otherwise
+    */
+   template<typename W>
+   inline bool ShortestPaths<W>::RadixHeap::empty() const
+   {
+      return size_ == 0;
+   }
+   
+   /**
+    * Returns the bucket of the specified distance, which is the number of bits
+    * up to and including the highest bit in which it differs from the last
+    * extracted distance.
+    *
+    * @param key   the distance
+    *
+    * @return the bucket of the distance
+    */
+   template<typename W>
+   inline size_t ShortestPaths<W>::RadixHeap::bucket(const Key& key) const
+   {
+      Key difference = key ^ last_;
+      size_t result = 0;
+      
+      for (size_t shift = std::numeric_limits<Key>::digits / 2; shift > 0;
+         shift /= 2)
+      {
+         if (difference >> shift)
+         {
+            difference >>= shift;
+            result += shift;
+         }
+      }
+      
+      return result + static_cast<size_t>(difference);
+   }
+}
+
+#endif   // PIC_10C_SHORTEST_PATHS_H_
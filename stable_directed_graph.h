@@ -0,0 +1,1345 @@
+/**
+ * Declarations and definitions of the <code>DirectedGraph</code> class for the
+ * <code>StableStorage</code> storage policy, and <code>operator<<</code> for
+ * that class.
+ *
+ * @file stable_directed_graph.h
+ *
+ * @author Kris Torres
+ *
+ * @date 2026-10-14
+ *
+ * @version 1.0
+ */
+
+#ifndef PIC_10C_STABLE_DIRECTED_GRAPH_H_
+#define PIC_10C_STABLE_DIRECTED_GRAPH_H_
+
+#include <string>
+#include <vector>
+#include <stdexcept>
+#include <algorithm>
+#include <memory>
+#include <new>
+#include <utility>
+#include <ostream>
+#include <type_traits>
+#include "adjacency.h"
+#include "directed_graph.h"
+#include "index_error.h"
+
+namespace Kris_Torres_UCLA_PIC_10C_Winter_2014
+{
+   /**
+    * A directed graph whose nodes are named by <b>handles</b> instead of
+    * positions. Erasing a node leaves a tombstone in its slot, and the slot
+    * is put on a free list for the next node to be inserted, so no other node
+    * is moved and every other handle stays valid. A handle to an erased node
+    * is always detected, since each slot counts the nodes that were erased
+    * from it.<p>
+    *
+    * Erasing a node takes linear time in its degree. The links to the node
+    * that its neighbors hold are not searched for; they are skipped as stale
+    * wherever they are read, and each vector of links is purged once more
+    * than half of it is stale. <code>compact</code> moves the nodes down over
+    * the tombstones and drops every stale link, after which the node in slot
+    * <i>k</i> is node <i>k</i> of <code>adjacency</code>; it returns the new
+    * handle of each node, by its former slot.
+    *
+    * @param T   the type of the elements
+    * @param A   the allocator type
+    *
+    * @author Kris Torres
+    */
+   template<typename T, typename A>
+   class DirectedGraph<T, StableStorage, A>
+   {
+   public:
+      
+      // Class
+      class Handle;
+      
+      // Type
+      typedef A allocator_type;
+      
+      // Constructors
+      DirectedGraph();
+      explicit DirectedGraph(const A& alloc);
+      DirectedGraph(const DirectedGraph& rhs);
+      DirectedGraph(const DirectedGraph& rhs, const A& alloc);
+      DirectedGraph(DirectedGraph&& rhs) noexcept;
+      
+      // Assignment operators
+      DirectedGraph& operator=(const DirectedGraph& rhs);
+      DirectedGraph& operator=(DirectedGraph&& rhs)
+         noexcept(std::allocator_traits<A>
+            ::propagate_on_container_move_assignment::value);
+      
+      // Destructor
+      virtual ~DirectedGraph();
+      
+      // Mutators
+      T& at(const Handle& h);
+      void clear();
+      std::vector<Handle> compact();
+      void connect(const Handle& from, const Handle& to);
+      void disconnect(const Handle& h);
+      void disconnect(const Handle& from, const Handle& to);
+      template<typename... Args>
+      Handle emplace(Args&&... args);
+      void erase(const Handle& h);
+      Handle insert(const T& val);
+      Handle insert(T&& val);
+      T& operator[](const Handle& h);
+      void reserve(const size_t& nodes);
+      void swap(DirectedGraph& rhs) noexcept;
+      
+      // Accessors
+      Adjacency adjacency() const;
+      T at(const Handle& h) const;
+      bool contains(const Handle& h) const;
+      bool empty() const;
+      A get_allocator() const;
+      Handle handle(const size_t& k) const;
+      bool has_edge(const Handle& from, const Handle& to) const;
+      size_t indegree(const Handle& h) const;
+      std::vector<Handle> next(const Handle& h) const;
+      T operator[](const Handle& h) const;
+      size_t outdegree(const Handle& h) const;
+      std::vector<Handle> prev(const Handle& h) const;
+      size_t size() const;
+      size_t slots() const;
+      
+      // Friend
+      template<typename U, typename V>
+      friend std::ostream& operator<<(std::ostream& out,
+         const DirectedGraph<U, StableStorage, V>& rhs);
+      
+   private:
+      
+      // Class
+      class Node;
+      
+      // Types
+      template<typename U>
+      using Allocator =
+         typename std::allocator_traits<A>::template rebind_alloc<U>;
+      typedef std::vector<Handle, Allocator<Handle>> Links;
+      typedef std::vector<Node, Allocator<Node>> Nodes;
+      typedef std::vector<size_t, Allocator<size_t>> Indices;
+      
+      // Mutators
+      void copy_nodes(const DirectedGraph& rhs);
+      void purge(Links& links, const size_t& count);
+      void rename(Links& links, const Indices& position,
+         const size_t& generation);
+      
+      // Accessors
+      bool live(const Handle& link) const;
+      void test_handle(const Handle& h, const char* error) const;
+      
+      /** The slots of the nodes in this directed graph, tombstones included. */
+      Nodes slots_;
+      
+      /** The tombstones, with the one to be reused first at the back. */
+      Indices free_;
+      
+      /** The number of nodes in this directed graph. */
+      size_t size_;
+      
+      /**
+       * The generation of each new slot, which is greater than that of any
+       * handle to a slot that was removed by <code>clear</code> or
+       * <code>compact</code>.
+       */
+      size_t generation_;
+   };
+   
+   /**
+    * A <b>handle</b> names a node of a directed graph for as long as the node
+    * is in the directed graph, no matter which other nodes are inserted or
+    * erased. A handle is invalidated when its node is erased, and every
+    * handle is invalidated by <code>compact</code>, which returns the new
+    * handle of each node by the index of its former handle.
+    */
+   template<typename T, typename A>
+   class DirectedGraph<T, StableStorage, A>::Handle final
+   {
+   public:
+      
+      // Constructor
+      Handle();
+      
+      // Accessor
+      size_t index() const;
+      
+      // Relational operators
+      bool operator==(const Handle& rhs) const;
+      bool operator!=(const Handle& rhs) const;
+      
+      // Friend
+      friend class DirectedGraph<T, StableStorage, A>;
+      
+   private:
+      
+      // Constructor
+      Handle(const size_t& index, const size_t& generation);
+      
+      /** The slot of the node. */
+      size_t index_;
+      
+      /** The number of nodes that were erased from the slot before the node. */
+      size_t generation_;
+   };
+   
+   /**
+    * A <b>node</b> is a slot of a directed graph. A slot either holds the value
+    * of a node or is a tombstone, and keeps its vectors of links either way so
+    * that their memory is reused.
+    */
+   template<typename T, typename A>
+   class DirectedGraph<T, StableStorage, A>::Node final
+   {
+   public:
+      
+      // Constructors
+      explicit Node(const A& alloc);
+      Node(const Node& rhs) = delete;
+      Node(const Node& rhs, const A& alloc);
+      Node(Node&& rhs) noexcept(std::is_nothrow_move_constructible<T>::value);
+      
+      // Assignment operator
+      Node& operator=(const Node& rhs) = delete;
+      
+      // Destructor
+      ~Node();
+      
+      // Mutators
+      template<typename... Args>
+      void construct(Args&&... args);
+      T& data();
+      void destroy();
+      
+      // Accessor
+      const T& data() const;
+      
+      // Friends
+      friend class DirectedGraph<T, StableStorage, A>;
+      template<typename U, typename V>
+      friend std::ostream& operator<<(std::ostream& out,
+         const DirectedGraph<U, StableStorage, V>& rhs);
+      
+   private:
+      
+      /** The storage of the value of this node. */
+      typename std::aligned_storage<sizeof(T), alignof(T)>::type storage_;
+      
+      /** Whether this slot holds a value, rather than being a tombstone. */
+      bool live_;
+      
+      /** The number of nodes that were erased from this slot. */
+      size_t generation_;
+      
+      /** The number of links in <code>prev_</code> that are not stale. */
+      size_t indegree_;
+      
+      /** The number of links in <code>next_</code> that are not stale. */
+      size_t outdegree_;
+      
+      /** The links to the tail nodes, some of which may be stale. */
+      Links next_;
+      
+      /** The links to the head nodes, some of which may be stale. */
+      Links prev_;
+   };
+   
+   // Directed graph output operator
+   template<typename T, typename A>
+   std::ostream& operator<<(std::ostream& out,
+      const DirectedGraph<T, StableStorage, A>& rhs);
+   
+   /** Constructs an empty directed graph, with no nodes. */
+   template<typename T, typename A>
+   inline DirectedGraph<T, StableStorage, A>::DirectedGraph()
+      : size_(0), generation_(0) {}
+   
+   /**
+    * Constructs an empty directed graph, with no nodes, that allocates its
+    * memory with the specified allocator.
+    *
+    * @param alloc   the allocator
+    */
+   template<typename T, typename A>
+   inline DirectedGraph<T, StableStorage, A>::DirectedGraph(const A& alloc)
+      : slots_(alloc), free_(alloc), size_(0), generation_(0) {}
+   
+   /**
+    * Constructs a directed graph with a copy of each of the nodes in the
+    * specified directed graph. The handles of the specified directed graph
+    * name the same nodes in the copy.
+    *
+    * @param rhs   the directed graph to be copied
+    */
+   template<typename T, typename A>
+   DirectedGraph<T, StableStorage, A>::DirectedGraph(const DirectedGraph& rhs)
+      : DirectedGraph(rhs, std::allocator_traits<A>
+         ::select_on_container_copy_construction(rhs.get_allocator())) {}
+   
+   /**
+    * Constructs a directed graph with a copy of each of the nodes in the
+    * specified directed graph, allocating its memory with the specified
+    * allocator. The handles of the specified directed graph name the same
+    * nodes in the copy.
+    *
+    * @param rhs     the directed graph to be copied
+    * @param alloc   the allocator
+    */
+   template<typename T, typename A>
+   DirectedGraph<T, StableStorage, A>::DirectedGraph(const DirectedGraph& rhs,
+      const A& alloc)
+      : slots_(alloc), free_(alloc), size_(0), generation_(0)
+   {
+      copy_nodes(rhs);
+   }
+   
+   /**
+    * Constructs a directed graph that acquires the nodes and the directed edges
+    * in the specified directed graph, without allocating. The handles of the
+    * specified directed graph name the same nodes in this directed graph, and
+    * the specified directed graph is left empty.
+    *
+    * @param rhs   the directed graph to be moved
+    */
+   template<typename T, typename A>
+   DirectedGraph<T, StableStorage, A>::DirectedGraph(DirectedGraph&& rhs)
+      noexcept
+      : slots_(std::move(rhs.slots_)), free_(std::move(rhs.free_)),
+        size_(rhs.size_), generation_(rhs.generation_)
+   {
+      rhs.clear();
+   }
+   
+   /**
+    * Copies all the nodes in the specified directed graph into this directed
+    * graph, with the former preserving its contents.
+    *
+    * @param rhs   the directed graph to be copied
+    *
+    * @return this directed graph after the assignment
+    */
+   template<typename T, typename A>
+   DirectedGraph<T, StableStorage, A>& DirectedGraph<T, StableStorage, A>
+      ::operator=(const DirectedGraph& rhs)
+   {
+      // Tests for self-assignment.
+      if (this != &rhs)
+      {
+         clear();
+         copy_nodes(rhs);
+      }
+      
+      return *this;
+   }
+   
+   /**
+    * Moves all the nodes and the directed edges in the specified directed
+    * graph into this directed graph, with the former left empty. Nothing is
+    * allocated unless the allocators of the two directed graphs compare
+    * unequal and do not propagate, in which case the nodes are copied
+    * instead.
+    *
+    * @param rhs   the directed graph to be moved
+    *
+    * @return this directed graph after the assignment
+    */
+   template<typename T, typename A>
+   DirectedGraph<T, StableStorage, A>& DirectedGraph<T, StableStorage, A>
+      ::operator=(DirectedGraph&& rhs)
+      noexcept(std::allocator_traits<A>
+         ::propagate_on_container_move_assignment::value)
+   {
+      typedef typename std::allocator_traits<A>
+         ::propagate_on_container_move_assignment propagate;
+      
+      // Tests for self-assignment.
+      if (this != &rhs)
+      {
+         clear();
+         
+         if (propagate::value || get_allocator() == rhs.get_allocator())
+         {
+            slots_ = std::move(rhs.slots_);
+            free_ = std::move(rhs.free_);
+            size_ = rhs.size_;
+            generation_ = rhs.generation_;
+         }
+         
+         // Copies the nodes into the memory of this directed graph.
+         else *this = rhs;
+         
+         rhs.clear();
+      }
+      
+      return *this;
+   }
+   
+   /** Destroys this directed graph. */
+   template<typename T, typename A>
+   inline DirectedGraph<T, StableStorage, A>::~DirectedGraph() {}
+   
+   /**
+    * Returns a reference to the value of the specified node in this directed
+    * graph.<p>
+    *
+    * The function automatically checks whether the handle names a node in the
+    * directed graph, throwing an <code>std::out_of_range</code> exception if
+    * it does not. This is in contrast with member <code>operator[]</code>,
+    * which does not check the handle.
+    *
+    * @param h   the handle of the node
+    *
+    * @return a reference to the value of the node
+    *
+    * @throws std::out_of_range if the handle is not valid
+    */
+   template<typename T, typename A>
+   T& DirectedGraph<T, StableStorage, A>::at(const Handle& h)
+   {
+      // Tests if h is valid.
+      test_handle(h, "Invalid node handle in directed graph: ");
+      
+      return slots_[h.index_].data();
+   }
+   
+   /**
+    * Removes all the nodes and tombstones in this directed graph. Every handle
+    * is invalidated.
+    */
+   template<typename T, typename A>
+   void DirectedGraph<T, StableStorage, A>::clear()
+   {
+      for (const auto& node : slots_)
+         generation_ = std::max(generation_, node.generation_ + 1);
+      
+      slots_.clear();
+      free_.clear();
+      size_ = 0;
+   }
+   
+   /**
+    * Moves the nodes in this directed graph down over the tombstones, keeping
+    * their order, and drops every stale link, in linear time in the number of
+    * slots and links. Afterwards, the node in slot <i>k</i> is node <i>k</i> of
+    * <code>adjacency</code>, and there are no tombstones left to reuse. Every
+    * handle is invalidated, and the new handle of the node named by a valid
+    * handle <code>h</code> is element <code>h.index()</code> of the returned
+    * vector, with which handles kept outside the directed graph can be
+    * translated. The elements for the tombstones name no node.
+    *
+    * @return the new handle of the node in each former slot
+    */
+   template<typename T, typename A>
+   std::vector<typename DirectedGraph<T, StableStorage, A>::Handle>
+      DirectedGraph<T, StableStorage, A>::compact()
+   {
+      Nodes nodes(get_allocator());
+      nodes.reserve(size_);
+      Indices position(slots_.size(), 0, get_allocator());
+      std::vector<Handle> mapping(slots_.size());
+      
+      // Gives every node a generation that no handle has had in its slot.
+      for (const auto& node : slots_)
+         generation_ = std::max(generation_, node.generation_ + 1);
+      
+      for (size_t i = 0; i < slots_.size(); i++)
+      {
+         if (!slots_[i].live_) continue;
+         
+         position[i] = nodes.size();
+         mapping[i] = Handle(nodes.size(), generation_);
+         nodes.push_back(std::move(slots_[i]));
+         nodes.back().generation_ = generation_;
+      }
+      
+      for (auto& node : nodes)
+      {
+         rename(node.next_, position, generation_);
+         rename(node.prev_, position, generation_);
+      }
+      
+      slots_.swap(nodes);
+      free_.clear();
+      return mapping;
+   }
+   
+   /**
+    * Connects a directed edge from the specified starting node to the specified
+    * ending node in this directed graph.<p>
+    *
+    * The function automatically checks whether <code>from</code> and
+    * <code>to</code> name nodes in the directed graph, throwing an
+    * <code>std::out_of_range</code> exception if either does not.
+    *
+    * @param from   the handle of the starting node
+    * @param to     the handle of the ending node
+    *
+    * @throws std::out_of_range if either <code>from</code> or <code>to</code>
+    * is not valid
+    */
+   template<typename T, typename A>
+   void DirectedGraph<T, StableStorage, A>::connect(const Handle& from,
+      const Handle& to)
+   {
+      // Tests if the starting and ending node handles are valid.
+      test_handle(from, "Invalid starting node handle in directed graph: ");
+      test_handle(to, "Invalid ending node handle in directed graph: ");
+      
+      Node& head = slots_[from.index_];
+      Node& tail = slots_[to.index_];
+      head.next_.push_back(to);
+      tail.prev_.push_back(from);
+      head.outdegree_++;
+      tail.indegree_++;
+   }
+   
+   /**
+    * Disconnects all head nodes and all tail nodes adjacent to the specified
+    * node in this directed graph. Unlike <code>erase</code>, the function
+    * removes the links to the node from each of its neighbors, so it takes
+    * linear time in the total degree of its neighbors.<p>
+    *
+    * The function automatically checks whether the handle names a node in the
+    * directed graph, throwing an <code>std::out_of_range</code> exception if
+    * it does not.
+    *
+    * @param h   the handle of the node
+    *
+    * @throws std::out_of_range if the handle is not valid
+    */
+   template<typename T, typename A>
+   void DirectedGraph<T, StableStorage, A>::disconnect(const Handle& h)
+   {
+      // Tests if h is valid.
+      test_handle(h, "Invalid node handle in directed graph: ");
+      
+      Node& node = slots_[h.index_];
+      
+      // Removes the given node from the adjacent nodes of its neighbors.
+      for (const auto& link : node.next_)
+      {
+         if (link == h || !live(link)) continue;
+         
+         Node& tail = slots_[link.index_];
+         const size_t count = tail.prev_.size();
+         tail.prev_.erase(std::remove(tail.prev_.begin(), tail.prev_.end(), h),
+            tail.prev_.end());
+         tail.indegree_ -= count - tail.prev_.size();
+      }
+      
+      for (const auto& link : node.prev_)
+      {
+         if (link == h || !live(link)) continue;
+         
+         Node& head = slots_[link.index_];
+         const size_t count = head.next_.size();
+         head.next_.erase(std::remove(head.next_.begin(), head.next_.end(), h),
+            head.next_.end());
+         head.outdegree_ -= count - head.next_.size();
+      }
+      
+      node.next_.clear();
+      node.prev_.clear();
+      node.indegree_ = 0;
+      node.outdegree_ = 0;
+   }
+   
+   /**
+    * Disconnects a directed edge from the specified starting node to the
+    * specified ending node in this directed graph.<p>
+    *
+    * The function automatically checks whether <code>from</code> and
+    * <code>to</code> name nodes in the directed graph, throwing an
+    * <code>std::out_of_range</code> exception if either does not.
+    *
+    * @param from   the handle of the starting node
+    * @param to     the handle of the ending node
+    *
+    * @throws std::out_of_range if either <code>from</code> or <code>to</code>
+    * is not valid
+    */
+   template<typename T, typename A>
+   void DirectedGraph<T, StableStorage, A>::disconnect(const Handle& from,
+      const Handle& to)
+   {
+      // Tests if the starting and ending node handles are valid.
+      test_handle(from, "Invalid starting node handle in directed graph: ");
+      test_handle(to, "Invalid ending node handle in directed graph: ");
+      
+      Node& head = slots_[from.index_];
+      Node& tail = slots_[to.index_];
+      
+      // Removes the rightmost occurrence of the given directed edge.
+      auto edge = std::find(head.next_.rbegin(), head.next_.rend(), to);
+      if (edge == head.next_.rend()) return;
+      
+      head.next_.erase(std::next(edge).base());
+      auto reverse = std::find(tail.prev_.rbegin(), tail.prev_.rend(), from);
+      tail.prev_.erase(std::next(reverse).base());
+      head.outdegree_--;
+      tail.indegree_--;
+   }
+   
+   /**
+    * Adds a node to this directed graph, in the most recently vacated
+    * tombstone if there is one, or in a new slot otherwise. The value of the
+    * new node is constructed in place from the specified arguments.
+    *
+    * @param args   the arguments with which to construct the value
+    *
+    * @return the handle of the new node
+    */
+   template<typename T, typename A>
+   template<typename... Args>
+   typename DirectedGraph<T, StableStorage, A>::Handle
+      DirectedGraph<T, StableStorage, A>::emplace(Args&&... args)
+   {
+      size_t k = slots_.size();
+      
+      if (free_.empty())
+      {
+         // Constructs the value before the slots can be reallocated.
+         Node node(get_allocator());
+         node.generation_ = generation_;
+         node.construct(std::forward<Args>(args)...);
+         slots_.push_back(std::move(node));
+      }
+      else
+      {
+         k = free_.back();
+         slots_[k].construct(std::forward<Args>(args)...);
+         free_.pop_back();
+      }
+      
+      size_++;
+      return Handle(k, slots_[k].generation_);
+   }
+   
+   /**
+    * Removes the specified node from this directed graph, in linear time in
+    * its degree. The slot of the node becomes a tombstone, and no other node
+    * is moved, so every other handle stays valid.<p>
+    *
+    * The function automatically checks whether the handle names a node in the
+    * directed graph, throwing an <code>std::out_of_range</code> exception if
+    * it does not.
+    *
+    * @param h   the handle of the node
+    *
+    * @throws std::out_of_range if the handle is not valid
+    */
+   template<typename T, typename A>
+   void DirectedGraph<T, StableStorage, A>::erase(const Handle& h)
+   {
+      // Tests if h is valid.
+      test_handle(h, "Invalid node handle in directed graph: ");
+      
+      free_.push_back(h.index_);
+      
+      // Makes every link to the given node stale, loops included.
+      Node& node = slots_[h.index_];
+      node.destroy();
+      node.generation_++;
+      size_--;
+      
+      for (const auto& link : node.next_)
+      {
+         if (!live(link)) continue;
+         
+         Node& tail = slots_[link.index_];
+         tail.indegree_--;
+         purge(tail.prev_, tail.indegree_);
+      }
+      
+      for (const auto& link : node.prev_)
+      {
+         if (!live(link)) continue;
+         
+         Node& head = slots_[link.index_];
+         head.outdegree_--;
+         purge(head.next_, head.outdegree_);
+      }
+      
+      node.next_.clear();
+      node.prev_.clear();
+      node.indegree_ = 0;
+      node.outdegree_ = 0;
+   }
+   
+   /**
+    * Adds a node with the specified value to this directed graph.
+    *
+    * @param val   the value of the new node
+    *
+    * @return the handle of the new node
+    */
+   template<typename T, typename A>
+   inline typename DirectedGraph<T, StableStorage, A>::Handle
+      DirectedGraph<T, StableStorage, A>::insert(const T& val)
+   {
+      return emplace(val);
+   }
+   
+   /**
+    * Adds a node with the specified value to this directed graph. The value
+    * is moved into the new node.
+    *
+    * @param val   the value of the new node
+    *
+    * @return the handle of the new node
+    */
+   template<typename T, typename A>
+   inline typename DirectedGraph<T, StableStorage, A>::Handle
+      DirectedGraph<T, StableStorage, A>::insert(T&& val)
+   {
+      return emplace(std::move(val));
+   }
+   
+   /**
+    * Returns a reference to the value of the specified node in this directed
+    * graph. The handle is not checked.
+    *
+    * @param h   the handle of the node
+    *
+    * @return a reference to the value of the node
+    */
+   template<typename T, typename A>
+   inline T& DirectedGraph<T, StableStorage, A>::operator[](const Handle& h)
+   {
+      return slots_[h.index_].data();
+   }
+   
+   /**
+    * Reserves memory for at least the specified number of slots, so that
+    * inserting and erasing up to that many nodes does not reallocate the
+    * vector of slots or the free list.
+    *
+    * @param nodes   the number of slots
+    */
+   template<typename T, typename A>
+   void DirectedGraph<T, StableStorage, A>::reserve(const size_t& nodes)
+   {
+      slots_.reserve(nodes);
+      free_.reserve(nodes);
+   }
+   
+   /**
+    * Exchanges the content of this directed graph with the content of the
+    * specified directed graph. No node or directed edge is copied or
+    * allocated, and every handle names the same node as before. As with the
+    * standard containers, the allocators of the two directed graphs must
+    * compare equal unless they propagate on swap.
+    *
+    * @param rhs   the directed graph to be swapped
+    */
+   template<typename T, typename A>
+   void DirectedGraph<T, StableStorage, A>::swap(DirectedGraph& rhs) noexcept
+   {
+      slots_.swap(rhs.slots_);
+      free_.swap(rhs.free_);
+      std::swap(size_, rhs.size_);
+      std::swap(generation_, rhs.generation_);
+   }
+   
+   /**
+    * Returns a snapshot of the directed edges in this directed graph, with the
+    * nodes numbered in the order of their slots and the tail nodes of each
+    * node in the order in which they were connected. The snapshot is not
+    * updated when this directed graph is modified.
+    *
+    * @return the adjacency of this directed graph
+    */
+   template<typename T, typename A>
+   Adjacency DirectedGraph<T, StableStorage, A>::adjacency() const
+   {
+      Indices position(slots_.size(), 0, get_allocator());
+      
+      for (size_t i = 0, count = 0; i < slots_.size(); i++)
+         if (slots_[i].live_) position[i] = count++;
+      
+      std::vector<std::pair<size_t, size_t>> edges;
+      
+      for (size_t i = 0; i < slots_.size(); i++)
+      {
+         if (!slots_[i].live_) continue;
+         
+         for (const auto& link : slots_[i].next_)
+         {
+            if (!live(link)) continue;
+            
+            const size_t tail = position[link.index_];
+            edges.push_back(std::make_pair(position[i], tail));
+         }
+      }
+      
+      return Adjacency(size_, edges);
+   }
+   
+   /**
+    * Returns the value of the specified node in this directed graph.<p>
+    *
+    * The function automatically checks whether the handle names a node in the
+    * directed graph, throwing an <code>std::out_of_range</code> exception if
+    * it does not. This is in contrast with member <code>operator[]</code>,
+    * which does not check the handle.
+    *
+    * @param h   the handle of the node
+    *
+    * @return the value of the node
+    *
+    * @throws std::out_of_range if the handle is not valid
+    */
+   template<typename T, typename A>
+   T DirectedGraph<T, StableStorage, A>::at(const Handle& h) const
+   {
+      // Tests if h is valid.
+      test_handle(h, "Invalid node handle in directed graph: ");
+      
+      return slots_[h.index_].data();
+   }
+   
+   /**
+    * Tests if the specified handle names a node in this directed graph (i.e.,
+    * if its node has not been erased, and <code>compact</code> has not been
+    * called since the handle was returned).
+    *
+    * @param h   the handle
+    *
+    * @return <code>true</code> if the handle is valid, or <code>false</code>
+    * otherwise
+    */
+   template<typename T, typename A>
+   inline bool DirectedGraph<T, StableStorage, A>::contains(const Handle& h)
+      const
+   {
+      return h.index_ < slots_.size() && live(h);
+   }
+   
+   /**
+    * Tests if this directed graph is empty (i.e., if the directed graph
+    * contains no nodes). Tombstones are not counted.
+    *
+    * @return <code>true</code> if this directed graph is empty, or
+    * <code>false</code> otherwise
+    */
+   template<typename T, typename A>
+   inline bool DirectedGraph<T, StableStorage, A>::empty() const
+   {
+      return size_ == 0;
+   }
+   
+   /**
+    * Returns the allocator with which this directed graph allocates its
+    * memory.
+    *
+    * @return the allocator of this directed graph
+    */
+   template<typename T, typename A>
+   inline A DirectedGraph<T, StableStorage, A>::get_allocator() const
+   {
+      return A(slots_.get_allocator());
+   }
+   
+   /**
+    * Returns the handle of the node in slot <i>k</i> of this directed graph.
+    * After <code>compact</code>, this is the handle of node <i>k</i>.<p>
+    *
+    * The function automatically checks whether slot <i>k</i> holds a node,
+    * throwing an <code>std::out_of_range</code> exception if it does not.
+    *
+    * @param k   the slot of the node
+    *
+    * @return the handle of the node
+    *
+    * @throws std::out_of_range if slot <i>k</i> does not exist or is a
+    * tombstone
+    */
+   template<typename T, typename A>
+   typename DirectedGraph<T, StableStorage, A>::Handle
+      DirectedGraph<T, StableStorage, A>::handle(const size_t& k) const
+   {
+      // Tests if k is valid.
+      if (k >= slots_.size() || !slots_[k].live_)
+         throw_index_error("Invalid node index in directed graph: ", k);
+      
+      return Handle(k, slots_[k].generation_);
+   }
+   
+   /**
+    * Tests if this directed graph has a directed edge from the specified
+    * starting node to the specified ending node. The function scans the
+    * shorter of the two vectors of links.<p>
+    *
+    * The function automatically checks whether <code>from</code> and
+    * <code>to</code> name nodes in the directed graph, throwing an
+    * <code>std::out_of_range</code> exception if either does not.
+    *
+    * @param from   the handle of the starting node
+    * @param to     the handle of the ending node
+    *
+    * @return <code>true</code> if the directed edge exists, or
+    * <code>false</code> otherwise
+    *
+    * @throws std::out_of_range if either <code>from</code> or <code>to</code>
+    * is not valid
+    */
+   template<typename T, typename A>
+   bool DirectedGraph<T, StableStorage, A>::has_edge(const Handle& from,
+      const Handle& to) const
+   {
+      // Tests if the starting and ending node handles are valid.
+      test_handle(from, "Invalid starting node handle in directed graph: ");
+      test_handle(to, "Invalid ending node handle in directed graph: ");
+      
+      const Links& edge = slots_[from.index_].next_;
+      const Links& reverse = slots_[to.index_].prev_;
+      
+      if (edge.size() <= reverse.size())
+         return std::find(edge.begin(), edge.end(), to) != edge.end();
+      
+      return std::find(reverse.begin(), reverse.end(), from) != reverse.end();
+   }
+   
+   /**
+    * Returns the <b>indegree</b> of the specified node in this directed graph
+    * (i.e., the number of head nodes adjacent to the node).<p>
+    *
+    * The function automatically checks whether the handle names a node in the
+    * directed graph, throwing an <code>std::out_of_range</code> exception if
+    * it does not.
+    *
+    * @param h   the handle of the node
+    *
+    * @return the indegree of the node
+    *
+    * @throws std::out_of_range if the handle is not valid
+    */
+   template<typename T, typename A>
+   size_t DirectedGraph<T, StableStorage, A>::indegree(const Handle& h) const
+   {
+      // Tests if h is valid.
+      test_handle(h, "Invalid node handle in directed graph: ");
+      
+      return slots_[h.index_].indegree_;
+   }
+   
+   /**
+    * Returns the handles of the tail nodes adjacent to the specified node in
+    * this directed graph, in the order in which they were connected.<p>
+    *
+    * The function automatically checks whether the handle names a node in the
+    * directed graph, throwing an <code>std::out_of_range</code> exception if
+    * it does not.
+    *
+    * @param h   the handle of the node
+    *
+    * @return the handles of the tail nodes
+    *
+    * @throws std::out_of_range if the handle is not valid
+    */
+   template<typename T, typename A>
+   std::vector<typename DirectedGraph<T, StableStorage, A>::Handle>
+      DirectedGraph<T, StableStorage, A>::next(const Handle& h) const
+   {
+      // Tests if h is valid.
+      test_handle(h, "Invalid node handle in directed graph: ");
+      
+      std::vector<Handle> result;
+      result.reserve(slots_[h.index_].outdegree_);
+      
+      for (const auto& link : slots_[h.index_].next_)
+         if (live(link)) result.push_back(link);
+      
+      return result;
+   }
+   
+   /**
+    * Returns the value of the specified node in this directed graph. The
+    * handle is not checked.
+    *
+    * @param h   the handle of the node
+    *
+    * @return the value of the node
+    */
+   template<typename T, typename A>
+   inline T DirectedGraph<T, StableStorage, A>::operator[](const Handle& h)
+      const
+   {
+      return slots_[h.index_].data();
+   }
+   
+   /**
+    * Returns the <b>outdegree</b> of the specified node in this directed graph
+    * (i.e., the number of tail nodes adjacent to the node).<p>
+    *
+    * The function automatically checks whether the handle names a node in the
+    * directed graph, throwing an <code>std::out_of_range</code> exception if
+    * it does not.
+    *
+    * @param h   the handle of the node
+    *
+    * @return the outdegree of the node
+    *
+    * @throws std::out_of_range if the handle is not valid
+    */
+   template<typename T, typename A>
+   size_t DirectedGraph<T, StableStorage, A>::outdegree(const Handle& h) const
+   {
+      // Tests if h is valid.
+      test_handle(h, "Invalid node handle in directed graph: ");
+      
+      return slots_[h.index_].outdegree_;
+   }
+   
+   /**
+    * Returns the handles of the head nodes adjacent to the specified node in
+    * this directed graph, in the order in which they were connected.<p>
+    *
+    * The function automatically checks whether the handle names a node in the
+    * directed graph, throwing an <code>std::out_of_range</code> exception if
+    * it does not.
+    *
+    * @param h   the handle of the node
+    *
+    * @return the handles of the head nodes
+    *
+    * @throws std::out_of_range if the handle is not valid
+    */
+   template<typename T, typename A>
+   std::vector<typename DirectedGraph<T, StableStorage, A>::Handle>
+      DirectedGraph<T, StableStorage, A>::prev(const Handle& h) const
+   {
+      // Tests if h is valid.
+      test_handle(h, "Invalid node handle in directed graph: ");
+      
+      std::vector<Handle> result;
+      result.reserve(slots_[h.index_].indegree_);
+      
+      for (const auto& link : slots_[h.index_].prev_)
+         if (live(link)) result.push_back(link);
+      
+      return result;
+   }
+   
+   /**
+    * Returns the number of nodes in this directed graph. Tombstones are not
+    * counted.
+    *
+    * @return the number of nodes
+    */
+   template<typename T, typename A>
+   inline size_t DirectedGraph<T, StableStorage, A>::size() const
+   {
+      return size_;
+   }
+   
+   /**
+    * Returns the number of slots in this directed graph, which is the number
+    * of nodes plus the number of tombstones.
+    *
+    * @return the number of slots
+    */
+   template<typename T, typename A>
+   inline size_t DirectedGraph<T, StableStorage, A>::slots() const
+   {
+      return slots_.size();
+   }
+   
+   /**
+    * Copies the slots and the free list of the specified directed graph into
+    * this empty directed graph, so that every handle names the same node in
+    * both.
+    *
+    * @param rhs   the directed graph to be copied
+    */
+   template<typename T, typename A>
+   void DirectedGraph<T, StableStorage, A>::copy_nodes(const DirectedGraph& rhs)
+   {
+      slots_.reserve(rhs.slots_.size());
+      for (const auto& node : rhs.slots_)
+         slots_.emplace_back(node, get_allocator());
+      
+      free_.assign(rhs.free_.begin(), rhs.free_.end());
+      size_ = rhs.size_;
+      generation_ = std::max(generation_, rhs.generation_);
+   }
+   
+   /**
+    * Removes the stale links from the specified vector of links if more than
+    * half of them are stale. Each purge removes at least as many links as it
+    * keeps, so purging takes constant amortized time for each stale link.
+    *
+    * @param links   the vector of links
+    * @param count   the number of links that are not stale
+    */
+   template<typename T, typename A>
+   void DirectedGraph<T, StableStorage, A>::purge(Links& links,
+      const size_t& count)
+   {
+      if (links.size() <= 2 * count) return;
+      
+      auto stale = [this](const Handle& link) { return !live(link); };
+      links.erase(std::remove_if(links.begin(), links.end(), stale),
+         links.end());
+   }
+   
+   /**
+    * Renames the links in the specified vector of links that are not stale
+    * after the nodes have been moved to the specified positions with the
+    * specified generation, and drops the others.
+    *
+    * @param links        the vector of links
+    * @param position     the new position of the node in each slot
+    * @param generation   the new generation of every node
+    */
+   template<typename T, typename A>
+   void DirectedGraph<T, StableStorage, A>::rename(Links& links,
+      const Indices& position, const size_t& generation)
+   {
+      size_t count = 0;
+      
+      for (size_t i = 0; i < links.size(); i++)
+      {
+         if (live(links[i]))
+            links[count++] = Handle(position[links[i].index_], generation);
+      }
+      
+      links.resize(count);
+   }
+   
+   /**
+    * Tests if the specified link, or handle whose slot exists, names a node
+    * in this directed graph.
+    *
+    * @param link   the link
+    *
+    * @return <code>true</code> if the link is not stale, or <code>false</code>
+    * otherwise
+    */
+   template<typename T, typename A>
+   inline bool DirectedGraph<T, StableStorage, A>::live(const Handle& link)
+      const
+   {
+      const Node& node = slots_[link.index_];
+      return node.live_ && node.generation_ == link.generation_;
+   }
+   
+   /**
+    * Tests if the specified handle names a node in this directed graph,
+    * throwing an <code>std::out_of_range</code> exception if it does not.
+    *
+    * @param h       the handle of the node
+    * @param error   the error message
+    *
+    * @throws std::out_of_range if the handle is not valid
+    */
+   template<typename T, typename A>
+   void DirectedGraph<T, StableStorage, A>::test_handle(const Handle& h,
+      const char* error) const
+   {
+      if (!contains(h)) throw_index_error(error, h.index_);
+   }
+   
+   /** Constructs a handle that does not name any node. */
+   template<typename T, typename A>
+   inline DirectedGraph<T, StableStorage, A>::Handle::Handle()
+      : index_(static_cast<size_t>(-1)), generation_(0) {}
+   
+   /**
+    * Constructs a handle of the node in the specified slot.
+    *
+    * @param index        the slot of the node
+    * @param generation   the number of nodes erased from the slot before it
+    */
+   template<typename T, typename A>
+   inline DirectedGraph<T, StableStorage, A>::Handle::Handle(
+      const size_t& index, const size_t& generation)
+      : index_(index), generation_(generation) {}
+   
+   /**
+    * Returns the slot of the node named by this handle.
+    *
+    * @return the slot of the node
+    */
+   template<typename T, typename A>
+   inline size_t DirectedGraph<T, StableStorage, A>::Handle::index() const
+   {
+      return index_;
+   }
+   
+   /**
+    * Tests if this handle and the specified handle name the same node.
+    *
+    * @param rhs   the handle to compare with this handle
+    *
+    * @return <code>true</code> if the two handles are equal, or
+    * <code>false</code> otherwise
+    */
+   template<typename T, typename A>
+   inline bool DirectedGraph<T, StableStorage, A>::Handle
+      ::operator==(const Handle& rhs) const
+   {
+      return index_ == rhs.index_ && generation_ == rhs.generation_;
+   }
+   
+   /**
+    * Tests if this handle and the specified handle name different nodes.
+    *
+    * @param rhs   the handle to compare with this handle
+    *
+    * @return <code>true</code> if the two handles are unequal, or
+    * <code>false</code> otherwise
+    */
+   template<typename T, typename A>
+   inline bool DirectedGraph<T, StableStorage, A>::Handle
+      ::operator!=(const Handle& rhs) const
+   {
+      return !(*this == rhs);
+   }
+   
+   /**
+    * Constructs a tombstone whose vectors of links allocate their memory with
+    * the specified allocator.
+    *
+    * @param alloc   the allocator
+    */
+   template<typename T, typename A>
+   inline DirectedGraph<T, StableStorage, A>::Node::Node(const A& alloc)
+      : live_(false), generation_(0), indegree_(0), outdegree_(0),
+        next_(alloc), prev_(alloc) {}
+   
+   /**
+    * Constructs a copy of the specified slot whose vectors of links allocate
+    * their memory with the specified allocator.
+    *
+    * @param rhs     the slot to be copied
+    * @param alloc   the allocator
+    */
+   template<typename T, typename A>
+   DirectedGraph<T, StableStorage, A>::Node::Node(const Node& rhs,
+      const A& alloc)
+      : live_(false), generation_(rhs.generation_), indegree_(rhs.indegree_),
+        outdegree_(rhs.outdegree_), next_(rhs.next_, alloc),
+        prev_(rhs.prev_, alloc)
+   {
+      if (rhs.live_) construct(rhs.data());
+   }
+   
+   /**
+    * Constructs a slot that acquires the vectors of links of the specified
+    * slot, and into which its value is moved.
+    *
+    * @param rhs   the slot to be moved
+    */
+   template<typename T, typename A>
+   DirectedGraph<T, StableStorage, A>::Node::Node(Node&& rhs)
+      noexcept(std::is_nothrow_move_constructible<T>::value)
+      : live_(false), generation_(rhs.generation_), indegree_(rhs.indegree_),
+        outdegree_(rhs.outdegree_), next_(std::move(rhs.next_)),
+        prev_(std::move(rhs.prev_))
+   {
+      if (rhs.live_) construct(std::move(rhs.data()));
+   }
+   
+   /** Destroys this slot, and its value if it holds one. */
+   template<typename T, typename A>
+   inline DirectedGraph<T, StableStorage, A>::Node::~Node()
+   {
+      if (live_) destroy();
+   }
+   
+   /**
+    * Constructs the value of this tombstone in place from the specified
+    * arguments, so that the slot holds a node.
+    *
+    * @param args   the arguments with which to construct the value
+    */
+   template<typename T, typename A>
+   template<typename... Args>
+   inline void DirectedGraph<T, StableStorage, A>::Node::construct(
+      Args&&... args)
+   {
+      ::new (static_cast<void*>(&storage_)) T(std::forward<Args>(args)...);
+      live_ = true;
+   }
+   
+   /**
+    * Returns a reference to the value of this node.
+    *
+    * @return a reference to the value
+    */
+   template<typename T, typename A>
+   inline T& DirectedGraph<T, StableStorage, A>::Node::data()
+   {
+      return *reinterpret_cast<T*>(&storage_);
+   }
+   
+   /** Destroys the value of this node, so that the slot is a tombstone. */
+   template<typename T, typename A>
+   inline void DirectedGraph<T, StableStorage, A>::Node::destroy()
+   {
+      data().~T();
+      live_ = false;
+   }
+   
+   /**
+    * Returns the value of this node.
+    *
+    * @return the value
+    */
+   template<typename T, typename A>
+   inline const T& DirectedGraph<T, StableStorage, A>::Node::data() const
+   {
+      return *reinterpret_cast<const T*>(&storage_);
+   }
+   
+   /**
+    * Outputs the specified directed graph with the specified output stream,
+    * in the order of the slots. The output stream is not flushed;
+    * <code>GraphWriter</code> writes large directed graphs faster.
+    *
+    * @param out   the output stream
+    * @param rhs   the directed graph to be outputted
+    *
+    * @return the stream after the output
+    */
+   template<typename T, typename A>
+   std::ostream& operator<<(std::ostream& out,
+      const DirectedGraph<T, StableStorage, A>& rhs)
+   {
+      for (const auto& node : rhs.slots_)
+      {
+         if (!node.live_) continue;
+         
+         // Outputs the current node by itself if it is disconnected.
+         if (node.indegree_ == 0 && node.outdegree_ == 0)
+            out << node.data() << '\n';
+         
+         // Outputs the starting and ending nodes for each directed edge.
+         else
+         {
+            for (const auto& link : node.next_)
+            {
+               if (rhs.live(link))
+               {
+                  out << node.data() << " -> "
+                     << rhs.slots_[link.index()].data() << '\n';
+               }
+            }
+         }
+      }
+      
+      return out;
+   }
+}
+
+#endif   // PIC_10C_STABLE_DIRECTED_GRAPH_H_
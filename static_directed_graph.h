@@ -0,0 +1,1169 @@
+/**
+ * Declarations and definitions of the <code>DirectedGraph</code> class for the
+ * <code>StaticStorage</code> storage policy, the
+ * <code>StaticDirectedGraph</code> alias template, and <code>operator<<</code>
+ * for that class.
+ *
+ * @file static_directed_graph.h
+ *
+ * @author Kris Torres
+ *
+ * @date 2026-10-14
+ *
+ * @version 1.0
+ */
+
+#ifndef PIC_10C_STATIC_DIRECTED_GRAPH_H_
+#define PIC_10C_STATIC_DIRECTED_GRAPH_H_
+
+#include <cstddef>
+#include <array>
+#include <vector>
+#include <stdexcept>
+#include <iterator>
+#include <utility>
+#include <ostream>
+#include <initializer_list>
+#include "adjacency.h"
+#include "directed_graph.h"
+#include "index_error.h"
+
+/**
+ * Marks a function of a static directed graph as usable in a constant
+ * expression, which needs the relaxed <code>constexpr</code> functions and
+ * the <code>constexpr</code> <code>std::array</code> accessors of C++17.
+ * Before C++17, the functions are only inline.
+ */
+#if __cplusplus >= 201703L
+#define PIC_10C_CONSTEXPR constexpr
+#else
+#define PIC_10C_CONSTEXPR inline
+#endif
+
+namespace Kris_Torres_UCLA_PIC_10C_Winter_2014
+{
+   /**
+    * A directed graph of at most <i>V</i> nodes and <i>E</i> directed edges,
+    * kept in fixed-size arrays inside the directed graph itself. Each node
+    * keeps the first and the last of its outgoing and of its incoming directed
+    * edges, and each directed edge keeps the next directed edge from the same
+    * starting node and the next into the same ending node, so connecting
+    * takes constant time and the adjacent nodes of each node are visited in
+    * the order in which they were connected, as in the other storage
+    * policies.<p>
+    *
+    * The directed graph allocates nothing and has no virtual destructor, so
+    * it can live on the stack or in static storage, and it is trivially
+    * copyable whenever <i>T</i> is: copying it is one <code>memcpy</code> of
+    * its arrays. Since C++17, a directed graph of a literal type can be built
+    * and queried in a constant expression, and an invalid position or a full
+    * directed graph is then a compile-time error.<p>
+    *
+    * The interface is the part of the interface of the other storage
+    * policies that does not erase: nodes and directed edges can be added, but
+    * not removed, until the directed graph is cleared.
+    *
+    * @param T   the type of the elements, which must be default constructible
+    * @param V   the largest number of nodes
+    * @param E   the largest number of directed edges
+    * @param A   the allocator type, which is not used
+    *
+    * @author Kris Torres
+    */
+   template<typename T, size_t V, size_t E, typename A>
+   class DirectedGraph<T, StaticStorage<V, E>, A>
+   {
+   public:
+      
+      // Classes
+      class NeighborIterator;
+      class Neighbors;
+      
+      // Constructors
+      PIC_10C_CONSTEXPR DirectedGraph();
+      PIC_10C_CONSTEXPR DirectedGraph(const std::initializer_list<T> il);
+      PIC_10C_CONSTEXPR DirectedGraph(const std::initializer_list<T> il,
+         const std::initializer_list<std::pair<size_t, size_t>> edges);
+      
+      // Mutators
+      PIC_10C_CONSTEXPR T& at(const size_t& k);
+      PIC_10C_CONSTEXPR void clear();
+      PIC_10C_CONSTEXPR void connect(const size_t& from, const size_t& to);
+      PIC_10C_CONSTEXPR void connect_bulk(
+         const std::initializer_list<std::pair<size_t, size_t>> il);
+      template<typename... Args>
+      PIC_10C_CONSTEXPR void emplace_back(Args&&... args);
+      PIC_10C_CONSTEXPR T* find(const size_t& k) noexcept;
+      PIC_10C_CONSTEXPR T& front();
+      PIC_10C_CONSTEXPR T& operator[](const size_t& k);
+      PIC_10C_CONSTEXPR void push_back(const T& val);
+      PIC_10C_CONSTEXPR void push_back(T&& val);
+      
+      // Accessors
+      Adjacency adjacency() const;
+      PIC_10C_CONSTEXPR T at(const size_t& k) const;
+      PIC_10C_CONSTEXPR size_t edge_count(const size_t& from,
+         const size_t& to) const;
+      PIC_10C_CONSTEXPR size_t edges() const;
+      PIC_10C_CONSTEXPR bool empty() const;
+      PIC_10C_CONSTEXPR const T* find(const size_t& k) const noexcept;
+      PIC_10C_CONSTEXPR T front() const;
+      PIC_10C_CONSTEXPR bool has_edge(const size_t& from, const size_t& to)
+         const;
+      PIC_10C_CONSTEXPR Neighbors in_neighbors(const size_t& k) const;
+      PIC_10C_CONSTEXPR size_t indegree(const size_t& k) const;
+      static constexpr size_t max_edges();
+      static constexpr size_t max_size();
+      PIC_10C_CONSTEXPR Neighbors neighbors(const size_t& k) const;
+      PIC_10C_CONSTEXPR T operator[](const size_t& k) const;
+      PIC_10C_CONSTEXPR size_t outdegree(const size_t& k) const;
+      PIC_10C_CONSTEXPR bool simple() const;
+      PIC_10C_CONSTEXPR size_t size() const;
+      
+      // Relational operators
+      PIC_10C_CONSTEXPR bool operator==(const DirectedGraph& rhs) const;
+      PIC_10C_CONSTEXPR bool operator!=(const DirectedGraph& rhs) const;
+      
+      // Friend
+      template<typename U, size_t W, size_t F, typename B>
+      friend std::ostream& operator<<(std::ostream& out,
+         const DirectedGraph<U, StaticStorage<W, F>, B>& rhs);
+      
+   private:
+      
+      // Mutator
+      PIC_10C_CONSTEXPR void add_node();
+      
+      // Accessor
+      PIC_10C_CONSTEXPR void test_index(const size_t& k, const char* error)
+         const;
+      
+      // Constant
+      static constexpr size_t none = static_cast<size_t>(-1);
+      
+      /** The values of the nodes. */
+      std::array<T, V> values_;
+      
+      /** The first directed edge from each node, or <code>none</code>. */
+      std::array<size_t, V> first_out_;
+      
+      /** The last directed edge from each node, or <code>none</code>. */
+      std::array<size_t, V> last_out_;
+      
+      /** The first directed edge into each node, or <code>none</code>. */
+      std::array<size_t, V> first_in_;
+      
+      /** The last directed edge into each node, or <code>none</code>. */
+      std::array<size_t, V> last_in_;
+      
+      /** The number of directed edges from each node. */
+      std::array<size_t, V> outdegrees_;
+      
+      /** The number of directed edges into each node. */
+      std::array<size_t, V> indegrees_;
+      
+      /** The starting node of each directed edge, in connection order. */
+      std::array<size_t, E> heads_;
+      
+      /** The ending node of each directed edge, in connection order. */
+      std::array<size_t, E> tails_;
+      
+      /**
+       * The next directed edge from the starting node of each directed edge,
+       * or <code>none</code>.
+       */
+      std::array<size_t, E> next_out_;
+      
+      /**
+       * The next directed edge into the ending node of each directed edge, or
+       * <code>none</code>.
+       */
+      std::array<size_t, E> next_in_;
+      
+      /** The number of nodes in this directed graph. */
+      size_t size_;
+      
+      /** The number of directed edges in this directed graph. */
+      size_t edges_;
+   };
+   
+   /**
+    * A <b>neighbor iterator</b> visits the positions of the tail nodes or the
+    * head nodes of one node in a static directed graph, by following the
+    * chain of its directed edges.
+    *
+    * @author Kris Torres
+    */
+   template<typename T, size_t V, size_t E, typename A>
+   class DirectedGraph<T, StaticStorage<V, E>, A>::NeighborIterator final
+   {
+   public:
+      
+      // Types
+      typedef std::forward_iterator_tag iterator_category;
+      typedef size_t value_type;
+      typedef std::ptrdiff_t difference_type;
+      typedef const size_t* pointer;
+      typedef const size_t& reference;
+      
+      // Constructor
+      PIC_10C_CONSTEXPR NeighborIterator();
+      
+      // Mutators
+      PIC_10C_CONSTEXPR NeighborIterator& operator++();
+      PIC_10C_CONSTEXPR NeighborIterator operator++(int);
+      
+      // Accessors
+      PIC_10C_CONSTEXPR reference operator*() const;
+      PIC_10C_CONSTEXPR pointer operator->() const;
+      
+      // Relational operators
+      PIC_10C_CONSTEXPR bool operator==(const NeighborIterator& rhs) const;
+      PIC_10C_CONSTEXPR bool operator!=(const NeighborIterator& rhs) const;
+      
+      // Friend
+      friend class DirectedGraph<T, StaticStorage<V, E>, A>::Neighbors;
+      
+   private:
+      
+      // Constructor
+      PIC_10C_CONSTEXPR NeighborIterator(const size_t* nodes,
+         const size_t* links, const size_t& edge);
+      
+      /** The adjacent node of each directed edge. */
+      const size_t* nodes_;
+      
+      /** The next directed edge in the chain after each directed edge. */
+      const size_t* links_;
+      
+      /** The current directed edge, or <code>none</code> past the end. */
+      size_t edge_;
+   };
+   
+   /**
+    * A <b>neighbors</b> view is a range of the positions of the tail nodes or
+    * the head nodes of one node in a static directed graph, in the order in
+    * which they were connected, which can be traversed with a range-based
+    * <code>for</code> loop, in a constant expression too. A view is
+    * invalidated when its directed graph is cleared or destroyed.
+    *
+    * @author Kris Torres
+    */
+   template<typename T, size_t V, size_t E, typename A>
+   class DirectedGraph<T, StaticStorage<V, E>, A>::Neighbors final
+   {
+   public:
+      
+      // Types
+      typedef NeighborIterator iterator;
+      typedef NeighborIterator const_iterator;
+      
+      // Accessors
+      PIC_10C_CONSTEXPR NeighborIterator begin() const;
+      PIC_10C_CONSTEXPR bool empty() const;
+      PIC_10C_CONSTEXPR NeighborIterator end() const;
+      PIC_10C_CONSTEXPR size_t size() const;
+      
+      // Friend
+      friend class DirectedGraph<T, StaticStorage<V, E>, A>;
+      
+   private:
+      
+      // Constructor
+      PIC_10C_CONSTEXPR Neighbors(const size_t* nodes, const size_t* links,
+         const size_t& first, const size_t& size);
+      
+      /** The adjacent node of each directed edge. */
+      const size_t* nodes_;
+      
+      /** The next directed edge in the chain after each directed edge. */
+      const size_t* links_;
+      
+      /** The first directed edge of the chain, or <code>none</code>. */
+      size_t first_;
+      
+      /** The number of directed edges in the chain. */
+      size_t size_;
+   };
+   
+   /**
+    * A <b>static directed graph</b> is a directed graph with the
+    * <code>StaticStorage</code> storage policy, of at most <i>V</i> nodes and
+    * <i>E</i> directed edges.
+    *
+    * @param T   the type of the elements
+    * @param V   the largest number of nodes
+    * @param E   the largest number of directed edges
+    */
+   template<typename T, size_t V, size_t E>
+   using StaticDirectedGraph = DirectedGraph<T, StaticStorage<V, E>>;
+   
+   // Directed graph output operator
+   template<typename T, size_t V, size_t E, typename A>
+   std::ostream& operator<<(std::ostream& out,
+      const DirectedGraph<T, StaticStorage<V, E>, A>& rhs);
+   
+   template<typename T, size_t V, size_t E, typename A>
+   constexpr size_t DirectedGraph<T, StaticStorage<V, E>, A>::none;
+   
+   /** Constructs an empty directed graph. */
+   template<typename T, size_t V, size_t E, typename A>
+   PIC_10C_CONSTEXPR DirectedGraph<T, StaticStorage<V, E>, A>::DirectedGraph()
+      : values_(), first_out_(), last_out_(), first_in_(), last_in_(),
+        outdegrees_(), indegrees_(), heads_(), tails_(), next_out_(),
+        next_in_(), size_(0), edges_(0) {}
+   
+   /**
+    * Constructs a directed graph that contains nodes with each of the elements
+    * in the specified initializer list.
+    *
+    * @param il   the initializer list of elements
+    *
+    * @throws std::length_error if there are more than <i>V</i> elements
+    */
+   template<typename T, size_t V, size_t E, typename A>
+   PIC_10C_CONSTEXPR DirectedGraph<T, StaticStorage<V, E>, A>::DirectedGraph(
+      const std::initializer_list<T> il) : DirectedGraph()
+   {
+      for (const auto& element : il) push_back(element);
+   }
+   
+   /**
+    * Constructs a directed graph that contains nodes with each of the elements
+    * in the first initializer list, connected by each of the directed edges
+    * in the second, given as pairs of starting and ending node positions.
+    *
+    * @param il      the initializer list of elements
+    * @param edges   the initializer list of directed edges
+    *
+    * @throws std::length_error if there are more than <i>V</i> elements or
+    * more than <i>E</i> directed edges
+    * @throws std::out_of_range if a position is invalid
+    */
+   template<typename T, size_t V, size_t E, typename A>
+   PIC_10C_CONSTEXPR DirectedGraph<T, StaticStorage<V, E>, A>::DirectedGraph(
+      const std::initializer_list<T> il,
+      const std::initializer_list<std::pair<size_t, size_t>> edges)
+      : DirectedGraph(il)
+   {
+      connect_bulk(edges);
+   }
+   
+   /**
+    * Returns the element in the <i>k</i>th node of this directed graph.
+    *
+    * @param k   the position of the node
+    *
+    * @return the element in the node
+    *
+    * @throws std::out_of_range if <i>k</i> is invalid
+    */
+   template<typename T, size_t V, size_t E, typename A>
+   PIC_10C_CONSTEXPR T& DirectedGraph<T, StaticStorage<V, E>, A>::at(
+      const size_t& k)
+   {
+      test_index(k, "Invalid node index in directed graph: ");
+      return values_[k];
+   }
+   
+   /**
+    * Removes all the nodes and the directed edges in this directed graph, and
+    * resets the elements of the nodes.
+    */
+   template<typename T, size_t V, size_t E, typename A>
+   PIC_10C_CONSTEXPR void DirectedGraph<T, StaticStorage<V, E>, A>::clear()
+   {
+      for (size_t i = 0; i < size_; i++) values_[i] = T();
+      size_ = edges_ = 0;
+   }
+   
+   /**
+    * Connects the <i>from</i>th node to the <i>to</i>th node of this directed
+    * graph with a new directed edge, in constant time. Multiple directed edges
+    * and loops are allowed.
+    *
+    * @param from   the position of the starting node
+    * @param to     the position of the ending node
+    *
+    * @throws std::out_of_range if <i>from</i> or <i>to</i> is invalid
+    * @throws std::length_error if the directed graph already has <i>E</i>
+    * directed edges
+    */
+   template<typename T, size_t V, size_t E, typename A>
+   PIC_10C_CONSTEXPR void DirectedGraph<T, StaticStorage<V, E>, A>::connect(
+      const size_t& from, const size_t& to)
+   {
+      test_index(from, "Invalid starting node index in directed graph: ");
+      test_index(to, "Invalid ending node index in directed graph: ");
+      
+      if (edges_ == E)
+         throw std::length_error("Too many directed edges in directed graph");
+      
+      const size_t edge = edges_++;
+      heads_[edge] = from;
+      tails_[edge] = to;
+      next_out_[edge] = next_in_[edge] = none;
+      
+      // Appends the directed edge to both chains, to keep connection order.
+      if (last_out_[from] == none) first_out_[from] = edge;
+      else next_out_[last_out_[from]] = edge;
+      
+      if (last_in_[to] == none) first_in_[to] = edge;
+      else next_in_[last_in_[to]] = edge;
+      
+      last_out_[from] = last_in_[to] = edge;
+      outdegrees_[from]++;
+      indegrees_[to]++;
+   }
+   
+   /**
+    * Connects each of the specified pairs of starting and ending node
+    * positions with a new directed edge, in order.
+    *
+    * @param il   the initializer list of directed edges
+    *
+    * @throws std::out_of_range if a position is invalid
+    * @throws std::length_error if the directed edges do not fit
+    */
+   template<typename T, size_t V, size_t E, typename A>
+   PIC_10C_CONSTEXPR void DirectedGraph<T, StaticStorage<V, E>, A>
+      ::connect_bulk(const std::initializer_list<std::pair<size_t, size_t>> il)
+   {
+      for (const auto& element : il) connect(element.first, element.second);
+   }
+   
+   /**
+    * Inserts a new node at the end of this directed graph, with its element
+    * constructed from the specified arguments.
+    *
+    * @param args   the arguments of the constructor of the element
+    *
+    * @throws std::length_error if the directed graph already has <i>V</i>
+    * nodes
+    */
+   template<typename T, size_t V, size_t E, typename A>
+   template<typename... Args>
+   PIC_10C_CONSTEXPR void DirectedGraph<T, StaticStorage<V, E>, A>
+      ::emplace_back(Args&&... args)
+   {
+      add_node();
+      values_[size_ - 1] = T(std::forward<Args>(args)...);
+   }
+   
+   /**
+    * Returns a pointer to the element in the <i>k</i>th node of this
+    * directed graph, or <code>nullptr</code> if <i>k</i> is invalid.
+    *
+    * @param k   the position of the node
+    *
+    * @return a pointer to the element, or <code>nullptr</code>
+    */
+   template<typename T, size_t V, size_t E, typename A>
+   PIC_10C_CONSTEXPR T* DirectedGraph<T, StaticStorage<V, E>, A>::find(
+      const size_t& k) noexcept
+   {
+      return k < size_ ? &values_[k] : nullptr;
+   }
+   
+   /**
+    * Returns the element in the first node of this directed graph.
+    *
+    * @return the element in the first node
+    *
+    * @throws std::out_of_range if the directed graph is empty
+    */
+   template<typename T, size_t V, size_t E, typename A>
+   PIC_10C_CONSTEXPR T& DirectedGraph<T, StaticStorage<V, E>, A>::front()
+   {
+      // Tests if the directed graph is empty.
+      if (empty()) throw std::out_of_range("Empty directed graph");
+      
+      return values_[0];
+   }
+   
+   /**
+    * Returns the element in the <i>k</i>th node of this directed graph,
+    * without testing if <i>k</i> is valid.
+    *
+    * @param k   the position of the node
+    *
+    * @return the element in the node
+    */
+   template<typename T, size_t V, size_t E, typename A>
+   PIC_10C_CONSTEXPR T& DirectedGraph<T, StaticStorage<V, E>, A>::operator[](
+      const size_t& k)
+   {
+      return values_[k];
+   }
+   
+   /**
+    * Inserts a new node with the specified element at the end of this
+    * directed graph.
+    *
+    * @param val   the element
+    *
+    * @throws std::length_error if the directed graph already has <i>V</i>
+    * nodes
+    */
+   template<typename T, size_t V, size_t E, typename A>
+   PIC_10C_CONSTEXPR void DirectedGraph<T, StaticStorage<V, E>, A>::push_back(
+      const T& val)
+   {
+      add_node();
+      values_[size_ - 1] = val;
+   }
+   
+   /**
+    * Inserts a new node with the specified element, moved, at the end of this
+    * directed graph.
+    *
+    * @param val   the element
+    *
+    * @throws std::length_error if the directed graph already has <i>V</i>
+    * nodes
+    */
+   template<typename T, size_t V, size_t E, typename A>
+   PIC_10C_CONSTEXPR void DirectedGraph<T, StaticStorage<V, E>, A>::push_back(
+      T&& val)
+   {
+      add_node();
+      values_[size_ - 1] = std::move(val);
+   }
+   
+   /**
+    * Returns a snapshot of the directed edges of this directed graph, for the
+    * graph algorithms that take an <code>Adjacency</code>.
+    *
+    * @return the adjacency of this directed graph
+    */
+   template<typename T, size_t V, size_t E, typename A>
+   Adjacency DirectedGraph<T, StaticStorage<V, E>, A>::adjacency() const
+   {
+      // Lists the directed edges by starting node, as the other storage
+      // policies do, so that the head nodes come out in the same order too.
+      std::vector<std::pair<size_t, size_t>> pairs;
+      pairs.reserve(edges_);
+      
+      for (size_t i = 0; i < size_; i++)
+         for (size_t j = first_out_[i]; j != none; j = next_out_[j])
+            pairs.push_back(std::make_pair(i, tails_[j]));
+      
+      return Adjacency(size_, pairs);
+   }
+   
+   /**
+    * Returns a copy of the element in the <i>k</i>th node of this directed
+    * graph.
+    *
+    * @param k   the position of the node
+    *
+    * @return a copy of the element in the node
+    *
+    * @throws std::out_of_range if <i>k</i> is invalid
+    */
+   template<typename T, size_t V, size_t E, typename A>
+   PIC_10C_CONSTEXPR T DirectedGraph<T, StaticStorage<V, E>, A>::at(
+      const size_t& k) const
+   {
+      test_index(k, "Invalid node index in directed graph: ");
+      return values_[k];
+   }
+   
+   /**
+    * Returns the number of directed edges from the <i>from</i>th node to the
+    * <i>to</i>th node of this directed graph, in time linear in the
+    * outdegree of the starting node.
+    *
+    * @param from   the position of the starting node
+    * @param to     the position of the ending node
+    *
+    * @return the number of directed edges
+    *
+    * @throws std::out_of_range if <i>from</i> or <i>to</i> is invalid
+    */
+   template<typename T, size_t V, size_t E, typename A>
+   PIC_10C_CONSTEXPR size_t DirectedGraph<T, StaticStorage<V, E>, A>
+      ::edge_count(const size_t& from, const size_t& to) const
+   {
+      test_index(from, "Invalid starting node index in directed graph: ");
+      test_index(to, "Invalid ending node index in directed graph: ");
+      
+      size_t count = 0;
+      
+      for (size_t i = first_out_[from]; i != none; i = next_out_[i])
+         if (tails_[i] == to) count++;
+      
+      return count;
+   }
+   
+   /**
+    * Returns the number of directed edges in this directed graph.
+    *
+    * @return the number of directed edges
+    */
+   template<typename T, size_t V, size_t E, typename A>
+   PIC_10C_CONSTEXPR size_t DirectedGraph<T, StaticStorage<V, E>, A>::edges()
+      const
+   {
+      return edges_;
+   }
+   
+   /**
+    * Tests if this directed graph has no nodes.
+    *
+    * @return <code>true</code> if the directed graph is empty, or
+    * <code>false</code> otherwise
+    */
+   template<typename T, size_t V, size_t E, typename A>
+   PIC_10C_CONSTEXPR bool DirectedGraph<T, StaticStorage<V, E>, A>::empty()
+      const
+   {
+      return size_ == 0;
+   }
+   
+   /**
+    * Returns a pointer to the element in the <i>k</i>th node of this
+    * directed graph, or <code>nullptr</code> if <i>k</i> is invalid.
+    *
+    * @param k   the position of the node
+    *
+    * @return a pointer to the element, or <code>nullptr</code>
+    */
+   template<typename T, size_t V, size_t E, typename A>
+   PIC_10C_CONSTEXPR const T* DirectedGraph<T, StaticStorage<V, E>, A>::find(
+      const size_t& k) const noexcept
+   {
+      return k < size_ ? &values_[k] : nullptr;
+   }
+   
+   /**
+    * Returns a copy of the element in the first node of this directed graph.
+    *
+    * @return a copy of the element in the first node
+    *
+    * @throws std::out_of_range if the directed graph is empty
+    */
+   template<typename T, size_t V, size_t E, typename A>
+   PIC_10C_CONSTEXPR T DirectedGraph<T, StaticStorage<V, E>, A>::front() const
+   {
+      // Tests if the directed graph is empty.
+      if (empty()) throw std::out_of_range("Empty directed graph");
+      
+      return values_[0];
+   }
+   
+   /**
+    * Tests if there is a directed edge from the <i>from</i>th node to the
+    * <i>to</i>th node of this directed graph, in time linear in the
+    * outdegree of the starting node.
+    *
+    * @param from   the position of the starting node
+    * @param to     the position of the ending node
+    *
+    * @return <code>true</code> if there is such a directed edge, or
+    * <code>false</code> otherwise
+    *
+    * @throws std::out_of_range if <i>from</i> or <i>to</i> is invalid
+    */
+   template<typename T, size_t V, size_t E, typename A>
+   PIC_10C_CONSTEXPR bool DirectedGraph<T, StaticStorage<V, E>, A>::has_edge(
+      const size_t& from, const size_t& to) const
+   {
+      test_index(from, "Invalid starting node index in directed graph: ");
+      test_index(to, "Invalid ending node index in directed graph: ");
+      
+      for (size_t i = first_out_[from]; i != none; i = next_out_[i])
+         if (tails_[i] == to) return true;
+      
+      return false;
+   }
+   
+   /**
+    * Returns a view of the positions of the head nodes of the <i>k</i>th node
+    * of this directed graph.
+    *
+    * @param k   the position of the node
+    *
+    * @return the view of the head nodes
+    *
+    * @throws std::out_of_range if <i>k</i> is invalid
+    */
+   template<typename T, size_t V, size_t E, typename A>
+   PIC_10C_CONSTEXPR typename DirectedGraph<T, StaticStorage<V, E>, A>
+      ::Neighbors DirectedGraph<T, StaticStorage<V, E>, A>::in_neighbors(
+      const size_t& k) const
+   {
+      test_index(k, "Invalid node index in directed graph: ");
+      return Neighbors(heads_.data(), next_in_.data(), first_in_[k],
+         indegrees_[k]);
+   }
+   
+   /**
+    * Returns the number of directed edges into the <i>k</i>th node of this
+    * directed graph.
+    *
+    * @param k   the position of the node
+    *
+    * @return the indegree of the node
+    *
+    * @throws std::out_of_range if <i>k</i> is invalid
+    */
+   template<typename T, size_t V, size_t E, typename A>
+   PIC_10C_CONSTEXPR size_t DirectedGraph<T, StaticStorage<V, E>, A>::indegree(
+      const size_t& k) const
+   {
+      test_index(k, "Invalid node index in directed graph: ");
+      return indegrees_[k];
+   }
+   
+   /**
+    * Returns the largest number of directed edges of this type of directed
+    * graph.
+    *
+    * @return <i>E</i>
+    */
+   template<typename T, size_t V, size_t E, typename A>
+   constexpr size_t DirectedGraph<T, StaticStorage<V, E>, A>::max_edges()
+   {
+      return E;
+   }
+   
+   /**
+    * Returns the largest number of nodes of this type of directed graph.
+    *
+    * @return <i>V</i>
+    */
+   template<typename T, size_t V, size_t E, typename A>
+   constexpr size_t DirectedGraph<T, StaticStorage<V, E>, A>::max_size()
+   {
+      return V;
+   }
+   
+   /**
+    * Returns a view of the positions of the tail nodes of the <i>k</i>th node
+    * of this directed graph.
+    *
+    * @param k   the position of the node
+    *
+    * @return the view of the tail nodes
+    *
+    * @throws std::out_of_range if <i>k</i> is invalid
+    */
+   template<typename T, size_t V, size_t E, typename A>
+   PIC_10C_CONSTEXPR typename DirectedGraph<T, StaticStorage<V, E>, A>
+      ::Neighbors DirectedGraph<T, StaticStorage<V, E>, A>::neighbors(
+      const size_t& k) const
+   {
+      test_index(k, "Invalid node index in directed graph: ");
+      return Neighbors(tails_.data(), next_out_.data(), first_out_[k],
+         outdegrees_[k]);
+   }
+   
+   /**
+    * Returns a copy of the element in the <i>k</i>th node of this directed
+    * graph, without testing if <i>k</i> is valid.
+    *
+    * @param k   the position of the node
+    *
+    * @return a copy of the element in the node
+    */
+   template<typename T, size_t V, size_t E, typename A>
+   PIC_10C_CONSTEXPR T DirectedGraph<T, StaticStorage<V, E>, A>::operator[](
+      const size_t& k) const
+   {
+      return values_[k];
+   }
+   
+   /**
+    * Returns the number of directed edges from the <i>k</i>th node of this
+    * directed graph.
+    *
+    * @param k   the position of the node
+    *
+    * @return the outdegree of the node
+    *
+    * @throws std::out_of_range if <i>k</i> is invalid
+    */
+   template<typename T, size_t V, size_t E, typename A>
+   PIC_10C_CONSTEXPR size_t DirectedGraph<T, StaticStorage<V, E>, A>
+      ::outdegree(const size_t& k) const
+   {
+      test_index(k, "Invalid node index in directed graph: ");
+      return outdegrees_[k];
+   }
+   
+   /**
+    * Tests if this directed graph is simple, that is, has no loops and no
+    * multiple directed edges.
+    *
+    * @return <code>true</code> if the directed graph is simple, or
+    * <code>false</code> otherwise
+    */
+   template<typename T, size_t V, size_t E, typename A>
+   PIC_10C_CONSTEXPR bool DirectedGraph<T, StaticStorage<V, E>, A>::simple()
+      const
+   {
+      std::array<size_t, V> marks = {};
+      for (size_t i = 0; i < size_; i++) marks[i] = none;
+      
+      for (size_t i = 0; i < size_; i++)
+      {
+         for (size_t j = first_out_[i]; j != none; j = next_out_[j])
+         {
+            // Tests if the current node has a loop or a multiple directed edge.
+            if (tails_[j] == i || marks[tails_[j]] == i) return false;
+            marks[tails_[j]] = i;
+         }
+      }
+      
+      return true;
+   }
+   
+   /**
+    * Returns the number of nodes in this directed graph.
+    *
+    * @return the number of nodes
+    */
+   template<typename T, size_t V, size_t E, typename A>
+   PIC_10C_CONSTEXPR size_t DirectedGraph<T, StaticStorage<V, E>, A>::size()
+      const
+   {
+      return size_;
+   }
+   
+   /**
+    * Tests if this directed graph has the same elements as the specified
+    * directed graph, and the same directed edges from each node in the same
+    * order.
+    *
+    * @param rhs   the directed graph to be compared
+    *
+    * @return <code>true</code> if the two directed graphs are equal, or
+    * <code>false</code> otherwise
+    */
+   template<typename T, size_t V, size_t E, typename A>
+   PIC_10C_CONSTEXPR bool DirectedGraph<T, StaticStorage<V, E>, A>::operator==(
+      const DirectedGraph& rhs) const
+   {
+      if (size_ != rhs.size_ || edges_ != rhs.edges_) return false;
+      
+      // Tests if the two directed graphs have the same nodes.
+      for (size_t i = 0; i < size_; i++)
+         if (values_[i] != rhs.values_[i]) return false;
+      
+      // Tests if the two directed graphs have the same directed edges, in the
+      // order in which they were connected.
+      for (size_t i = 0; i < size_; i++)
+      {
+         if (outdegrees_[i] != rhs.outdegrees_[i]) return false;
+         
+         for (size_t j = first_out_[i], k = rhs.first_out_[i]; j != none;
+            j = next_out_[j], k = rhs.next_out_[k])
+         {
+            if (tails_[j] != rhs.tails_[k]) return false;
+         }
+      }
+      
+      return true;
+   }
+   
+   /**
+    * Tests if this directed graph differs from the specified directed graph.
+    *
+    * @param rhs   the directed graph to be compared
+    *
+    * @return <code>true</code> if the two directed graphs differ, or
+    * <code>false</code> otherwise
+    */
+   template<typename T, size_t V, size_t E, typename A>
+   PIC_10C_CONSTEXPR bool DirectedGraph<T, StaticStorage<V, E>, A>::operator!=(
+      const DirectedGraph& rhs) const
+   {
+      return !(*this == rhs);
+   }
+   
+   /**
+    * Appends a node with no directed edges to this directed graph.
+    *
+    * @throws std::length_error if the directed graph already has <i>V</i>
+    * nodes
+    */
+   template<typename T, size_t V, size_t E, typename A>
+   PIC_10C_CONSTEXPR void DirectedGraph<T, StaticStorage<V, E>, A>::add_node()
+   {
+      if (size_ == V)
+         throw std::length_error("Too many nodes in directed graph");
+      
+      first_out_[size_] = last_out_[size_] = none;
+      first_in_[size_] = last_in_[size_] = none;
+      outdegrees_[size_] = indegrees_[size_] = 0;
+      size_++;
+   }
+   
+   /**
+    * Tests if the specified position is valid in this directed graph.
+    *
+    * @param k       the position
+    * @param error   the error message
+    *
+    * @throws std::out_of_range if <i>k</i> is invalid
+    */
+   template<typename T, size_t V, size_t E, typename A>
+   PIC_10C_CONSTEXPR void DirectedGraph<T, StaticStorage<V, E>, A>::test_index(
+      const size_t& k, const char* error) const
+   {
+      if (k >= size_) throw_index_error(error, k);
+   }
+   
+   /** Constructs a past-the-end neighbor iterator. */
+   template<typename T, size_t V, size_t E, typename A>
+   PIC_10C_CONSTEXPR DirectedGraph<T, StaticStorage<V, E>, A>::NeighborIterator
+      ::NeighborIterator() : nodes_(nullptr), links_(nullptr), edge_(none) {}
+   
+   /**
+    * Moves this iterator to the next adjacent node.
+    *
+    * @return this iterator after the increment
+    */
+   template<typename T, size_t V, size_t E, typename A>
+   PIC_10C_CONSTEXPR typename DirectedGraph<T, StaticStorage<V, E>, A>
+      ::NeighborIterator& DirectedGraph<T, StaticStorage<V, E>, A>
+      ::NeighborIterator::operator++()
+   {
+      edge_ = links_[edge_];
+      return *this;
+   }
+   
+   /**
+    * Moves this iterator to the next adjacent node.
+    *
+    * @return a copy of this iterator before the increment
+    */
+   template<typename T, size_t V, size_t E, typename A>
+   PIC_10C_CONSTEXPR typename DirectedGraph<T, StaticStorage<V, E>, A>
+      ::NeighborIterator DirectedGraph<T, StaticStorage<V, E>, A>
+      ::NeighborIterator::operator++(int)
+   {
+      NeighborIterator result = *this;
+      ++*this;
+      return result;
+   }
+   
+   /**
+    * Returns the position of the current adjacent node.
+    *
+    * @return the position of the adjacent node
+    */
+   template<typename T, size_t V, size_t E, typename A>
+   PIC_10C_CONSTEXPR typename DirectedGraph<T, StaticStorage<V, E>, A>
+      ::NeighborIterator::reference DirectedGraph<T, StaticStorage<V, E>, A>
+      ::NeighborIterator::operator*() const
+   {
+      return nodes_[edge_];
+   }
+   
+   /**
+    * Returns a pointer to the position of the current adjacent node.
+    *
+    * @return a pointer to the position of the adjacent node
+    */
+   template<typename T, size_t V, size_t E, typename A>
+   PIC_10C_CONSTEXPR typename DirectedGraph<T, StaticStorage<V, E>, A>
+      ::NeighborIterator::pointer DirectedGraph<T, StaticStorage<V, E>, A>
+      ::NeighborIterator::operator->() const
+   {
+      return nodes_ + edge_;
+   }
+   
+   /**
+    * Tests if this iterator is at the same directed edge as the specified
+    * iterator.
+    *
+    * @param rhs   the iterator to be compared
+    *
+    * @return <code>true</code> if the two iterators are equal, or
+    * <code>false</code> otherwise
+    */
+   template<typename T, size_t V, size_t E, typename A>
+   PIC_10C_CONSTEXPR bool DirectedGraph<T, StaticStorage<V, E>, A>
+      ::NeighborIterator::operator==(const NeighborIterator& rhs) const
+   {
+      return edge_ == rhs.edge_;
+   }
+   
+   /**
+    * Tests if this iterator is not at the same directed edge as the specified
+    * iterator.
+    *
+    * @param rhs   the iterator to be compared
+    *
+    * @return <code>true</code> if the two iterators differ, or
+    * <code>false</code> otherwise
+    */
+   template<typename T, size_t V, size_t E, typename A>
+   PIC_10C_CONSTEXPR bool DirectedGraph<T, StaticStorage<V, E>, A>
+      ::NeighborIterator::operator!=(const NeighborIterator& rhs) const
+   {
+      return edge_ != rhs.edge_;
+   }
+   
+   /**
+    * Constructs an iterator at the specified directed edge of a chain.
+    *
+    * @param nodes   the adjacent node of each directed edge
+    * @param links   the next directed edge in the chain after each one
+    * @param edge    the directed edge, or <code>none</code>
+    */
+   template<typename T, size_t V, size_t E, typename A>
+   PIC_10C_CONSTEXPR DirectedGraph<T, StaticStorage<V, E>, A>::NeighborIterator
+      ::NeighborIterator(const size_t* nodes, const size_t* links,
+      const size_t& edge) : nodes_(nodes), links_(links), edge_(edge) {}
+   
+   /**
+    * Returns an iterator at the first adjacent node.
+    *
+    * @return the iterator at the first adjacent node
+    */
+   template<typename T, size_t V, size_t E, typename A>
+   PIC_10C_CONSTEXPR typename DirectedGraph<T, StaticStorage<V, E>, A>
+      ::NeighborIterator DirectedGraph<T, StaticStorage<V, E>, A>::Neighbors
+      ::begin() const
+   {
+      return NeighborIterator(nodes_, links_, first_);
+   }
+   
+   /**
+    * Tests if this view has no adjacent nodes.
+    *
+    * @return <code>true</code> if the view is empty, or <code>false</code>
+    * otherwise
+    */
+   template<typename T, size_t V, size_t E, typename A>
+   PIC_10C_CONSTEXPR bool DirectedGraph<T, StaticStorage<V, E>, A>::Neighbors
+      ::empty() const
+   {
+      return size_ == 0;
+   }
+   
+   /**
+    * Returns an iterator past the last adjacent node.
+    *
+    * @return the past-the-end iterator
+    */
+   template<typename T, size_t V, size_t E, typename A>
+   PIC_10C_CONSTEXPR typename DirectedGraph<T, StaticStorage<V, E>, A>
+      ::NeighborIterator DirectedGraph<T, StaticStorage<V, E>, A>::Neighbors
+      ::end() const
+   {
+      return NeighborIterator(nodes_, links_, none);
+   }
+   
+   /**
+    * Returns the number of adjacent nodes in this view.
+    *
+    * @return the number of adjacent nodes
+    */
+   template<typename T, size_t V, size_t E, typename A>
+   PIC_10C_CONSTEXPR size_t DirectedGraph<T, StaticStorage<V, E>, A>::Neighbors
+      ::size() const
+   {
+      return size_;
+   }
+   
+   /**
+    * Constructs a view of a chain of directed edges.
+    *
+    * @param nodes   the adjacent node of each directed edge
+    * @param links   the next directed edge in the chain after each one
+    * @param first   the first directed edge of the chain, or <code>none</code>
+    * @param size    the number of directed edges in the chain
+    */
+   template<typename T, size_t V, size_t E, typename A>
+   PIC_10C_CONSTEXPR DirectedGraph<T, StaticStorage<V, E>, A>::Neighbors
+      ::Neighbors(const size_t* nodes, const size_t* links,
+      const size_t& first, const size_t& size)
+      : nodes_(nodes), links_(links), first_(first), size_(size) {}
+   
+   /**
+    * Outputs the specified directed graph with the specified output stream.
+    *
+    * @param out   the output stream
+    * @param rhs   the directed graph to be outputted
+    *
+    * @return the stream after the output
+    */
+   template<typename T, size_t V, size_t E, typename A>
+   std::ostream& operator<<(std::ostream& out,
+      const DirectedGraph<T, StaticStorage<V, E>, A>& rhs)
+   {
+      for (size_t i = 0; i < rhs.size_; i++)
+      {
+         // Outputs the current node by itself if it is disconnected.
+         if (rhs.outdegrees_[i] == 0 && rhs.indegrees_[i] == 0)
+            out << rhs.values_[i] << '\n';
+         
+         // Outputs the starting and ending nodes for each directed edge.
+         else
+         {
+            for (size_t j = rhs.first_out_[i]; j != rhs.none;
+               j = rhs.next_out_[j])
+            {
+               out << rhs.values_[i] << " -> " << rhs.values_[rhs.tails_[j]]
+                  << '\n';
+            }
+         }
+      }
+      
+      return out;
+   }
+   
+   /**
+    * Visits each node reachable from the node at position <i>source</i> in the
+    * specified static directed graph in breadth-first order, starting with the
+    * source node itself. The search follows the chains of directed edges
+    * without an adjacency, and keeps its queue in arrays of <i>V</i> elements
+    * instead of allocating, so since C++17 it can run in a constant
+    * expression.
+    *
+    * @param Visitor   the type of the function called on each node
+    *
+    * @param graph    the static directed graph
+    * @param source   the position of the source node
+    * @param visit    the function called with the position of each node
+    *
+    * @throws std::out_of_range if <i>source</i> is at least the number of nodes
+    */
+   template<typename T, size_t V, size_t E, typename A, typename Visitor>
+   PIC_10C_CONSTEXPR void bfs(
+      const DirectedGraph<T, StaticStorage<V, E>, A>& graph,
+      const size_t& source, Visitor visit)
+   {
+      // Tests if source is valid.
+      if (source >= graph.size())
+         throw_index_error("Invalid source node index in directed graph: ",
+            source);
+      
+      std::array<bool, V> visited = {};
+      std::array<size_t, V> queue = {};
+      size_t size = 0;
+      queue[size++] = source;
+      visited[source] = true;
+      
+      for (size_t i = 0; i < size; i++)
+      {
+         const size_t node = queue[i];
+         visit(node);
+         
+         for (const auto& tail : graph.neighbors(node))
+         {
+            if (!visited[tail])
+            {
+               visited[tail] = true;
+               queue[size++] = tail;
+            }
+         }
+      }
+   }
+}
+
+#endif   // PIC_10C_STATIC_DIRECTED_GRAPH_H_
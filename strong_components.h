@@ -0,0 +1,656 @@
+/**
+ * Declarations and definitions of the <code>strong_components</code>,
+ * <code>parallel_strong_components</code>, and <code>condensation</code>
+ * functions, and the <code>ParallelSCC</code> class.
+ *
+ * @file strong_components.h
+ *
+ * @author Kris Torres
+ *
+ * @date 2026-10-14
+ *
+ * @version 1.0
+ */
+
+#ifndef PIC_10C_STRONG_COMPONENTS_H_
+#define PIC_10C_STRONG_COMPONENTS_H_
+
+#include <vector>
+#include <algorithm>
+#include <utility>
+#include <atomic>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include "adjacency.h"
+#include "directed_graph.h"
+
+namespace Kris_Torres_UCLA_PIC_10C_Winter_2014
+{
+   /**
+    * A <b>parallel strongly connected component search</b> splits the nodes
+    * of a directed graph into its strongly connected components on a fixed
+    * set of threads.<p>
+    *
+    * The search first <i>trims</i> every node that has no head nodes or no
+    * tail nodes among the remaining ones, since each such node is a component
+    * by itself; on most real directed graphs, this removes a large share of
+    * the nodes in linear time. The rest is split by the <i>forward-backward
+    * </i> method: the nodes reachable from a pivot node and the nodes that
+    * reach it meet in the component of the pivot, and every other component
+    * lies entirely in one of the three remaining parts, which become
+    * independent tasks.<p>
+    *
+    * The threads take tasks from a shared queue, so the parts are split at
+    * the same time. Each part carries its own color, and a search only
+    * follows the directed edges between nodes of its color, so the tasks
+    * never touch each other's nodes. A part smaller than
+    * <code>serial_threshold</code> nodes is finished by the algorithm of
+    * Tarjan instead, which is faster than splitting it further.
+    *
+    * @author Kris Torres
+    */
+   class ParallelSCC final
+   {
+   public:
+      
+      // Constant
+      static const size_t serial_threshold = 4096;
+      
+      // Constructor
+      explicit ParallelSCC(const Adjacency& graph, const size_t& threads = 0);
+      
+      // Mutator
+      std::vector<size_t> run();
+      
+      // Accessor
+      size_t threads() const;
+      
+   private:
+      
+      // Constant
+      static const size_t none = static_cast<size_t>(-1);
+      
+      // Mutators
+      void push(std::vector<size_t>& nodes);
+      void reach(const size_t& pivot, const size_t& color,
+         std::vector<unsigned char>& marks, const bool& forward);
+      void solve(std::vector<size_t>& nodes);
+      void tarjan(const std::vector<size_t>& nodes, const size_t& color);
+      void trim();
+      void work();
+      
+      /** The directed graph to be searched. */
+      const Adjacency* graph_;
+      
+      /** The number of threads that search the directed graph. */
+      size_t threads_;
+      
+      /** The component of each node, or <code>none</code>. */
+      std::vector<size_t> component_;
+      
+      /** The color of the task to which each node belongs. */
+      std::vector<std::atomic<size_t>> color_;
+      
+      /** Whether each node is reachable from the pivot of its task. */
+      std::vector<unsigned char> forward_;
+      
+      /** Whether each node reaches the pivot of its task. */
+      std::vector<unsigned char> backward_;
+      
+      /** The order in which the search of Tarjan reached each node. */
+      std::vector<size_t> index_;
+      
+      /** The least order reachable from each node in the search of Tarjan. */
+      std::vector<size_t> low_;
+      
+      /** Whether each node is on the stack of the search of Tarjan. */
+      std::vector<unsigned char> on_stack_;
+      
+      /** The tasks that remain to be taken. */
+      std::vector<std::vector<size_t>> tasks_;
+      
+      /** The number of tasks that the threads are working on. */
+      size_t active_;
+      
+      /** The next unused color. */
+      std::atomic<size_t> next_color_;
+      
+      /** The next unused component. */
+      std::atomic<size_t> next_component_;
+      
+      /** The mutex that guards the queue of tasks. */
+      std::mutex mutex_;
+      
+      /** The condition on which the idle threads wait for tasks. */
+      std::condition_variable condition_;
+   };
+   
+   /**
+    * Returns the strongly connected component of each node in the specified
+    * adjacency, found by the algorithm of Tarjan in linear time. Two nodes
+    * are in the same component if and only if each can be reached from the
+    * other.<p>
+    *
+    * The components are numbered in topological order: every directed edge
+    * between two components leaves the one with the smaller number. The
+    * search keeps its own stack, so it does not overflow the call stack on a
+    * long path.
+    *
+    * @param graph   the adjacency of the directed graph
+    *
+    * @return the component of each node, from 0 up to the number of
+    * components
+    */
+   inline std::vector<size_t> strong_components(const Adjacency& graph)
+   {
+      const size_t none = static_cast<size_t>(-1);
+      const size_t n = graph.size();
+      std::vector<size_t> result(n, none);
+      std::vector<size_t> index(n, none);
+      std::vector<size_t> low(n);
+      std::vector<size_t> stack;
+      size_t order = 0;
+      size_t components = 0;
+      
+      // Each frame holds a node and the tail nodes that it has left to follow.
+      std::vector<std::pair<size_t, Adjacency::Range>> frames;
+      
+      for (size_t root = 0; root < n; root++)
+      {
+         if (index[root] != none) continue;
+         
+         index[root] = low[root] = order++;
+         stack.push_back(root);
+         frames.push_back(std::make_pair(root, graph.next(root)));
+         
+         while (!frames.empty())
+         {
+            const size_t node = frames.back().first;
+            Adjacency::Range& tails = frames.back().second;
+            
+            if (!tails.empty())
+            {
+               const size_t tail = *tails.begin();
+               tails = Adjacency::Range(tails.begin() + 1, tails.end());
+               
+               if (index[tail] == none)
+               {
+                  index[tail] = low[tail] = order++;
+                  stack.push_back(tail);
+                  frames.push_back(std::make_pair(tail, graph.next(tail)));
+               }
+               
+               // Follows a directed edge back into the current path.
+               else if (result[tail] == none)
+                  low[node] = std::min(low[node], index[tail]);
+               
+               continue;
+            }
+            
+            frames.pop_back();
+            if (!frames.empty())
+            {
+               const size_t head = frames.back().first;
+               low[head] = std::min(low[head], low[node]);
+            }
+            
+            // Pops the component of which the current node is the root.
+            if (low[node] == index[node])
+            {
+               size_t member;
+               
+               do
+               {
+                  member = stack.back();
+                  stack.pop_back();
+                  result[member] = components;
+               } while (member != node);
+               
+               components++;
+            }
+         }
+      }
+      
+      // Renumbers the components, found in reverse topological order.
+      for (auto& component : result) component = components - 1 - component;
+      
+      return result;
+   }
+   
+   /**
+    * Returns the strongly connected component of each node in the specified
+    * directed graph, numbered in topological order.
+    *
+    * @param graph   the directed graph
+    *
+    * @return the component of each node, from 0 up to the number of
+    * components
+    */
+   template<typename T, typename S, typename A>
+   inline std::vector<size_t> strong_components(
+      const DirectedGraph<T, S, A>& graph)
+   {
+      return strong_components(graph.adjacency());
+   }
+   
+   /**
+    * Returns the strongly connected component of each node in the specified
+    * adjacency, found on the specified number of threads (see
+    * <code>ParallelSCC</code>). Unlike <code>strong_components</code>, the
+    * components are numbered in no particular order.
+    *
+    * @param graph     the adjacency of the directed graph
+    * @param threads   the number of threads, or 0 for one per hardware thread
+    *
+    * @return the component of each node, from 0 up to the number of
+    * components
+    */
+   inline std::vector<size_t> parallel_strong_components(
+      const Adjacency& graph, const size_t& threads = 0)
+   {
+      return ParallelSCC(graph, threads).run();
+   }
+   
+   /**
+    * Returns the strongly connected component of each node in the specified
+    * directed graph, found on the specified number of threads.
+    *
+    * @param graph     the directed graph
+    * @param threads   the number of threads, or 0 for one per hardware thread
+    *
+    * @return the component of each node, from 0 up to the number of
+    * components
+    */
+   template<typename T, typename S, typename A>
+   inline std::vector<size_t> parallel_strong_components(
+      const DirectedGraph<T, S, A>& graph, const size_t& threads = 0)
+   {
+      return parallel_strong_components(graph.adjacency(), threads);
+   }
+   
+   /**
+    * Returns the <b>condensation</b> of the specified adjacency, which has a
+    * node for each strongly connected component and a single directed edge
+    * from one component to another whenever some directed edge of the
+    * adjacency connects them. The condensation is acyclic, and its nodes are
+    * in topological order; each node holds the positions of the members of
+    * its component, in increasing order.
+    *
+    * @param graph   the adjacency of the directed graph
+    *
+    * @return the condensation of the directed graph
+    */
+   inline DirectedGraph<std::vector<size_t>> condensation(
+      const Adjacency& graph)
+   {
+      const std::vector<size_t> components = strong_components(graph);
+      const size_t count = components.empty() ? 0
+         : *std::max_element(components.begin(), components.end()) + 1;
+      
+      std::vector<std::vector<size_t>> members(count);
+      for (size_t i = 0; i < graph.size(); i++)
+         members[components[i]].push_back(i);
+      
+      // Marks each component with the last component that connected to it.
+      std::vector<size_t> marks(count, static_cast<size_t>(-1));
+      std::vector<std::pair<size_t, size_t>> edges;
+      
+      for (size_t i = 0; i < count; i++)
+      {
+         for (const auto& member : members[i])
+         {
+            for (const auto& tail : graph.next(member))
+            {
+               const size_t component = components[tail];
+               
+               if (component != i && marks[component] != i)
+               {
+                  marks[component] = i;
+                  edges.push_back(std::make_pair(i, component));
+               }
+            }
+         }
+      }
+      
+      DirectedGraph<std::vector<size_t>> result;
+      result.reserve(count, edges.size());
+      for (auto& component : members) result.push_back(std::move(component));
+      result.connect_bulk(edges.begin(), edges.end());
+      
+      return result;
+   }
+   
+   /**
+    * Returns the condensation of the specified directed graph.
+    *
+    * @param graph   the directed graph
+    *
+    * @return the condensation of the directed graph
+    */
+   template<typename T, typename S, typename A>
+   inline DirectedGraph<std::vector<size_t>> condensation(
+      const DirectedGraph<T, S, A>& graph)
+   {
+      return condensation(graph.adjacency());
+   }
+   
+   /**
+    * Constructs a parallel strongly connected component search of the
+    * specified adjacency on the specified number of threads. The adjacency
+    * must outlive the search.
+    *
+    * @param graph     the adjacency of the directed graph
+    * @param threads   the number of threads, or 0 for one per hardware thread
+    */
+   inline ParallelSCC::ParallelSCC(const Adjacency& graph,
+      const size_t& threads)
+      : graph_(&graph), threads_(threads), color_(graph.size()), active_(0),
+        next_color_(0), next_component_(0)
+   {
+      if (threads_ == 0) threads_ = std::thread::hardware_concurrency();
+      if (threads_ == 0) threads_ = 1;
+   }
+   
+   /**
+    * Searches the directed graph for its strongly connected components.
+    *
+    * @return the component of each node, from 0 up to the number of
+    * components
+    */
+   inline std::vector<size_t> ParallelSCC::run()
+   {
+      // Copies the constant, which has no definition outside the class.
+      const size_t n = graph_ -> size(), unset = none;
+      component_.assign(n, unset);
+      forward_.assign(n, 0);
+      backward_.assign(n, 0);
+      index_.assign(n, unset);
+      low_.assign(n, 0);
+      on_stack_.assign(n, 0);
+      tasks_.clear();
+      active_ = 0;
+      next_color_.store(1);
+      next_component_.store(0);
+      
+      for (auto& color : color_) color.store(0, std::memory_order_relaxed);
+      trim();
+      
+      // Gathers the nodes left by the trimming into the first task.
+      std::vector<size_t> rest;
+      
+      for (size_t i = 0; i < n; i++)
+         if (component_[i] == none) rest.push_back(i);
+      
+      if (!rest.empty()) push(rest);
+      
+      // The calling thread takes part in the search.
+      std::vector<std::thread> workers;
+      
+      for (size_t i = 1; i < threads_; i++)
+         workers.push_back(std::thread(&ParallelSCC::work, this));
+      
+      work();
+      for (auto& worker : workers) worker.join();
+      
+      return std::move(component_);
+   }
+   
+   /**
+    * Returns the number of threads that search the directed graph.
+    *
+    * @return the number of threads
+    */
+   inline size_t ParallelSCC::threads() const
+   {
+      return threads_;
+   }
+   
+   /**
+    * Gives the specified nodes a new color, and adds them to the queue as a
+    * new task. The vector of nodes is left empty.
+    *
+    * @param nodes   the nodes of the task
+    */
+   inline void ParallelSCC::push(std::vector<size_t>& nodes)
+   {
+      const size_t color = next_color_++;
+      
+      for (const auto& node : nodes)
+         color_[node].store(color, std::memory_order_relaxed);
+      
+      {
+         std::lock_guard<std::mutex> lock(mutex_);
+         tasks_.push_back(std::move(nodes));
+      }
+      
+      nodes.clear();
+      condition_.notify_one();
+   }
+   
+   /**
+    * Marks every node of the specified color that is reachable from the pivot
+    * node, following the directed edges either forward or backward.
+    *
+    * @param pivot     the position of the pivot node
+    * @param color     the color of the task
+    * @param marks     the marks to be set
+    * @param forward   whether to follow the directed edges forward
+    */
+   inline void ParallelSCC::reach(const size_t& pivot, const size_t& color,
+      std::vector<unsigned char>& marks, const bool& forward)
+   {
+      std::vector<size_t> queue(1, pivot);
+      marks[pivot] = 1;
+      
+      for (size_t i = 0; i < queue.size(); i++)
+      {
+         const Adjacency::Range neighbors = forward ? graph_ -> next(queue[i])
+            : graph_ -> prev(queue[i]);
+         
+         for (const auto& neighbor : neighbors)
+         {
+            if (!marks[neighbor]
+               && color_[neighbor].load(std::memory_order_relaxed) == color)
+            {
+               marks[neighbor] = 1;
+               queue.push_back(neighbor);
+            }
+         }
+      }
+   }
+   
+   /**
+    * Splits the specified task by the forward-backward method, or finishes it
+    * by the algorithm of Tarjan if it is small. The parts that remain are
+    * added to the queue.
+    *
+    * @param nodes   the nodes of the task, all of the same color
+    */
+   inline void ParallelSCC::solve(std::vector<size_t>& nodes)
+   {
+      const size_t color =
+         color_[nodes.front()].load(std::memory_order_relaxed);
+      
+      if (nodes.size() < serial_threshold)
+      {
+         tarjan(nodes, color);
+         return;
+      }
+      
+      const size_t pivot = nodes.front();
+      reach(pivot, color, forward_, true);
+      reach(pivot, color, backward_, false);
+      
+      // The component of the pivot is where the two searches meet.
+      const size_t component = next_component_++;
+      std::vector<size_t> ahead, behind, apart;
+      
+      for (const auto& node : nodes)
+      {
+         if (forward_[node] && backward_[node]) component_[node] = component;
+         else if (forward_[node]) ahead.push_back(node);
+         else if (backward_[node]) behind.push_back(node);
+         else apart.push_back(node);
+         
+         forward_[node] = backward_[node] = 0;
+      }
+      
+      if (!ahead.empty()) push(ahead);
+      if (!behind.empty()) push(behind);
+      if (!apart.empty()) push(apart);
+   }
+   
+   /**
+    * Finds the components of the specified task by the algorithm of Tarjan,
+    * following only the directed edges between nodes of the same color.
+    *
+    * @param nodes   the nodes of the task
+    * @param color   the color of the task
+    */
+   inline void ParallelSCC::tarjan(const std::vector<size_t>& nodes,
+      const size_t& color)
+   {
+      std::vector<size_t> stack;
+      std::vector<std::pair<size_t, Adjacency::Range>> frames;
+      size_t order = 0;
+      
+      for (const auto& root : nodes)
+      {
+         if (index_[root] != none) continue;
+         
+         index_[root] = low_[root] = order++;
+         stack.push_back(root);
+         on_stack_[root] = 1;
+         frames.push_back(std::make_pair(root, graph_ -> next(root)));
+         
+         while (!frames.empty())
+         {
+            const size_t node = frames.back().first;
+            Adjacency::Range& tails = frames.back().second;
+            
+            if (!tails.empty())
+            {
+               const size_t tail = *tails.begin();
+               tails = Adjacency::Range(tails.begin() + 1, tails.end());
+               
+               if (color_[tail].load(std::memory_order_relaxed) != color)
+                  continue;
+               
+               if (index_[tail] == none)
+               {
+                  index_[tail] = low_[tail] = order++;
+                  stack.push_back(tail);
+                  on_stack_[tail] = 1;
+                  frames.push_back(std::make_pair(tail, graph_ -> next(tail)));
+               }
+               
+               else if (on_stack_[tail])
+                  low_[node] = std::min(low_[node], index_[tail]);
+               
+               continue;
+            }
+            
+            frames.pop_back();
+            if (!frames.empty())
+            {
+               const size_t head = frames.back().first;
+               low_[head] = std::min(low_[head], low_[node]);
+            }
+            
+            if (low_[node] == index_[node])
+            {
+               const size_t component = next_component_++;
+               size_t member;
+               
+               do
+               {
+                  member = stack.back();
+                  stack.pop_back();
+                  on_stack_[member] = 0;
+                  component_[member] = component;
+               } while (member != node);
+            }
+         }
+      }
+   }
+   
+   /**
+    * Makes each node that has no head nodes or no tail nodes among the
+    * remaining nodes a component by itself, until no such node is left.
+    */
+   inline void ParallelSCC::trim()
+   {
+      const size_t n = graph_ -> size();
+      std::vector<size_t> indegree(n), outdegree(n), queue;
+      
+      for (size_t i = 0; i < n; i++)
+      {
+         indegree[i] = graph_ -> indegree(i);
+         outdegree[i] = graph_ -> outdegree(i);
+         
+         if (indegree[i] == 0 || outdegree[i] == 0)
+         {
+            component_[i] = next_component_++;
+            queue.push_back(i);
+         }
+      }
+      
+      // Removes the directed edges of each trimmed node from its neighbors.
+      for (size_t i = 0; i < queue.size(); i++)
+      {
+         for (const auto& tail : graph_ -> next(queue[i]))
+         {
+            if (component_[tail] == none && --indegree[tail] == 0)
+            {
+               component_[tail] = next_component_++;
+               queue.push_back(tail);
+            }
+         }
+         
+         for (const auto& head : graph_ -> prev(queue[i]))
+         {
+            if (component_[head] == none && --outdegree[head] == 0)
+            {
+               component_[head] = next_component_++;
+               queue.push_back(head);
+            }
+         }
+      }
+      
+      for (const auto& node : queue)
+         color_[node].store(none, std::memory_order_relaxed);
+   }
+   
+   /**
+    * Takes tasks from the queue until every task is done. A thread waits
+    * while the queue is empty, since the tasks that other threads are working
+    * on may still add more.
+    */
+   inline void ParallelSCC::work()
+   {
+      std::unique_lock<std::mutex> lock(mutex_);
+      
+      while (true)
+      {
+         condition_.wait(lock, [this]() {
+            return !tasks_.empty() || active_ == 0;
+         });
+         
+         if (tasks_.empty()) break;
+         
+         std::vector<size_t> nodes = std::move(tasks_.back());
+         tasks_.pop_back();
+         active_++;
+         lock.unlock();
+         
+         solve(nodes);
+         
+         lock.lock();
+         active_--;
+         if (active_ == 0 && tasks_.empty()) condition_.notify_all();
+      }
+   }
+}
+
+#endif   // PIC_10C_STRONG_COMPONENTS_H_
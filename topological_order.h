@@ -0,0 +1,543 @@
+/**
+ * Declarations and definitions of the <code>has_cycle</code> and
+ * <code>topological_order</code> functions, and the
+ * <code>TopologicalOrder</code> class.
+ *
+ * @file topological_order.h
+ *
+ * @author Kris Torres
+ *
+ * @date 2026-10-14
+ *
+ * @version 1.0
+ */
+
+#ifndef PIC_10C_TOPOLOGICAL_ORDER_H_
+#define PIC_10C_TOPOLOGICAL_ORDER_H_
+
+#include <string>
+#include <vector>
+#include <stdexcept>
+#include <algorithm>
+#include <utility>
+#include "boost/lexical_cast.hpp"
+#include "adjacency.h"
+#include "directed_graph.h"
+
+namespace Kris_Torres_UCLA_PIC_10C_Winter_2014
+{
+   /**
+    * A <b>topological order</b> lists the nodes of an acyclic directed graph
+    * so that the starting node of every directed edge comes before its ending
+    * node, and keeps the list valid while directed edges are connected and
+    * disconnected.<p>
+    *
+    * The order is maintained by the algorithm of Pearce and Kelly. Connecting
+    * a directed edge that already agrees with the order costs nothing more
+    * than storing it. Otherwise, only the nodes whose positions lie between
+    * the two ends of the directed edge can be out of place: the nodes reachable
+    * from the ending node are searched forward, and the nodes that reach the
+    * starting node are searched backward, without leaving that region, and
+    * the two sets are then moved past each other within the same positions.
+    * The cost is proportional to the size of that region and its directed
+    * edges, not to the size of the directed graph. Disconnecting a directed
+    * edge never invalidates the order.<p>
+    *
+    * A topological order keeps its own copy of the directed edges, so every
+    * change to the directed graph must also be made to the topological order.
+    *
+    * @author Kris Torres
+    */
+   class TopologicalOrder final
+   {
+   public:
+      
+      // Constructors
+      TopologicalOrder();
+      explicit TopologicalOrder(const Adjacency& graph);
+      template<typename T, typename S, typename A>
+      explicit TopologicalOrder(const DirectedGraph<T, S, A>& graph);
+      
+      // Mutators
+      void connect(const size_t& from, const size_t& to);
+      void disconnect(const size_t& from, const size_t& to);
+      void erase(const size_t& k);
+      void push_back();
+      
+      // Accessors
+      const std::vector<size_t>& order() const;
+      size_t position(const size_t& k) const;
+      size_t size() const;
+      
+   private:
+      
+      // Mutators
+      void search_backward(const size_t& start, const size_t& lower);
+      bool search_forward(const size_t& start, const size_t& upper,
+         const size_t& target);
+      void unmark();
+      
+      // Accessor
+      void test_index(const size_t& k, const char* error) const;
+      
+      /** The tail nodes of each node, with one entry per directed edge. */
+      std::vector<std::vector<size_t>> next_;
+      
+      /** The head nodes of each node, with one entry per directed edge. */
+      std::vector<std::vector<size_t>> prev_;
+      
+      /** The nodes, in topological order. */
+      std::vector<size_t> order_;
+      
+      /** The position of each node in the topological order. */
+      std::vector<size_t> position_;
+      
+      /** Whether each node has been reached by the current search. */
+      std::vector<bool> visited_;
+      
+      /** The nodes reached forward from the ending node of a directed edge. */
+      std::vector<size_t> forward_;
+      
+      /** The nodes that reach the starting node of a directed edge. */
+      std::vector<size_t> backward_;
+      
+      /** The nodes left to search. */
+      std::vector<size_t> stack_;
+   };
+   
+   /**
+    * Returns the nodes of the specified adjacency in topological order, so
+    * that the starting node of every directed edge comes before its ending
+    * node. The order is found by the algorithm of Kahn in linear time; the
+    * nodes without head nodes are taken in the order of their positions.
+    *
+    * @param graph   the adjacency of the directed graph
+    *
+    * @return the positions of the nodes in topological order
+    *
+    * @throws std::logic_error if the directed graph has a cycle
+    */
+   inline std::vector<size_t> topological_order(const Adjacency& graph)
+   {
+      std::vector<size_t> indegree(graph.size());
+      std::vector<size_t> result;
+      result.reserve(graph.size());
+      
+      for (size_t i = 0; i < graph.size(); i++)
+      {
+         indegree[i] = graph.indegree(i);
+         if (indegree[i] == 0) result.push_back(i);
+      }
+      
+      // Releases each tail node once all of its head nodes have been taken.
+      for (size_t i = 0; i < result.size(); i++)
+      {
+         for (const auto& tail : graph.next(result[i]))
+            if (--indegree[tail] == 0) result.push_back(tail);
+      }
+      
+      // Tests if some nodes were never released, which only a cycle causes.
+      if (result.size() != graph.size())
+         throw std::logic_error("Directed graph has a cycle");
+      
+      return result;
+   }
+   
+   /**
+    * Returns the nodes of the specified directed graph in topological order.
+    *
+    * @param graph   the directed graph
+    *
+    * @return the positions of the nodes in topological order
+    *
+    * @throws std::logic_error if the directed graph has a cycle
+    */
+   template<typename T, typename S, typename A>
+   inline std::vector<size_t> topological_order(
+      const DirectedGraph<T, S, A>& graph)
+   {
+      return topological_order(graph.adjacency());
+   }
+   
+   /**
+    * Tests if the specified adjacency has a cycle (i.e., a path of one or more
+    * directed edges from a node back to itself), in linear time. A loop is a
+    * cycle.
+    *
+    * @param graph   the adjacency of the directed graph
+    *
+    * @return <code>true</code> if the directed graph has a cycle, or
+    * <code>false</code> otherwise
+    */
+   inline bool has_cycle(const Adjacency& graph)
+   {
+      std::vector<size_t> indegree(graph.size());
+      std::vector<size_t> released;
+      released.reserve(graph.size());
+      
+      for (size_t i = 0; i < graph.size(); i++)
+      {
+         indegree[i] = graph.indegree(i);
+         if (indegree[i] == 0) released.push_back(i);
+      }
+      
+      for (size_t i = 0; i < released.size(); i++)
+      {
+         for (const auto& tail : graph.next(released[i]))
+            if (--indegree[tail] == 0) released.push_back(tail);
+      }
+      
+      return released.size() != graph.size();
+   }
+   
+   /**
+    * Tests if the specified directed graph has a cycle, in linear time.
+    *
+    * @param graph   the directed graph
+    *
+    * @return <code>true</code> if the directed graph has a cycle, or
+    * <code>false</code> otherwise
+    */
+   template<typename T, typename S, typename A>
+   inline bool has_cycle(const DirectedGraph<T, S, A>& graph)
+   {
+      return has_cycle(graph.adjacency());
+   }
+   
+   /** Constructs an empty topological order, with no nodes. */
+   inline TopologicalOrder::TopologicalOrder() {}
+   
+   /**
+    * Constructs a topological order of the nodes in the specified adjacency.
+    *
+    * @param graph   the adjacency of the directed graph
+    *
+    * @throws std::logic_error if the directed graph has a cycle
+    */
+   inline TopologicalOrder::TopologicalOrder(const Adjacency& graph)
+      : next_(graph.size()), prev_(graph.size()),
+        order_(topological_order(graph)), position_(graph.size()),
+        visited_(graph.size(), false)
+   {
+      for (size_t i = 0; i < graph.size(); i++)
+      {
+         next_[i].assign(graph.next(i).begin(), graph.next(i).end());
+         prev_[i].assign(graph.prev(i).begin(), graph.prev(i).end());
+         position_[order_[i]] = i;
+      }
+   }
+   
+   /**
+    * Constructs a topological order of the nodes in the specified directed
+    * graph.
+    *
+    * @param graph   the directed graph
+    *
+    * @throws std::logic_error if the directed graph has a cycle
+    */
+   template<typename T, typename S, typename A>
+   inline TopologicalOrder::TopologicalOrder(
+      const DirectedGraph<T, S, A>& graph)
+      : TopologicalOrder(graph.adjacency()) {}
+   
+   /**
+    * Connects a directed edge from the specified starting node to the specified
+    * ending node, and moves the nodes between them as needed to keep the order
+    * topological. If the directed edge would close a cycle, nothing is changed
+    * and an exception is thrown.<p>
+    *
+    * The function automatically checks whether <code>from</code> and
+    * <code>to</code> are greater than or equal to the number of nodes,
+    * throwing an <code>std::out_of_range</code> exception if it is not.
+    *
+    * @param from   the position of the starting node
+    * @param to     the position of the ending node
+    *
+    * @throws std::out_of_range if either <code>from</code> or <code>to</code>
+    * is out of bounds
+    * @throws std::logic_error if the directed edge would close a cycle
+    */
+   inline void TopologicalOrder::connect(const size_t& from, const size_t& to)
+   {
+      // Tests if the starting and ending node indices are valid.
+      test_index(from, "Invalid starting node index in directed graph: ");
+      test_index(to, "Invalid ending node index in directed graph: ");
+      
+      const size_t lower = position_[to];
+      const size_t upper = position_[from];
+      
+      // Reorders the nodes between the two ends if they are out of order.
+      if (lower <= upper)
+      {
+         if (search_forward(to, upper, from))
+         {
+            unmark();
+            throw std::logic_error("Directed edge would close a cycle: "
+               + boost::lexical_cast<std::string>(from) + " -> "
+               + boost::lexical_cast<std::string>(to));
+         }
+         
+         search_backward(from, lower);
+         
+         auto earlier = [this](const size_t& a, const size_t& b)
+         {
+            return position_[a] < position_[b];
+         };
+         
+         std::sort(forward_.begin(), forward_.end(), earlier);
+         std::sort(backward_.begin(), backward_.end(), earlier);
+         
+         // Places the backward nodes before the forward nodes.
+         std::vector<size_t> positions;
+         positions.reserve(forward_.size() + backward_.size());
+         
+         for (const auto& node : backward_)
+            positions.push_back(position_[node]);
+         
+         for (const auto& node : forward_)
+            positions.push_back(position_[node]);
+         
+         std::sort(positions.begin(), positions.end());
+         
+         size_t i = 0;
+         for (const auto& node : backward_) position_[node] = positions[i++];
+         for (const auto& node : forward_) position_[node] = positions[i++];
+         for (const auto& node : backward_) order_[position_[node]] = node;
+         for (const auto& node : forward_) order_[position_[node]] = node;
+         
+         unmark();
+      }
+      
+      next_[from].push_back(to);
+      prev_[to].push_back(from);
+   }
+   
+   /**
+    * Disconnects a directed edge from the specified starting node to the
+    * specified ending node, if there is one. The order stays topological.<p>
+    *
+    * The function automatically checks whether <code>from</code> and
+    * <code>to</code> are greater than or equal to the number of nodes,
+    * throwing an <code>std::out_of_range</code> exception if it is not.
+    *
+    * @param from   the position of the starting node
+    * @param to     the position of the ending node
+    *
+    * @throws std::out_of_range if either <code>from</code> or <code>to</code>
+    * is out of bounds
+    */
+   inline void TopologicalOrder::disconnect(const size_t& from,
+      const size_t& to)
+   {
+      // Tests if the starting and ending node indices are valid.
+      test_index(from, "Invalid starting node index in directed graph: ");
+      test_index(to, "Invalid ending node index in directed graph: ");
+      
+      std::vector<size_t>& edge = next_[from];
+      const auto tail = std::find(edge.begin(), edge.end(), to);
+      if (tail == edge.end()) return;
+      edge.erase(tail);
+      
+      std::vector<size_t>& reverse = prev_[to];
+      reverse.erase(std::find(reverse.begin(), reverse.end(), from));
+   }
+   
+   /**
+    * Removes the node at position <i>k</i>, along with its directed edges.
+    * The nodes after position <i>k</i> are moved down by one position, as in
+    * <code>DirectedGraph::erase</code>, so this function takes linear time.<p>
+    *
+    * The function automatically checks whether <i>k</i> is greater than or
+    * equal to the number of nodes, throwing an <code>std::out_of_range</code>
+    * exception if it is not.
+    *
+    * @param k   the position of the node
+    *
+    * @throws std::out_of_range if <i>k</i> is out of bounds
+    */
+   inline void TopologicalOrder::erase(const size_t& k)
+   {
+      // Tests if k is valid.
+      test_index(k, "Invalid node index in directed graph: ");
+      
+      // Removes the given node from the adjacent nodes of its neighbors.
+      for (const auto& tail : next_[k])
+      {
+         std::vector<size_t>& edge = prev_[tail];
+         edge.erase(std::remove(edge.begin(), edge.end(), k), edge.end());
+      }
+      
+      for (const auto& head : prev_[k])
+      {
+         std::vector<size_t>& edge = next_[head];
+         edge.erase(std::remove(edge.begin(), edge.end(), k), edge.end());
+      }
+      
+      order_.erase(order_.begin() + position_[k]);
+      next_.erase(next_.begin() + k);
+      prev_.erase(prev_.begin() + k);
+      position_.pop_back();
+      visited_.pop_back();
+      
+      // Renumbers the nodes after position k.
+      for (size_t i = 0; i < size(); i++)
+      {
+         if (order_[i] > k) order_[i]--;
+         position_[order_[i]] = i;
+         for (auto& tail : next_[i]) if (tail > k) tail--;
+         for (auto& head : prev_[i]) if (head > k) head--;
+      }
+   }
+   
+   /**
+    * Adds a node with no directed edges, after the current last node. The new
+    * node comes last in the order.
+    */
+   inline void TopologicalOrder::push_back()
+   {
+      position_.push_back(size());
+      order_.push_back(size());
+      next_.emplace_back();
+      prev_.emplace_back();
+      visited_.push_back(false);
+   }
+   
+   /**
+    * Returns the nodes in topological order.
+    *
+    * @return the positions of the nodes in topological order
+    */
+   inline const std::vector<size_t>& TopologicalOrder::order() const
+   {
+      return order_;
+   }
+   
+   /**
+    * Returns the position of the node at position <i>k</i> in the topological
+    * order.<p>
+    *
+    * The function automatically checks whether <i>k</i> is greater than or
+    * equal to the number of nodes, throwing an <code>std::out_of_range</code>
+    * exception if it is not.
+    *
+    * @param k   the position of the node
+    *
+    * @return the position of the node in the topological order
+    *
+    * @throws std::out_of_range if <i>k</i> is out of bounds
+    */
+   inline size_t TopologicalOrder::position(const size_t& k) const
+   {
+      // Tests if k is valid.
+      test_index(k, "Invalid node index in directed graph: ");
+      
+      return position_[k];
+   }
+   
+   /**
+    * Returns the number of nodes.
+    *
+    * @return the number of nodes
+    */
+   inline size_t TopologicalOrder::size() const
+   {
+      return order_.size();
+   }
+   
+   /**
+    * Gathers into <code>backward_</code> the nodes that reach the specified
+    * node and come after position <i>lower</i> in the order.
+    *
+    * @param start   the node from which to search
+    * @param lower   the position that bounds the search
+    */
+   inline void TopologicalOrder::search_backward(const size_t& start,
+      const size_t& lower)
+   {
+      visited_[start] = true;
+      stack_.assign(1, start);
+      
+      while (!stack_.empty())
+      {
+         const size_t node = stack_.back();
+         stack_.pop_back();
+         backward_.push_back(node);
+         
+         for (const auto& head : prev_[node])
+         {
+            if (!visited_[head] && position_[head] > lower)
+            {
+               visited_[head] = true;
+               stack_.push_back(head);
+            }
+         }
+      }
+   }
+   
+   /**
+    * Gathers into <code>forward_</code> the nodes reachable from the
+    * specified node that come before position <i>upper</i> in the order,
+    * stopping as soon as the target node is reached.
+    *
+    * @param start    the node from which to search
+    * @param upper    the position that bounds the search
+    * @param target   the node whose discovery means a cycle
+    *
+    * @return <code>true</code> if the target node is reachable, or
+    * <code>false</code> otherwise
+    */
+   inline bool TopologicalOrder::search_forward(const size_t& start,
+      const size_t& upper, const size_t& target)
+   {
+      visited_[start] = true;
+      stack_.assign(1, start);
+      
+      while (!stack_.empty())
+      {
+         const size_t node = stack_.back();
+         stack_.pop_back();
+         forward_.push_back(node);
+         if (node == target) return true;
+         
+         for (const auto& tail : next_[node])
+         {
+            if (!visited_[tail] && position_[tail] <= upper)
+            {
+               visited_[tail] = true;
+               stack_.push_back(tail);
+            }
+         }
+      }
+      
+      return false;
+   }
+   
+   /** Clears the marks left by the last searches, and the nodes they found. */
+   inline void TopologicalOrder::unmark()
+   {
+      for (const auto& node : forward_) visited_[node] = false;
+      for (const auto& node : backward_) visited_[node] = false;
+      for (const auto& node : stack_) visited_[node] = false;
+      forward_.clear();
+      backward_.clear();
+      stack_.clear();
+   }
+   
+   /**
+    * Tests if <i>k</i> is within the bounds of valid node positions, throwing
+    * an <code>std::out_of_range</code> exception if it is not (i.e., if
+    * <i>k</i> is greater than or equal to the number of nodes).
+    *
+    * @param k       the position of the node
+    * @param error   the error message
+    *
+    * @throws std::out_of_range if <i>k</i> is out of bounds
+    */
+   inline void TopologicalOrder::test_index(const size_t& k,
+      const char* error) const
+   {
+      if (k >= size()) throw_index_error(error, k);
+   }
+}
+
+#endif   // PIC_10C_TOPOLOGICAL_ORDER_H_
@@ -0,0 +1,386 @@
+/**
+ * Declarations and definitions of the <code>WeightedAdjacency</code> class
+ * template.
+ *
+ * @file weighted_adjacency.h
+ *
+ * @author Kris Torres
+ *
+ * @date 2026-10-14
+ *
+ * @version 1.0
+ */
+
+#ifndef PIC_10C_WEIGHTED_ADJACENCY_H_
+#define PIC_10C_WEIGHTED_ADJACENCY_H_
+
+#include <string>
+#include <vector>
+#include <stdexcept>
+#include <algorithm>
+#include <tuple>
+#include "boost/lexical_cast.hpp"
+#include "adjacency.h"
+#include "directed_graph.h"
+#include "index_error.h"
+
+namespace Kris_Torres_UCLA_PIC_10C_Winter_2014
+{
+   template<typename W>
+   class ShortestPaths;
+   
+   /**
+    * A <b>weighted adjacency</b> is a read-only snapshot of the directed edges
+    * of a directed graph, in compressed sparse row form, with a weight on
+    * every directed edge. The directed edges leaving each node are kept in one
+    * contiguous array of <i>arcs</i>, grouped by starting node, and each arc
+    * holds the position of its ending node right next to its weight, so that
+    * a shortest-path search reads both with one access.<p>
+    *
+    * The weights must not be negative. The arcs of each node are kept in the
+    * order of the directed edges that they were built from.
+    *
+    * @param W   the type of the weights
+    *
+    * @author Kris Torres
+    */
+   template<typename W>
+   class WeightedAdjacency final
+   {
+   public:
+      
+      // Classes
+      struct Arc;
+      class Range;
+      
+      // Type
+      typedef std::tuple<size_t, size_t, W> Edge;
+      
+      // Constructors
+      WeightedAdjacency();
+      WeightedAdjacency(const size_t& n, const std::vector<Edge>& edges);
+      template<typename F>
+      WeightedAdjacency(const Adjacency& graph, F weight);
+      template<typename T, typename S, typename A, typename F>
+      WeightedAdjacency(const DirectedGraph<T, S, A>& graph, F weight);
+      
+      // Accessors
+      size_t edges() const;
+      Range next(const size_t& k) const;
+      size_t outdegree(const size_t& k) const;
+      size_t size() const;
+      
+      // Friend
+      friend class ShortestPaths<W>;
+      
+   private:
+      
+      // Accessors
+      void test_index(const size_t& k) const;
+      static void test_weight(const W& weight);
+      
+      /**
+       * The position in <code>arcs_</code> at which the arcs of each node
+       * begin, followed by the number of directed edges.
+       */
+      std::vector<size_t> offsets_;
+      
+      /** The arcs of all the directed edges, grouped by starting node. */
+      std::vector<Arc> arcs_;
+   };
+   
+   /**
+    * An <b>arc</b> is a directed edge leaving a node in a weighted adjacency,
+    * given by the position of its ending node and its weight.
+    *
+    * @author Kris Torres
+    */
+   template<typename W>
+   struct WeightedAdjacency<W>::Arc final
+   {
+      /** The position of the ending node. */
+      size_t target;
+      
+      /** The weight of the directed edge. */
+      W weight;
+   };
+   
+   /**
+    * A <b>range</b> is a view of the arcs leaving one node in a weighted
+    * adjacency, which can be traversed with a range-based <code>for</code>
+    * loop. A range is invalidated when its weighted adjacency is destroyed.
+    *
+    * @author Kris Torres
+    */
+   template<typename W>
+   class WeightedAdjacency<W>::Range final
+   {
+   public:
+      
+      // Constructor
+      Range(const Arc* first, const Arc* last);
+      
+      // Accessors
+      const Arc* begin() const;
+      bool empty() const;
+      const Arc* end() const;
+      size_t size() const;
+      
+   private:
+      
+      /** The position of the first arc. */
+      const Arc* first_;
+      
+      /** The position one past the last arc. */
+      const Arc* last_;
+   };
+   
+   /** Constructs an empty weighted adjacency, with no nodes. */
+   template<typename W>
+   inline WeightedAdjacency<W>::WeightedAdjacency() : offsets_(1, 0) {}
+   
+   /**
+    * Constructs a weighted adjacency with <i>n</i> nodes and the specified
+    * directed edges, given as tuples of starting node position, ending node
+    * position, and weight. The directed edges are grouped by a stable
+    * counting sort, so the whole weighted adjacency is built in linear time.
+    *
+    * @param n       the number of nodes
+    * @param edges   the weighted directed edges
+    *
+    * @throws std::out_of_range if some directed edge has a node position that
+    * is at least <i>n</i>
+    * @throws std::invalid_argument if some directed edge has a negative weight
+    */
+   template<typename W>
+   WeightedAdjacency<W>::WeightedAdjacency(const size_t& n,
+      const std::vector<Edge>& edges) : offsets_(n + 1, 0)
+   {
+      // Counts the outdegree of each node.
+      for (const auto& edge : edges)
+      {
+         const size_t from = std::get<0>(edge);
+         const size_t to = std::get<1>(edge);
+         
+         if (from >= n || to >= n)
+            throw_index_error("Invalid node index in adjacency: ",
+               std::max(from, to));
+         
+         test_weight(std::get<2>(edge));
+         offsets_[from + 1]++;
+      }
+      
+      for (size_t i = 0; i < n; i++) offsets_[i + 1] += offsets_[i];
+      
+      // Places each directed edge at the next free slot of its group.
+      std::vector<size_t> next(offsets_.begin(), offsets_.end() - 1);
+      arcs_.resize(edges.size());
+      
+      for (const auto& edge : edges)
+      {
+         Arc& arc = arcs_[next[std::get<0>(edge)]++];
+         arc.target = std::get<1>(edge);
+         arc.weight = std::get<2>(edge);
+      }
+   }
+   
+   /**
+    * Constructs a weighted adjacency with the directed edges of the specified
+    * adjacency, in the same order, weighted by the specified function.
+    *
+    * @param F   the type of the weight function
+    *
+    * @param graph    the adjacency of the directed graph
+    * @param weight   the function called with the starting and ending node
+    *                 positions of each directed edge, which returns its weight
+    *
+    * @throws std::invalid_argument if some directed edge has a negative weight
+    */
+   template<typename W>
+   template<typename F>
+   WeightedAdjacency<W>::WeightedAdjacency(const Adjacency& graph, F weight)
+      : offsets_(graph.size() + 1, 0), arcs_(graph.edges())
+   {
+      size_t k = 0;
+      
+      for (size_t i = 0; i < graph.size(); i++)
+      {
+         for (const auto& tail : graph.next(i))
+         {
+            Arc& arc = arcs_[k++];
+            arc.target = tail;
+            arc.weight = weight(i, tail);
+            test_weight(arc.weight);
+         }
+         
+         offsets_[i + 1] = k;
+      }
+   }
+   
+   /**
+    * Constructs a weighted adjacency with the directed edges of the specified
+    * directed graph, weighted by the specified function.
+    *
+    * @param F   the type of the weight function
+    *
+    * @param graph    the directed graph
+    * @param weight   the function called with the starting and ending node
+    *                 positions of each directed edge, which returns its weight
+    *
+    * @throws std::invalid_argument if some directed edge has a negative weight
+    */
+   template<typename W>
+   template<typename T, typename S, typename A, typename F>
+   inline WeightedAdjacency<W>::WeightedAdjacency(
+      const DirectedGraph<T, S, A>& graph, F weight)
+      : WeightedAdjacency(graph.adjacency(), weight) {}
+   
+   /**
+    * Returns the number of directed edges in this weighted adjacency.
+    *
+    * @return the number of directed edges
+    */
+   template<typename W>
+   inline size_t WeightedAdjacency<W>::edges() const
+   {
+      return arcs_.size();
+   }
+   
+   /**
+    * Returns the arcs leaving the node at position <i>k</i> in this weighted
+    * adjacency.
+    *
+    * @param k   the position of the node
+    *
+    * @return the range of the arcs
+    *
+    * @throws std::out_of_range if <i>k</i> is at least the number of nodes
+    */
+   template<typename W>
+   inline typename WeightedAdjacency<W>::Range WeightedAdjacency<W>::next(
+      const size_t& k) const
+   {
+      test_index(k);
+      return Range(arcs_.data() + offsets_[k], arcs_.data() + offsets_[k + 1]);
+   }
+   
+   /**
+    * Returns the <b>outdegree</b> of the node at position <i>k</i> in this
+    * weighted adjacency.
+    *
+    * @param k   the position of the node
+    *
+    * @return the outdegree of the node
+    *
+    * @throws std::out_of_range if <i>k</i> is at least the number of nodes
+    */
+   template<typename W>
+   inline size_t WeightedAdjacency<W>::outdegree(const size_t& k) const
+   {
+      test_index(k);
+      return offsets_[k + 1] - offsets_[k];
+   }
+   
+   /**
+    * Returns the number of nodes in this weighted adjacency.
+    *
+    * @return the number of nodes
+    */
+   template<typename W>
+   inline size_t WeightedAdjacency<W>::size() const
+   {
+      return offsets_.size() - 1;
+   }
+   
+   /**
+    * Tests if the specified position is a valid node position in this
+    * weighted adjacency.
+    *
+    * @param k   the position of the node
+    *
+    * @throws std::out_of_range if <i>k</i> is at least the number of nodes
+    */
+   template<typename W>
+   inline void WeightedAdjacency<W>::test_index(const size_t& k) const
+   {
+      if (k >= size())
+         throw_index_error("Invalid node index in adjacency: ", k);
+   }
+   
+   /**
+    * Tests if the specified weight is not negative.
+    *
+    * @param weight   the weight of a directed edge
+    *
+    * @throws std::invalid_argument if the weight is negative
+    */
+   template<typename W>
+   inline void WeightedAdjacency<W>::test_weight(const W& weight)
+   {
+      if (weight < W())
+      {
+         throw std::invalid_argument("Negative weight in adjacency: "
+            + boost::lexical_cast<std::string>(weight));
+      }
+   }
+   
+   /**
+    * Constructs a range of the arcs from <i>first</i> up to, but not
+    * including, <i>last</i>.
+    *
+    * @param first   the position of the first arc
+    * @param last    the position one past the last arc
+    */
+   template<typename W>
+   inline WeightedAdjacency<W>::Range::Range(const Arc* first, const Arc* last)
+      : first_(first), last_(last) {}
+   
+   /**
+    * Returns the position of the first arc in this range.
+    *
+    * @return the position of the first arc
+    */
+   template<typename W>
+   inline const typename WeightedAdjacency<W>::Arc*
+      WeightedAdjacency<W>::Range::begin() const
+   {
+      return first_;
+   }
+   
+   /**
+    * Tests if this range is empty.
+    *
+    * @return <code>true</code> if this range has no arcs, or
+    * <code>false</code> otherwise
+    */
+   template<typename W>
+   inline bool WeightedAdjacency<W>::Range::empty() const
+   {
+      return first_ == last_;
+   }
+   
+   /**
+    * Returns the position one past the last arc in this range.
+    *
+    * @return the position one past the last arc
+    */
+   template<typename W>
+   inline const typename WeightedAdjacency<W>::Arc*
+      WeightedAdjacency<W>::Range::end() const
+   {
+      return last_;
+   }
+   
+   /**
+    * Returns the number of arcs in this range.
+    *
+    * @return the number of arcs
+    */
+   template<typename W>
+   inline size_t WeightedAdjacency<W>::Range::size() const
+   {
+      return last_ - first_;
+   }
+}
+
+#endif   // PIC_10C_WEIGHTED_ADJACENCY_H_